@@ -0,0 +1,57 @@
+'''
+Compares linear frustum culling with BVH queries for growing numbers of objects scattered in a large world.
+
+    python benchmarks/bench_culling.py
+'''
+
+import array
+import random
+import time
+import timeit
+
+from pygl.math import BVH, Frustum, Matrix4, Vector3
+
+COUNTS = (10_000, 100_000, 200_000, 500_000)
+WORLD_SIZE = 2000.0
+REPEATS = 20
+
+def make_aabbs(count: int) -> array.array:
+    rng = random.Random(0)
+    data = array.array('f')
+    for _ in range(count):
+        x, y, z = (rng.uniform(-WORLD_SIZE, WORLD_SIZE) for _ in range(3))
+        size = rng.uniform(0.5, 4.0)
+        data.extend((x - size, y - size, z - size, x + size, y + size, z + size))
+
+    return data
+
+def best_ms(func) -> float:
+    return min(timeit.repeat(func, number=1, repeat=REPEATS)) * 1e3
+
+def main() -> None:
+    frustum = Frustum(
+        Matrix4.perspective(1.0, 16.0 / 9.0, 0.1, 500.0) @
+        Matrix4.look_at(Vector3(0.0, 0.0, 0.0), Vector3(1.0, 0.2, 0.3), Vector3(0.0, 1.0, 0.0)))
+    rays = array.array('f', [0.0, 0.0, 0.0] * 1000)
+    directions = array.array('f', [1.0, 0.01, 0.02] * 1000)
+
+    print(f'{"objects":>10}{"build ms":>12}{"refit ms":>12}{"linear ms":>12}{"bvh ms":>10}{"1k rays ms":>12}')
+    for count in COUNTS:
+        aabbs = make_aabbs(count)
+
+        start = time.perf_counter()
+        bvh = BVH(aabbs)
+        build = (time.perf_counter() - start) * 1e3
+
+        assert sorted(bvh.query_frustum(frustum).tolist()) == frustum.cull_aabbs(aabbs, indices=True).tolist()
+
+        print(
+            f'{count:>10}'
+            f'{build:>12.1f}'
+            f'{best_ms(lambda: bvh.refit(aabbs)):>12.2f}'
+            f'{best_ms(lambda: frustum.cull_aabbs(aabbs, indices=True)):>12.2f}'
+            f'{best_ms(lambda: bvh.query_frustum(frustum)):>10.2f}'
+            f'{best_ms(lambda: bvh.query_rays(rays, directions)):>12.2f}')
+
+if __name__ == '__main__':
+    main()
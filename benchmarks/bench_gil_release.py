@@ -0,0 +1,109 @@
+'''
+Measures how much work a background Python thread gets done while the main thread performs large uploads,
+compared with a copy of the same size that holds the GIL. Requires glfw and OpenGL 4.5 capable driver.
+
+    python benchmarks/bench_gil_release.py
+'''
+
+import threading
+import time
+
+import glfw
+
+import pygl
+from pygl.buffers import Buffer, BufferFlags
+from pygl.textures import (InternalFormat, PixelFormat, Texture, TextureSpec,
+                           TextureTarget, TextureUploadInfo)
+
+SIZES_MB = (16, 64, 256)
+TEXTURE_SIZE = 4096
+REPEATS = 5
+
+class Counter:
+    def __init__(self) -> None:
+        self.ticks = 0
+        self.running = True
+        self.thread = threading.Thread(target=self._run, daemon=True)
+
+    def _run(self) -> None:
+        while self.running:
+            self.ticks += 1
+
+    def __enter__(self) -> 'Counter':
+        self.thread.start()
+        return self
+
+    def __exit__(self, *_) -> None:
+        self.running = False
+        self.thread.join()
+
+def measure(func) -> tuple[float, float]:
+    '''
+    Returns best time of `func` in milliseconds and number of background thread ticks per millisecond
+    recorded during that run.
+    '''
+
+    best_ms = float('inf')
+    best_rate = 0.0
+    for _ in range(REPEATS):
+        with Counter() as counter:
+            # let the counter thread start running before measuring
+            time.sleep(0.01)
+            start_ticks = counter.ticks
+            start = time.perf_counter()
+            func()
+            elapsed_ms = (time.perf_counter() - start) * 1e3
+            ticks = counter.ticks - start_ticks
+
+        if elapsed_ms < best_ms:
+            best_ms = elapsed_ms
+            best_rate = ticks / elapsed_ms
+
+    return best_ms, best_rate
+
+def main() -> None:
+    glfw.init()
+    glfw.window_hint(glfw.CONTEXT_VERSION_MAJOR, 4)
+    glfw.window_hint(glfw.CONTEXT_VERSION_MINOR, 5)
+    glfw.window_hint(glfw.OPENGL_PROFILE, glfw.OPENGL_CORE_PROFILE)
+    glfw.window_hint(glfw.VISIBLE, False)
+    win = glfw.create_window(64, 64, 'Benchmark', None, None)
+    glfw.make_context_current(win)
+    pygl.init()
+
+    print(f'{"operation":<28}{"size MB":>9}{"ms":>10}{"bg ticks/ms":>14}')
+    for size_mb in SIZES_MB:
+        size = size_mb << 20
+        data = bytes(size)
+        target = bytearray(size)
+        buffer = Buffer(size, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+        def copy_with_gil() -> None:
+            target[:] = data
+
+        def store() -> None:
+            buffer.store(data, 0)
+
+        def store_transfer() -> None:
+            buffer.store(data, 0)
+            buffer.transfer()
+
+        for name, func in (('bytearray copy (GIL held)', copy_with_gil), ('Buffer.store', store), ('Buffer.store + transfer', store_transfer)):
+            ms, rate = measure(func)
+            print(f'{name:<28}{size_mb:>9}{ms:>10.1f}{rate:>14.0f}')
+
+        buffer.delete()
+
+    texture = Texture(TextureSpec(TextureTarget.TEXTURE_2D, TEXTURE_SIZE, TEXTURE_SIZE, InternalFormat.RGBA8))
+    info = TextureUploadInfo(PixelFormat.RGBA, TEXTURE_SIZE, TEXTURE_SIZE, generate_mipmap=False)
+    pixels = bytes(TEXTURE_SIZE * TEXTURE_SIZE * 4)
+
+    ms, rate = measure(lambda: texture.upload(info, pixels))
+    print(f'{"Texture.upload":<28}{len(pixels) >> 20:>9}{ms:>10.1f}{rate:>14.0f}')
+
+    texture.delete()
+    glfw.destroy_window(win)
+    glfw.terminate()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,43 @@
+'''
+Measures per-call overhead of the most common pygl.math constructors and methods.
+Run it against two builds of pygl to compare them, e.g.:
+
+    python benchmarks/bench_math_calls.py
+'''
+
+import timeit
+
+from pygl.math import Matrix4, Quaternion, Vector3, interpolate
+
+ITERATIONS = 1_000_000
+REPEATS = 5
+
+a = Vector3(1.0, 2.0, 3.0)
+b = Vector3(4.0, 5.0, 6.0)
+q = Quaternion(0.0, 0.0, 0.0, 1.0)
+m = Matrix4.identity()
+
+CASES = {
+    'Vector3(x, y, z)': lambda: Vector3(1.0, 2.0, 3.0),
+    'Quaternion(x, y, z, w)': lambda: Quaternion(0.0, 0.0, 0.0, 1.0),
+    'Matrix4(float)': lambda: Matrix4(1.0),
+    'Vector3 + Vector3': lambda: a + b,
+    'Vector3.interpolate': lambda: a.interpolate(b, 0.5),
+    'Quaternion.interpolate': lambda: q.interpolate(q, 0.5),
+    'Quaternion.from_axis': lambda: Quaternion.from_axis(1.0, a),
+    'Matrix4.transform': lambda: Matrix4.transform(a, b, q),
+    'Matrix4.perspective (kwargs)': lambda: Matrix4.perspective(1.0, 1.5, z_near=0.1, z_far=100.0),
+    'Matrix4 @ Matrix4': lambda: m @ m,
+    'pygl.math.interpolate': lambda: interpolate(a, b, 0.5),
+}
+
+def main() -> None:
+    baseline = min(timeit.repeat(lambda: None, number=ITERATIONS, repeat=REPEATS))
+
+    print(f'{"case":<32}{"ns/call":>10}')
+    for name, func in CASES.items():
+        best = min(timeit.repeat(func, number=ITERATIONS, repeat=REPEATS))
+        print(f'{name:<32}{(best - baseline) / ITERATIONS * 1e9:>10.1f}')
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,45 @@
+'''
+Measures per-call cost of matrix and vector operations which have SIMD code paths in cglm.
+Run it against builds with and without AVX (`-DPYGL_ENABLE_AVX=ON`) to compare them, e.g.:
+
+    python benchmarks/bench_math_simd.py
+
+`*_into` variants are included to separate arithmetic cost from object allocation.
+'''
+
+import timeit
+
+from pygl.math import Matrix4, Quaternion, Vector3, Vector4
+
+ITERATIONS = 1_000_000
+REPEATS = 5
+
+m = Matrix4.transform(Vector3(1.0, 2.0, 3.0), Vector3(2.0), Quaternion.from_axis(0.5, Vector3(0.0, 1.0, 0.0)))
+v = Vector4(1.0, 2.0, 3.0, 4.0)
+q = Quaternion(0.1, 0.2, 0.3, 0.9)
+out_m = Matrix4()
+out_v = Vector4(0.0)
+out_q = Quaternion(0.0, 0.0, 0.0, 1.0)
+
+CASES = {
+    'Matrix4 @ Matrix4': lambda: m @ m,
+    'Matrix4.matmul_into': lambda: m.matmul_into(m, out_m),
+    'Matrix4 @ Vector4': lambda: m @ v,
+    'Matrix4.inversed': lambda: m.inversed(),
+    'Matrix4.inversed_into': lambda: m.inversed_into(out_m),
+    'Matrix4.transposed_into': lambda: m.transposed_into(out_m),
+    'Vector4.normalized': lambda: v.normalized(),
+    'Vector4.normalized_into': lambda: v.normalized_into(out_v),
+    'Quaternion.normalized_into': lambda: q.normalized_into(out_q),
+}
+
+def main() -> None:
+    baseline = min(timeit.repeat(lambda: None, number=ITERATIONS, repeat=REPEATS))
+
+    print(f'{"case":<32}{"ns/call":>10}')
+    for name, func in CASES.items():
+        best = min(timeit.repeat(func, number=ITERATIONS, repeat=REPEATS))
+        print(f'{name:<32}{(best - baseline) / ITERATIONS * 1e9:>10.1f}')
+
+if __name__ == '__main__':
+    main()
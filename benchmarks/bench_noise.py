@@ -0,0 +1,77 @@
+'''
+Compares filling 2D heightmaps with `pygl.math.noise.fill` against vectorized numpy implementation of Perlin noise
+and fBm built on top of it. Requires numpy.
+
+    python benchmarks/bench_noise.py
+'''
+
+import timeit
+
+import numpy as np
+
+from pygl.math import noise
+
+SIZES = (256, 512, 1024, 2048)
+OCTAVES = 5
+SCALE = 1.0 / 64.0
+REPEATS = 5
+
+_GRADIENTS = np.array([
+    [1.0, 0.0], [-1.0, 0.0], [0.0, 1.0], [0.0, -1.0],
+    [0.7071, 0.7071], [-0.7071, 0.7071], [0.7071, -0.7071], [-0.7071, -0.7071]], dtype=np.float32)
+
+def _fade(t: np.ndarray) -> np.ndarray:
+    return t * t * t * (t * (t * 6.0 - 15.0) + 10.0)
+
+def numpy_perlin(x: np.ndarray, y: np.ndarray, permutation: np.ndarray) -> np.ndarray:
+    xi = np.floor(x).astype(np.int64)
+    yi = np.floor(y).astype(np.int64)
+    xf = (x - xi).astype(np.float32)
+    yf = (y - yi).astype(np.float32)
+    xi &= 255
+    yi &= 255
+
+    def corner(ox: int, oy: int) -> np.ndarray:
+        gradient = _GRADIENTS[permutation[permutation[xi + ox] + yi + oy] & 7]
+        return gradient[..., 0] * (xf - ox) + gradient[..., 1] * (yf - oy)
+
+    u = _fade(xf)
+    v = _fade(yf)
+    bottom = corner(0, 0) + u * (corner(1, 0) - corner(0, 0))
+    top = corner(0, 1) + u * (corner(1, 1) - corner(0, 1))
+
+    return (bottom + v * (top - bottom)) * 1.4142
+
+def numpy_fill(size: int, octaves: int, permutation: np.ndarray) -> np.ndarray:
+    y, x = np.mgrid[0:size, 0:size].astype(np.float32) * SCALE
+    result = np.zeros((size, size), dtype=np.float32)
+    amplitude = 1.0
+    amplitude_sum = 0.0
+    for _ in range(octaves):
+        result += numpy_perlin(x, y, permutation) * amplitude
+        amplitude_sum += amplitude
+        amplitude *= 0.5
+        x *= 2.0
+        y *= 2.0
+
+    return result / amplitude_sum
+
+def best_ms(func) -> float:
+    return min(timeit.repeat(func, number=1, repeat=REPEATS)) * 1e3
+
+def main() -> None:
+    rng = np.random.default_rng(0)
+    permutation = np.tile(rng.permutation(256), 2)
+
+    print(f'{"size":>8}{"octaves":>9}{"numpy ms":>12}{"pygl ms":>10}{"speedup":>10}')
+    for size in SIZES:
+        dst = np.empty((size, size), dtype=np.float32)
+        for octaves in (1, OCTAVES):
+            fractal = noise.FractalType.NONE if octaves == 1 else noise.FractalType.FBM
+            numpy_ms = best_ms(lambda: numpy_fill(size, octaves, permutation))
+            pygl_ms = best_ms(lambda: noise.fill(dst, size, size, fractal=fractal, octaves=octaves, scale=SCALE))
+
+            print(f'{size:>8}{octaves:>9}{numpy_ms:>12.1f}{pygl_ms:>10.1f}{numpy_ms / pygl_ms:>10.1f}')
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,59 @@
+'''
+Measures throughput of `Buffer.store` into persistently mapped and client storage buffers with parallel copies
+disabled and enabled (see `pygl.buffers.set_parallel_copy_threshold`). Requires glfw and OpenGL 4.5 capable driver.
+
+    python benchmarks/bench_parallel_copy.py
+'''
+
+import timeit
+
+import glfw
+
+import pygl
+from pygl import buffers
+from pygl.buffers import Buffer, BufferFlags
+
+SIZES_MB = (1, 4, 16, 64, 256)
+PARALLEL_THRESHOLD = 1 << 20
+REPEATS = 10
+
+def best_gbps(func, size: int) -> float:
+    return size / min(timeit.repeat(func, number=1, repeat=REPEATS)) / 1e9
+
+def main() -> None:
+    glfw.init()
+    glfw.window_hint(glfw.CONTEXT_VERSION_MAJOR, 4)
+    glfw.window_hint(glfw.CONTEXT_VERSION_MINOR, 5)
+    glfw.window_hint(glfw.OPENGL_PROFILE, glfw.OPENGL_CORE_PROFILE)
+    glfw.window_hint(glfw.VISIBLE, False)
+    win = glfw.create_window(64, 64, 'Benchmark', None, None)
+    glfw.make_context_current(win)
+    pygl.init()
+
+    storages = (
+        ('mapped', BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT | BufferFlags.MAP_COHERENT_BIT),
+        ('client', BufferFlags.DYNAMIC_STORAGE_BIT))
+
+    print(f'{"storage":<10}{"size MB":>9}{"serial GB/s":>14}{"parallel GB/s":>16}{"speedup":>10}')
+    for name, flags in storages:
+        for size_mb in SIZES_MB:
+            size = size_mb << 20
+            data = bytes(size)
+            buffer = Buffer(size, flags)
+
+            buffers.set_parallel_copy_threshold(0)
+            serial = best_gbps(lambda: buffer.store(data, 0), size)
+
+            buffers.set_parallel_copy_threshold(PARALLEL_THRESHOLD)
+            parallel = best_gbps(lambda: buffer.store(data, 0), size)
+
+            buffers.set_parallel_copy_threshold(0)
+            buffer.delete()
+
+            print(f'{name:<10}{size_mb:>9}{serial:>14.2f}{parallel:>16.2f}{parallel / serial:>10.2f}')
+
+    glfw.destroy_window(win)
+    glfw.terminate()
+
+if __name__ == '__main__':
+    main()
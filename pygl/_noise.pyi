@@ -0,0 +1,72 @@
+# Stubs of `pygl.math.noise`. The module is created together with `pygl.math` and registered under its full name,
+# it doesn't exist as `pygl._noise` at runtime.
+
+import enum
+import typing as t
+from collections.abc import Buffer as TSupportsBuffer
+
+from pygl.math import Vector2, Vector3, Vector4
+
+class NoiseType(enum.IntEnum):
+    PERLIN = t.cast(int, ...)
+    SIMPLEX = t.cast(int, ...)
+    WORLEY = t.cast(int, ...)
+
+class FractalType(enum.IntEnum):
+    NONE = t.cast(int, ...)
+    FBM = t.cast(int, ...)
+    RIDGED = t.cast(int, ...)
+
+def perlin(point: Vector2 | Vector3 | Vector4, seed: int = 0) -> float:
+    '''
+    Evaluates gradient noise of dimension matching `point`. All noise functions return values in range `[-1, 1]`.
+    '''
+
+def simplex(point: Vector2 | Vector3 | Vector4, seed: int = 0) -> float: ...
+
+def worley(point: Vector2 | Vector3 | Vector4, seed: int = 0) -> float:
+    '''
+    Evaluates cellular noise, that is distance to the closest feature point (one per unit cell) remapped from `[0, 1]` to `[-1, 1]`.
+    '''
+
+def fractal(point: Vector2 | Vector3 | Vector4,
+            noise_type: NoiseType = NoiseType.PERLIN,
+            *,
+            fractal: FractalType = FractalType.FBM,
+            octaves: int = 4,
+            lacunarity: float = 2.0,
+            gain: float = 0.5,
+            seed: int = 0) -> float:
+    '''
+    Sums `octaves` layers of noise, each one with frequency multiplied by `lacunarity` and amplitude multiplied by `gain`.
+    '''
+
+def fill(dst: TSupportsBuffer,
+         width: int,
+         height: int,
+         depth: int = 1,
+         *,
+         noise_type: NoiseType = NoiseType.PERLIN,
+         fractal: FractalType = FractalType.NONE,
+         octaves: int = 4,
+         lacunarity: float = 2.0,
+         gain: float = 0.5,
+         seed: int = 0,
+         origin: Vector2 | Vector3 | Vector4 | None = None,
+         scale: float = 1.0 / 32.0,
+         pixel_type: int = ...,
+         alignment: t.Literal[1, 2, 4, 8] = 4,
+         row_length: int = 0,
+         image_height: int = 0,
+         offset: int = -1) -> None:
+    '''
+    Fills image of given size with noise sampled at `origin + (x, y, z) * scale` and writes it into `dst` (either
+    a writable buffer or a mapped `pygl.buffers.Buffer`, e.g. one used as pixel unpack buffer). Images with `depth`
+    greater than 1 use 3D noise, passing 4-component `origin` selects 4D noise (e.g. to animate a texture over time).
+
+    Texels are written as single channel `pygl.textures.PixelType.FLOAT` or, if `pixel_type` is
+    `pygl.textures.PixelType.UNSIGNED_BYTE`, as values normalized to `[0, 255]`. Rows are padded to `alignment` and
+    `row_length` / `image_height` allow filling a region of a larger image, the same way as `pygl.textures.TextureUploadInfo`
+    describes it, so result can be passed directly to `pygl.textures.Texture.upload` with `PixelFormat.RED`.
+    Large images release the GIL and are filled by multiple threads.
+    '''
@@ -2,14 +2,17 @@ import enum
 import typing as t
 from collections.abc import Buffer as TSupportsBuffer
 
-from .math import (Matrix2, Matrix3, Matrix4, Quaternion, Vector2, Vector3,
-                   Vector4)
+from .math import (DMatrix4, DVector2, DVector3, DVector4, Matrix2, Matrix3,
+                   Matrix4, Matrix4Array, Quaternion, Vector2, Vector2Array,
+                   Vector3, Vector3Array, Vector4, Vector4Array)
+from .vertex_array import VertexDescriptor, VertexInput
 
 class BufferFlags(enum.IntFlag):
     MAP_WRITE_BIT: int
     MAP_READ_BIT: int
     MAP_PERSISTENT_BIT: int
     MAP_COHERENT_BIT: int
+    MAP_FLUSH_EXPLICIT_BIT: int
     DYNAMIC_STORAGE_BIT: int
     NONE: int
 
@@ -35,8 +38,40 @@ class BindTarget(enum.IntEnum):
     TRANSFORM_FEEDBACK_BUFFER: int
     UNIFORM_BUFFER: int
 
-TMatrix = Matrix2 | Matrix3 | Matrix4
-TVector = Vector2 | Vector3 | Vector4
+class FieldType(enum.IntEnum):
+    FLOAT: int
+    FLOAT2: int
+    FLOAT3: int
+    FLOAT4: int
+    INT: int
+    INT2: int
+    INT3: int
+    INT4: int
+    UINT: int
+    UINT2: int
+    UINT3: int
+    UINT4: int
+    HALF2: int
+    HALF4: int
+    BYTE4N: int
+    UBYTE4: int
+    UBYTE4N: int
+    SHORT2N: int
+    SHORT4N: int
+    USHORT2N: int
+    USHORT4N: int
+    INT_2_10_10_10_REV: int
+    MAT3: int
+    MAT4: int
+
+class LayoutRule(enum.IntEnum):
+    PACKED: int
+    STD140: int
+    STD430: int
+
+TMatrix = Matrix2 | Matrix3 | Matrix4 | DMatrix4
+TVector = Vector2 | Vector3 | Vector4 | DVector2 | DVector3 | DVector4
+TVectorArray = Vector2Array | Vector3Array | Vector4Array
 
 class Buffer:
     '''
@@ -64,6 +99,12 @@ class Buffer:
     @t.overload
     def store(self, data: TVector, offset: int | None = None) -> None: ...
 
+    @t.overload
+    def store(self, data: TVectorArray, offset: int | None = None) -> None: ...
+
+    @t.overload
+    def store(self, data: Matrix4Array, offset: int | None = None) -> None: ...
+
     @t.overload
     def store(self, data: Quaternion, offset: int | None = None) -> None: ...
 
@@ -73,16 +114,58 @@ class Buffer:
     @t.overload
     def store(self, data: float, offset: int | None = None) -> None: ...
 
+    def store_many(self, data: t.Sequence[TSupportsBuffer | TMatrix | TVector | TVectorArray | Matrix4Array | Quaternion | int | float], offset: int | None = None) -> None:
+        '''
+        Stores all objects from `data` one after another, using the same rules as `store`. Current offset is
+        advanced only if all objects were stored.
+        '''
+
     def store_address(self, address: int, size: int) -> None: ...
 
     def delete(self) -> None: ...
-    def transfer(self) -> None: ...
+
+    def transfer(self) -> int:
+        '''
+        Uploads ranges written since the last transfer (for dynamic storage buffers) or flushes them (for buffers
+        mapped with `MAP_FLUSH_EXPLICIT_BIT`), unmaps non-persistent buffers and resets current offset.
+        Returns number of uploaded or flushed bytes.
+        '''
+
     def reset_offset(self) -> None: ...
     def map(self) -> None: ...
     def read(self, out: TSupportsBuffer, size: int, offset: int = 0) -> None: ...
     def bind_base(self, target: BufferBaseTarget, index: int) -> None: ...
     def bind(self, target: BindTarget) -> None: ...
 
+    def read_async(self, size: int, offset: int = 0) -> ReadbackFuture:
+        '''
+        Copies `size` bytes at `offset` into a persistently mapped staging buffer on GPU and returns a future
+        for the data, without waiting for commands that use the buffer to finish. Like `read`, it returns
+        buffer storage contents, so data stored into client storage has to be transferred first.
+        '''
+
+    def view(self, format: str = 'B', shape: t.Sequence[int] | None = None, offset: int = 0, size: int | None = None) -> memoryview:
+        '''
+        Returns a memoryview of `size` bytes of the buffer memory starting at `offset`, cast to `format` and
+        `shape` (see `memoryview.cast`). Without `size` view covers as many items as fit in the rest of the buffer.
+        Data is not copied, so the buffer has to be mapped or use client storage. Views are read-only if the buffer
+        isn't mapped for writing and their whole range is treated as written until they are released.
+        '''
+
+    def __buffer__(self, flags: int, /) -> memoryview:
+        '''
+        Exports whole buffer memory as bytes, on the same terms as `view`. Buffer can't be unmapped
+        (by `transfer`) or deleted while any exports are alive.
+        '''
+
+    def __release_buffer__(self, buffer: memoryview, /) -> None: ...
+
+    @property
+    def export_count(self) -> int:
+        '''
+        Number of alive exports of the buffer memory.
+        '''
+
     @property
     def current_offset(self) -> int: ...
 
@@ -94,3 +177,241 @@ class Buffer:
 
     @property
     def size(self) -> int: ...
+
+    @property
+    def dirty_ranges(self) -> list[tuple[int, int]]:
+        '''
+        Sorted (offset, size) ranges which will be uploaded or flushed on next `transfer`. Writes close to each
+        other are merged into a single range. Always empty for buffers that don't need tracking.
+        '''
+
+class ReadbackFuture:
+    '''
+    Pending result of `Buffer.read_async`. Data is available once the fence placed after the copy is signaled.
+    '''
+
+    def ready(self) -> bool:
+        '''
+        Checks if the data is available, without blocking.
+        '''
+
+    def result(self) -> memoryview:
+        '''
+        Waits for the data and returns read-only view of the staging memory. Staging buffer is reused
+        by other reads only after the future and all views of it are released.
+        '''
+
+    def __buffer__(self, flags: int, /) -> memoryview: ...
+
+    @property
+    def offset(self) -> int: ...
+
+    @property
+    def size(self) -> int: ...
+
+class StreamBuffer:
+    '''
+    Persistently mapped buffer split into `region_count` regions used in round-robin order, intended for
+    data that is rewritten every frame. Allocations are handed out from the current region only and
+    `end_frame` moves to the next one, placing a fence after commands that use the finished region.
+    The fence is waited on only when the region is written to again.
+    '''
+
+    def __init__(self, region_size: int, region_count: int = 3, alignment: int = 0) -> None:
+        '''
+        Create new stream buffer with `region_count` regions, each `region_size` bytes big (rounded up to
+        the alignment). Alignment of 0 uses the biggest of uniform and shader storage buffer offset
+        alignments, so every allocation can be bound with `bind_range`. Alignment has to be a power of two.
+        '''
+
+    def allocate(self, size: int) -> int:
+        '''
+        Reserves `size` aligned bytes from the current region and returns their offset from the beginning
+        of the buffer. Raises RuntimeError if the region doesn't have enough space left.
+        '''
+
+    def store(self, data: TSupportsBuffer | TMatrix | TVector | TVectorArray | Matrix4Array | Quaternion | int | float) -> int:
+        '''
+        Allocates space for `data` and copies it there, using the same rules as `Buffer.store`.
+        Returns offset of the stored data.
+        '''
+
+    def end_frame(self) -> None:
+        '''
+        Finishes writing to the current region and moves to the next one. Should be called after all
+        draw calls that use the current region were issued.
+        '''
+
+    def read(self, out: TSupportsBuffer, size: int, offset: int = 0) -> None: ...
+    def delete(self) -> None: ...
+    def bind(self, target: BindTarget) -> None: ...
+    def bind_range(self, target: BufferBaseTarget, index: int, offset: int, size: int) -> None: ...
+
+    @property
+    def id(self) -> int: ...
+
+    @property
+    def size(self) -> int: ...
+
+    @property
+    def region_size(self) -> int: ...
+
+    @property
+    def region_count(self) -> int: ...
+
+    @property
+    def current_region(self) -> int: ...
+
+    @property
+    def region_offset(self) -> int: ...
+
+    @property
+    def available(self) -> int:
+        '''
+        Number of bytes that can still be allocated from the current region.
+        '''
+
+    @property
+    def alignment(self) -> int: ...
+
+    @property
+    def stall_count(self) -> int:
+        '''
+        Number of times writing to a region had to wait for GPU to finish using it.
+        '''
+
+class HeapAllocation:
+    '''
+    Block of memory allocated from `BufferHeap`. Offset is updated when the heap is defragmented.
+    Block is returned to the heap when `free` is called or when the allocation is garbage collected.
+    '''
+
+    def free(self) -> None: ...
+
+    def index(self, stride: int) -> int:
+        '''
+        Returns offset of the allocation in elements of `stride` bytes, to be used as `first` or `base_vertex`
+        argument of draw calls. Allocation has to be made with alignment equal to `stride`.
+        '''
+
+    @property
+    def offset(self) -> int: ...
+
+    @property
+    def size(self) -> int: ...
+
+    @property
+    def is_freed(self) -> bool: ...
+
+class BufferHeapStats(t.TypedDict):
+    size: int
+    used: int
+    free: int
+    largest_free_block: int
+    free_blocks: int
+    allocations: int
+    fragmentation: float
+
+class BufferHeap:
+    '''
+    Sub-allocator placing many small allocations (e.g. meshes) in one big buffer, so they can be drawn
+    without rebinding vertex and index buffers. Free space is managed by two-level segregated fit allocator.
+    '''
+
+    def __init__(self, size: int, flags: BufferFlags = BufferFlags.DYNAMIC_STORAGE_BIT, alignment: int = 16) -> None:
+        '''
+        Create new heap backed by buffer of `size` bytes created with `flags`. Sizes of all allocations are
+        rounded up to `alignment`. Heap size cannot exceed 4GB.
+        '''
+
+    def allocate(self, size: int, alignment: int | None = None) -> HeapAllocation:
+        '''
+        Allocates `size` bytes with offset being multiple of `alignment` (which doesn't have to be a power of two,
+        e.g. vertex stride can be used). Raises RuntimeError if there is no free block big enough.
+        '''
+
+    def free(self, allocation: HeapAllocation) -> None: ...
+
+    def store(self, allocation: HeapAllocation, data: TSupportsBuffer | TMatrix | TVector | TVectorArray | Matrix4Array | Quaternion | int | float, offset: int = 0) -> int:
+        '''
+        Stores `data` at `offset` bytes into the allocation, using the same rules as `Buffer.store`, and
+        returns number of bytes written. Data of dynamic storage heaps is uploaded immediately, heaps mapped with
+        `MAP_FLUSH_EXPLICIT_BIT` are flushed by `buffer.transfer()`.
+        '''
+
+    def defragment(self) -> int:
+        '''
+        Moves all allocations towards the beginning of the heap using GPU-side copies and returns number of
+        bytes moved. Offsets of existing allocations are updated, so draw commands using them have to be
+        recorded again.
+        '''
+
+    def get_stats(self) -> BufferHeapStats:
+        '''
+        Returns usage statistics of the heap. Fragmentation is 0 when all free space forms one block.
+        '''
+
+    @property
+    def buffer(self) -> Buffer: ...
+
+    @property
+    def size(self) -> int: ...
+
+    @property
+    def alignment(self) -> int: ...
+
+TFieldValue = TVector | Quaternion | Matrix3 | Matrix4 | t.Sequence[float] | t.Sequence[int] | float | int
+
+class RecordLayout:
+    '''
+    Layout of interleaved records (vertices, instances or elements of std140/std430 arrays), compiled from
+    a list of fields. Rows of Python values are converted to packed records in a single native pass.
+    '''
+
+    def __init__(self, fields: t.Sequence[tuple[str, FieldType]], rule: LayoutRule = LayoutRule.PACKED) -> None:
+        '''
+        Create new layout with fields placed in the given order. `PACKED` rule places fields right after each other,
+        `STD140` and `STD430` follow GLSL block layout rules and support only 32-bit component types.
+        '''
+
+    def pack_into(self, buffer: Buffer | TSupportsBuffer, offset: int | None, rows: t.Iterable[tuple[TFieldValue, ...] | TFieldValue]) -> int:
+        '''
+        Packs `rows` into `buffer` starting at `offset` and returns number of packed rows. Each row is a tuple with
+        one value per field, rows of single field layouts can also be passed as bare values instead of 1-tuples. Vector and matrix fields
+        accept math objects or sequences of numbers, normalized fields expect floats. `None` offset means current
+        offset of `pygl.buffers.Buffer`, the same as in `Buffer.store`.
+        '''
+
+    def pack(self, rows: t.Iterable[tuple[TFieldValue, ...] | TFieldValue]) -> bytes: ...
+
+    def get_vertex_descriptors(self, attrib_index: int = 0) -> list[VertexDescriptor]:
+        '''
+        Returns vertex descriptors matching the layout, with consecutive attribute indices starting at `attrib_index`.
+        Matrix fields use one attribute per column.
+        '''
+
+    def create_vertex_input(self, buffer: Buffer | None, attrib_index: int = 0, offset: int = 0, divisor: int = 0) -> VertexInput: ...
+
+    @property
+    def stride(self) -> int: ...
+
+    @property
+    def alignment(self) -> int: ...
+
+    @property
+    def rule(self) -> LayoutRule: ...
+
+    @property
+    def names(self) -> tuple[str, ...]: ...
+
+    @property
+    def offsets(self) -> dict[str, int]: ...
+
+def set_parallel_copy_threshold(threshold: int) -> None:
+    '''
+    Enables splitting copies of at least `threshold` bytes (made by `Buffer.store`, `Buffer.read` and similar)
+    between threads of the internal thread pool. Mapped GL memory is then written with non-temporal stores.
+    Threshold of 0 disables parallel copies, which is the default.
+    '''
+
+def get_parallel_copy_threshold() -> int: ...
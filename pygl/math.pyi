@@ -1,6 +1,9 @@
+import enum
 import typing as t
 from collections.abc import Buffer as TSupportsBuffer
 
+from . import _noise as noise
+
 class _Vector:
     @classmethod
     def length(cls) -> int: ...
@@ -31,10 +34,16 @@ class _Vector:
     def __release_buffer__(self, buf: memoryview) -> None: ...
 
     def normalize(self) -> None: ...
-    def normalized(self) -> t.Self: ...
+    def normalized(self, out: t.Self | None = None) -> t.Self:
+        '''
+        Returns normalized copy of the vector. If `out` is provided, result is written into it and `out` is returned.
+        '''
+
+    def normalized_into(self, out: t.Self) -> t.Self: ...
     def dot(self, other: t.Self) -> float: ...
     def distance(self, other: t.Self) -> float: ...
-    def interpolate(self, other: t.Self, factor: float) -> t.Self: ...
+    def interpolate(self, other: t.Self, factor: float, out: t.Self | None = None) -> t.Self: ...
+    def interpolate_into(self, other: t.Self, factor: float, out: t.Self) -> t.Self: ...
 
 class Vector2(_Vector):
     x: float
@@ -74,7 +83,8 @@ class Vector3(_Vector):
     @t.overload
     def __init__(self, x: float, y: float, z: float) -> None: ...
 
-    def cross(self, other: t.Self) -> t.Self: ...
+    def cross(self, other: t.Self, out: t.Self | None = None) -> t.Self: ...
+    def cross_into(self, other: t.Self, out: t.Self) -> t.Self: ...
 
     @property
     def r(self) -> float: ...
@@ -109,6 +119,133 @@ class Vector4(_Vector):
     @property
     def a(self) -> float: ...
 
+class DVector2(_Vector):
+    x: float
+    y: float
+
+    @t.overload
+    def __init__(self, value: float) -> None: ...
+
+    @t.overload
+    def __init__(self, x: float, y: float) -> None: ...
+
+    def cross(self, other: t.Self) -> float: ...
+
+    @property
+    def r(self) -> float: ...
+
+    @property
+    def g(self) -> float: ...
+
+class DVector3(_Vector):
+    x: float
+    y: float
+    z: float
+
+    @classmethod
+    def forward(cls) -> t.Self: ...
+
+    @classmethod
+    def up(cls) -> t.Self: ...
+
+    @classmethod
+    def right(cls) -> t.Self: ...
+
+    @t.overload
+    def __init__(self, value: float) -> None: ...
+
+    @t.overload
+    def __init__(self, x: float, y: float, z: float) -> None: ...
+
+    def cross(self, other: t.Self, out: t.Self | None = None) -> t.Self: ...
+    def cross_into(self, other: t.Self, out: t.Self) -> t.Self: ...
+
+    @property
+    def r(self) -> float: ...
+
+    @property
+    def g(self) -> float: ...
+
+    @property
+    def b(self) -> float: ...
+
+class DVector4(_Vector):
+    x: float
+    y: float
+    z: float
+    w: float
+
+    @t.overload
+    def __init__(self, value: float) -> None: ...
+
+    @t.overload
+    def __init__(self, x: float, y: float, z: float, w: float) -> None: ...
+
+    @property
+    def r(self) -> float: ...
+
+    @property
+    def g(self) -> float: ...
+
+    @property
+    def b(self) -> float: ...
+
+    @property
+    def a(self) -> float: ...
+
+class _VectorArray[TVec]:
+    '''
+    Contiguous array of vectors, stored in a single aligned memory block.
+    Arithmetic operations are applied to all elements at once and support
+    either another array of the same length or a single vector, that is
+    broadcasted to all elements.
+    '''
+
+    @t.overload
+    def __init__(self, count: int) -> None: ...
+
+    @t.overload
+    def __init__(self, data: TSupportsBuffer) -> None: ...
+
+    @t.overload
+    def __init__(self, values: t.Sequence[TVec]) -> None: ...
+
+    @property
+    def count(self) -> int: ...
+
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> TVec: ...
+    def __setitem__(self, i: int, value: TVec) -> None: ...
+
+    def __add__(self, other: t.Self | TVec) -> t.Self: ...
+    def __radd__(self, other: TVec) -> t.Self: ...
+    def __iadd__(self, other: t.Self | TVec) -> t.Self: ...
+    def __sub__(self, other: t.Self | TVec) -> t.Self: ...
+    def __rsub__(self, other: TVec) -> t.Self: ...
+    def __isub__(self, other: t.Self | TVec) -> t.Self: ...
+    def __mul__(self, other: t.Self | TVec | float) -> t.Self: ...
+    def __rmul__(self, other: TVec | float) -> t.Self: ...
+    def __imul__(self, other: t.Self | TVec | float) -> t.Self: ...
+    def __neg__(self) -> t.Self: ...
+
+    def __buffer__(self, flags: int) -> memoryview: ...
+    def __release_buffer__(self, buf: memoryview) -> None: ...
+
+    def normalize(self) -> None: ...
+    def normalized(self) -> t.Self: ...
+    def lengths(self) -> memoryview: ...
+    def dot(self, other: t.Self | TVec) -> memoryview: ...
+    def interpolate(self, other: t.Self | TVec, factor: float) -> t.Self: ...
+
+class Vector2Array(_VectorArray[Vector2]):
+    def cross(self, other: t.Self | Vector2) -> memoryview: ...
+
+class Vector3Array(_VectorArray[Vector3]):
+    def cross(self, other: t.Self | Vector3) -> t.Self: ...
+
+class Vector4Array(_VectorArray[Vector4]):
+    pass
+
 class Quaternion:
     x: float
     y: float
@@ -122,10 +259,10 @@ class Quaternion:
     def from_axis(cls, angle: float, axis: Vector3) -> t.Self: ...
 
     @classmethod
-    def from_euler_deg(cls, rotatrion: Vector3) -> t.Self: ...
+    def from_euler_deg(cls, rotation: Vector3) -> t.Self: ...
 
     @classmethod
-    def from_euler_rad(cls, rotatrion: Vector3) -> t.Self: ...
+    def from_euler_rad(cls, rotation: Vector3) -> t.Self: ...
 
     @classmethod
     def look_at(cls, dir: Vector3, up: Vector3) -> t.Self: ...
@@ -135,13 +272,21 @@ class Quaternion:
     def __imul__(self, other: Quaternion) -> Quaternion: ...
 
     def normalize(self) -> None: ...
-    def normalized(self) -> Quaternion: ...
+    def normalized(self, out: Quaternion | None = None) -> Quaternion: ...
+    def normalized_into(self, out: Quaternion) -> Quaternion: ...
     def dot(self, other: Quaternion) -> Quaternion: ...
     def conjugate(self) -> None: ...
     def inverse(self) -> None: ...
-    def inversed(self) -> Quaternion: ...
-    def interpolate(self, other: Quaternion, factor: float) -> Quaternion: ...
-    def rotate_vector(self, vector: Vector3) -> Vector3: ...
+    def inversed(self, out: Quaternion | None = None) -> Quaternion: ...
+    def inversed_into(self, out: Quaternion) -> Quaternion: ...
+    def interpolate(self, other: Quaternion, factor: float, out: Quaternion | None = None) -> Quaternion: ...
+    def interpolate_into(self, other: Quaternion, factor: float, out: Quaternion) -> Quaternion: ...
+    def rotate_vector(self, vector: Vector3, out: Vector3 | None = None) -> Vector3:
+        '''
+        Rotates `vector` and writes result into `out`. If `out` is not provided, `vector` is rotated in place.
+        '''
+
+    def rotate_vector_into(self, vector: Vector3, out: Vector3) -> Vector3: ...
 
     @property
     def angle(self) -> float: ...
@@ -166,8 +311,25 @@ class Plane:
     @property
     def normal(self) -> Vector3: ...
 
+    def distance_to(self, point: Vector3) -> float:
+        '''
+        Returns signed distance from the plane to `point`, positive on the side `normal` points to.
+        '''
+
 TVec = t.TypeVar('TVec', bound=_Vector)
 
+class MatrixKind(enum.IntEnum):
+    '''
+    Structural class of a 4x4 matrix, used to select cheaper inverse and multiplication kernels.
+    Kind of a product is the lesser of its factors' kinds.
+    '''
+
+    GENERAL = t.cast(int, ...)
+    AFFINE = t.cast(int, ...)
+    RIGID = t.cast(int, ...)
+    TRANSLATION = t.cast(int, ...)
+    IDENTITY = t.cast(int, ...)
+
 class _Matrix[TVec]:
     @classmethod
     def length(cls) -> int: ...
@@ -219,9 +381,26 @@ class _Matrix[TVec]:
     def __release_buffer__(self, buf: memoryview) -> None: ...
 
     def transpose(self) -> None: ...
-    def transposed(self) -> t.Self: ...
+    def transposed(self, out: t.Self | None = None) -> t.Self: ...
+    def transposed_into(self, out: t.Self) -> t.Self: ...
     def inverse(self) -> None: ...
-    def inversed(self) -> t.Self: ...
+    def inversed(self, out: t.Self | None = None) -> t.Self: ...
+    def inversed_into(self, out: t.Self) -> t.Self: ...
+
+    @t.overload
+    def matmul(self, other: t.Self, out: t.Self | None = None) -> t.Self: ...
+
+    @t.overload
+    def matmul(self, other: TVec, out: TVec | None = None) -> TVec:
+        '''
+        Same as `self @ other`. If `out` is provided, result is written into it and `out` is returned.
+        '''
+
+    @t.overload
+    def matmul_into(self, other: t.Self, out: t.Self) -> t.Self: ...
+
+    @t.overload
+    def matmul_into(self, other: TVec, out: TVec) -> TVec: ...
 
     @property
     def row0(self) -> TVec: ...
@@ -242,6 +421,14 @@ class Matrix3(_Matrix[Vector3]):
     pass
 
 class Matrix4(_Matrix[Vector4]):
+    kind: MatrixKind
+    '''
+    Set by constructors and propagated through products and inverses. Matrices created from raw values are
+    classified automatically, except for rigid ones, which are reported as affine. Kind may be declared
+    explicitly, but it has to match matrix values, as it is trusted by inverse and multiplication kernels.
+    Requesting writable buffer from the matrix resets it to `MatrixKind.GENERAL`.
+    '''
+
     @classmethod
     def perspective(cls,
                     fov: float,
@@ -281,8 +468,450 @@ class Matrix4(_Matrix[Vector4]):
     @classmethod
     def transform(cls, translation: Vector3, scale: Vector3, rotation: Quaternion) -> t.Self: ...
 
+class DMatrix4(_Matrix[DVector4]):
+    kind: MatrixKind
+    '''
+    Set by constructors and propagated through products and inverses. Matrices created from raw values are
+    classified automatically, except for rigid ones, which are reported as affine. Kind may be declared
+    explicitly, but it has to match matrix values, as it is trusted by inverse and multiplication kernels.
+    Requesting writable buffer from the matrix resets it to `MatrixKind.GENERAL`.
+    '''
+
+    @classmethod
+    def perspective(cls,
+                    fov: float,
+                    aspect: float,
+                    z_near: float = -1.0,
+                    z_far: float = 1.0) -> t.Self: ...
+
+    @classmethod
+    def ortho(cls,
+              left: float,
+              right: float,
+              bottom: float,
+              top: float,
+              z_near: float = -1.0,
+              z_far: float = 1.0) -> t.Self: ...
+
+    @classmethod
+    def look_at(cls, eye: DVector3, center: DVector3, up: DVector3 = DVector3(0.0, 1.0, 0.0)) -> t.Self: ...
+
+    @t.overload
+    @classmethod
+    def look(cls, eye: DVector3, orientation: Quaternion) -> t.Self: ...
+
+    @t.overload
+    @classmethod
+    def look(cls, eye: DVector3, dir: DVector3, up: DVector3 = DVector3(0.0, 1.0, 0.0)) -> t.Self: ...
+
+    @t.overload
+    @classmethod
+    def transform(cls, translation: DVector3) -> t.Self: ...
+
+    @t.overload
+    @classmethod
+    def transform(cls, translation: DVector3, scale: DVector3) -> t.Self: ...
+
+    @t.overload
+    @classmethod
+    def transform(cls, translation: DVector3, scale: DVector3, rotation: Quaternion) -> t.Self: ...
+
+class Matrix4Array:
+    '''
+    Contiguous array of 4x4 matrices, stored in a single aligned memory block.
+    Methods accepting `out` write their results straight into provided object
+    (either a mapped `pygl.buffers.Buffer` or any writable buffer) and return `None`.
+    When used with `pygl.buffers.Buffer`, `offset` defaults to its current offset.
+    '''
+
+    @t.overload
+    def __init__(self, count: int) -> None: ...
+
+    @t.overload
+    def __init__(self, data: TSupportsBuffer) -> None: ...
+
+    @t.overload
+    def __init__(self, values: t.Sequence[Matrix4]) -> None: ...
+
+    @classmethod
+    def identity(cls, count: int) -> t.Self: ...
+
+    @t.overload
+    @classmethod
+    def compose(cls,
+                translations: TSupportsBuffer,
+                scales: TSupportsBuffer | None = None,
+                rotations: TSupportsBuffer | None = None) -> t.Self:
+        '''
+        Composes `T * R * S` matrices from packed arrays of translations (3 floats),
+        scales (3 floats) and rotation quaternions (4 floats, xyzw).
+        '''
+
+    @t.overload
+    @classmethod
+    def compose(cls,
+                translations: TSupportsBuffer,
+                scales: TSupportsBuffer | None = None,
+                rotations: TSupportsBuffer | None = None,
+                *,
+                out: TSupportsBuffer,
+                offset: int | None = None) -> None: ...
+
+    @property
+    def count(self) -> int: ...
+
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> Matrix4: ...
+    def __setitem__(self, i: int, value: Matrix4) -> None: ...
+
+    def __matmul__(self, other: t.Self | Matrix4) -> t.Self: ...
+    def __rmatmul__(self, other: Matrix4) -> t.Self: ...
+    def __imatmul__(self, other: t.Self | Matrix4) -> t.Self: ...
+
+    def __buffer__(self, flags: int) -> memoryview: ...
+    def __release_buffer__(self, buf: memoryview) -> None: ...
+
+    @t.overload
+    def matmul(self, other: t.Self | Matrix4) -> t.Self:
+        '''
+        Computes `self[i] @ other[i]` (or `self[i] @ other` for single matrix).
+        '''
+
+    @t.overload
+    def matmul(self, other: t.Self | Matrix4, *, out: TSupportsBuffer, offset: int | None = None) -> None: ...
+
+    @t.overload
+    def rmatmul(self, other: t.Self | Matrix4) -> t.Self:
+        '''
+        Computes `other[i] @ self[i]` (or `other @ self[i]` for single matrix).
+        '''
+
+    @t.overload
+    def rmatmul(self, other: t.Self | Matrix4, *, out: TSupportsBuffer, offset: int | None = None) -> None: ...
+
+    def inverse(self) -> None: ...
+
+    @t.overload
+    def inversed(self) -> t.Self: ...
+
+    @t.overload
+    def inversed(self, *, out: TSupportsBuffer, offset: int | None = None) -> None: ...
+
+    def transpose(self) -> None: ...
+
+    @t.overload
+    def transposed(self) -> t.Self: ...
+
+    @t.overload
+    def transposed(self, *, out: TSupportsBuffer, offset: int | None = None) -> None: ...
+
+class Frustum:
+    def __init__(self, view_projection: Matrix4) -> None: ...
+
+    @property
+    def planes(self) -> tuple[Plane, Plane, Plane, Plane, Plane, Plane]:
+        '''
+        Normalized planes in order: left, right, bottom, top, near, far. Normals point inside of the frustum.
+        '''
+
+    def update(self, view_projection: Matrix4) -> None:
+        '''
+        Extracts planes from new view-projection matrix without allocating new frustum.
+        '''
+
+    def contains_point(self, point: Vector3) -> bool: ...
+    def intersects_sphere(self, center: Vector3, radius: float) -> bool: ...
+    def intersects_aabb(self, min: Vector3, max: Vector3) -> bool: ...
+
+    def cull_spheres(self, volumes: TSupportsBuffer, indices: bool = False) -> memoryview:
+        '''
+        Tests packed bounding spheres (x, y, z, radius) against the frustum, e.g. `Vector4Array` or float buffer.
+        If `indices` is `False` returns visibility bitmask (format 'B', one bit per sphere, least significant bit first),
+        otherwise returns compacted indices of visible spheres (format 'I').
+        '''
+
+    def cull_aabbs(self, volumes: TSupportsBuffer, indices: bool = False) -> memoryview:
+        '''
+        Tests packed axis aligned bounding boxes (min_x, min_y, min_z, max_x, max_y, max_z) against the frustum.
+        Returns the same results as `cull_spheres`.
+        '''
+
+class BVH:
+    '''
+    Flattened bounding volume hierarchy built over packed axis aligned bounding boxes
+    (min_x, min_y, min_z, max_x, max_y, max_z) using binned surface area heuristic.
+    Large trees are built in parallel with the GIL released.
+    '''
+
+    count: t.Final[int]
+    node_count: t.Final[int]
+    depth: t.Final[int]
+    max_leaf_size: t.Final[int]
+
+    def __init__(self, aabbs: TSupportsBuffer, max_leaf_size: int = 4) -> None: ...
+
+    @property
+    def bounds(self) -> memoryview:
+        '''
+        Bounding box of the whole hierarchy as 6 floats (format 'f').
+        '''
+
+    def refit(self, aabbs: TSupportsBuffer) -> None:
+        '''
+        Updates bounds of all nodes after primitives moved, keeping tree topology.
+        `aabbs` has to contain the same number of boxes the tree was built with.
+        '''
+
+    def query_frustum(self, frustum: Frustum) -> memoryview:
+        '''
+        Returns indices of boxes visible by `frustum` (format 'I'), in no particular order.
+        '''
+
+    def query_rays(self,
+                   origins: TSupportsBuffer,
+                   directions: TSupportsBuffer,
+                   max_distance: float = ...) -> tuple[memoryview, memoryview]:
+        '''
+        Finds the closest box hit by each ray packed as 3 floats in `origins` and `directions`.
+        Returns indices of hit boxes (format 'I', 0xFFFFFFFF for misses) and hit distances expressed in
+        lengths of ray direction (format 'f', infinity for misses). `max_distance` defaults to infinity.
+        '''
+
+    def query_aabbs(self, aabbs: TSupportsBuffer) -> tuple[memoryview, memoryview]:
+        '''
+        Finds boxes overlapping each of the query boxes. Returns `offsets` (format 'I', len(aabbs) + 1 elements)
+        and `indices` (format 'I'), where overlaps of query `i` are `indices[offsets[i]:offsets[i + 1]]`.
+        '''
+
+class AnimationClip:
+    '''
+    Packed keyframes of a skeletal animation. Keys of joint `i` are stored in range
+    `[key_offsets[i], key_offsets[i + 1])` of `times`, `translations` (3 floats), `rotations` (quaternions, 4 floats)
+    and `scales` (3 floats, defaults to 1). Every joint needs at least one key and its key times have to be sorted.
+    '''
+
+    joint_count: t.Final[int]
+    key_count: t.Final[int]
+    duration: t.Final[float]
+
+    def __init__(self,
+                 key_offsets: t.Sequence[int],
+                 times: TSupportsBuffer,
+                 translations: TSupportsBuffer,
+                 rotations: TSupportsBuffer,
+                 scales: TSupportsBuffer | None = None) -> None: ...
+
+    @t.overload
+    def sample(self, time: float, *, loop: bool = True, nlerp: bool = False, out: None = None) -> Matrix4Array: ...
+
+    @t.overload
+    def sample(self, time: float, *, loop: bool = True, nlerp: bool = False, out: TSupportsBuffer, offset: int = -1) -> None:
+        '''
+        Computes local (parent relative) matrices of all joints at `time`. Rotations are interpolated using
+        slerp or nlerp if `nlerp` is `True`. If `loop` is `True` time wraps around `duration`, otherwise it is clamped.
+        '''
+
+class Skeleton:
+    joint_count: t.Final[int]
+
+    def __init__(self, parents: t.Sequence[int], inverse_bind_matrices: TSupportsBuffer | None = None) -> None:
+        '''
+        Creates joint hierarchy, where parent of every joint has to precede it (-1 for roots).
+        '''
+
+    @property
+    def parents(self) -> tuple[int, ...]: ...
+
+    @t.overload
+    def compute_palettes(self,
+                         clips: AnimationClip | t.Sequence[AnimationClip],
+                         times: float | TSupportsBuffer,
+                         *,
+                         out: None = None,
+                         loop: bool = True,
+                         nlerp: bool = False) -> Matrix4Array: ...
+
+    @t.overload
+    def compute_palettes(self,
+                         clips: AnimationClip | t.Sequence[AnimationClip],
+                         times: float | TSupportsBuffer,
+                         *,
+                         out: TSupportsBuffer,
+                         offset: int = -1,
+                         loop: bool = True,
+                         nlerp: bool = False) -> None:
+        '''
+        Samples clip of every instance at its time, resolves joint hierarchy and multiplies results by inverse bind
+        matrices, producing `joint_count` skinning matrices per instance. `clips` can be a single clip shared by all
+        instances or one clip per element of `times`. Results are written into `out` (e.g. mapped `pygl.buffers.Buffer`,
+        advancing its current offset) or returned as new array. Large batches are computed in parallel with the GIL released.
+        '''
+
+class TransformTree:
+    '''
+    Flat hierarchy of local transforms (translation, rotation, scale) with cached world matrices. Parent of every node
+    has to precede it (-1 for roots). Changed nodes are tracked and `update` recomputes only them and their subtrees.
+    World matrices are stored contiguously and exposed through the buffer protocol as (count, 4, 4) floats, so they can
+    be uploaded with a single `pygl.buffers.Buffer.store`.
+    '''
+
+    count: t.Final[int]
+
+    def __init__(self, parents: t.Sequence[int]) -> None: ...
+    def __len__(self) -> int: ...
+    def __buffer__(self, flags: int) -> memoryview: ...
+
+    @property
+    def parents(self) -> tuple[int, ...]: ...
+
+    @property
+    def is_dirty(self) -> bool: ...
+
+    def set_translation(self, index: int, translation: Vector3) -> None: ...
+    def set_rotation(self, index: int, rotation: Quaternion) -> None: ...
+    def set_scale(self, index: int, scale: Vector3) -> None: ...
+
+    def set_transforms(self,
+                       indices: TSupportsBuffer | None,
+                       translations: TSupportsBuffer | None = None,
+                       rotations: TSupportsBuffer | None = None,
+                       scales: TSupportsBuffer | None = None) -> None:
+        '''
+        Sets local transforms of many nodes at once. `indices` is a buffer of 32-bit integers; if it is `None`,
+        values are assigned to the first nodes of the tree.
+        '''
+
+    def update(self) -> tuple[int, int]:
+        '''
+        Recomputes world matrices of nodes which local transforms (or transforms of their ancestors) changed.
+        Returns range `[begin, end)` of nodes that might have changed, which is empty if nothing had to be updated.
+        '''
+
+    def get_local(self, index: int) -> Matrix4: ...
+    def get_world(self, index: int) -> Matrix4: ...
+
+class Curve:
+    '''
+    Base class of piecewise cubic curves. Every segment is stored in power basis, so all curve types share the same
+    evaluation kernels. `length` is approximated from a table of chord lengths built on construction and is also used
+    to map arc length parameters onto segment parameters.
+    '''
+
+    segment_count: t.Final[int]
+    length: t.Final[float]
+
+    def evaluate(self, params: int | TSupportsBuffer, dst: TSupportsBuffer, stride: int = 12, offset: int = 0, *, arc_length: bool = False) -> None:
+        '''
+        Evaluates positions of the curve and writes them into `dst` (either a writable buffer or a mapped
+        `pygl.buffers.Buffer`). `params` is either number of evenly spaced samples over `[0, 1]` or buffer of floats.
+        If `arc_length` is set, parameters are treated as fractions of curve length instead of curve parameter.
+        Large batches release the GIL and are split across worker threads.
+        '''
+
+    def evaluate_tangents(self, params: int | TSupportsBuffer, dst: TSupportsBuffer, stride: int = 12, offset: int = 0, *, arc_length: bool = False, normalize: bool = False) -> None:
+        '''
+        Evaluates derivatives of the curve with respect to the whole-curve parameter (or curve length
+        if `arc_length` is set) using the same rules as `evaluate`.
+        '''
+
+    def point_at(self, t: float, *, arc_length: bool = False) -> Vector3: ...
+    def tangent_at(self, t: float, *, arc_length: bool = False) -> Vector3: ...
+
+class BezierCurve(Curve):
+    '''
+    Chain of cubic Bezier segments. Requires `3 * n + 1` points, consecutive segments share end points.
+    '''
+
+    def __init__(self, points: TSupportsBuffer) -> None: ...
+
+class CatmullRomCurve(Curve):
+    '''
+    Uniform Catmull-Rom spline passing through all of `points`. Open curves duplicate end points.
+    '''
+
+    def __init__(self, points: TSupportsBuffer, closed: bool = False) -> None: ...
+
+class HermiteCurve(Curve):
+    '''
+    Cubic Hermite spline passing through `points` with given `tangents` at every point.
+    '''
+
+    def __init__(self, points: TSupportsBuffer, tangents: TSupportsBuffer) -> None: ...
+
 TInterpolate = t.TypeVar('TInterpolate', Vector2, Vector3, Vector4, float, Quaternion)
 def interpolate(x: TInterpolate, y: TInterpolate, factor: float) -> TInterpolate: ...
 def get_closest_factors(x: float) -> float: ...
 def rad_to_deg(a: float) -> float: ...
 def deg_to_rad(a: float) -> float: ...
+
+def transform_points(matrix: Matrix4, src: TSupportsBuffer, dst: TSupportsBuffer, stride: int = 12, offset: int = 0) -> None:
+    '''
+    Transforms 3-component points read from `src` by `matrix` and writes them into `dst`
+    (either a writable buffer or a mapped `pygl.buffers.Buffer`) using the same vertex layout.
+    `stride` and `offset` describe placement of points inside interleaved vertex data.
+    '''
+
+def transform_directions(matrix: Matrix4, src: TSupportsBuffer, dst: TSupportsBuffer, stride: int = 12, offset: int = 0) -> None:
+    '''
+    Same as `transform_points`, but ignores translation part of `matrix`.
+    '''
+
+def transform_normals(matrix: Matrix4, src: TSupportsBuffer, dst: TSupportsBuffer, stride: int = 12, offset: int = 0) -> None:
+    '''
+    Same as `transform_directions`, but uses inverse-transpose of `matrix` and normalizes results.
+    '''
+
+def to_camera_relative(positions: TSupportsBuffer, origin: DVector3, dst: TSupportsBuffer, stride: int = 12, offset: int = 0) -> None:
+    '''
+    Converts packed double precision 3-component positions (buffer of format `d`) into float positions relative
+    to `origin` and writes them into `dst` (either a writable buffer or a mapped `pygl.buffers.Buffer`).
+    `stride` and `offset` describe placement of positions inside interleaved destination vertex data.
+    '''
+
+class PackFormat(enum.IntEnum):
+    '''
+    Compact vertex attribute encodings. `OCTAHEDRAL*` formats store unit normals as 2 signed normalized components
+    and have to be decoded in shader. `*_2_10_10_10_REV` formats occupy a single 32-bit word and have to be declared
+    with 4 components in `pygl.vertex_array.VertexDescriptor`.
+    '''
+
+    HALF_FLOAT = t.cast(int, ...)
+    SNORM8 = t.cast(int, ...)
+    SNORM16 = t.cast(int, ...)
+    UNORM8 = t.cast(int, ...)
+    UNORM16 = t.cast(int, ...)
+    INT_2_10_10_10_REV = t.cast(int, ...)
+    UNSIGNED_INT_2_10_10_10_REV = t.cast(int, ...)
+    OCTAHEDRAL8 = t.cast(int, ...)
+    OCTAHEDRAL16 = t.cast(int, ...)
+
+def pack_vertices(src: TSupportsBuffer, dst: TSupportsBuffer, format: PackFormat, components: int = 3, stride: int = 0, offset: int = 0) -> None:
+    '''
+    Converts tightly packed float attributes with `components` values each into `format` and writes them into `dst`
+    (either a writable buffer or a mapped `pygl.buffers.Buffer`). `stride` and `offset` describe placement of packed
+    attributes inside interleaved vertex data, stride of 0 means attributes are tightly packed.
+    '''
+
+def unpack_vertices(src: TSupportsBuffer, dst: TSupportsBuffer, format: PackFormat, components: int = 3, stride: int = 0, offset: int = 0) -> None:
+    '''
+    Inverse of `pack_vertices`, reads packed attributes from interleaved `src` and writes tightly packed floats into `dst`.
+    '''
+
+def get_packed_size(format: PackFormat, components: int = 3) -> int: ...
+
+class _FreeListStats(t.TypedDict):
+    hits: int
+    misses: int
+    size: int
+    capacity: int
+
+def get_free_list_stats() -> dict[str, _FreeListStats]:
+    '''
+    Returns statistics of free lists used to cache instances of vector, matrix and quaternion types,
+    keyed by type name.
+    '''
+
+def set_free_list_capacity(capacity: int, type: type | None = None) -> None:
+    '''
+    Sets maximum number of cached instances for given `type` or for all types if `type` is `None`.
+    '''
@@ -1,6 +1,6 @@
 import enum
 
-from .buffers import Buffer
+from .buffers import Buffer, StreamBuffer
 
 class AttribType(enum.IntEnum):
     FLOAT: int
@@ -12,6 +12,8 @@ class AttribType(enum.IntEnum):
     UNSIGNED_SHORT: int
     INT: int
     UNSIGNED_INT: int
+    INT_2_10_10_10_REV: int
+    UNSIGNED_INT_2_10_10_10_REV: int
 
 class VertexDescriptor:
     attrib_index: int
@@ -19,13 +21,19 @@ class VertexDescriptor:
     count: int
     rows: int = 1
     is_normalized: bool = False
+    offset: int = -1
 
     def __init__(self,
                  attrib_index: int,
                  type: AttribType,
                  count: int,
                  rows: int = 1,
-                 is_normalized: bool = False) -> None: ...
+                 is_normalized: bool = False,
+                 offset: int = -1) -> None:
+        '''
+        Describes vertex attribute (or `rows` consecutive attributes for matrices). Attributes are placed right
+        after the previous one unless `offset` relative to the start of vertex is specified.
+        '''
 
 class VertexInput:
     buffer_id: int
@@ -48,7 +56,7 @@ class VertexArray:
 
     def delete(self) -> None: ...
     def bind(self) -> None: ...
-    def bind_vertex_buffer(self, buffer: Buffer, index: int, stride: int, offset: int = 0, divisor: int = 0) -> None: ...
+    def bind_vertex_buffer(self, buffer: Buffer | StreamBuffer, index: int, stride: int, offset: int = 0, divisor: int = 0) -> None: ...
     def bind_index_buffer(self, buffer: Buffer) -> None: ...
 
 def bind_default() -> None: ...
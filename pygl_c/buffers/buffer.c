@@ -1,9 +1,98 @@
 #include "buffer.h"
+#include "readbackFuture.h"
+#include "../copyEngine.h"
 #include "../utility.h"
 #include "../math/matrix/matrix.h"
+#include "../math/matrix/matrix4Array.h"
 #include "../math/vector/vector.h"
+#include "../math/vector/vectorArray.h"
 #include "../math/quaternion.h"
 
+#define BUFFER_MAP_FLAGS (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
+
+static void merge_closest_dirty_ranges(PyBuffer *self)
+{
+    int closest = 0;
+    for (int i = 1; i < self->dirtyRangeCount - 1; i++)
+    {
+        if (self->dirtyRanges[i + 1].start - self->dirtyRanges[i].end <
+            self->dirtyRanges[closest + 1].start - self->dirtyRanges[closest].end)
+            closest = i;
+    }
+
+    self->dirtyRanges[closest].end = self->dirtyRanges[closest + 1].end;
+    memmove(
+        &self->dirtyRanges[closest + 1],
+        &self->dirtyRanges[closest + 2],
+        (self->dirtyRangeCount - closest - 2) * sizeof(DirtyRange));
+    self->dirtyRangeCount--;
+}
+
+void py_buffer_mark_dirty(PyBuffer *self, GLintptr offset, GLsizeiptr size)
+{
+    if (!self->tracksDirtyRanges || size <= 0)
+        return;
+
+    GLintptr start = offset;
+    GLintptr end = offset + size;
+
+    // sequential stores extend the last range
+    if (self->dirtyRangeCount != 0)
+    {
+        DirtyRange *last = &self->dirtyRanges[self->dirtyRangeCount - 1];
+        if (start >= last->start && start <= last->end + BUFFER_DIRTY_MERGE_GAP)
+        {
+            if (end > last->end)
+                last->end = end;
+
+            return;
+        }
+    }
+
+    int first = 0;
+    while (first < self->dirtyRangeCount && self->dirtyRanges[first].end + BUFFER_DIRTY_MERGE_GAP < start)
+        first++;
+
+    int next = first;
+    while (next < self->dirtyRangeCount && self->dirtyRanges[next].start <= end + BUFFER_DIRTY_MERGE_GAP)
+    {
+        if (self->dirtyRanges[next].start < start)
+            start = self->dirtyRanges[next].start;
+        if (self->dirtyRanges[next].end > end)
+            end = self->dirtyRanges[next].end;
+
+        next++;
+    }
+
+    if (next != first)
+    {
+        // replace all merged ranges with the new one
+        self->dirtyRanges[first] = (DirtyRange){start, end};
+        memmove(
+            &self->dirtyRanges[first + 1],
+            &self->dirtyRanges[next],
+            (self->dirtyRangeCount - next) * sizeof(DirtyRange));
+        self->dirtyRangeCount -= next - first - 1;
+
+        return;
+    }
+
+    if (self->dirtyRangeCount == BUFFER_MAX_DIRTY_RANGES)
+    {
+        merge_closest_dirty_ranges(self);
+        py_buffer_mark_dirty(self, start, end - start);
+
+        return;
+    }
+
+    memmove(
+        &self->dirtyRanges[first + 1],
+        &self->dirtyRanges[first],
+        (self->dirtyRangeCount - first) * sizeof(DirtyRange));
+    self->dirtyRanges[first] = (DirtyRange){start, end};
+    self->dirtyRangeCount++;
+}
+
 static PyObject *map(PyBuffer *self, PyObject *Py_UNUSED(args))
 {
     // don't map the buffer if:
@@ -19,7 +108,7 @@ static PyObject *map(PyBuffer *self, PyObject *Py_UNUSED(args))
         Py_RETURN_NONE;
     }
 
-    self->dataPtr = glMapNamedBufferRange(self->id, 0, self->size, self->flags);
+    self->dataPtr = glMapNamedBufferRange(self->id, 0, self->size, self->flags & BUFFER_MAP_FLAGS);
     if (!self->dataPtr)
     {
         PyErr_Format(PyExc_RuntimeError, "Couldn't map buffer: %d.", glGetError());
@@ -29,15 +118,60 @@ static PyObject *map(PyBuffer *self, PyObject *Py_UNUSED(args))
     Py_RETURN_NONE;
 }
 
+GLsizeiptr py_buffer_flush_mapped_ranges(PyBuffer *self)
+{
+    GLsizeiptr flushedSize = 0;
+    for (int i = 0; i < self->dirtyRangeCount; i++)
+    {
+        const DirtyRange *range = &self->dirtyRanges[i];
+        glFlushMappedNamedBufferRange(self->id, range->start, range->end - range->start);
+        flushedSize += range->end - range->start;
+    }
+
+    self->dirtyRangeCount = 0;
+
+    return flushedSize;
+}
+
 static PyObject *transfer(PyBuffer *self, PyObject *Py_UNUSED(args))
 {
-    // for persistent buffer this function just resets data offset
+    // for persistent buffer this function just flushes written ranges (if needed) and resets data offset
+
+    THROW_IF(
+        self->exportCount != 0 && !py_buffer_has_client_storage(self) && !self->isPersistent && self->dataPtr != NULL,
+        PyExc_BufferError,
+        "Buffer cannot be unmapped while its memory is exported.",
+        NULL);
 
-    if (FLAG_IS_SET(self->flags, GL_DYNAMIC_STORAGE_BIT))
+    // writes made through exported memory can't be tracked
+    if (self->writableExportCount != 0)
+        py_buffer_mark_dirty(self, self->exportedRange.start, self->exportedRange.end - self->exportedRange.start);
+
+    GLsizeiptr transferredSize = 0;
+    if (FLAG_IS_SET(self->flags, GL_MAP_FLUSH_EXPLICIT_BIT) && self->dataPtr != NULL)
+        transferredSize = py_buffer_flush_mapped_ranges(self);
+    else if (py_buffer_has_client_storage(self))
     {
-        glNamedBufferSubData(self->id, 0, (GLsizeiptr)self->currentOffset, self->dataPtr);
+        // ranges are copied, so other threads can store new data while uploading without the GIL
+        DirtyRange ranges[BUFFER_MAX_DIRTY_RANGES];
+        const int rangeCount = self->dirtyRangeCount;
+        memcpy(ranges, self->dirtyRanges, rangeCount * sizeof(DirtyRange));
+        self->dirtyRangeCount = 0;
+
+        for (int i = 0; i < rangeCount; i++)
+            transferredSize += ranges[i].end - ranges[i].start;
+
+        py_buffer_pin(self);
+        PyThreadState *threadState = utils_begin_allow_threads(transferredSize >= UTILS_ALLOW_THREADS_THRESHOLD);
+
+        for (int i = 0; i < rangeCount; i++)
+            glNamedBufferSubData(self->id, ranges[i].start, ranges[i].end - ranges[i].start, (char *)self->dataPtr + ranges[i].start);
+
+        utils_end_allow_threads(threadState);
+        py_buffer_unpin(self);
     }
-    else if (!self->isPersistent && self->dataPtr != NULL) // non-persistent buffer that was mapped before
+
+    if (!py_buffer_has_client_storage(self) && !self->isPersistent && self->dataPtr != NULL) // non-persistent buffer that was mapped before
     {
         GLboolean unmapSuccess = glUnmapNamedBuffer(self->id);
         if (!unmapSuccess)
@@ -51,11 +185,21 @@ static PyObject *transfer(PyBuffer *self, PyObject *Py_UNUSED(args))
 
     self->currentOffset = 0;
 
-    Py_RETURN_NONE;
+    return PyLong_FromSsize_t(transferredSize);
+}
+
+// Advances current offset past `size` bytes about to be stored at `offset`. Has to be called before the data is
+// copied, so stores made by other threads while the GIL is released don't get the same range.
+static void reserve_range(PyBuffer *self, Py_ssize_t offset, Py_ssize_t size)
+{
+    if (offset == 0 || offset == self->currentOffset)
+        self->currentOffset += size;
 }
 
 static PyObject *store_address(PyBuffer *self, PyObject *args, PyObject *Py_UNUSED(kwargs))
 {
+    THROW_IF(self->id == 0, PyExc_RuntimeError, "Cannot store data in deleted buffer.", NULL);
+
     // throw an error if the buffer is not persistently mapped or dynamic and has not been mapped before
     THROW_IF(
         !FLAG_IS_SET(self->flags, GL_MAP_PERSISTENT_BIT) && !FLAG_IS_SET(self->flags, GL_DYNAMIC_STORAGE_BIT) && !self->dataPtr,
@@ -78,90 +222,315 @@ static PyObject *store_address(PyBuffer *self, PyObject *args, PyObject *Py_UNUS
         "Data transfer would cause buffer overflow.",
         NULL);
 
-    memcpy((char *)self->dataPtr + self->currentOffset, dataBuffer, dataSize);
-    self->currentOffset += dataSize;
+    const Py_ssize_t offset = self->currentOffset;
+    reserve_range(self, offset, dataSize);
+
+    py_buffer_pin(self);
+    copy_engine_copy((char *)self->dataPtr + offset, dataBuffer, dataSize, !py_buffer_has_client_storage(self));
+    py_buffer_unpin(self);
+
+    py_buffer_mark_dirty(self, offset, dataSize);
 
     Py_RETURN_NONE;
 }
 
-static PyObject *store(PyBuffer *self, PyObject *args, PyObject *kwargs)
+typedef struct
+{
+    PyTypeObject *type;
+    size_t dataOffset;
+    size_t size;
+} MathStoreInfo;
+
+// Math objects which data is copied directly, without going through the buffer protocol. Types are compared
+// exactly, so subclasses take the generic path.
+static const MathStoreInfo mathStoreInfos[] = {
+    {&pyMatrix4Type, offsetof(Matrix4, data), sizeof(mat4)},
+    {&pyVector4Type, offsetof(Vector4, data), sizeof(vec4)},
+    {&pyVector3Type, offsetof(Vector3, data), sizeof(vec3)},
+    {&pyVector2Type, offsetof(Vector2, data), sizeof(vec2)},
+    {&pyQuaternionType, offsetof(Quaternion, data), sizeof(versor)},
+    {&pyMatrix3Type, offsetof(Matrix3, data), sizeof(mat3)},
+    {&pyMatrix2Type, offsetof(Matrix2, data), sizeof(mat2)},
+    {&pyDMatrix4Type, offsetof(DMatrix4, data), sizeof(dmat4)},
+    {&pyDVector4Type, offsetof(DVector4, data), sizeof(dvec4)},
+    {&pyDVector3Type, offsetof(DVector3, data), sizeof(dvec3)},
+    {&pyDVector2Type, offsetof(DVector2, data), sizeof(dvec2)},
+};
+
+// Data of an object passed to store functions, resolved before anything is copied.
+typedef struct
 {
-    static char *kwNames[] = {"data", "offset", NULL};
+    const void *src;
+    Py_ssize_t size;
+    // numbers are converted into this storage
+    union
+    {
+        float f;
+        int i;
+    } scalar;
+    // exports of vector and matrix arrays, which prevent their reinitialization while copying without the GIL
+    Py_ssize_t *arrayExports;
+    Py_buffer view;
+} StoreSource;
+
+static bool resolve_store_source(PyObject *data, StoreSource *source)
+{
+    *source = (StoreSource){0};
 
-    PyObject *result = NULL;
+    for (size_t i = 0; i < sizeof(mathStoreInfos) / sizeof(*mathStoreInfos); i++)
+    {
+        if (Py_IS_TYPE(data, mathStoreInfos[i].type))
+        {
+            source->src = (const char *)data + mathStoreInfos[i].dataOffset;
+            source->size = mathStoreInfos[i].size;
+            return true;
+        }
+    }
+
+    // float subclasses which don't export their own data are handled after the buffer protocol
+    if (PyFloat_CheckExact(data) || (PyFloat_Check(data) && !PyObject_CheckBuffer(data)))
+    {
+        source->scalar.f = (float)PyFloat_AS_DOUBLE(data);
+        source->size = sizeof(float);
+        return true;
+    }
+
+    if (PyLong_Check(data))
+    {
+        const long value = PyLong_AsLong(data);
+        if (value == -1 && PyErr_Occurred())
+            return false;
+
+        source->scalar.i = (int)value;
+        source->size = sizeof(int);
+        return true;
+    }
+
+    if (py_vector_array_check(data))
+    {
+        // vector arrays are always contiguous, so whole array can be copied at once
+        VectorArray *array = (VectorArray *)data;
+        source->src = array->data;
+        source->size = py_vector_array_size(array);
+        source->arrayExports = &array->exports;
+        array->exports++;
+        return true;
+    }
+
+    if (Py_IS_TYPE(data, &pyMatrix4ArrayType))
+    {
+        Matrix4Array *array = (Matrix4Array *)data;
+        source->src = array->data;
+        source->size = py_matrix4_array_size(array);
+        source->arrayExports = &array->exports;
+        array->exports++;
+        return true;
+    }
+
+    if (PyObject_CheckBuffer(data))
+    {
+        THROW_IF(
+            PyObject_GetBuffer(data, &source->view, PyBUF_CONTIG_RO) == -1, // double check to catch non-contiguous buffers
+            PyExc_ValueError,
+            "Data buffer has to be C-contiguous. For more informations go to https://github.com/m4reQ/pygl?tab=readme-ov-file#buffer-protocol-usage.",
+            false);
+
+        source->src = source->view.buf;
+        source->size = source->view.len;
+        return true;
+    }
+
+    PyErr_Format(PyExc_TypeError, "Expected argument to be of math type, buffer or simple numeric type, got %s.", Py_TYPE(data)->tp_name);
+    return false;
+}
+
+static void release_store_source(StoreSource *source)
+{
+    if (source->arrayExports != NULL)
+        (*source->arrayExports)--;
+
+    if (source->view.obj != NULL)
+        PyBuffer_Release(&source->view);
+
+    *source = (StoreSource){0};
+}
+
+// Copies resolved data into `dst`, possibly with the GIL released.
+static void copy_store_source(const StoreSource *source, char *dst, bool streaming)
+{
+    if (source->src == NULL)
+        memcpy(dst, &source->scalar, source->size);
+    else
+        copy_engine_copy(dst, source->src, source->size, streaming);
+}
+
+Py_ssize_t py_buffer_store_object(PyObject *data, char *dst, Py_ssize_t available, bool streaming)
+{
+    StoreSource source;
+    if (!resolve_store_source(data, &source))
+        return -1;
+
+    const Py_ssize_t size = source.size;
+    if (size > available)
+    {
+        release_store_source(&source);
+        PyErr_SetString(PyExc_RuntimeError, "Data transfer would cause buffer overflow.");
+        return -1;
+    }
+
+    copy_store_source(&source, dst, streaming);
+    release_store_source(&source);
+
+    return size;
+}
+
+// Resolves optional offset argument of store functions, `None` means current offset.
+static bool get_store_offset(PyBuffer *self, PyObject *offsetObj, Py_ssize_t *offset)
+{
+    THROW_IF(self->id == 0, PyExc_RuntimeError, "Cannot store data in deleted buffer.", false);
 
     // throw an error if the buffer is not persistently mapped or dynamic and has not been mapped before
     THROW_IF(
         !FLAG_IS_SET(self->flags, GL_MAP_PERSISTENT_BIT) && !FLAG_IS_SET(self->flags, GL_DYNAMIC_STORAGE_BIT) && !self->dataPtr,
         PyExc_RuntimeError,
         "Non-persistent buffer has to be mapped prior to storing data.",
-        NULL);
+        false);
 
-    PyObject *data = NULL;
-    Py_buffer dataBuffer = {0};
-    size_t offset = self->currentOffset;
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", kwNames, &data, &offset))
+    if (offsetObj == NULL || Py_IsNone(offsetObj))
+    {
+        *offset = self->currentOffset;
+        return true;
+    }
+
+    *offset = PyLong_AsSsize_t(offsetObj);
+    if (*offset == -1 && PyErr_Occurred())
+        return false;
+
+    THROW_IF(
+        *offset < 0 || *offset > self->size,
+        PyExc_ValueError,
+        "Offset has to point inside the buffer.",
+        false);
+
+    return true;
+}
+
+static PyObject *store(PyBuffer *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"data", "offset", NULL};
+
+    PyObject *values[2];
+    Py_ssize_t offset = 0;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !get_store_offset(self, values[1], &offset))
         return NULL;
 
-    void *dataPtr = (char *)self->dataPtr + offset;
-    size_t dataSize = 0;
+    StoreSource source;
+    if (!resolve_store_source(values[0], &source))
+        return NULL;
 
-    // FIXME Add fast path for matrix and vector stores
-    if (PyObject_CheckBuffer(data))
+    const Py_ssize_t size = source.size;
+    if (size > self->size - offset)
     {
-        int _result = PyObject_GetBuffer(data, &dataBuffer, PyBUF_CONTIG_RO); // double check to catch non-contiguous buffers
-        THROW_IF_GOTO(
-            _result == -1,
-            PyExc_ValueError,
-            "Data buffer has to be C-contiguous. For more informations go to https://github.com/m4reQ/pygl?tab=readme-ov-file#buffer-protocol-usage.",
-            end);
+        release_store_source(&source);
+        PyErr_SetString(PyExc_RuntimeError, "Data transfer would cause buffer overflow.");
+        return NULL;
+    }
 
-        THROW_IF_GOTO(
-            dataBuffer.len > self->size - self->currentOffset,
-            PyExc_RuntimeError,
-            "Data transfer would cause buffer overflow.",
-            end);
+    reserve_range(self, offset, size);
 
-        memcpy(dataPtr, dataBuffer.buf, dataBuffer.len);
-        dataSize = dataBuffer.len;
-    }
-    // else if (PyObject_IsInstance(data, (PyObject *)&pyQuaternionType))
-    // {
-    //     py_quaternion_copy(dataPtr, (Quaternion *)data);
-    //     dataSize = sizeof(versor);
-    // }
-    else if (PyLong_Check(data))
+    py_buffer_pin(self);
+    copy_store_source(&source, (char *)self->dataPtr + offset, !py_buffer_has_client_storage(self));
+    py_buffer_unpin(self);
+
+    release_store_source(&source);
+    py_buffer_mark_dirty(self, offset, size);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *store_many(PyBuffer *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"data", "offset", NULL};
+
+    PyObject *values[2];
+    Py_ssize_t offset = 0;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !get_store_offset(self, values[1], &offset))
+        return NULL;
+
+    // tuple keeps items alive even if the original sequence is modified while copying without the GIL
+    PyObject *items = PySequence_Tuple(values[0]);
+    if (!items)
+        return NULL;
+
+    PyObject *result = NULL;
+    const Py_ssize_t count = PyTuple_GET_SIZE(items);
+    StoreSource *sources = PyMem_Calloc(count > 0 ? count : 1, sizeof(StoreSource));
+    if (!sources)
     {
-        *(int *)dataPtr = PyLong_AsLong(data);
-        dataSize = sizeof(int);
+        PyErr_NoMemory();
+        goto end;
     }
-    else if (PyFloat_Check(data))
+
+    // all objects are resolved first, so the whole range can be reserved at once and nothing is written on failure
+    Py_ssize_t totalSize = 0;
+    for (Py_ssize_t i = 0; i < count; i++)
     {
-        *(float *)dataPtr = (float)PyFloat_AS_DOUBLE(data);
-        dataSize = sizeof(float);
+        if (!resolve_store_source(PyTuple_GET_ITEM(items, i), &sources[i]))
+            goto end;
+
+        totalSize += sources[i].size;
     }
-    else
+
+    THROW_IF_GOTO(
+        totalSize > self->size - offset,
+        PyExc_RuntimeError,
+        "Data transfer would cause buffer overflow.",
+        end);
+
+    reserve_range(self, offset, totalSize);
+
+    // objects are packed one after another
+    const bool streaming = !py_buffer_has_client_storage(self);
+    char *dst = (char *)self->dataPtr + offset;
+    py_buffer_pin(self);
+    for (Py_ssize_t i = 0; i < count; i++)
     {
-        PyErr_Format(PyExc_TypeError, "Expected argument to be of math type, buffer or simple numeric type, got %s.", Py_TYPE(data)->tp_name);
-        return NULL;
+        copy_store_source(&sources[i], dst, streaming);
+        dst += sources[i].size;
     }
 
-    if (offset == 0 || offset == self->currentOffset)
-        self->currentOffset += dataSize;
+    py_buffer_unpin(self);
+    py_buffer_mark_dirty(self, offset, totalSize);
 
     result = Py_NewRef(Py_None);
 
 end:
-    if (dataBuffer.buf != NULL)
-        PyBuffer_Release(&dataBuffer);
+    if (sources)
+    {
+        for (Py_ssize_t i = 0; i < count; i++)
+            release_store_source(&sources[i]);
+
+        PyMem_Free(sources);
+    }
+
+    Py_DECREF(items);
 
     return result;
 }
 
 static PyObject *delete(PyBuffer *self, PyObject *Py_UNUSED(args))
 {
+    THROW_IF(self->exportCount != 0, PyExc_BufferError, "Buffer cannot be deleted while its memory is exported.", NULL);
+
+    // deleting the buffer implicitly unmaps it, client storage has to be freed manually
+    if (py_buffer_has_client_storage(self) && self->dataPtr != NULL)
+        PyMem_Free(self->dataPtr);
+
     glDeleteBuffers(1, &self->id);
     self->id = 0;
+    self->dataPtr = NULL;
 
     Py_RETURN_NONE;
 }
@@ -238,7 +607,12 @@ static PyObject *buf_read(PyBuffer *self, PyObject *args, PyObject *kwargs)
     }
 
     if (self->flags & GL_DYNAMIC_STORAGE_BIT)
+    {
+        // output buffer stays exported until the end of the function
+        PyThreadState *threadState = utils_begin_allow_threads(size >= UTILS_ALLOW_THREADS_THRESHOLD);
         glGetNamedBufferSubData(self->id, offset, size, outBuffer.buf);
+        utils_end_allow_threads(threadState);
+    }
     else
     {
         THROW_IF_GOTO(
@@ -253,12 +627,10 @@ static PyObject *buf_read(PyBuffer *self, PyObject *args, PyObject *kwargs)
             "Mappable buffer has to be mapped before attempting to read data. Map buffer or use MAP_PERSISTENT_BIT.",
             end);
 
-        int result = PyBuffer_FromContiguous(&outBuffer, (char *)self->dataPtr + offset, size, 'C');
-        THROW_IF_GOTO(
-            result == -1,
-            PyExc_RuntimeError,
-            "Couldn't read data from buffer.",
-            end);
+        // output buffer was checked to be contiguous
+        py_buffer_pin(self);
+        copy_engine_copy(outBuffer.buf, (char *)self->dataPtr + offset, size, false);
+        py_buffer_unpin(self);
     }
 
     result = Py_NewRef(Py_None);
@@ -273,8 +645,6 @@ end:
 static void dealloc(PyBuffer *self)
 {
     delete (self, NULL);
-    if ((self->flags & GL_DYNAMIC_STORAGE_BIT) && self->dataPtr != NULL)
-        PyMem_Free(self->dataPtr);
 
     Py_TYPE(self)->tp_free(self);
 }
@@ -298,45 +668,341 @@ static int init(PyBuffer *self, PyObject *args, PyObject *kwargs)
         self->isPersistent = true;
     }
 
+    THROW_IF(
+        FLAG_IS_SET(self->flags, GL_MAP_FLUSH_EXPLICIT_BIT) && !FLAG_IS_SET(self->flags, GL_MAP_WRITE_BIT),
+        PyExc_ValueError,
+        "When using BufferFlags.MAP_FLUSH_EXPLICIT_BIT, BufferFlags.MAP_WRITE_BIT must also be set.",
+        -1);
+
+    self->tracksDirtyRanges = py_buffer_has_client_storage(self) || FLAG_IS_SET(self->flags, GL_MAP_FLUSH_EXPLICIT_BIT);
+    self->dirtyRangeCount = 0;
+
     glCreateBuffers(1, &self->id);
 
+    // client storage shadow is initialized the same way as the GL storage, so it can be used to upload the data
+    const bool clientStorage = py_buffer_has_client_storage(self);
     void *dataPtr = NULL;
+    const void *storageData = NULL;
     if (data.obj != NULL)
     {
-        THROW_IF(
-            data.len > self->size,
-            PyExc_RuntimeError,
-            "Provided data is bigger than the requested buffer size.",
-            -1);
-
-        dataPtr = PyMem_Malloc(self->size);
-        if (PyBuffer_ToContiguous(dataPtr, &data, self->size, 'C') == -1)
+        if (data.len > self->size)
         {
-            PyMem_Free(dataPtr);
             PyBuffer_Release(&data);
-            PyErr_SetString(PyExc_RuntimeError, "Failed to upload provided data to the buffer.");
+            PyErr_SetString(PyExc_RuntimeError, "Provided data is bigger than the requested buffer size.");
 
             return -1;
         }
 
+        if (!clientStorage && data.len == self->size && PyBuffer_IsContiguous(&data, 'C'))
+            storageData = data.buf; // storage can be initialized directly from the provided data
+        else
+        {
+            dataPtr = PyMem_Calloc(1, self->size);
+            if (dataPtr == NULL)
+            {
+                PyBuffer_Release(&data);
+                PyErr_NoMemory();
+
+                return -1;
+            }
+
+            if (PyBuffer_IsContiguous(&data, 'C'))
+                copy_engine_copy(dataPtr, data.buf, data.len, false);
+            else if (PyBuffer_ToContiguous(dataPtr, &data, data.len, 'C') == -1)
+            {
+                PyMem_Free(dataPtr);
+                PyBuffer_Release(&data);
+                PyErr_SetString(PyExc_RuntimeError, "Failed to upload provided data to the buffer.");
+
+                return -1;
+            }
+
+            storageData = dataPtr;
+        }
+    }
+
+    // explicit flushing is property of the mapping, not of the storage
+    PyThreadState *threadState = utils_begin_allow_threads(storageData != NULL && self->size >= UTILS_ALLOW_THREADS_THRESHOLD);
+    glNamedBufferStorage(self->id, self->size, storageData, self->flags & ~GL_MAP_FLUSH_EXPLICIT_BIT);
+    utils_end_allow_threads(threadState);
+
+    if (data.obj != NULL)
         PyBuffer_Release(&data);
+
+    if (clientStorage)
+    {
+        self->dataPtr = dataPtr != NULL ? dataPtr : PyMem_Calloc(1, self->size);
+        if (self->dataPtr == NULL)
+        {
+            PyErr_NoMemory();
+            return -1;
+        }
     }
+    else
+    {
+        if (dataPtr != NULL)
+            PyMem_Free(dataPtr);
 
-    glNamedBufferStorage(self->id, self->size, dataPtr, self->flags);
+        if (FLAG_IS_SET(self->flags, GL_MAP_PERSISTENT_BIT))
+            self->dataPtr = glMapNamedBufferRange(self->id, 0, self->size, self->flags & BUFFER_MAP_FLAGS);
+    }
 
-    if (dataPtr != NULL)
+    return 0;
+}
+
+bool py_buffer_acquire_write_target(PyObject *obj, Py_ssize_t offset, Py_ssize_t size, WriteTarget *target)
+{
+    *target = (WriteTarget){0};
+
+    if (Py_IS_TYPE(obj, &pyBufferType))
+    {
+        PyBuffer *buffer = (PyBuffer *)obj;
+
+        THROW_IF(
+            buffer->dataPtr == NULL,
+            PyExc_RuntimeError,
+            "Non-persistent buffer has to be mapped prior to storing data.",
+            false);
+
+        if (offset < 0)
+            offset = buffer->currentOffset;
+
+        THROW_IF(
+            size > buffer->size - offset,
+            PyExc_RuntimeError,
+            "Data transfer would cause buffer overflow.",
+            false);
+
+        // keep the same offset semantics as Buffer.store
+        reserve_range(buffer, offset, size);
+        py_buffer_pin(buffer);
+
+        target->data = (char *)buffer->dataPtr + offset;
+        target->buffer = buffer;
+        target->size = size;
+
+        return true;
+    }
+
+    if (PyObject_GetBuffer(obj, &target->view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) == -1)
+        return false;
+
+    if (offset < 0)
+        offset = 0;
+
+    if (size > target->view.len - offset)
     {
-        PyMem_Free(dataPtr);
+        PyErr_Format(PyExc_ValueError, "Output buffer is too small (required: %zd, got: %zd).", offset + size, target->view.len);
+        PyBuffer_Release(&target->view);
+        return false;
     }
 
-    if (FLAG_IS_SET(self->flags, GL_MAP_PERSISTENT_BIT))
-        self->dataPtr = glMapNamedBufferRange(self->id, 0, self->size, self->flags);
-    else if (FLAG_IS_SET(self->flags, GL_DYNAMIC_STORAGE_BIT))
-        self->dataPtr = PyMem_Malloc(self->size);
+    target->data = (char *)target->view.buf + offset;
+
+    return true;
+}
+
+void py_buffer_release_write_target(WriteTarget *target)
+{
+    if (target->view.obj != NULL)
+        PyBuffer_Release(&target->view);
+
+    // written range is marked only after writing, so it's not lost if the buffer is transferred meanwhile
+    if (target->buffer != NULL)
+    {
+        py_buffer_unpin(target->buffer);
+        py_buffer_mark_dirty(target->buffer, (char *)target->data - (char *)target->buffer->dataPtr, target->size);
+    }
+
+    target->data = NULL;
+    target->buffer = NULL;
+}
+
+static PyObject *read_async(PyBuffer *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"size", "offset", NULL};
+
+    GLsizeiptr size = 0;
+    GLintptr offset = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|n", kwNames, &size, &offset))
+        return NULL;
+
+    THROW_IF(
+        size <= 0 || offset < 0 || size > self->size - offset,
+        PyExc_ValueError,
+        "Requested size and offset exceed buffer size.",
+        NULL);
+
+    THROW_IF(
+        self->dataPtr != NULL && !self->isPersistent && !py_buffer_has_client_storage(self),
+        PyExc_RuntimeError,
+        "Buffer cannot be read asynchronously while it is mapped. Call transfer first.",
+        NULL);
+
+    return (PyObject *)py_readback_future_create(self->id, offset, size);
+}
+
+static int export_range(PyBuffer *self, PyObject *owner, Py_buffer *view, int flags, Py_ssize_t offset, Py_ssize_t size)
+{
+    if (self->dataPtr == NULL)
+    {
+        PyErr_SetString(
+            PyExc_BufferError,
+            self->id == 0 ? "Cannot export memory of deleted buffer." : "Buffer has to be mapped or use client storage to export its memory.");
+        view->obj = NULL;
+        return -1;
+    }
+
+    const bool readonly = !py_buffer_has_client_storage(self) && !FLAG_IS_SET(self->flags, GL_MAP_WRITE_BIT);
+    if (PyBuffer_FillInfo(view, owner, (char *)self->dataPtr + offset, size, readonly, flags) == -1)
+        return -1;
+
+    self->exportCount++;
+    if (!readonly)
+    {
+        if (self->writableExportCount++ == 0)
+            self->exportedRange = (DirtyRange){offset, offset + size};
+        else
+        {
+            if (offset < self->exportedRange.start)
+                self->exportedRange.start = offset;
+            if (offset + size > self->exportedRange.end)
+                self->exportedRange.end = offset + size;
+        }
+    }
 
     return 0;
 }
 
+static void release_range(PyBuffer *self, Py_buffer *view)
+{
+    self->exportCount--;
+    if (!view->readonly)
+    {
+        py_buffer_mark_dirty(self, (char *)view->buf - (char *)self->dataPtr, view->len);
+
+        // range of released exports was just marked dirty, so it doesn't have to be tracked anymore
+        if (--self->writableExportCount == 0)
+            self->exportedRange = (DirtyRange){0, 0};
+    }
+}
+
+static int get_buffer(PyBuffer *self, Py_buffer *view, int flags)
+{
+    return export_range(self, (PyObject *)self, view, flags, 0, self->size);
+}
+
+static void release_buffer(PyBuffer *self, Py_buffer *view)
+{
+    release_range(self, view);
+}
+
+// Exports part of the buffer memory, used to create views which mark only their range as dirty.
+typedef struct
+{
+    PyObject_HEAD
+    PyBuffer *buffer;
+    Py_ssize_t offset, size;
+} BufferRange;
+
+static int range_get_buffer(BufferRange *self, Py_buffer *view, int flags)
+{
+    return export_range(self->buffer, (PyObject *)self, view, flags, self->offset, self->size);
+}
+
+static void range_release_buffer(BufferRange *self, Py_buffer *view)
+{
+    release_range(self->buffer, view);
+}
+
+static void range_dealloc(BufferRange *self)
+{
+    Py_XDECREF(self->buffer);
+    PyObject_Free(self);
+}
+
+PyTypeObject pyBufferRangeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.buffers._BufferRange",
+    .tp_basicsize = sizeof(BufferRange),
+    .tp_dealloc = (destructor)range_dealloc,
+    .tp_as_buffer = &(PyBufferProcs){
+        .bf_getbuffer = (getbufferproc)range_get_buffer,
+        .bf_releasebuffer = (releasebufferproc)range_release_buffer,
+    },
+};
+
+static PyObject *view(PyBuffer *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"format", "shape", "offset", "size", NULL};
+
+    const char *format = "B";
+    PyObject *shape = NULL;
+    Py_ssize_t offset = 0;
+    Py_ssize_t size = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sOnn", kwNames, &format, &shape, &offset, &size))
+        return NULL;
+
+    THROW_IF(offset < 0 || offset > self->size, PyExc_ValueError, "Offset has to point inside the buffer.", NULL);
+
+    const Py_ssize_t itemSize = PyBuffer_SizeFromFormat(format);
+    if (itemSize == -1)
+        return NULL;
+
+    // by default view covers as many items as fit in the rest of the buffer
+    if (size < 0)
+        size = (self->size - offset) / itemSize * itemSize;
+
+    THROW_IF(size > self->size - offset, PyExc_ValueError, "Requested view exceeds buffer size.", NULL);
+
+    BufferRange *range = PyObject_New(BufferRange, &pyBufferRangeType);
+    if (range == NULL)
+        return NULL;
+
+    range->buffer = (PyBuffer *)Py_NewRef(self);
+    range->offset = offset;
+    range->size = size;
+
+    PyObject *bytesView = PyMemoryView_FromObject((PyObject *)range);
+    Py_DECREF(range);
+    if (bytesView == NULL || (strcmp(format, "B") == 0 && (shape == NULL || Py_IsNone(shape))))
+        return bytesView;
+
+    PyObject *result = shape == NULL || Py_IsNone(shape)
+                           ? PyObject_CallMethod(bytesView, "cast", "s", format)
+                           : PyObject_CallMethod(bytesView, "cast", "sO", format, shape);
+
+    // cast view shares the export with the original one, so it stays alive as long as the result does
+    Py_DECREF(bytesView);
+
+    return result;
+}
+
+static PyObject *get_dirty_ranges(PyBuffer *self, void *Py_UNUSED(closure))
+{
+    PyObject *ranges = PyList_New(self->dirtyRangeCount);
+    if (ranges == NULL)
+        return NULL;
+
+    for (int i = 0; i < self->dirtyRangeCount; i++)
+    {
+        PyObject *range = Py_BuildValue(
+            "(nn)",
+            (Py_ssize_t)self->dirtyRanges[i].start,
+            (Py_ssize_t)(self->dirtyRanges[i].end - self->dirtyRanges[i].start));
+        if (range == NULL)
+        {
+            Py_DECREF(ranges);
+            return NULL;
+        }
+
+        PyList_SET_ITEM(ranges, i, range);
+    }
+
+    return ranges;
+}
+
 PyTypeObject pyBufferType = {
     PyVarObject_HEAD_INIT(NULL, 0)
         .tp_new = PyType_GenericNew,
@@ -350,15 +1016,26 @@ PyTypeObject pyBufferType = {
         {"id", T_UINT, offsetof(PyBuffer, id), READONLY, NULL},
         {"size", T_ULONGLONG, offsetof(PyBuffer, size), READONLY, NULL},
         {"current_offset", T_ULONGLONG, offsetof(PyBuffer, currentOffset), 0, NULL},
+        {"export_count", T_PYSSIZET, offsetof(PyBuffer, exportCount), READONLY, NULL},
         {0}},
+    .tp_getset = (PyGetSetDef[]){
+        {"dirty_ranges", (getter)get_dirty_ranges, NULL, NULL, NULL},
+        {0}},
+    .tp_as_buffer = &(PyBufferProcs){
+        .bf_getbuffer = (getbufferproc)get_buffer,
+        .bf_releasebuffer = (releasebufferproc)release_buffer,
+    },
     .tp_methods = (PyMethodDef[]){
         {"delete", (PyCFunction) delete, METH_NOARGS, NULL},
-        {"store", (PyCFunction)store, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"store", (PyCFunction)store, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"store_many", (PyCFunction)store_many, METH_FASTCALL | METH_KEYWORDS, NULL},
         {"store_address", (PyCFunction)store_address, METH_VARARGS, NULL},
         {"transfer", (PyCFunction)transfer, METH_NOARGS, NULL},
         {"reset_offset", (PyCFunction)reset_offset, METH_NOARGS, NULL},
         {"map", (PyCFunction)map, METH_NOARGS, NULL},
         {"read", (PyCFunction)buf_read, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"read_async", (PyCFunction)read_async, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"view", (PyCFunction)view, METH_VARARGS | METH_KEYWORDS, NULL},
         {"bind_base", (PyCFunction)bind_base, METH_VARARGS, NULL},
         {"bind", (PyCFunction)bind, METH_O, NULL},
         {0},
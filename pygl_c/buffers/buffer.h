@@ -2,6 +2,16 @@
 #include <stdbool.h>
 #include "../gl.h"
 
+// Maximum number of separate dirty ranges tracked per buffer. When exceeded, two closest ranges are merged.
+#define BUFFER_MAX_DIRTY_RANGES 16
+// Ranges separated by fewer bytes than this are uploaded with a single call.
+#define BUFFER_DIRTY_MERGE_GAP 256
+
+typedef struct
+{
+    GLintptr start, end;
+} DirtyRange;
+
 typedef struct
 {
     PyObject_HEAD
@@ -10,6 +20,61 @@ typedef struct
     GLenum flags;
     GLsizeiptr size, currentOffset;
     bool isPersistent;
+    // set for client side storage of dynamic buffers and for mappings with explicit flushes
+    bool tracksDirtyRanges;
+    int dirtyRangeCount;
+    // sorted and non-overlapping
+    DirtyRange dirtyRanges[BUFFER_MAX_DIRTY_RANGES];
+    // number of alive buffer protocol exports, buffer can't be unmapped or deleted while there are any
+    Py_ssize_t exportCount;
+    Py_ssize_t writableExportCount;
+    // union of writable exports made since the last transfer, treated as dirty while they are alive
+    DirtyRange exportedRange;
 } PyBuffer;
 
 extern PyTypeObject pyBufferType;
+// Exports part of buffer memory, returned (wrapped in memoryview) by Buffer.view.
+extern PyTypeObject pyBufferRangeType;
+
+// Records that `size` bytes at `offset` were written and have to be uploaded or flushed on next transfer.
+void py_buffer_mark_dirty(PyBuffer *buffer, GLintptr offset, GLsizeiptr size);
+
+// Flushes dirty ranges of buffer mapped with `GL_MAP_FLUSH_EXPLICIT_BIT`. Returns number of flushed bytes.
+GLsizeiptr py_buffer_flush_mapped_ranges(PyBuffer *buffer);
+
+// Pins buffer memory, so it can't be unmapped or deleted by other threads while the GIL is released.
+static inline void py_buffer_pin(PyBuffer *buffer)
+{
+    buffer->exportCount++;
+}
+
+static inline void py_buffer_unpin(PyBuffer *buffer)
+{
+    buffer->exportCount--;
+}
+
+// Returns true if buffer data lives in client memory and is uploaded with `glNamedBufferSubData` on transfer.
+static inline bool py_buffer_has_client_storage(const PyBuffer *buffer)
+{
+    return (buffer->flags & GL_DYNAMIC_STORAGE_BIT) && !buffer->isPersistent;
+}
+
+// Writable memory region resolved either from mapped pygl.buffers.Buffer or any object supporting buffer protocol.
+typedef struct
+{
+    void *data;
+    Py_buffer view;
+    // pinned until the target is released, kernels write into it without the GIL
+    PyBuffer *buffer;
+    Py_ssize_t size;
+} WriteTarget;
+
+// Resolves `obj` into memory region of `size` bytes starting at `offset`. Negative `offset` means current
+// offset for pygl.buffers.Buffer and beginning of memory for other objects. Target has to be released
+// with `py_buffer_release_write_target` after use.
+bool py_buffer_acquire_write_target(PyObject *obj, Py_ssize_t offset, Py_ssize_t size, WriteTarget *target);
+void py_buffer_release_write_target(WriteTarget *target);
+
+// Copies math object, number or contiguous buffer `data` into `dst` which has `available` bytes of space left.
+// `streaming` marks `dst` as GL mapping (see `copy_engine_copy`). Returns number of bytes written or -1 on failure.
+Py_ssize_t py_buffer_store_object(PyObject *data, char *dst, Py_ssize_t available, bool streaming);
@@ -0,0 +1,754 @@
+#include "bufferHeap.h"
+#include <structmember.h>
+#include <string.h>
+#include "../utility.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+static inline uint32_t highest_bit(uint32_t value)
+{
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return index;
+}
+
+static inline uint32_t lowest_bit(uint32_t value)
+{
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+}
+#else
+static inline uint32_t highest_bit(uint32_t value)
+{
+    return 31 - __builtin_clz(value);
+}
+
+static inline uint32_t lowest_bit(uint32_t value)
+{
+    return __builtin_ctz(value);
+}
+#endif
+
+#define MANTISSA_VALUE (1u << BUFFER_HEAP_MANTISSA_BITS)
+#define MANTISSA_MASK (MANTISSA_VALUE - 1)
+#define NODE_RESERVE_MIN 64
+
+// Encodes `size` as small float used as bin index. Free blocks are inserted rounding down, so every block in
+// the bin found for rounded up request size is big enough.
+static uint32_t size_to_bin(uint32_t size, bool roundUp)
+{
+    if (size < MANTISSA_VALUE)
+        return size;
+
+    const uint32_t mantissaStart = highest_bit(size) - BUFFER_HEAP_MANTISSA_BITS;
+    uint32_t mantissa = (size >> mantissaStart) & MANTISSA_MASK;
+    if (roundUp && (size & ((1u << mantissaStart) - 1)) != 0)
+        mantissa++;
+
+    // mantissa overflow carries into the exponent
+    return ((mantissaStart + 1) << BUFFER_HEAP_MANTISSA_BITS) + mantissa;
+}
+
+static uint32_t lowest_bit_after(uint32_t mask, uint32_t start)
+{
+    if (start >= 32)
+        return BUFFER_HEAP_NONE;
+
+    const uint32_t masked = mask & ~((1u << start) - 1);
+    return masked ? lowest_bit(masked) : BUFFER_HEAP_NONE;
+}
+
+static uint64_t gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0)
+    {
+        const uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+// Ensures that at least `count` nodes can be acquired without failing.
+static bool node_reserve(PyBufferHeap *self, uint32_t count)
+{
+    if (self->nodeCapacity - self->nodeCount >= count)
+        return true;
+
+    uint32_t capacity = self->nodeCapacity ? self->nodeCapacity * 2 : NODE_RESERVE_MIN;
+    while (capacity - self->nodeCount < count)
+        capacity *= 2;
+
+    HeapNode *nodes = PyMem_Realloc(self->nodes, capacity * sizeof(HeapNode));
+    if (nodes == NULL)
+    {
+        PyErr_NoMemory();
+        return false;
+    }
+
+    self->nodes = nodes;
+    self->nodeCapacity = capacity;
+
+    return true;
+}
+
+// Node storage has to be reserved beforehand.
+static uint32_t node_acquire(PyBufferHeap *self)
+{
+    if (self->deadHead != BUFFER_HEAP_NONE)
+    {
+        const uint32_t index = self->deadHead;
+        self->deadHead = self->nodes[index].binNext;
+
+        return index;
+    }
+
+    return self->nodeCount++;
+}
+
+static void node_release(PyBufferHeap *self, uint32_t index)
+{
+    self->nodes[index].state = HEAP_NODE_DEAD;
+    self->nodes[index].binNext = self->deadHead;
+    self->deadHead = index;
+}
+
+static void bin_insert(PyBufferHeap *self, uint32_t index)
+{
+    HeapNode *node = &self->nodes[index];
+    const uint32_t bin = size_to_bin(node->size, false);
+    const uint32_t top = bin >> BUFFER_HEAP_MANTISSA_BITS;
+
+    node->state = HEAP_NODE_FREE;
+    node->binPrev = BUFFER_HEAP_NONE;
+    node->binNext = self->binHeads[bin];
+    if (node->binNext != BUFFER_HEAP_NONE)
+        self->nodes[node->binNext].binPrev = index;
+
+    self->binHeads[bin] = index;
+    self->usedBins[top] |= 1u << (bin & MANTISSA_MASK);
+    self->usedBinsTop |= 1u << top;
+    self->freeSize += node->size;
+    self->freeBlockCount++;
+}
+
+static void bin_remove(PyBufferHeap *self, uint32_t index)
+{
+    HeapNode *node = &self->nodes[index];
+
+    if (node->binPrev != BUFFER_HEAP_NONE)
+        self->nodes[node->binPrev].binNext = node->binNext;
+    else
+    {
+        const uint32_t bin = size_to_bin(node->size, false);
+        const uint32_t top = bin >> BUFFER_HEAP_MANTISSA_BITS;
+
+        self->binHeads[bin] = node->binNext;
+        if (node->binNext == BUFFER_HEAP_NONE)
+        {
+            self->usedBins[top] &= ~(1u << (bin & MANTISSA_MASK));
+            if (self->usedBins[top] == 0)
+                self->usedBinsTop &= ~(1u << top);
+        }
+    }
+
+    if (node->binNext != BUFFER_HEAP_NONE)
+        self->nodes[node->binNext].binPrev = node->binPrev;
+
+    self->freeSize -= node->size;
+    self->freeBlockCount--;
+}
+
+// Creates free block of `size` bytes at `offset`, placed between `prev` and `next` neighbors.
+static uint32_t insert_free_block(PyBufferHeap *self, uint32_t offset, uint32_t size, uint32_t prev, uint32_t next)
+{
+    const uint32_t index = node_acquire(self);
+    HeapNode *node = &self->nodes[index];
+    node->offset = offset;
+    node->size = size;
+    node->alignment = 0;
+    node->neighborPrev = prev;
+    node->neighborNext = next;
+
+    if (prev != BUFFER_HEAP_NONE)
+        self->nodes[prev].neighborNext = index;
+    if (next != BUFFER_HEAP_NONE)
+        self->nodes[next].neighborPrev = index;
+
+    bin_insert(self, index);
+
+    return index;
+}
+
+// Returns node of the allocated block or BUFFER_HEAP_NONE if there is no free block big enough. `size` has
+// to be multiple of heap alignment and `alignment` multiple of heap alignment.
+static uint32_t heap_allocate(PyBufferHeap *self, uint32_t size, uint32_t alignment)
+{
+    // block found for the padded size always has room to align its start
+    const uint64_t request = (uint64_t)size + alignment - self->alignment;
+    if (request > self->freeSize)
+        return BUFFER_HEAP_NONE;
+
+    const uint32_t minBin = size_to_bin((uint32_t)request, true);
+    uint32_t top = minBin >> BUFFER_HEAP_MANTISSA_BITS;
+    uint32_t leaf = BUFFER_HEAP_NONE;
+
+    if (top < BUFFER_HEAP_TOP_BIN_COUNT && (self->usedBinsTop & (1u << top)))
+        leaf = lowest_bit_after(self->usedBins[top], minBin & MANTISSA_MASK);
+
+    if (leaf == BUFFER_HEAP_NONE)
+    {
+        top = lowest_bit_after(self->usedBinsTop, top + 1);
+        if (top == BUFFER_HEAP_NONE)
+            return BUFFER_HEAP_NONE;
+
+        leaf = lowest_bit(self->usedBins[top]);
+    }
+
+    const uint32_t index = self->binHeads[(top << BUFFER_HEAP_MANTISSA_BITS) | leaf];
+    bin_remove(self, index);
+
+    const uint32_t offset = self->nodes[index].offset;
+    const uint32_t alignedOffset = (uint32_t)((offset + alignment - 1) / alignment * alignment);
+    if (alignedOffset != offset)
+    {
+        insert_free_block(self, offset, alignedOffset - offset, self->nodes[index].neighborPrev, index);
+        self->nodes[index].offset = alignedOffset;
+        self->nodes[index].size -= alignedOffset - offset;
+    }
+
+    HeapNode *node = &self->nodes[index];
+    if (node->size > size)
+    {
+        const uint32_t remainder = node->size - size;
+        node->size = size;
+        insert_free_block(self, alignedOffset + size, remainder, index, node->neighborNext);
+    }
+
+    node = &self->nodes[index];
+    node->state = HEAP_NODE_USED;
+    node->alignment = alignment;
+    self->allocationCount++;
+
+    return index;
+}
+
+static void heap_free(PyBufferHeap *self, uint32_t index)
+{
+    HeapNode *node = &self->nodes[index];
+    self->allocationCount--;
+
+    const uint32_t prev = node->neighborPrev;
+    if (prev != BUFFER_HEAP_NONE && self->nodes[prev].state == HEAP_NODE_FREE)
+    {
+        bin_remove(self, prev);
+
+        node->offset = self->nodes[prev].offset;
+        node->size += self->nodes[prev].size;
+        node->neighborPrev = self->nodes[prev].neighborPrev;
+        if (node->neighborPrev != BUFFER_HEAP_NONE)
+            self->nodes[node->neighborPrev].neighborNext = index;
+
+        node_release(self, prev);
+    }
+
+    const uint32_t next = node->neighborNext;
+    if (next != BUFFER_HEAP_NONE && self->nodes[next].state == HEAP_NODE_FREE)
+    {
+        bin_remove(self, next);
+
+        node->size += self->nodes[next].size;
+        node->neighborNext = self->nodes[next].neighborNext;
+        if (node->neighborNext != BUFFER_HEAP_NONE)
+            self->nodes[node->neighborNext].neighborPrev = index;
+
+        node_release(self, next);
+    }
+
+    bin_insert(self, index);
+}
+
+// Moves `size` bytes within the heap buffer to lower offset. Overlapping copies are split into chunks no
+// bigger than the move distance, as GL doesn't allow copying between overlapping ranges.
+static void move_range(PyBufferHeap *self, uint32_t src, uint32_t dst, uint32_t size)
+{
+    const uint32_t distance = src - dst;
+    for (uint32_t done = 0; done < size; done += distance)
+    {
+        const uint32_t chunk = size - done < distance ? size - done : distance;
+        glCopyNamedBufferSubData(self->buffer->id, self->buffer->id, src + done, dst + done, chunk);
+    }
+
+    // client side copy of dynamic storage buffer has to stay in sync with GPU memory
+    if (py_buffer_has_client_storage(self->buffer) && self->buffer->dataPtr != NULL)
+        memmove((char *)self->buffer->dataPtr + dst, (char *)self->buffer->dataPtr + src, size);
+}
+
+static uint32_t get_capacity(PyBufferHeap *self)
+{
+    return (uint32_t)(self->buffer->size / self->alignment * self->alignment);
+}
+
+static PyHeapAllocation *get_allocation(PyBufferHeap *self, PyObject *obj)
+{
+    if (!PyObject_TypeCheck(obj, &pyHeapAllocationType))
+    {
+        PyErr_Format(PyExc_TypeError, "Expected argument to be of type pygl.buffers.HeapAllocation, got: %s.", Py_TYPE(obj)->tp_name);
+        return NULL;
+    }
+
+    PyHeapAllocation *allocation = (PyHeapAllocation *)obj;
+    THROW_IF(allocation->heap != self, PyExc_ValueError, "Allocation doesn't belong to this heap.", NULL);
+    THROW_IF(allocation->node == BUFFER_HEAP_NONE, PyExc_RuntimeError, "Allocation was already freed.", NULL);
+
+    return allocation;
+}
+
+static PyObject *allocate(PyBufferHeap *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"size", "alignment", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values))
+        return NULL;
+
+    const Py_ssize_t size = PyLong_AsSsize_t(values[0]);
+    if (size == -1 && PyErr_Occurred())
+        return NULL;
+
+    Py_ssize_t alignment = self->alignment;
+    if (values[1] != NULL && !Py_IsNone(values[1]))
+    {
+        alignment = PyLong_AsSsize_t(values[1]);
+        if (alignment == -1 && PyErr_Occurred())
+            return NULL;
+    }
+
+    THROW_IF(size <= 0, PyExc_ValueError, "Allocation size has to be greater than 0.", NULL);
+    THROW_IF(alignment <= 0, PyExc_ValueError, "Alignment has to be greater than 0.", NULL);
+
+    // all blocks start at multiple of heap alignment, so allocation is aligned to both of them
+    const uint64_t effectiveAlignment = (uint64_t)alignment / gcd(alignment, self->alignment) * self->alignment;
+    const uint64_t alignedSize = ((uint64_t)size + self->alignment - 1) / self->alignment * self->alignment;
+    if (alignedSize + effectiveAlignment > get_capacity(self) + (uint64_t)self->alignment)
+    {
+        PyErr_Format(PyExc_ValueError, "Allocation of %zd bytes doesn't fit in the heap.", size);
+        return NULL;
+    }
+
+    PyHeapAllocation *allocation = PyObject_New(PyHeapAllocation, &pyHeapAllocationType);
+    if (allocation == NULL)
+        return NULL;
+
+    allocation->heap = (PyBufferHeap *)Py_NewRef(self);
+    allocation->node = BUFFER_HEAP_NONE;
+
+    if (!node_reserve(self, 2))
+    {
+        Py_DECREF(allocation);
+        return NULL;
+    }
+
+    allocation->node = heap_allocate(self, (uint32_t)alignedSize, (uint32_t)effectiveAlignment);
+    if (allocation->node == BUFFER_HEAP_NONE)
+    {
+        PyErr_Format(
+            PyExc_RuntimeError,
+            "Not enough contiguous space in the heap to allocate %zd bytes (free: %u). Defragment the heap or use bigger one.",
+            size,
+            self->freeSize);
+        Py_DECREF(allocation);
+        return NULL;
+    }
+
+    return (PyObject *)allocation;
+}
+
+static PyObject *py_buffer_heap_free(PyBufferHeap *self, PyObject *obj)
+{
+    PyHeapAllocation *allocation = get_allocation(self, obj);
+    if (allocation == NULL)
+        return NULL;
+
+    heap_free(self, allocation->node);
+    allocation->node = BUFFER_HEAP_NONE;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *store(PyBufferHeap *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"allocation", "data", "offset", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values))
+        return NULL;
+
+    PyHeapAllocation *allocation = get_allocation(self, values[0]);
+    if (allocation == NULL)
+        return NULL;
+
+    Py_ssize_t offset = 0;
+    if (values[2] != NULL)
+    {
+        offset = PyLong_AsSsize_t(values[2]);
+        if (offset == -1 && PyErr_Occurred())
+            return NULL;
+    }
+
+    const HeapNode *node = &self->nodes[allocation->node];
+    THROW_IF(
+        offset < 0 || offset > (Py_ssize_t)node->size,
+        PyExc_ValueError,
+        "Offset has to point inside the allocation.",
+        NULL);
+
+    PyBuffer *buffer = self->buffer;
+    THROW_IF(
+        buffer->dataPtr == NULL,
+        PyExc_RuntimeError,
+        "Non-persistent heap buffer has to be mapped prior to storing data.",
+        NULL);
+
+    const Py_ssize_t start = (Py_ssize_t)node->offset + offset;
+
+    // pinning also prevents defragmentation from moving the allocation while the GIL is released
+    py_buffer_pin(buffer);
+    const Py_ssize_t size = py_buffer_store_object(values[1], (char *)buffer->dataPtr + start, node->size - offset, !py_buffer_has_client_storage(buffer));
+    if (size == -1)
+    {
+        py_buffer_unpin(buffer);
+        return NULL;
+    }
+
+    // allocations are written in random order, so data is uploaded right away instead of on transfer
+    if (py_buffer_has_client_storage(buffer))
+    {
+        PyThreadState *threadState = utils_begin_allow_threads(size >= UTILS_ALLOW_THREADS_THRESHOLD);
+        glNamedBufferSubData(buffer->id, start, size, (char *)buffer->dataPtr + start);
+        utils_end_allow_threads(threadState);
+    }
+    else
+        py_buffer_mark_dirty(buffer, start, size);
+
+    py_buffer_unpin(buffer);
+
+    return PyLong_FromSsize_t(size);
+}
+
+static PyObject *defragment(PyBufferHeap *self, PyObject *Py_UNUSED(args))
+{
+    PyBuffer *buffer = self->buffer;
+    THROW_IF(
+        buffer->exportCount != 0,
+        PyExc_BufferError,
+        "Heap cannot be defragmented while its buffer memory is exported.",
+        NULL);
+
+    // GL doesn't allow copying within a buffer which is mapped without MAP_PERSISTENT_BIT
+    THROW_IF(
+        buffer->dataPtr != NULL && !buffer->isPersistent && !py_buffer_has_client_storage(buffer),
+        PyExc_BufferError,
+        "Heap cannot be defragmented while its buffer is mapped. Call transfer first.",
+        NULL);
+
+    // data written through the mapping has to reach GPU memory before it's copied
+    if (FLAG_IS_SET(buffer->flags, GL_MAP_FLUSH_EXPLICIT_BIT) && buffer->dataPtr != NULL)
+        py_buffer_flush_mapped_ranges(buffer);
+
+    // every used block may need padding block in front of it and there may be one trailing free block
+    if (!node_reserve(self, self->allocationCount + 1))
+        return NULL;
+
+    uint32_t index = BUFFER_HEAP_NONE;
+    for (uint32_t i = 0; i < self->nodeCount; i++)
+    {
+        if (self->nodes[i].state != HEAP_NODE_DEAD && self->nodes[i].neighborPrev == BUFFER_HEAP_NONE)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    uint64_t movedSize = 0;
+    uint32_t cursor = 0;
+    uint32_t last = BUFFER_HEAP_NONE;
+
+    // consecutive blocks moved by the same distance are copied at once
+    uint32_t runSrc = 0, runDst = 0, runSize = 0;
+
+    while (index != BUFFER_HEAP_NONE)
+    {
+        const uint32_t next = self->nodes[index].neighborNext;
+
+        if (self->nodes[index].state == HEAP_NODE_FREE)
+        {
+            bin_remove(self, index);
+            node_release(self, index);
+            index = next;
+            continue;
+        }
+
+        HeapNode *node = &self->nodes[index];
+        const uint32_t newOffset = (cursor + node->alignment - 1) / node->alignment * node->alignment;
+        if (newOffset != node->offset)
+        {
+            if (runSize != 0 && runSrc + runSize == node->offset && runDst + runSize == newOffset)
+                runSize += node->size;
+            else
+            {
+                if (runSize != 0)
+                    move_range(self, runSrc, runDst, runSize);
+
+                runSrc = node->offset;
+                runDst = newOffset;
+                runSize = node->size;
+            }
+
+            movedSize += node->size;
+            node->offset = newOffset;
+        }
+
+        node->neighborPrev = last;
+        if (last != BUFFER_HEAP_NONE)
+            self->nodes[last].neighborNext = index;
+
+        if (newOffset != cursor)
+            insert_free_block(self, cursor, newOffset - cursor, last, index);
+
+        cursor = newOffset + self->nodes[index].size;
+        last = index;
+        index = next;
+    }
+
+    if (runSize != 0)
+        move_range(self, runSrc, runDst, runSize);
+
+    const uint32_t capacity = get_capacity(self);
+    if (last != BUFFER_HEAP_NONE)
+        self->nodes[last].neighborNext = BUFFER_HEAP_NONE;
+
+    if (cursor != capacity)
+        insert_free_block(self, cursor, capacity - cursor, last, BUFFER_HEAP_NONE);
+
+    return PyLong_FromUnsignedLongLong(movedSize);
+}
+
+static uint32_t get_largest_free_block(PyBufferHeap *self)
+{
+    if (self->usedBinsTop == 0)
+        return 0;
+
+    const uint32_t top = highest_bit(self->usedBinsTop);
+    const uint32_t bin = (top << BUFFER_HEAP_MANTISSA_BITS) | highest_bit(self->usedBins[top]);
+
+    uint32_t largest = 0;
+    for (uint32_t i = self->binHeads[bin]; i != BUFFER_HEAP_NONE; i = self->nodes[i].binNext)
+    {
+        if (self->nodes[i].size > largest)
+            largest = self->nodes[i].size;
+    }
+
+    return largest;
+}
+
+static PyObject *get_stats(PyBufferHeap *self, PyObject *Py_UNUSED(args))
+{
+    const uint32_t capacity = get_capacity(self);
+    const uint32_t largestFreeBlock = get_largest_free_block(self);
+
+    // 0 when all free space is in one block, approaching 1 when it's split into many small ones
+    const double fragmentation = self->freeSize ? 1.0 - (double)largestFreeBlock / self->freeSize : 0.0;
+
+    return Py_BuildValue(
+        "{sIsIsIsIsIsIsd}",
+        "size", capacity,
+        "used", capacity - self->freeSize,
+        "free", self->freeSize,
+        "largest_free_block", largestFreeBlock,
+        "free_blocks", self->freeBlockCount,
+        "allocations", self->allocationCount,
+        "fragmentation", fragmentation);
+}
+
+static PyObject *get_buffer(PyBufferHeap *self, void *Py_UNUSED(closure))
+{
+    return Py_NewRef(self->buffer);
+}
+
+static PyObject *get_size(PyBufferHeap *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(get_capacity(self));
+}
+
+static PyObject *repr(PyBufferHeap *self)
+{
+    return PyUnicode_FromFormat(
+        "<object %s (size: %u, free: %u, allocations: %u) at %p>",
+        Py_TYPE(self)->tp_name,
+        get_capacity(self),
+        self->freeSize,
+        self->allocationCount,
+        self);
+}
+
+static void dealloc(PyBufferHeap *self)
+{
+    PyMem_Free(self->nodes);
+    Py_XDECREF(self->buffer);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int init(PyBufferHeap *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"size", "flags", "alignment", NULL};
+
+    Py_ssize_t size = 0;
+    GLenum flags = GL_DYNAMIC_STORAGE_BIT;
+    Py_ssize_t alignment = BUFFER_HEAP_DEFAULT_ALIGNMENT;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|In", kwNames, &size, &flags, &alignment))
+        return -1;
+
+    THROW_IF(self->buffer != NULL, PyExc_RuntimeError, "Buffer heap is already initialized.", -1);
+    THROW_IF(alignment <= 0 || alignment > UINT16_MAX, PyExc_ValueError, "Alignment has to be in range [1, 65535].", -1);
+    THROW_IF(
+        size < alignment || size > UINT32_MAX,
+        PyExc_ValueError,
+        "Heap size has to be at least equal to alignment and smaller than 4GB.",
+        -1);
+
+    self->buffer = (PyBuffer *)PyObject_CallFunction((PyObject *)&pyBufferType, "nI", size, flags);
+    if (self->buffer == NULL)
+        return -1;
+
+    self->alignment = (uint32_t)alignment;
+    self->deadHead = BUFFER_HEAP_NONE;
+    memset(self->binHeads, 0xff, sizeof(self->binHeads));
+
+    if (!node_reserve(self, 1))
+        return -1;
+
+    insert_free_block(self, 0, get_capacity(self), BUFFER_HEAP_NONE, BUFFER_HEAP_NONE);
+
+    return 0;
+}
+
+PyTypeObject pyBufferHeapType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_new = PyType_GenericNew,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.buffers.BufferHeap",
+    .tp_basicsize = sizeof(PyBufferHeap),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_members = (PyMemberDef[]){
+        {"alignment", T_UINT, offsetof(PyBufferHeap, alignment), READONLY, NULL},
+        {0}},
+    .tp_getset = (PyGetSetDef[]){
+        {"buffer", (getter)get_buffer, NULL, NULL, NULL},
+        {"size", (getter)get_size, NULL, NULL, NULL},
+        {0}},
+    .tp_methods = (PyMethodDef[]){
+        {"allocate", (PyCFunction)allocate, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"free", (PyCFunction)py_buffer_heap_free, METH_O, NULL},
+        {"store", (PyCFunction)store, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"defragment", (PyCFunction)defragment, METH_NOARGS, NULL},
+        {"get_stats", (PyCFunction)get_stats, METH_NOARGS, NULL},
+        {0},
+    },
+};
+
+static const HeapNode *get_allocation_node(PyHeapAllocation *self)
+{
+    THROW_IF(self->node == BUFFER_HEAP_NONE, PyExc_RuntimeError, "Allocation was already freed.", NULL);
+    return &self->heap->nodes[self->node];
+}
+
+static PyObject *allocation_get_offset(PyHeapAllocation *self, void *Py_UNUSED(closure))
+{
+    const HeapNode *node = get_allocation_node(self);
+    return node ? PyLong_FromUnsignedLong(node->offset) : NULL;
+}
+
+static PyObject *allocation_get_size(PyHeapAllocation *self, void *Py_UNUSED(closure))
+{
+    const HeapNode *node = get_allocation_node(self);
+    return node ? PyLong_FromUnsignedLong(node->size) : NULL;
+}
+
+static PyObject *allocation_get_is_freed(PyHeapAllocation *self, void *Py_UNUSED(closure))
+{
+    return PyBool_FromLong(self->node == BUFFER_HEAP_NONE);
+}
+
+static PyObject *allocation_free(PyHeapAllocation *self, PyObject *Py_UNUSED(args))
+{
+    return py_buffer_heap_free(self->heap, (PyObject *)self);
+}
+
+static PyObject *allocation_index(PyHeapAllocation *self, PyObject *strideObj)
+{
+    const HeapNode *node = get_allocation_node(self);
+    if (node == NULL)
+        return NULL;
+
+    const Py_ssize_t stride = PyLong_AsSsize_t(strideObj);
+    if (stride == -1 && PyErr_Occurred())
+        return NULL;
+
+    THROW_IF(stride <= 0, PyExc_ValueError, "Stride has to be greater than 0.", NULL);
+    if (node->offset % stride != 0)
+    {
+        PyErr_Format(PyExc_ValueError, "Allocation offset %u is not a multiple of stride %zd. Allocate it with alignment equal to stride.", node->offset, stride);
+        return NULL;
+    }
+
+    return PyLong_FromSsize_t(node->offset / stride);
+}
+
+static PyObject *allocation_repr(PyHeapAllocation *self)
+{
+    if (self->node == BUFFER_HEAP_NONE)
+        return PyUnicode_FromFormat("<object %s (freed) at %p>", Py_TYPE(self)->tp_name, self);
+
+    const HeapNode *node = &self->heap->nodes[self->node];
+    return PyUnicode_FromFormat(
+        "<object %s (offset: %u, size: %u) at %p>",
+        Py_TYPE(self)->tp_name,
+        node->offset,
+        node->size,
+        self);
+}
+
+static void allocation_dealloc(PyHeapAllocation *self)
+{
+    if (self->node != BUFFER_HEAP_NONE)
+        heap_free(self->heap, self->node);
+
+    Py_DECREF(self->heap);
+    PyObject_Free(self);
+}
+
+PyTypeObject pyHeapAllocationType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.buffers.HeapAllocation",
+    .tp_basicsize = sizeof(PyHeapAllocation),
+    .tp_dealloc = (destructor)allocation_dealloc,
+    .tp_repr = (reprfunc)allocation_repr,
+    .tp_getset = (PyGetSetDef[]){
+        {"offset", (getter)allocation_get_offset, NULL, NULL, NULL},
+        {"size", (getter)allocation_get_size, NULL, NULL, NULL},
+        {"is_freed", (getter)allocation_get_is_freed, NULL, NULL, NULL},
+        {0}},
+    .tp_methods = (PyMethodDef[]){
+        {"free", (PyCFunction)allocation_free, METH_NOARGS, NULL},
+        {"index", (PyCFunction)allocation_index, METH_O, NULL},
+        {0},
+    },
+};
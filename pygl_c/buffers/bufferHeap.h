@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+#include "buffer.h"
+
+// Free blocks are kept in segregated lists (TLSF), indexed by sizes encoded as 8 bit floats with 3 bit mantissa.
+#define BUFFER_HEAP_MANTISSA_BITS 3
+#define BUFFER_HEAP_TOP_BIN_COUNT 32
+#define BUFFER_HEAP_LEAF_BIN_COUNT (1 << BUFFER_HEAP_MANTISSA_BITS)
+#define BUFFER_HEAP_BIN_COUNT (BUFFER_HEAP_TOP_BIN_COUNT * BUFFER_HEAP_LEAF_BIN_COUNT)
+#define BUFFER_HEAP_DEFAULT_ALIGNMENT 16
+#define BUFFER_HEAP_NONE UINT32_MAX
+
+typedef enum
+{
+    HEAP_NODE_DEAD,
+    HEAP_NODE_FREE,
+    HEAP_NODE_USED,
+} HeapNodeState;
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t size;
+    // effective alignment of the allocation, used to place it again during defragmentation
+    uint32_t alignment;
+    // links of the free list in which the block is stored, dead nodes are chained through `binNext`
+    uint32_t binPrev, binNext;
+    // blocks directly before and after this one in the buffer
+    uint32_t neighborPrev, neighborNext;
+    uint8_t state;
+} HeapNode;
+
+typedef struct
+{
+    PyObject_HEAD
+    PyBuffer *buffer;
+    HeapNode *nodes;
+    uint32_t nodeCount, nodeCapacity;
+    uint32_t deadHead;
+    uint32_t alignment;
+    uint32_t usedBinsTop;
+    uint8_t usedBins[BUFFER_HEAP_TOP_BIN_COUNT];
+    uint32_t binHeads[BUFFER_HEAP_BIN_COUNT];
+    uint32_t freeSize;
+    uint32_t freeBlockCount;
+    uint32_t allocationCount;
+} PyBufferHeap;
+
+// Handle of a block allocated from `heap`. Offset and size are read from the heap so they stay valid after
+// defragmentation. Block is returned to the heap when the handle is freed or garbage collected.
+typedef struct
+{
+    PyObject_HEAD
+    PyBufferHeap *heap;
+    uint32_t node;
+} PyHeapAllocation;
+
+extern PyTypeObject pyBufferHeapType;
+extern PyTypeObject pyHeapAllocationType;
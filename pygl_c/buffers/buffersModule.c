@@ -1,5 +1,11 @@
 #include "buffer.h"
+#include "streamBuffer.h"
+#include "bufferHeap.h"
+#include "recordLayout.h"
+#include "readbackFuture.h"
+#include "../copyEngine.h"
 #include "../module.h"
+#include "../utility.h"
 
 static EnumDef bufferFlagsEnum = {
     .enumName = "BufferFlags",
@@ -8,6 +14,7 @@ static EnumDef bufferFlagsEnum = {
         {"MAP_READ_BIT", GL_MAP_READ_BIT},
         {"MAP_PERSISTENT_BIT", GL_MAP_PERSISTENT_BIT},
         {"MAP_COHERENT_BIT", GL_MAP_COHERENT_BIT},
+        {"MAP_FLUSH_EXPLICIT_BIT", GL_MAP_FLUSH_EXPLICIT_BIT},
         {"DYNAMIC_STORAGE_BIT", GL_DYNAMIC_STORAGE_BIT},
         {"NONE", 0},
         {0},
@@ -47,20 +54,92 @@ static EnumDef bindTargetEnum = {
     },
 };
 
+static EnumDef fieldTypeEnum = {
+    .enumName = "FieldType",
+    .values = (EnumValue[]){
+        {"FLOAT", FIELD_TYPE_FLOAT},
+        {"FLOAT2", FIELD_TYPE_FLOAT2},
+        {"FLOAT3", FIELD_TYPE_FLOAT3},
+        {"FLOAT4", FIELD_TYPE_FLOAT4},
+        {"INT", FIELD_TYPE_INT},
+        {"INT2", FIELD_TYPE_INT2},
+        {"INT3", FIELD_TYPE_INT3},
+        {"INT4", FIELD_TYPE_INT4},
+        {"UINT", FIELD_TYPE_UINT},
+        {"UINT2", FIELD_TYPE_UINT2},
+        {"UINT3", FIELD_TYPE_UINT3},
+        {"UINT4", FIELD_TYPE_UINT4},
+        {"HALF2", FIELD_TYPE_HALF2},
+        {"HALF4", FIELD_TYPE_HALF4},
+        {"BYTE4N", FIELD_TYPE_BYTE4N},
+        {"UBYTE4", FIELD_TYPE_UBYTE4},
+        {"UBYTE4N", FIELD_TYPE_UBYTE4N},
+        {"SHORT2N", FIELD_TYPE_SHORT2N},
+        {"SHORT4N", FIELD_TYPE_SHORT4N},
+        {"USHORT2N", FIELD_TYPE_USHORT2N},
+        {"USHORT4N", FIELD_TYPE_USHORT4N},
+        {"INT_2_10_10_10_REV", FIELD_TYPE_INT_2_10_10_10_REV},
+        {"MAT3", FIELD_TYPE_MAT3},
+        {"MAT4", FIELD_TYPE_MAT4},
+        {0},
+    },
+};
+
+static EnumDef layoutRuleEnum = {
+    .enumName = "LayoutRule",
+    .values = (EnumValue[]){
+        {"PACKED", LAYOUT_RULE_PACKED},
+        {"STD140", LAYOUT_RULE_STD140},
+        {"STD430", LAYOUT_RULE_STD430},
+        {0},
+    },
+};
+
+static PyObject *set_parallel_copy_threshold(PyObject *Py_UNUSED(self), PyObject *threshold)
+{
+    const Py_ssize_t value = PyLong_AsSsize_t(threshold);
+    if (value == -1 && PyErr_Occurred())
+        return NULL;
+
+    THROW_IF(value < 0, PyExc_ValueError, "Parallel copy threshold cannot be negative.", NULL);
+
+    copy_engine_set_parallel_threshold((size_t)value);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *get_parallel_copy_threshold(PyObject *Py_UNUSED(self), PyObject *Py_UNUSED(args))
+{
+    return PyLong_FromSize_t(copy_engine_get_parallel_threshold());
+}
+
 static ModuleInfo modInfo = {
     .def = {
         PyModuleDef_HEAD_INIT,
         .m_name = "pygl.buffers",
         .m_size = -1,
+        .m_methods = (PyMethodDef[]){
+            {"set_parallel_copy_threshold", (PyCFunction)set_parallel_copy_threshold, METH_O, NULL},
+            {"get_parallel_copy_threshold", (PyCFunction)get_parallel_copy_threshold, METH_NOARGS, NULL},
+            {0},
+        },
     },
     .enums = (EnumDef *[]){
         &bindTargetEnum,
         &bufferBaseEnum,
         &bufferFlagsEnum,
+        &fieldTypeEnum,
+        &layoutRuleEnum,
         NULL,
     },
     .types = (PyTypeObject *[]){
         &pyBufferType,
+        &pyBufferRangeType,
+        &pyStreamBufferType,
+        &pyBufferHeapType,
+        &pyHeapAllocationType,
+        &pyRecordLayoutType,
+        &pyReadbackFutureType,
         NULL,
     },
 };
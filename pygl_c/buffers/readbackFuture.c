@@ -0,0 +1,188 @@
+#include "readbackFuture.h"
+#include <structmember.h>
+#include "../sync.h"
+#include "../utility.h"
+
+#define READBACK_WAIT_TIMEOUT_NS 1000000
+#define STAGING_FLAGS (GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+static StagingBuffer stagingPool[READBACK_STAGING_POOL_SIZE];
+static int stagingPoolCount;
+
+static bool acquire_staging(GLsizeiptr size, StagingBuffer *out)
+{
+    // reuse the smallest pooled buffer that fits
+    int best = -1;
+    for (int i = 0; i < stagingPoolCount; i++)
+    {
+        if (stagingPool[i].size >= size && (best == -1 || stagingPool[i].size < stagingPool[best].size))
+            best = i;
+    }
+
+    if (best != -1)
+    {
+        *out = stagingPool[best];
+        stagingPool[best] = stagingPool[--stagingPoolCount];
+        return true;
+    }
+
+    // round up to power of two, so buffers can be reused for reads of slightly varying size
+    GLsizeiptr capacity = READBACK_MIN_STAGING_SIZE;
+    while (capacity < size)
+        capacity <<= 1;
+
+    glCreateBuffers(1, &out->id);
+    glNamedBufferStorage(out->id, capacity, NULL, STAGING_FLAGS);
+
+    out->dataPtr = glMapNamedBufferRange(out->id, 0, capacity, STAGING_FLAGS);
+    if (out->dataPtr == NULL)
+    {
+        PyErr_Format(PyExc_RuntimeError, "Couldn't map readback staging buffer: %d.", glGetError());
+        glDeleteBuffers(1, &out->id);
+        out->id = 0;
+        return false;
+    }
+
+    out->size = capacity;
+
+    return true;
+}
+
+static void release_staging(StagingBuffer *staging)
+{
+    if (staging->id == 0)
+        return;
+
+    // GL executes commands in order, so the buffer can be reused even if the copy into it hasn't finished yet
+    if (stagingPoolCount < READBACK_STAGING_POOL_SIZE)
+        stagingPool[stagingPoolCount++] = *staging;
+    else
+    {
+        glUnmapNamedBuffer(staging->id);
+        glDeleteBuffers(1, &staging->id);
+    }
+
+    *staging = (StagingBuffer){0};
+}
+
+PyReadbackFuture *py_readback_future_create(GLuint sourceId, GLintptr offset, GLsizeiptr size)
+{
+    PyReadbackFuture *future = PyObject_New(PyReadbackFuture, &pyReadbackFutureType);
+    if (future == NULL)
+        return NULL;
+
+    future->staging = (StagingBuffer){0};
+    future->fence = NULL;
+    future->offset = offset;
+    future->size = size;
+
+    if (!acquire_staging(size, &future->staging))
+    {
+        Py_DECREF(future);
+        return NULL;
+    }
+
+    glCopyNamedBufferSubData(sourceId, future->staging.id, offset, 0, size);
+    future->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    return future;
+}
+
+static bool wait_for_copy(PyReadbackFuture *self, bool block)
+{
+    if (self->fence == NULL)
+        return true;
+
+    GLenum waitState = glClientWaitSync(self->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (block && !SYNC_SIGNALED(waitState))
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        do
+        {
+            waitState = glClientWaitSync(self->fence, 0, READBACK_WAIT_TIMEOUT_NS);
+        } while (waitState == GL_TIMEOUT_EXPIRED);
+        Py_END_ALLOW_THREADS;
+    }
+
+    THROW_IF(
+        waitState == GL_WAIT_FAILED,
+        PyExc_RuntimeError,
+        "Failed to wait for buffer readback.",
+        false);
+
+    if (!SYNC_SIGNALED(waitState))
+        return false;
+
+    glDeleteSync(self->fence);
+    self->fence = NULL;
+
+    return true;
+}
+
+static PyObject *ready(PyReadbackFuture *self, PyObject *Py_UNUSED(args))
+{
+    const bool isReady = wait_for_copy(self, false);
+    if (PyErr_Occurred())
+        return NULL;
+
+    return PyBool_FromLong(isReady);
+}
+
+static PyObject *result(PyReadbackFuture *self, PyObject *Py_UNUSED(args))
+{
+    if (!wait_for_copy(self, true))
+        return NULL;
+
+    return PyMemoryView_FromObject((PyObject *)self);
+}
+
+static int get_buffer(PyReadbackFuture *self, Py_buffer *view, int flags)
+{
+    if (self->fence != NULL)
+    {
+        PyErr_SetString(PyExc_BufferError, "Readback is not finished yet. Use result() to wait for it.");
+        view->obj = NULL;
+        return -1;
+    }
+
+    return PyBuffer_FillInfo(view, (PyObject *)self, self->staging.dataPtr, self->size, 1, flags);
+}
+
+static PyObject *repr(PyReadbackFuture *self)
+{
+    return PyUnicode_FromFormat(
+        "<object %s (offset: %zd, size: %zd, ready: %s) at %p>",
+        Py_TYPE(self)->tp_name,
+        (Py_ssize_t)self->offset,
+        (Py_ssize_t)self->size,
+        self->fence == NULL ? "True" : "False",
+        self);
+}
+
+static void dealloc(PyReadbackFuture *self)
+{
+    glDeleteSync(self->fence);
+    release_staging(&self->staging);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyTypeObject pyReadbackFutureType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.buffers.ReadbackFuture",
+    .tp_basicsize = sizeof(PyReadbackFuture),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_methods = (PyMethodDef[]){
+        {"ready", (PyCFunction)ready, METH_NOARGS, NULL},
+        {"result", (PyCFunction)result, METH_NOARGS, NULL},
+        {0}},
+    .tp_members = (PyMemberDef[]){
+        {"offset", T_PYSSIZET, offsetof(PyReadbackFuture, offset), READONLY, NULL},
+        {"size", T_PYSSIZET, offsetof(PyReadbackFuture, size), READONLY, NULL},
+        {0}},
+    .tp_as_buffer = &(PyBufferProcs){
+        .bf_getbuffer = (getbufferproc)get_buffer,
+    },
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include "../gl.h"
+
+// Staging buffers of finished futures are kept for reuse, so reading back every frame doesn't create new buffers.
+#define READBACK_STAGING_POOL_SIZE 8
+#define READBACK_MIN_STAGING_SIZE 4096
+
+typedef struct
+{
+    GLuint id;
+    void *dataPtr;
+    GLsizeiptr size;
+} StagingBuffer;
+
+// Result of asynchronous buffer read. Data is copied on GPU into a persistently mapped staging buffer
+// and becomes available once the fence placed after the copy is signaled.
+typedef struct
+{
+    PyObject_HEAD
+    StagingBuffer staging;
+    // NULL once the copy is known to be finished
+    GLsync fence;
+    GLintptr offset;
+    GLsizeiptr size;
+} PyReadbackFuture;
+
+extern PyTypeObject pyReadbackFutureType;
+
+// Copies `size` bytes at `offset` of buffer `sourceId` into a staging buffer and returns a future for the data.
+PyReadbackFuture *py_readback_future_create(GLuint sourceId, GLintptr offset, GLsizeiptr size);
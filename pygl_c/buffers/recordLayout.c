@@ -0,0 +1,673 @@
+#include "recordLayout.h"
+#include <structmember.h>
+#include "buffer.h"
+#include "../utility.h"
+#include "../math/packing.h"
+#include "../math/matrix/matrix.h"
+#include "../math/vector/vector.h"
+#include "../math/quaternion.h"
+#include "../vertexArray/vertexDescriptor.h"
+#include "../vertexArray/vertexInput.h"
+
+#define STD_BLOCK_ALIGNMENT 16
+
+typedef struct
+{
+    GLenum glType;
+    uint8_t components; // per column
+    uint8_t columns;
+    uint8_t componentSize;
+    bool isNormalized;
+    // values are read as Python ints instead of floats
+    bool isInteger;
+} FieldTypeInfo;
+
+static const FieldTypeInfo fieldTypeInfos[FIELD_TYPE_COUNT] = {
+    [FIELD_TYPE_FLOAT] = {GL_FLOAT, 1, 1, 4, false, false},
+    [FIELD_TYPE_FLOAT2] = {GL_FLOAT, 2, 1, 4, false, false},
+    [FIELD_TYPE_FLOAT3] = {GL_FLOAT, 3, 1, 4, false, false},
+    [FIELD_TYPE_FLOAT4] = {GL_FLOAT, 4, 1, 4, false, false},
+    [FIELD_TYPE_INT] = {GL_INT, 1, 1, 4, false, true},
+    [FIELD_TYPE_INT2] = {GL_INT, 2, 1, 4, false, true},
+    [FIELD_TYPE_INT3] = {GL_INT, 3, 1, 4, false, true},
+    [FIELD_TYPE_INT4] = {GL_INT, 4, 1, 4, false, true},
+    [FIELD_TYPE_UINT] = {GL_UNSIGNED_INT, 1, 1, 4, false, true},
+    [FIELD_TYPE_UINT2] = {GL_UNSIGNED_INT, 2, 1, 4, false, true},
+    [FIELD_TYPE_UINT3] = {GL_UNSIGNED_INT, 3, 1, 4, false, true},
+    [FIELD_TYPE_UINT4] = {GL_UNSIGNED_INT, 4, 1, 4, false, true},
+    [FIELD_TYPE_HALF2] = {GL_HALF_FLOAT, 2, 1, 2, false, false},
+    [FIELD_TYPE_HALF4] = {GL_HALF_FLOAT, 4, 1, 2, false, false},
+    [FIELD_TYPE_BYTE4N] = {GL_BYTE, 4, 1, 1, true, false},
+    [FIELD_TYPE_UBYTE4] = {GL_UNSIGNED_BYTE, 4, 1, 1, false, true},
+    [FIELD_TYPE_UBYTE4N] = {GL_UNSIGNED_BYTE, 4, 1, 1, true, false},
+    [FIELD_TYPE_SHORT2N] = {GL_SHORT, 2, 1, 2, true, false},
+    [FIELD_TYPE_SHORT4N] = {GL_SHORT, 4, 1, 2, true, false},
+    [FIELD_TYPE_USHORT2N] = {GL_UNSIGNED_SHORT, 2, 1, 2, true, false},
+    [FIELD_TYPE_USHORT4N] = {GL_UNSIGNED_SHORT, 4, 1, 2, true, false},
+    [FIELD_TYPE_INT_2_10_10_10_REV] = {GL_INT_2_10_10_10_REV, 4, 1, 1, true, false},
+    [FIELD_TYPE_MAT3] = {GL_FLOAT, 3, 3, 4, false, false},
+    [FIELD_TYPE_MAT4] = {GL_FLOAT, 4, 4, 4, false, false},
+};
+
+static uint32_t get_column_size(const FieldTypeInfo *info)
+{
+    // all components of packed formats share a single 32-bit word
+    if (info->glType == GL_INT_2_10_10_10_REV)
+        return sizeof(GLuint);
+
+    return info->components * info->componentSize;
+}
+
+static uint32_t align_up(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool compile_layout(PyRecordLayout *self, PyObject *fields)
+{
+    PyObject *sequence = PySequence_Fast(fields, "Expected fields to be a sequence of (name, FieldType) tuples.");
+    if (sequence == NULL)
+        return false;
+
+    bool result = false;
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(sequence);
+    PyObject **items = PySequence_Fast_ITEMS(sequence);
+
+    THROW_IF_GOTO(count == 0, PyExc_ValueError, "Record layout has to have at least one field.", end);
+
+    self->fields = PyMem_Calloc(count, sizeof(RecordField));
+    self->names = PyTuple_New(count);
+    if (self->fields == NULL || self->names == NULL)
+    {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    self->fieldCount = count;
+
+    uint32_t cursor = 0;
+    uint32_t maxAlignment = 1;
+    uint32_t coveredSize = 0;
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        PyObject *name = NULL;
+        int type = 0;
+        THROW_IF_GOTO(
+            !PyTuple_Check(items[i]) || !PyArg_ParseTuple(items[i], "Ui", &name, &type),
+            PyExc_TypeError,
+            "Expected every field to be a (name, FieldType) tuple.",
+            end);
+
+        THROW_IF_GOTO(type < 0 || type >= FIELD_TYPE_COUNT, PyExc_ValueError, "Invalid field type.", end);
+
+        for (Py_ssize_t j = 0; j < i; j++)
+        {
+            if (PyUnicode_Compare(PyTuple_GET_ITEM(self->names, j), name) == 0)
+            {
+                PyErr_Format(PyExc_ValueError, "Duplicated field name: %U.", name);
+                goto end;
+            }
+        }
+
+        const FieldTypeInfo *info = &fieldTypeInfos[type];
+        const uint32_t columnSize = get_column_size(info);
+        uint32_t alignment = 1;
+        uint32_t columnStride = columnSize;
+
+        if (self->rule != LAYOUT_RULE_PACKED)
+        {
+            if (info->componentSize != 4 || info->glType == GL_INT_2_10_10_10_REV)
+            {
+                PyErr_Format(PyExc_ValueError, "Field %U: std140 and std430 layouts support only 32-bit component types.", name);
+                goto end;
+            }
+
+            // vec3 is aligned the same as vec4, matrices are stored as arrays of column vectors
+            alignment = info->components == 1 ? 4 : (info->components == 2 ? 8 : 16);
+            if (info->columns > 1)
+                columnStride = align_up(columnSize, alignment);
+        }
+
+        const uint32_t offset = align_up(cursor, alignment);
+        self->fields[i] = (RecordField){
+            .type = (FieldType)type,
+            .offset = offset,
+            .columnStride = columnStride,
+        };
+
+        cursor = offset + (info->columns > 1 ? info->columns * columnStride : columnSize);
+        coveredSize += columnSize * info->columns;
+        if (alignment > maxAlignment)
+            maxAlignment = alignment;
+
+        PyTuple_SET_ITEM(self->names, i, Py_NewRef(name));
+    }
+
+    // std140 rounds alignment of structures up to vec4
+    if (self->rule == LAYOUT_RULE_STD140 && maxAlignment < STD_BLOCK_ALIGNMENT)
+        maxAlignment = STD_BLOCK_ALIGNMENT;
+
+    self->alignment = maxAlignment;
+    self->stride = align_up(cursor, maxAlignment);
+    self->hasPadding = coveredSize != self->stride;
+
+    result = true;
+
+end:
+    // failed layout is left uninitialized, so __init__ can be called again
+    if (!result)
+    {
+        PyMem_Free(self->fields);
+        self->fields = NULL;
+        Py_CLEAR(self->names);
+        self->fieldCount = 0;
+    }
+
+    Py_DECREF(sequence);
+    return result;
+}
+
+static const float *get_math_data(PyObject *value, int *count)
+{
+    if (Py_IS_TYPE(value, &pyVector2Type))
+    {
+        *count = 2;
+        return ((Vector2 *)value)->data;
+    }
+    if (Py_IS_TYPE(value, &pyVector3Type))
+    {
+        *count = 3;
+        return ((Vector3 *)value)->data;
+    }
+    if (Py_IS_TYPE(value, &pyVector4Type))
+    {
+        *count = 4;
+        return ((Vector4 *)value)->data;
+    }
+    if (Py_IS_TYPE(value, &pyQuaternionType))
+    {
+        *count = 4;
+        return ((Quaternion *)value)->data;
+    }
+    if (Py_IS_TYPE(value, &pyMatrix3Type))
+    {
+        *count = 9;
+        return (const float *)((Matrix3 *)value)->data;
+    }
+    if (Py_IS_TYPE(value, &pyMatrix4Type))
+    {
+        *count = 16;
+        return (const float *)((Matrix4 *)value)->data;
+    }
+
+    return NULL;
+}
+
+static bool read_floats(PyObject *value, int count, float *out)
+{
+    int mathCount = 0;
+    const float *data = get_math_data(value, &mathCount);
+    if (data != NULL)
+    {
+        if (mathCount != count)
+        {
+            PyErr_Format(PyExc_ValueError, "Expected field value with %d components, got %s.", count, Py_TYPE(value)->tp_name);
+            return false;
+        }
+
+        memcpy(out, data, count * sizeof(float));
+        return true;
+    }
+
+    if (count == 1)
+    {
+        const double number = PyFloat_AsDouble(value);
+        if (number == -1.0 && PyErr_Occurred())
+            return false;
+
+        out[0] = (float)number;
+        return true;
+    }
+
+    PyObject *sequence = PySequence_Fast(value, "Expected field value to be a math object or a sequence of numbers.");
+    if (sequence == NULL)
+        return false;
+
+    bool result = false;
+    if (PySequence_Fast_GET_SIZE(sequence) != count)
+    {
+        PyErr_Format(PyExc_ValueError, "Expected field value with %d components, got %zd.", count, PySequence_Fast_GET_SIZE(sequence));
+        goto end;
+    }
+
+    PyObject **items = PySequence_Fast_ITEMS(sequence);
+    for (int i = 0; i < count; i++)
+    {
+        const double number = PyFloat_AsDouble(items[i]);
+        if (number == -1.0 && PyErr_Occurred())
+            goto end;
+
+        out[i] = (float)number;
+    }
+
+    result = true;
+
+end:
+    Py_DECREF(sequence);
+    return result;
+}
+
+static bool read_ints(PyObject *value, int count, long long *out)
+{
+    if (count == 1)
+    {
+        out[0] = PyLong_AsLongLong(value);
+        return !(out[0] == -1 && PyErr_Occurred());
+    }
+
+    PyObject *sequence = PySequence_Fast(value, "Expected field value to be a sequence of ints.");
+    if (sequence == NULL)
+        return false;
+
+    bool result = false;
+    if (PySequence_Fast_GET_SIZE(sequence) != count)
+    {
+        PyErr_Format(PyExc_ValueError, "Expected field value with %d components, got %zd.", count, PySequence_Fast_GET_SIZE(sequence));
+        goto end;
+    }
+
+    PyObject **items = PySequence_Fast_ITEMS(sequence);
+    for (int i = 0; i < count; i++)
+    {
+        out[i] = PyLong_AsLongLong(items[i]);
+        if (out[i] == -1 && PyErr_Occurred())
+            goto end;
+    }
+
+    result = true;
+
+end:
+    Py_DECREF(sequence);
+    return result;
+}
+
+static bool pack_int_field(const FieldTypeInfo *info, PyObject *value, char *dst)
+{
+    long long values[4];
+    if (!read_ints(value, info->components, values))
+        return false;
+
+    long long min = 0, max = UINT8_MAX;
+    if (info->glType == GL_INT)
+    {
+        min = INT32_MIN;
+        max = INT32_MAX;
+    }
+    else if (info->glType == GL_UNSIGNED_INT)
+        max = UINT32_MAX;
+
+    for (int i = 0; i < info->components; i++)
+    {
+        if (values[i] < min || values[i] > max)
+        {
+            PyErr_Format(PyExc_OverflowError, "Field value %lld is out of range [%lld, %lld].", values[i], min, max);
+            return false;
+        }
+
+        if (info->glType == GL_UNSIGNED_BYTE)
+            ((uint8_t *)dst)[i] = (uint8_t)values[i];
+        else
+        {
+            const uint32_t bits = (uint32_t)values[i];
+            memcpy(dst + i * sizeof(bits), &bits, sizeof(bits));
+        }
+    }
+
+    return true;
+}
+
+static bool pack_field(const RecordField *field, PyObject *value, char *dst)
+{
+    const FieldTypeInfo *info = &fieldTypeInfos[field->type];
+    if (info->isInteger)
+        return pack_int_field(info, value, dst);
+
+    float values[16];
+    if (!read_floats(value, info->components * info->columns, values))
+        return false;
+
+    if (info->glType == GL_INT_2_10_10_10_REV)
+    {
+        const uint32_t packed =
+            ((uint32_t)pack_snorm(values[0], 511.0f) & 0x3ffu) |
+            ((uint32_t)pack_snorm(values[1], 511.0f) & 0x3ffu) << 10 |
+            ((uint32_t)pack_snorm(values[2], 511.0f) & 0x3ffu) << 20 |
+            ((uint32_t)pack_snorm(values[3], 1.0f) & 0x3u) << 30;
+        memcpy(dst, &packed, sizeof(packed));
+
+        return true;
+    }
+
+    for (int column = 0; column < info->columns; column++)
+    {
+        char *columnDst = dst + column * field->columnStride;
+        const float *src = values + column * info->components;
+
+        switch (info->glType)
+        {
+        case GL_FLOAT:
+            memcpy(columnDst, src, info->components * sizeof(float));
+            break;
+        case GL_HALF_FLOAT:
+            for (int i = 0; i < info->components; i++)
+            {
+                const uint16_t half = float_to_half(src[i]);
+                memcpy(columnDst + i * sizeof(half), &half, sizeof(half));
+            }
+            break;
+        case GL_BYTE:
+            for (int i = 0; i < info->components; i++)
+                ((int8_t *)columnDst)[i] = (int8_t)pack_snorm(src[i], 127.0f);
+            break;
+        case GL_UNSIGNED_BYTE:
+            for (int i = 0; i < info->components; i++)
+                ((uint8_t *)columnDst)[i] = (uint8_t)pack_unorm(src[i], 255.0f);
+            break;
+        case GL_SHORT:
+            for (int i = 0; i < info->components; i++)
+            {
+                const int16_t packed = (int16_t)pack_snorm(src[i], 32767.0f);
+                memcpy(columnDst + i * sizeof(packed), &packed, sizeof(packed));
+            }
+            break;
+        case GL_UNSIGNED_SHORT:
+            for (int i = 0; i < info->components; i++)
+            {
+                const uint16_t packed = (uint16_t)pack_unorm(src[i], 65535.0f);
+                memcpy(columnDst + i * sizeof(packed), &packed, sizeof(packed));
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool pack_rows(PyRecordLayout *self, PyObject *rows, char *dst)
+{
+    PyObject **items = PySequence_Fast_ITEMS(rows);
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(rows);
+
+    for (Py_ssize_t row = 0; row < count; row++)
+    {
+        char *record = dst + row * self->stride;
+        if (self->hasPadding)
+            memset(record, 0, self->stride);
+
+        // rows of single field layouts can be passed without wrapping them in 1-tuples
+        if (self->fieldCount == 1 && !(PyTuple_Check(items[row]) && PyTuple_GET_SIZE(items[row]) == 1))
+        {
+            if (!pack_field(&self->fields[0], items[row], record + self->fields[0].offset))
+                return false;
+
+            continue;
+        }
+
+        PyObject *values = PySequence_Fast(items[row], "Expected every row to be a sequence of field values.");
+        if (values == NULL)
+            return false;
+
+        if (PySequence_Fast_GET_SIZE(values) != self->fieldCount)
+        {
+            PyErr_Format(PyExc_ValueError, "Row %zd has %zd values, expected %zd.", row, PySequence_Fast_GET_SIZE(values), self->fieldCount);
+            Py_DECREF(values);
+            return false;
+        }
+
+        for (Py_ssize_t i = 0; i < self->fieldCount; i++)
+        {
+            if (!pack_field(&self->fields[i], PySequence_Fast_GET_ITEM(values, i), record + self->fields[i].offset))
+            {
+                Py_DECREF(values);
+                return false;
+            }
+        }
+
+        Py_DECREF(values);
+    }
+
+    return true;
+}
+
+static PyObject *pack_into(PyRecordLayout *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"buffer", "offset", "rows", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 3, values))
+        return NULL;
+
+    Py_ssize_t offset = -1;
+    if (!Py_IsNone(values[1]))
+    {
+        offset = PyLong_AsSsize_t(values[1]);
+        if (offset == -1 && PyErr_Occurred())
+            return NULL;
+
+        THROW_IF(offset < 0, PyExc_ValueError, "Offset cannot be negative.", NULL);
+    }
+
+    PyObject *rows = PySequence_Fast(values[2], "Expected rows to be an iterable.");
+    if (rows == NULL)
+        return NULL;
+
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(rows);
+
+    // acquiring pygl.buffers.Buffer advances its current offset, which is restored if packing fails
+    PyBuffer *buffer = Py_IS_TYPE(values[0], &pyBufferType) ? (PyBuffer *)values[0] : NULL;
+    const GLsizeiptr currentOffset = buffer ? buffer->currentOffset : 0;
+
+    WriteTarget target;
+    if (!py_buffer_acquire_write_target(values[0], offset, count * self->stride, &target))
+    {
+        Py_DECREF(rows);
+        return NULL;
+    }
+
+    const bool success = pack_rows(self, rows, target.data);
+    if (!success && buffer)
+        buffer->currentOffset = currentOffset;
+
+    py_buffer_release_write_target(&target);
+    Py_DECREF(rows);
+
+    return success ? PyLong_FromSsize_t(count) : NULL;
+}
+
+static PyObject *pack(PyRecordLayout *self, PyObject *rowsObj)
+{
+    PyObject *rows = PySequence_Fast(rowsObj, "Expected rows to be an iterable.");
+    if (rows == NULL)
+        return NULL;
+
+    PyObject *result = PyBytes_FromStringAndSize(NULL, PySequence_Fast_GET_SIZE(rows) * self->stride);
+    if (result != NULL && !pack_rows(self, rows, PyBytes_AS_STRING(result)))
+        Py_CLEAR(result);
+
+    Py_DECREF(rows);
+    return result;
+}
+
+static PyObject *create_descriptor(GLuint attribIndex, const FieldTypeInfo *info, GLuint rows, uint32_t offset)
+{
+    PyObject *args = Py_BuildValue("(IIiI)", attribIndex, info->glType, (int)info->components, rows);
+    PyObject *kwargs = Py_BuildValue("{sOsI}", "is_normalized", info->isNormalized ? Py_True : Py_False, "offset", offset);
+
+    PyObject *descriptor = NULL;
+    if (args != NULL && kwargs != NULL)
+        descriptor = PyObject_Call((PyObject *)&pyVertexDescriptorType, args, kwargs);
+
+    Py_XDECREF(args);
+    Py_XDECREF(kwargs);
+
+    return descriptor;
+}
+
+static PyObject *build_vertex_descriptors(PyRecordLayout *self, GLuint attribIndex)
+{
+    if (PyType_Ready(&pyVertexDescriptorType) == -1)
+        return NULL;
+
+    PyObject *descriptors = PyList_New(0);
+    if (descriptors == NULL)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->fieldCount; i++)
+    {
+        const RecordField *field = &self->fields[i];
+        const FieldTypeInfo *info = &fieldTypeInfos[field->type];
+
+        // matrix with tightly packed columns is described by a single descriptor with multiple rows
+        const bool isTight = field->columnStride == get_column_size(info);
+        const int descriptorCount = isTight ? 1 : info->columns;
+        for (int column = 0; column < descriptorCount; column++)
+        {
+            PyObject *descriptor = create_descriptor(
+                attribIndex,
+                info,
+                isTight ? info->columns : 1,
+                field->offset + column * field->columnStride);
+            if (descriptor == NULL || PyList_Append(descriptors, descriptor) == -1)
+            {
+                Py_XDECREF(descriptor);
+                Py_DECREF(descriptors);
+                return NULL;
+            }
+
+            Py_DECREF(descriptor);
+            attribIndex += isTight ? info->columns : 1;
+        }
+    }
+
+    return descriptors;
+}
+
+static PyObject *get_vertex_descriptors(PyRecordLayout *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"attrib_index", NULL};
+
+    GLuint attribIndex = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|I", kwNames, &attribIndex))
+        return NULL;
+
+    return build_vertex_descriptors(self, attribIndex);
+}
+
+static PyObject *create_vertex_input(PyRecordLayout *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"buffer", "attrib_index", "offset", "divisor", NULL};
+
+    PyObject *buffer = NULL;
+    GLuint attribIndex = 0;
+    long long offset = 0;
+    GLuint divisor = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|ILI", kwNames, &buffer, &attribIndex, &offset, &divisor))
+        return NULL;
+
+    if (PyType_Ready(&pyVertexInputType) == -1)
+        return NULL;
+
+    PyObject *descriptors = build_vertex_descriptors(self, attribIndex);
+    if (descriptors == NULL)
+        return NULL;
+
+    return PyObject_CallFunction((PyObject *)&pyVertexInputType, "OiNLI", buffer, (int)self->stride, descriptors, offset, divisor);
+}
+
+static PyObject *get_offsets(PyRecordLayout *self, void *Py_UNUSED(closure))
+{
+    PyObject *offsets = PyDict_New();
+    if (offsets == NULL)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->fieldCount; i++)
+    {
+        PyObject *offset = PyLong_FromUnsignedLong(self->fields[i].offset);
+        if (offset == NULL || PyDict_SetItem(offsets, PyTuple_GET_ITEM(self->names, i), offset) == -1)
+        {
+            Py_XDECREF(offset);
+            Py_DECREF(offsets);
+            return NULL;
+        }
+
+        Py_DECREF(offset);
+    }
+
+    return offsets;
+}
+
+static PyObject *repr(PyRecordLayout *self)
+{
+    return PyUnicode_FromFormat(
+        "<object %s (fields: %R, stride: %u) at %p>",
+        Py_TYPE(self)->tp_name,
+        self->names,
+        self->stride,
+        self);
+}
+
+static void dealloc(PyRecordLayout *self)
+{
+    PyMem_Free(self->fields);
+    Py_XDECREF(self->names);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int init(PyRecordLayout *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"fields", "rule", NULL};
+
+    PyObject *fields = NULL;
+    int rule = LAYOUT_RULE_PACKED;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", kwNames, &fields, &rule))
+        return -1;
+
+    THROW_IF(self->fields != NULL, PyExc_RuntimeError, "Record layout is already initialized.", -1);
+    THROW_IF(
+        rule != LAYOUT_RULE_PACKED && rule != LAYOUT_RULE_STD140 && rule != LAYOUT_RULE_STD430,
+        PyExc_ValueError,
+        "Invalid layout rule.",
+        -1);
+
+    self->rule = (LayoutRule)rule;
+
+    return compile_layout(self, fields) ? 0 : -1;
+}
+
+PyTypeObject pyRecordLayoutType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_new = PyType_GenericNew,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.buffers.RecordLayout",
+    .tp_basicsize = sizeof(PyRecordLayout),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_members = (PyMemberDef[]){
+        {"stride", T_UINT, offsetof(PyRecordLayout, stride), READONLY, NULL},
+        {"alignment", T_UINT, offsetof(PyRecordLayout, alignment), READONLY, NULL},
+        {"rule", T_INT, offsetof(PyRecordLayout, rule), READONLY, NULL},
+        {"names", T_OBJECT_EX, offsetof(PyRecordLayout, names), READONLY, NULL},
+        {0}},
+    .tp_getset = (PyGetSetDef[]){
+        {"offsets", (getter)get_offsets, NULL, NULL, NULL},
+        {0}},
+    .tp_methods = (PyMethodDef[]){
+        {"pack_into", (PyCFunction)pack_into, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"pack", (PyCFunction)pack, METH_O, NULL},
+        {"get_vertex_descriptors", (PyCFunction)get_vertex_descriptors, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"create_vertex_input", (PyCFunction)create_vertex_input, METH_VARARGS | METH_KEYWORDS, NULL},
+        {0},
+    },
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "../gl.h"
+
+typedef enum
+{
+    FIELD_TYPE_FLOAT,
+    FIELD_TYPE_FLOAT2,
+    FIELD_TYPE_FLOAT3,
+    FIELD_TYPE_FLOAT4,
+    FIELD_TYPE_INT,
+    FIELD_TYPE_INT2,
+    FIELD_TYPE_INT3,
+    FIELD_TYPE_INT4,
+    FIELD_TYPE_UINT,
+    FIELD_TYPE_UINT2,
+    FIELD_TYPE_UINT3,
+    FIELD_TYPE_UINT4,
+    FIELD_TYPE_HALF2,
+    FIELD_TYPE_HALF4,
+    FIELD_TYPE_BYTE4N,
+    FIELD_TYPE_UBYTE4,
+    FIELD_TYPE_UBYTE4N,
+    FIELD_TYPE_SHORT2N,
+    FIELD_TYPE_SHORT4N,
+    FIELD_TYPE_USHORT2N,
+    FIELD_TYPE_USHORT4N,
+    FIELD_TYPE_INT_2_10_10_10_REV,
+    FIELD_TYPE_MAT3,
+    FIELD_TYPE_MAT4,
+    FIELD_TYPE_COUNT,
+} FieldType;
+
+typedef enum
+{
+    LAYOUT_RULE_PACKED,
+    LAYOUT_RULE_STD140,
+    LAYOUT_RULE_STD430,
+} LayoutRule;
+
+typedef struct
+{
+    FieldType type;
+    uint32_t offset;
+    // distance between matrix columns, equal to column size for other types
+    uint32_t columnStride;
+} RecordField;
+
+typedef struct
+{
+    PyObject_HEAD
+    RecordField *fields;
+    PyObject *names; // tuple of str
+    Py_ssize_t fieldCount;
+    uint32_t stride;
+    uint32_t alignment;
+    LayoutRule rule;
+    // record contains bytes not covered by any field, which are zeroed when packing
+    bool hasPadding;
+} PyRecordLayout;
+
+extern PyTypeObject pyRecordLayoutType;
@@ -0,0 +1,330 @@
+#include "streamBuffer.h"
+#include <structmember.h>
+#include "buffer.h"
+#include "../sync.h"
+#include "../utility.h"
+
+#define STREAM_BUFFER_WAIT_TIMEOUT_NS 1000000
+
+static bool wait_for_region(PyStreamBuffer *self, GLsizei region)
+{
+    GLsync fence = self->fences[region];
+    if (fence == NULL)
+        return true;
+
+    GLenum waitState = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (!SYNC_SIGNALED(waitState))
+    {
+        self->stallCount++;
+
+        Py_BEGIN_ALLOW_THREADS;
+        do
+        {
+            waitState = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_BUFFER_WAIT_TIMEOUT_NS);
+        } while (waitState == GL_TIMEOUT_EXPIRED);
+        Py_END_ALLOW_THREADS;
+    }
+
+    glDeleteSync(fence);
+    self->fences[region] = NULL;
+
+    THROW_IF(
+        waitState == GL_WAIT_FAILED,
+        PyExc_RuntimeError,
+        "Failed to wait for stream buffer region.",
+        false);
+
+    return true;
+}
+
+GLintptr py_stream_buffer_allocate(PyStreamBuffer *self, GLsizeiptr size)
+{
+    THROW_IF(self->dataPtr == NULL, PyExc_RuntimeError, "Stream buffer was deleted.", -1);
+    THROW_IF(size < 0, PyExc_ValueError, "Allocation size cannot be negative.", -1);
+
+    const GLsizeiptr offset = (self->regionOffset + self->alignment - 1) & ~(self->alignment - 1);
+    if (size > self->regionSize - offset)
+    {
+        PyErr_Format(
+            PyExc_RuntimeError,
+            "Stream buffer region is full (requested: %zd, available: %zd). Call end_frame or use bigger regions.",
+            (Py_ssize_t)size,
+            (Py_ssize_t)(offset < self->regionSize ? self->regionSize - offset : 0));
+        return -1;
+    }
+
+    if (!wait_for_region(self, self->currentRegion))
+        return -1;
+
+    self->regionOffset = offset + size;
+
+    return (GLintptr)self->currentRegion * self->regionSize + offset;
+}
+
+static PyObject *allocate(PyStreamBuffer *self, PyObject *sizeObj)
+{
+    const Py_ssize_t size = PyLong_AsSsize_t(sizeObj);
+    if (size == -1 && PyErr_Occurred())
+        return NULL;
+
+    const GLintptr offset = py_stream_buffer_allocate(self, size);
+    if (offset == -1)
+        return NULL;
+
+    return PyLong_FromSsize_t(offset);
+}
+
+static PyObject *store(PyStreamBuffer *self, PyObject *data)
+{
+    THROW_IF(self->dataPtr == NULL, PyExc_RuntimeError, "Stream buffer was deleted.", NULL);
+
+    // store into the remaining space first, then commit allocation of the size that was actually written
+    const GLsizeiptr offset = (self->regionOffset + self->alignment - 1) & ~(self->alignment - 1);
+    const GLsizeiptr available = offset < self->regionSize ? self->regionSize - offset : 0;
+
+    if (!wait_for_region(self, self->currentRegion))
+        return NULL;
+
+    char *dst = self->dataPtr + (GLintptr)self->currentRegion * self->regionSize + offset;
+    self->pinCount++;
+    const Py_ssize_t size = py_buffer_store_object(data, dst, available, true);
+    self->pinCount--;
+    if (size == -1)
+        return NULL;
+
+    return PyLong_FromSsize_t(py_stream_buffer_allocate(self, size));
+}
+
+static PyObject *end_frame(PyStreamBuffer *self, PyObject *Py_UNUSED(args))
+{
+    THROW_IF(self->dataPtr == NULL, PyExc_RuntimeError, "Stream buffer was deleted.", NULL);
+
+    // regions that were not written to don't need to be fenced
+    if (self->regionOffset != 0)
+        self->fences[self->currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    self->currentRegion = (self->currentRegion + 1) % self->regionCount;
+    self->regionOffset = 0;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *bind(PyStreamBuffer *self, PyObject *target)
+{
+    if (!PyLong_Check(target))
+    {
+        PyErr_SetString(PyExc_TypeError, "target has to be of type int.");
+        return NULL;
+    }
+
+    glBindBuffer(PyLong_AsUnsignedLong(target), self->id);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *bind_range(PyStreamBuffer *self, PyObject *args)
+{
+    GLenum target = 0;
+    GLuint index = 0;
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+    if (!PyArg_ParseTuple(args, "IInn", &target, &index, &offset, &size))
+        return NULL;
+
+    THROW_IF(
+        offset < 0 || size <= 0 || offset + size > self->size,
+        PyExc_ValueError,
+        "Bound range exceeds buffer size.",
+        NULL);
+
+    glBindBufferRange(target, index, self->id, offset, size);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *buf_read(PyStreamBuffer *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"out", "size", "offset", NULL};
+
+    PyObject *result = NULL;
+
+    Py_buffer outBuffer = {0};
+    GLsizeiptr size = 0;
+    GLintptr offset = 0;
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwargs, "w*n|n", kwNames,
+            &outBuffer, &size, &offset))
+        goto end;
+
+    if (!utils_check_buffer_contiguous(&outBuffer))
+        goto end;
+
+    THROW_IF_GOTO(
+        size < 0 || offset < 0 || size + offset > self->size,
+        PyExc_ValueError,
+        "Requested size and offset exceed buffer size.",
+        end);
+
+    if (size > outBuffer.len)
+    {
+        PyErr_Format(PyExc_ValueError, "Buffer that was passed in is smaller than requested size. (buffer size: %zu, requested: %zu)", outBuffer.len, size);
+        goto end;
+    }
+
+    // mapping is write only, but persistently mapped storage can still be queried
+    glGetNamedBufferSubData(self->id, offset, size, outBuffer.buf);
+
+    result = Py_NewRef(Py_None);
+
+end:
+    if (outBuffer.buf != NULL)
+        PyBuffer_Release(&outBuffer);
+
+    return result;
+}
+
+static PyObject *delete(PyStreamBuffer *self, PyObject *Py_UNUSED(args))
+{
+    THROW_IF(self->pinCount != 0, PyExc_BufferError, "Stream buffer cannot be deleted while data is being stored.", NULL);
+
+    if (self->fences != NULL)
+    {
+        for (GLsizei i = 0; i < self->regionCount; i++)
+            glDeleteSync(self->fences[i]);
+
+        PyMem_Free(self->fences);
+        self->fences = NULL;
+    }
+
+    if (self->dataPtr != NULL)
+    {
+        glUnmapNamedBuffer(self->id);
+        self->dataPtr = NULL;
+    }
+
+    glDeleteBuffers(1, &self->id);
+    self->id = 0;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *repr(PyStreamBuffer *self)
+{
+    return PyUnicode_FromFormat(
+        "<object %s (region size: %zd, regions: %d, current region: %d, region offset: %zd) at %p>",
+        Py_TYPE(self)->tp_name,
+        (Py_ssize_t)self->regionSize,
+        self->regionCount,
+        self->currentRegion,
+        (Py_ssize_t)self->regionOffset,
+        self);
+}
+
+static void dealloc(PyStreamBuffer *self)
+{
+    delete (self, NULL);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int init(PyStreamBuffer *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"region_size", "region_count", "alignment", NULL};
+
+    Py_ssize_t regionSize = 0;
+    int regionCount = STREAM_BUFFER_DEFAULT_REGION_COUNT;
+    Py_ssize_t alignment = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|in", kwNames, &regionSize, &regionCount, &alignment))
+        return -1;
+
+    THROW_IF(regionSize <= 0, PyExc_ValueError, "Region size has to be greater than 0.", -1);
+    THROW_IF(regionCount <= 0, PyExc_ValueError, "Region count has to be greater than 0.", -1);
+    THROW_IF(alignment < 0, PyExc_ValueError, "Alignment cannot be negative.", -1);
+
+    if (alignment == 0)
+    {
+        // default alignment allows each allocation to be bound as uniform or shader storage buffer range
+        GLint uniformAlignment = 1;
+        GLint storageAlignment = 1;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+
+        alignment = uniformAlignment > storageAlignment ? uniformAlignment : storageAlignment;
+        if (alignment < 1)
+            alignment = 1;
+    }
+
+    THROW_IF(
+        (alignment & (alignment - 1)) != 0,
+        PyExc_ValueError,
+        "Alignment has to be a power of two.",
+        -1);
+
+    self->alignment = alignment;
+    self->regionSize = (regionSize + alignment - 1) & ~(alignment - 1);
+    self->regionCount = regionCount;
+    self->size = self->regionSize * regionCount;
+    self->currentRegion = 0;
+    self->regionOffset = 0;
+    self->stallCount = 0;
+
+    self->fences = PyMem_Calloc(regionCount, sizeof(GLsync));
+    if (self->fences == NULL)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &self->id);
+    glNamedBufferStorage(self->id, self->size, NULL, flags);
+
+    self->dataPtr = glMapNamedBufferRange(self->id, 0, self->size, flags);
+    if (self->dataPtr == NULL)
+    {
+        PyErr_Format(PyExc_RuntimeError, "Couldn't map stream buffer: 0x%x.", glGetError());
+        return -1;
+    }
+
+    return 0;
+}
+
+static PyObject *get_available(PyStreamBuffer *self, void *Py_UNUSED(closure))
+{
+    const GLsizeiptr offset = (self->regionOffset + self->alignment - 1) & ~(self->alignment - 1);
+    return PyLong_FromSsize_t(offset < self->regionSize ? self->regionSize - offset : 0);
+}
+
+PyTypeObject pyStreamBufferType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_new = PyType_GenericNew,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.buffers.StreamBuffer",
+    .tp_basicsize = sizeof(PyStreamBuffer),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_members = (PyMemberDef[]){
+        {"id", T_UINT, offsetof(PyStreamBuffer, id), READONLY, NULL},
+        {"size", T_PYSSIZET, offsetof(PyStreamBuffer, size), READONLY, NULL},
+        {"region_size", T_PYSSIZET, offsetof(PyStreamBuffer, regionSize), READONLY, NULL},
+        {"region_count", T_INT, offsetof(PyStreamBuffer, regionCount), READONLY, NULL},
+        {"current_region", T_INT, offsetof(PyStreamBuffer, currentRegion), READONLY, NULL},
+        {"region_offset", T_PYSSIZET, offsetof(PyStreamBuffer, regionOffset), READONLY, NULL},
+        {"alignment", T_PYSSIZET, offsetof(PyStreamBuffer, alignment), READONLY, NULL},
+        {"stall_count", T_ULONGLONG, offsetof(PyStreamBuffer, stallCount), READONLY, NULL},
+        {0}},
+    .tp_getset = (PyGetSetDef[]){
+        {"available", (getter)get_available, NULL, NULL, NULL},
+        {0}},
+    .tp_methods = (PyMethodDef[]){
+        {"delete", (PyCFunction) delete, METH_NOARGS, NULL},
+        {"allocate", (PyCFunction)allocate, METH_O, NULL},
+        {"store", (PyCFunction)store, METH_O, NULL},
+        {"end_frame", (PyCFunction)end_frame, METH_NOARGS, NULL},
+        {"read", (PyCFunction)buf_read, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"bind", (PyCFunction)bind, METH_O, NULL},
+        {"bind_range", (PyCFunction)bind_range, METH_VARARGS, NULL},
+        {0},
+    },
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "../gl.h"
+
+#define STREAM_BUFFER_DEFAULT_REGION_COUNT 3
+
+// Persistently and coherently mapped buffer split into `regionCount` equally sized regions used in round-robin
+// order (usually one per frame). Finishing a region places a fence, which is waited on only when the region
+// is written to again.
+typedef struct
+{
+    PyObject_HEAD
+    GL_OBJECT_HEAD;
+    char *dataPtr;
+    GLsizeiptr size;
+    GLsizeiptr regionSize;
+    GLsizei regionCount;
+    GLsizei currentRegion;
+    // number of bytes already handed out from the current region
+    GLsizeiptr regionOffset;
+    GLsizeiptr alignment;
+    // one per region, NULL if GPU is not using the region
+    GLsync *fences;
+    uint64_t stallCount;
+    // number of stores in progress, buffer can't be deleted while other threads run during a store
+    Py_ssize_t pinCount;
+} PyStreamBuffer;
+
+extern PyTypeObject pyStreamBufferType;
+
+// Returns offset of `size` bytes reserved from the current region (relative to the beginning of the buffer)
+// or -1 on failure. Waits for the region fence if GPU might still use it.
+GLintptr py_stream_buffer_allocate(PyStreamBuffer *buffer, GLsizeiptr size);
@@ -0,0 +1,125 @@
+#include "copyEngine.h"
+#include <stdint.h>
+#include <string.h>
+#include "threadPool.h"
+#include "utility.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COPY_ENGINE_HAS_STREAMING_STORES
+#endif
+
+typedef struct
+{
+    char *dst;
+    const char *src;
+    size_t size;
+    // size of the first chunk, which ends at aligned destination address
+    size_t headSize;
+    size_t chunkSize;
+    bool streaming;
+} CopyJob;
+
+static size_t parallelThreshold;
+
+static void stream_copy(char *dst, const char *src, size_t size)
+{
+#ifdef COPY_ENGINE_HAS_STREAMING_STORES
+    // non-temporal stores require 16 byte aligned destination
+    size_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+    if (head > size)
+        head = size;
+
+    memcpy(dst, src, head);
+
+    size_t i = head;
+    for (; i + 64 <= size; i += 64)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(src + i + 16));
+        const __m128i c = _mm_loadu_si128((const __m128i *)(src + i + 32));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(src + i + 48));
+        _mm_stream_si128((__m128i *)(dst + i), a);
+        _mm_stream_si128((__m128i *)(dst + i + 16), b);
+        _mm_stream_si128((__m128i *)(dst + i + 32), c);
+        _mm_stream_si128((__m128i *)(dst + i + 48), d);
+    }
+
+    for (; i + 16 <= size; i += 16)
+        _mm_stream_si128((__m128i *)(dst + i), _mm_loadu_si128((const __m128i *)(src + i)));
+
+    // non-temporal stores are weakly ordered, they have to be visible before the job is reported as finished
+    _mm_sfence();
+
+    memcpy(dst + i, src + i, size - i);
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+static void copy_job(void *userData, size_t index)
+{
+    const CopyJob *job = userData;
+
+    const size_t start = index == 0 ? 0 : job->headSize + (index - 1) * job->chunkSize;
+    size_t end = index == 0 ? job->headSize : start + job->chunkSize;
+    if (end > job->size)
+        end = job->size;
+
+    if (job->streaming)
+        stream_copy(job->dst + start, job->src + start, end - start);
+    else
+        memcpy(job->dst + start, job->src + start, end - start);
+}
+
+static void parallel_copy(char *dst, const char *src, size_t size, bool streaming)
+{
+    // few chunks per thread keep threads busy if some of them start late
+    const size_t threadCount = thread_pool_get_thread_count();
+    size_t chunkSize = size / (threadCount * 2);
+    if (chunkSize < COPY_ENGINE_MIN_CHUNK_SIZE)
+        chunkSize = COPY_ENGINE_MIN_CHUNK_SIZE;
+
+    chunkSize = (chunkSize + COPY_ENGINE_CHUNK_ALIGNMENT - 1) & ~(size_t)(COPY_ENGINE_CHUNK_ALIGNMENT - 1);
+
+    // first chunk is extended up to the aligned address, so no cache line is written by two threads
+    size_t headSize = (COPY_ENGINE_CHUNK_ALIGNMENT - ((uintptr_t)dst & (COPY_ENGINE_CHUNK_ALIGNMENT - 1))) & (COPY_ENGINE_CHUNK_ALIGNMENT - 1);
+    headSize += chunkSize;
+    if (headSize > size)
+        headSize = size;
+
+    CopyJob job = {
+        .dst = dst,
+        .src = src,
+        .size = size,
+        .headSize = headSize,
+        .chunkSize = chunkSize,
+        .streaming = streaming,
+    };
+
+    thread_pool_run(copy_job, &job, 1 + (size - headSize + chunkSize - 1) / chunkSize);
+}
+
+void copy_engine_copy(void *dst, const void *src, size_t size, bool streaming)
+{
+    const bool parallel = parallelThreshold != 0 && size >= parallelThreshold;
+
+    PyThreadState *threadState = utils_begin_allow_threads(size >= UTILS_ALLOW_THREADS_THRESHOLD);
+
+    if (parallel)
+        parallel_copy(dst, src, size, streaming);
+    else
+        memcpy(dst, src, size);
+
+    utils_end_allow_threads(threadState);
+}
+
+size_t copy_engine_get_parallel_threshold(void)
+{
+    return parallelThreshold;
+}
+
+void copy_engine_set_parallel_threshold(size_t threshold)
+{
+    parallelThreshold = threshold;
+}
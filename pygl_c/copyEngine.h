@@ -0,0 +1,18 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+// Chunks of parallel copies start at multiples of this many bytes of the destination.
+#define COPY_ENGINE_CHUNK_ALIGNMENT 64
+#define COPY_ENGINE_MIN_CHUNK_SIZE (256 * 1024)
+
+// Copies `size` bytes from `src` to `dst`, releasing the GIL for copies of at least `UTILS_ALLOW_THREADS_THRESHOLD`
+// bytes. If parallel copying is enabled, copies of at least the parallel copy threshold are split into chunks
+// executed by the thread pool. `streaming` marks destination that won't be read by the CPU (e.g. write-combined
+// GL mapping), which is then written with non-temporal stores bypassing the cache during parallel copies.
+// Has to be called with the GIL held.
+void copy_engine_copy(void *dst, const void *src, size_t size, bool streaming);
+
+// Returns minimal size of copies done in parallel or 0 if parallel copying is disabled (default).
+size_t copy_engine_get_parallel_threshold(void);
+void copy_engine_set_parallel_threshold(size_t threshold);
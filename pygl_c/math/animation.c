@@ -0,0 +1,571 @@
+#include "animation.h"
+#include <string.h>
+#include <math.h>
+#include <cglm/quat.h>
+#include "matrix/matrix4Array.h"
+#include "../threadPool.h"
+#include "../utility.h"
+
+#define _ROTATIONS_ALIGNMENT 16
+
+typedef struct
+{
+    Skeleton *skeleton;
+    AnimationClip **clips;
+    // 0 if all instances use the same clip
+    size_t clipStride;
+    const float *times;
+    size_t count;
+    bool loop;
+    bool nlerp;
+    // world matrices of currently processed instance, `jointCount` matrices per job
+    mat4 *scratch;
+    char *out;
+} PaletteJob;
+
+static float wrap_time(float time, float duration, bool loop)
+{
+    if (!loop || duration <= 0.0f)
+        return time;
+
+    time = fmodf(time, duration);
+    return time < 0.0f ? time + duration : time;
+}
+
+// Interpolates keys of `joint` surrounding `time` and composes them into T * R * S matrix. Times outside of
+// joint keys range are clamped to the first or the last key.
+static void sample_joint(const AnimationClip *clip, Py_ssize_t joint, float time, bool nlerp, mat4 dest)
+{
+    const uint32_t first = clip->keyOffsets[joint];
+    const uint32_t last = clip->keyOffsets[joint + 1] - 1;
+    const float *times = clip->times;
+
+    vec3 translation;
+    vec3 scale;
+    versor rotation;
+    if (time <= times[first] || first == last)
+    {
+        glm_vec3_copy(clip->translations[first], translation);
+        glm_vec3_copy(clip->scales[first], scale);
+        glm_quat_copy(clip->rotations[first], rotation);
+    }
+    else if (time >= times[last])
+    {
+        glm_vec3_copy(clip->translations[last], translation);
+        glm_vec3_copy(clip->scales[last], scale);
+        glm_quat_copy(clip->rotations[last], rotation);
+    }
+    else
+    {
+        // find the first key after `time`, it lies in range (first, last]
+        uint32_t low = first + 1;
+        uint32_t high = last;
+        while (low < high)
+        {
+            const uint32_t mid = low + (high - low) / 2;
+            if (times[mid] <= time)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        const uint32_t a = low - 1;
+        const uint32_t b = low;
+        const float span = times[b] - times[a];
+        const float factor = span > 0.0f ? (time - times[a]) / span : 0.0f;
+
+        glm_vec3_lerp(clip->translations[a], clip->translations[b], factor, translation);
+        glm_vec3_lerp(clip->scales[a], clip->scales[b], factor, scale);
+        if (nlerp)
+            glm_quat_nlerp(clip->rotations[a], clip->rotations[b], factor, rotation);
+        else
+            glm_quat_slerp(clip->rotations[a], clip->rotations[b], factor, rotation);
+    }
+
+    matrix4_compose_trs(translation, rotation, scale, dest);
+}
+
+static void palette_job(void *userData, size_t index)
+{
+    PaletteJob *job = userData;
+    const Skeleton *skeleton = job->skeleton;
+    const Py_ssize_t jointCount = skeleton->jointCount;
+    mat4 *world = job->scratch + index * jointCount;
+
+    const size_t first = index * ANIMATION_INSTANCE_CHUNK_SIZE;
+    const size_t end = first + ANIMATION_INSTANCE_CHUNK_SIZE < job->count ? first + ANIMATION_INSTANCE_CHUNK_SIZE : job->count;
+    for (size_t instance = first; instance < end; instance++)
+    {
+        const AnimationClip *clip = job->clips[instance * job->clipStride];
+        const float time = wrap_time(job->times[instance], clip->duration, job->loop);
+        char *out = job->out + instance * jointCount * sizeof(mat4);
+
+        for (Py_ssize_t i = 0; i < jointCount; i++)
+        {
+            mat4 local;
+            sample_joint(clip, i, time, job->nlerp, local);
+
+            const int32_t parent = skeleton->parents[i];
+            if (parent < 0)
+                glm_mat4_copy(local, world[i]);
+            else
+                glm_mat4_mul(world[parent], local, world[i]);
+
+            // output might be unaligned (e.g. arbitrary offset into mapped buffer)
+            if (skeleton->inverseBindMatrices != NULL)
+            {
+                mat4 skin;
+                glm_mat4_mul(world[i], skeleton->inverseBindMatrices[i], skin);
+                memcpy(out + i * sizeof(mat4), skin, sizeof(mat4));
+            }
+            else
+            {
+                memcpy(out + i * sizeof(mat4), world[i], sizeof(mat4));
+            }
+        }
+    }
+}
+
+static bool get_float_array(PyObject *obj, Py_ssize_t components, Py_ssize_t count, const char *name, void *dest)
+{
+    Py_buffer buf;
+    Py_ssize_t bufCount = 0;
+    if (!utils_get_float_buffer(obj, components, &buf, &bufCount))
+        return false;
+
+    if (bufCount != count)
+    {
+        PyBuffer_Release(&buf);
+        PyErr_Format(PyExc_ValueError, "Expected %zd %s, got: %zd.", count, name, bufCount);
+        return false;
+    }
+
+    memcpy(dest, buf.buf, buf.len);
+
+    PyBuffer_Release(&buf);
+    return true;
+}
+
+static int clip_init(AnimationClip *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"key_offsets", "times", "translations", "rotations", "scales", NULL};
+
+    PyObject *offsetsObj = NULL;
+    PyObject *timesObj = NULL;
+    PyObject *translationsObj = NULL;
+    PyObject *rotationsObj = NULL;
+    PyObject *scalesObj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOO|O", kwNames, &offsetsObj, &timesObj, &translationsObj, &rotationsObj, &scalesObj))
+        return -1;
+
+    // clips are read without the GIL while palettes are computed, so their data cannot be replaced
+    THROW_IF(self->keyOffsets != NULL, PyExc_RuntimeError, "Animation clip is already initialized.", -1);
+
+    PyObject *offsets = PySequence_Fast(offsetsObj, "Key offsets have to be a sequence of integers.");
+    if (!offsets)
+        return -1;
+
+    uint32_t *keyOffsets = NULL;
+    float *times = NULL;
+    vec3 *translations = NULL;
+    vec3 *scales = NULL;
+    versor *rotations = NULL;
+
+    const Py_ssize_t offsetCount = PySequence_Fast_GET_SIZE(offsets);
+    THROW_IF_GOTO(offsetCount < 2, PyExc_ValueError, "Key offsets have to contain at least 2 elements.", fail);
+
+    keyOffsets = PyMem_Malloc(sizeof(uint32_t) * offsetCount);
+    if (!keyOffsets)
+    {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    for (Py_ssize_t i = 0; i < offsetCount; i++)
+    {
+        const long long value = PyLong_AsLongLong(PySequence_Fast_GET_ITEM(offsets, i));
+        if (value == -1 && PyErr_Occurred())
+            goto fail;
+
+        if ((i == 0 && value != 0) || (i > 0 && value <= keyOffsets[i - 1]) || value > UINT32_MAX)
+        {
+            PyErr_SetString(PyExc_ValueError, "Key offsets have to start at 0 and every joint has to have at least one key.");
+            goto fail;
+        }
+
+        keyOffsets[i] = (uint32_t)value;
+    }
+
+    const Py_ssize_t keyCount = keyOffsets[offsetCount - 1];
+    times = PyMem_Malloc(sizeof(float) * keyCount);
+    translations = PyMem_Malloc(sizeof(vec3) * keyCount);
+    scales = PyMem_Malloc(sizeof(vec3) * keyCount);
+    rotations = utils_aligned_malloc(sizeof(versor) * keyCount, _ROTATIONS_ALIGNMENT);
+    if (!times || !translations || !scales || !rotations)
+    {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    if (!get_float_array(timesObj, 1, keyCount, "key times", times) ||
+        !get_float_array(translationsObj, 3, keyCount, "translations", translations) ||
+        !get_float_array(rotationsObj, 4, keyCount, "rotations", rotations))
+        goto fail;
+
+    if (scalesObj != Py_None)
+    {
+        if (!get_float_array(scalesObj, 3, keyCount, "scales", scales))
+            goto fail;
+    }
+    else
+    {
+        for (Py_ssize_t i = 0; i < keyCount; i++)
+            glm_vec3_one(scales[i]);
+    }
+
+    float duration = 0.0f;
+    for (Py_ssize_t i = 0; i < offsetCount - 1; i++)
+    {
+        for (uint32_t j = keyOffsets[i] + 1; j < keyOffsets[i + 1]; j++)
+        {
+            if (times[j] < times[j - 1])
+            {
+                PyErr_Format(PyExc_ValueError, "Key times of joint %zd are not sorted.", i);
+                goto fail;
+            }
+        }
+
+        if (times[keyOffsets[i + 1] - 1] > duration)
+            duration = times[keyOffsets[i + 1] - 1];
+    }
+
+    Py_DECREF(offsets);
+
+    self->jointCount = offsetCount - 1;
+    self->keyCount = keyCount;
+    self->duration = duration;
+    self->keyOffsets = keyOffsets;
+    self->times = times;
+    self->translations = translations;
+    self->rotations = rotations;
+    self->scales = scales;
+
+    return 0;
+
+fail:
+    Py_DECREF(offsets);
+    PyMem_Free(keyOffsets);
+    PyMem_Free(times);
+    PyMem_Free(translations);
+    PyMem_Free(scales);
+    utils_aligned_free(rotations);
+    return -1;
+}
+
+static void clip_dealloc(AnimationClip *self)
+{
+    PyMem_Free(self->keyOffsets);
+    PyMem_Free(self->times);
+    PyMem_Free(self->translations);
+    PyMem_Free(self->scales);
+    utils_aligned_free(self->rotations);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+static bool check_clip_initialized(AnimationClip *clip)
+{
+    THROW_IF(clip->keyOffsets == NULL, PyExc_RuntimeError, "Animation clip is not initialized.", false);
+    return true;
+}
+
+static PyObject *clip_sample(AnimationClip *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"time", "loop", "nlerp", "out", "offset", NULL};
+
+    float time = 0.0f;
+    int loop = 1;
+    int nlerp = 0;
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "f|$ppOn", kwNames, &time, &loop, &nlerp, &out, &offset) ||
+        !check_clip_initialized(self))
+        return NULL;
+
+    PyObject *result = NULL;
+    WriteTarget target;
+    char *outData = py_matrix4_array_acquire_output(out, offset, self->jointCount, &target, &result);
+    if (!outData)
+        return NULL;
+
+    time = wrap_time(time, self->duration, loop);
+    for (Py_ssize_t i = 0; i < self->jointCount; i++)
+    {
+        mat4 local;
+        sample_joint(self, i, time, nlerp, local);
+        memcpy(outData + i * sizeof(mat4), local, sizeof(mat4));
+    }
+
+    if (result == Py_None)
+        py_buffer_release_write_target(&target);
+
+    return result;
+}
+
+static int skeleton_init(Skeleton *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"parents", "inverse_bind_matrices", NULL};
+
+    PyObject *parentsObj = NULL;
+    PyObject *inverseBindObj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwNames, &parentsObj, &inverseBindObj))
+        return -1;
+
+    THROW_IF(self->parents != NULL, PyExc_RuntimeError, "Skeleton is already initialized.", -1);
+
+    PyObject *parentsSeq = PySequence_Fast(parentsObj, "Parents have to be a sequence of integers.");
+    if (!parentsSeq)
+        return -1;
+
+    const Py_ssize_t jointCount = PySequence_Fast_GET_SIZE(parentsSeq);
+    int32_t *parents = PyMem_Malloc(sizeof(int32_t) * (jointCount > 0 ? jointCount : 1));
+    mat4 *inverseBind = NULL;
+    if (!parents)
+    {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    for (Py_ssize_t i = 0; i < jointCount; i++)
+    {
+        const long parent = PyLong_AsLong(PySequence_Fast_GET_ITEM(parentsSeq, i));
+        if (parent == -1 && PyErr_Occurred())
+            goto fail;
+
+        // requiring parents to precede their children lets the hierarchy be resolved in a single pass
+        if (parent < -1 || parent >= i)
+        {
+            PyErr_Format(PyExc_ValueError, "Parent of joint %zd has to be -1 or index of one of preceding joints, got: %ld.", i, parent);
+            goto fail;
+        }
+
+        parents[i] = (int32_t)parent;
+    }
+
+    if (inverseBindObj != Py_None)
+    {
+        inverseBind = utils_aligned_malloc(sizeof(mat4) * (jointCount > 0 ? jointCount : 1), MATRIX_ARRAY_ALIGNMENT);
+        if (!inverseBind)
+        {
+            PyErr_NoMemory();
+            goto fail;
+        }
+
+        if (!get_float_array(inverseBindObj, 16, jointCount, "inverse bind matrices", inverseBind))
+            goto fail;
+    }
+
+    Py_DECREF(parentsSeq);
+
+    self->jointCount = jointCount;
+    self->parents = parents;
+    self->inverseBindMatrices = inverseBind;
+
+    return 0;
+
+fail:
+    Py_DECREF(parentsSeq);
+    PyMem_Free(parents);
+    utils_aligned_free(inverseBind);
+    return -1;
+}
+
+static void skeleton_dealloc(Skeleton *self)
+{
+    PyMem_Free(self->parents);
+    utils_aligned_free(self->inverseBindMatrices);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *skeleton_parents_get(Skeleton *self, void *Py_UNUSED(closure))
+{
+    PyObject *result = PyTuple_New(self->jointCount);
+    if (!result)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->jointCount; i++)
+    {
+        PyObject *parent = PyLong_FromLong(self->parents[i]);
+        if (!parent)
+        {
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        PyTuple_SET_ITEM(result, i, parent);
+    }
+
+    return result;
+}
+
+static PyObject *compute_palettes(Skeleton *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"clips", "times", "out", "offset", "loop", "nlerp", NULL};
+
+    PyObject *clipsObj = NULL;
+    PyObject *timesObj = NULL;
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    int loop = 1;
+    int nlerp = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|$Onpp", kwNames, &clipsObj, &timesObj, &out, &offset, &loop, &nlerp))
+        return NULL;
+
+    THROW_IF(self->parents == NULL, PyExc_RuntimeError, "Skeleton is not initialized.", NULL);
+
+    PyObject *result = NULL;
+    PyObject *clipsSeq = NULL;
+    Py_buffer times = {0};
+    float singleTime = 0.0f;
+    PaletteJob job = {
+        .skeleton = self,
+        .loop = loop,
+        .nlerp = nlerp,
+    };
+
+    if (PyFloat_Check(timesObj) || PyLong_Check(timesObj))
+    {
+        if (!utils_as_float(timesObj, &singleTime))
+            return NULL;
+
+        job.times = &singleTime;
+        job.count = 1;
+    }
+    else
+    {
+        Py_ssize_t count = 0;
+        if (!utils_get_float_buffer(timesObj, 1, &times, &count))
+            return NULL;
+
+        job.times = times.buf;
+        job.count = count;
+    }
+
+    AnimationClip *singleClip = NULL;
+    if (Py_IS_TYPE(clipsObj, &pyAnimationClipType))
+    {
+        singleClip = (AnimationClip *)clipsObj;
+        job.clips = &singleClip;
+        job.clipStride = 0;
+    }
+    else
+    {
+        // tuple keeps clips alive even if the original sequence is modified while sampling without the GIL
+        clipsSeq = PySequence_Tuple(clipsObj);
+        if (!clipsSeq)
+            goto end;
+
+        THROW_IF_GOTO(
+            (size_t)PyTuple_GET_SIZE(clipsSeq) != job.count,
+            PyExc_ValueError,
+            "Number of clips has to match number of sample times.",
+            end);
+
+        job.clips = (AnimationClip **)PySequence_Fast_ITEMS(clipsSeq);
+        job.clipStride = 1;
+    }
+
+    for (size_t i = 0; i < (job.clipStride ? job.count : 1); i++)
+    {
+        PyObject *clip = (PyObject *)job.clips[i];
+        if (!utils_check_arg_type(clip, &pyAnimationClipType, "clips") || !check_clip_initialized((AnimationClip *)clip))
+            goto end;
+
+        if (((AnimationClip *)clip)->jointCount != self->jointCount)
+        {
+            PyErr_Format(PyExc_ValueError, "Clip animates %zd joints, but skeleton has %zd.", ((AnimationClip *)clip)->jointCount, self->jointCount);
+            goto end;
+        }
+    }
+
+    const size_t chunkCount = (job.count + ANIMATION_INSTANCE_CHUNK_SIZE - 1) / ANIMATION_INSTANCE_CHUNK_SIZE;
+    // empty aligned allocation may return NULL, so at least one matrix is allocated for skeletons without joints
+    const size_t scratchCount = self->jointCount * chunkCount;
+    job.scratch = utils_aligned_malloc(sizeof(mat4) * (scratchCount > 0 ? scratchCount : 1), MATRIX_ARRAY_ALIGNMENT);
+    if (!job.scratch)
+    {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    WriteTarget target;
+    job.out = py_matrix4_array_acquire_output(out, offset, job.count * self->jointCount, &target, &result);
+    if (!job.out)
+        goto end;
+
+    if (job.count * self->jointCount >= ANIMATION_PARALLEL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        thread_pool_run(palette_job, &job, chunkCount);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        for (size_t i = 0; i < chunkCount; i++)
+            palette_job(&job, i);
+    }
+
+    if (result == Py_None)
+        py_buffer_release_write_target(&target);
+
+end:
+    utils_aligned_free(job.scratch);
+    Py_XDECREF(clipsSeq);
+    if (times.obj != NULL)
+        PyBuffer_Release(&times);
+
+    return result;
+}
+
+PyTypeObject pyAnimationClipType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.AnimationClip",
+    .tp_basicsize = sizeof(AnimationClip),
+    .tp_init = (initproc)clip_init,
+    .tp_dealloc = (destructor)clip_dealloc,
+    .tp_members = (PyMemberDef[]){
+        {"joint_count", Py_T_PYSSIZET, offsetof(AnimationClip, jointCount), Py_READONLY, NULL},
+        {"key_count", Py_T_PYSSIZET, offsetof(AnimationClip, keyCount), Py_READONLY, NULL},
+        {"duration", Py_T_FLOAT, offsetof(AnimationClip, duration), Py_READONLY, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"sample", (PyCFunction)clip_sample, METH_VARARGS | METH_KEYWORDS, NULL},
+        {0},
+    },
+};
+
+PyTypeObject pySkeletonType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.Skeleton",
+    .tp_basicsize = sizeof(Skeleton),
+    .tp_init = (initproc)skeleton_init,
+    .tp_dealloc = (destructor)skeleton_dealloc,
+    .tp_members = (PyMemberDef[]){
+        {"joint_count", Py_T_PYSSIZET, offsetof(Skeleton, jointCount), Py_READONLY, NULL},
+        {0},
+    },
+    .tp_getset = (PyGetSetDef[]){
+        {"parents", (getter)skeleton_parents_get, NULL, NULL, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"compute_palettes", (PyCFunction)compute_palettes, METH_VARARGS | METH_KEYWORDS, NULL},
+        {0},
+    },
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+#include <Python.h>
+#include <cglm/types.h>
+
+// Number of joints (summed over all sampled instances) above which palette computation releases the GIL
+// and is split across the thread pool.
+#define ANIMATION_PARALLEL_THRESHOLD 4096
+// Number of instances processed by a single thread pool job.
+#define ANIMATION_INSTANCE_CHUNK_SIZE 8
+
+typedef struct
+{
+    PyObject_HEAD
+    Py_ssize_t jointCount;
+    Py_ssize_t keyCount;
+    float duration;
+    // keys of joint `i` are stored in range [keyOffsets[i], keyOffsets[i + 1])
+    uint32_t *keyOffsets;
+    float *times;
+    vec3 *translations;
+    versor *rotations;
+    vec3 *scales;
+} AnimationClip;
+
+typedef struct
+{
+    PyObject_HEAD
+    Py_ssize_t jointCount;
+    // parent of every joint is stored before it, roots have parent -1
+    int32_t *parents;
+    mat4 *inverseBindMatrices;
+} Skeleton;
+
+extern PyTypeObject pyAnimationClipType;
+extern PyTypeObject pySkeletonType;
@@ -0,0 +1,1112 @@
+#include "bvh.h"
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "frustum.h"
+#include "../threadPool.h"
+#include "../utility.h"
+
+#define _SELF BVH *self
+#define _AABB_COMPONENTS 6
+#define _AABB_SIZE (sizeof(float) * _AABB_COMPONENTS)
+#define _IS_LEAF(node) ((node)->count != 0)
+// Node indices have to fit into 32 bits, and full binary tree has at most 2n - 1 nodes.
+#define _MAX_PRIMITIVES (UINT32_MAX / 2)
+#define _CENTROID_CHUNK_SIZE 65536
+#define _MISS_INDEX UINT32_MAX
+
+typedef struct
+{
+    uint32_t node;
+    uint32_t first;
+    uint32_t count;
+    uint32_t depth;
+} BuildTask;
+
+typedef struct
+{
+    BuildTask *data;
+    size_t count;
+    size_t capacity;
+} TaskList;
+
+typedef struct
+{
+    uint32_t *data;
+    size_t count;
+    size_t capacity;
+} IndexList;
+
+typedef struct
+{
+    BVHNode *data;
+    size_t count;
+} NodeList;
+
+typedef struct
+{
+    const float *aabbs;
+    float *centroids;
+    uint32_t *indices;
+    size_t count;
+    size_t maxLeafSize;
+    // nodes with at most this many primitives are deferred to be built in parallel, 0 disables deferring
+    size_t deferThreshold;
+} BuildContext;
+
+typedef struct
+{
+    BuildContext *context;
+    BuildTask *tasks;
+    NodeList *subtrees;
+    size_t *depths;
+    bool *failed;
+} SubtreeBuild;
+
+typedef struct
+{
+    int axis;
+    int bin;
+    float cost;
+} Split;
+
+static bool task_list_push(TaskList *list, BuildTask task)
+{
+    if (list->count == list->capacity)
+    {
+        size_t capacity = list->capacity ? list->capacity * 2 : 64;
+        BuildTask *data = PyMem_RawRealloc(list->data, sizeof(BuildTask) * capacity);
+        if (!data)
+            return false;
+
+        list->data = data;
+        list->capacity = capacity;
+    }
+
+    list->data[list->count++] = task;
+    return true;
+}
+
+static bool index_list_push(IndexList *list, const uint32_t *indices, size_t count)
+{
+    if (list->count + count > list->capacity)
+    {
+        size_t capacity = list->capacity ? list->capacity : 256;
+        while (capacity < list->count + count)
+            capacity *= 2;
+
+        uint32_t *data = PyMem_RawRealloc(list->data, sizeof(uint32_t) * capacity);
+        if (!data)
+            return false;
+
+        list->data = data;
+        list->capacity = capacity;
+    }
+
+    memcpy(list->data + list->count, indices, sizeof(uint32_t) * count);
+    list->count += count;
+    return true;
+}
+
+static inline void bounds_reset(float *min, float *max)
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        min[i] = FLT_MAX;
+        max[i] = -FLT_MAX;
+    }
+}
+
+static inline void bounds_grow(float *min, float *max, const float *otherMin, const float *otherMax)
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        // plain comparisons instead of fminf/fmaxf, which have to handle NaNs and compile to library calls
+        min[i] = otherMin[i] < min[i] ? otherMin[i] : min[i];
+        max[i] = otherMax[i] > max[i] ? otherMax[i] : max[i];
+    }
+}
+
+static inline float bounds_area(const float *min, const float *max)
+{
+    const float x = max[0] - min[0];
+    const float y = max[1] - min[1];
+    const float z = max[2] - min[2];
+
+    if (x < 0.0f || y < 0.0f || z < 0.0f)
+        return 0.0f;
+
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+static inline bool bounds_overlap(const float *min, const float *max, const float *aabb)
+{
+    return min[0] <= aabb[3] && max[0] >= aabb[0] &&
+           min[1] <= aabb[4] && max[1] >= aabb[1] &&
+           min[2] <= aabb[5] && max[2] >= aabb[2];
+}
+
+static inline int bin_index(float centroid, float centroidMin, float scale)
+{
+    int bin = (int)((centroid - centroidMin) * scale);
+    return bin < BVH_BIN_COUNT ? bin : BVH_BIN_COUNT - 1;
+}
+
+// Evaluates surface area heuristic for BVH_BIN_COUNT - 1 candidate planes on each axis with non-zero centroid extent.
+// All axes are binned in a single pass over primitives. Returns false if all centroids are the same and primitives
+// cannot be split by any plane.
+static bool find_split(BuildContext *context, const BuildTask *task, const float *centroidMin, const float *centroidMax, Split *split)
+{
+    uint32_t binCounts[3][BVH_BIN_COUNT] = {0};
+    float binMin[3][BVH_BIN_COUNT][3];
+    float binMax[3][BVH_BIN_COUNT][3];
+    float scales[3];
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const float extent = centroidMax[axis] - centroidMin[axis];
+        scales[axis] = extent > 0.0f ? BVH_BIN_COUNT / extent : 0.0f;
+
+        for (size_t i = 0; i < BVH_BIN_COUNT; i++)
+            bounds_reset(binMin[axis][i], binMax[axis][i]);
+    }
+
+    for (uint32_t i = task->first; i < task->first + task->count; i++)
+    {
+        const uint32_t primitive = context->indices[i];
+        const float *aabb = context->aabbs + primitive * _AABB_COMPONENTS;
+        const float *centroid = context->centroids + primitive * 3;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const int bin = bin_index(centroid[axis], centroidMin[axis], scales[axis]);
+            binCounts[axis][bin]++;
+            bounds_grow(binMin[axis][bin], binMax[axis][bin], aabb, aabb + 3);
+        }
+    }
+
+    split->cost = FLT_MAX;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (scales[axis] == 0.0f)
+            continue;
+
+        // sweep from the right to gather costs of right sides, then from the left to evaluate whole splits
+        float rightCosts[BVH_BIN_COUNT];
+        float min[3];
+        float max[3];
+        uint32_t count = 0;
+        bounds_reset(min, max);
+        for (int i = BVH_BIN_COUNT - 1; i > 0; i--)
+        {
+            count += binCounts[axis][i];
+            bounds_grow(min, max, binMin[axis][i], binMax[axis][i]);
+            rightCosts[i] = count ? bounds_area(min, max) * count : FLT_MAX;
+        }
+
+        count = 0;
+        bounds_reset(min, max);
+        for (int i = 1; i < BVH_BIN_COUNT; i++)
+        {
+            count += binCounts[axis][i - 1];
+            bounds_grow(min, max, binMin[axis][i - 1], binMax[axis][i - 1]);
+            if (count == 0 || rightCosts[i] == FLT_MAX)
+                continue;
+
+            const float cost = bounds_area(min, max) * count + rightCosts[i];
+            if (cost < split->cost)
+            {
+                split->axis = axis;
+                split->bin = i;
+                split->cost = cost;
+            }
+        }
+    }
+
+    return split->cost != FLT_MAX;
+}
+
+// Builds tree rooted at `root` node depth first. If `deferred` is not NULL, nodes small enough are left as
+// placeholders and appended to `deferred` instead of being built.
+static bool build_tree(BuildContext *context, NodeList *nodes, BuildTask root, TaskList *deferred, size_t *maxDepth)
+{
+    TaskList stack = {0};
+    if (!task_list_push(&stack, root))
+        return false;
+
+    bool result = true;
+    while (stack.count > 0)
+    {
+        const BuildTask task = stack.data[--stack.count];
+        if (task.depth > *maxDepth)
+            *maxDepth = task.depth;
+
+        BVHNode *node = &nodes->data[task.node];
+        float centroidMin[3];
+        float centroidMax[3];
+        bounds_reset(node->min, node->max);
+        bounds_reset(centroidMin, centroidMax);
+        for (uint32_t i = task.first; i < task.first + task.count; i++)
+        {
+            const uint32_t primitive = context->indices[i];
+            const float *aabb = context->aabbs + primitive * _AABB_COMPONENTS;
+            const float *centroid = context->centroids + primitive * 3;
+
+            bounds_grow(node->min, node->max, aabb, aabb + 3);
+            bounds_grow(centroidMin, centroidMax, centroid, centroid);
+        }
+
+        // every node starts as a leaf and is turned into internal node if split is worth it
+        node->offset = task.first;
+        node->count = task.count;
+
+        if (task.count <= 1)
+            continue;
+
+        if (deferred != NULL && task.count <= context->deferThreshold)
+        {
+            if (!task_list_push(deferred, task))
+            {
+                result = false;
+                break;
+            }
+
+            continue;
+        }
+
+        uint32_t mid;
+        Split split;
+        if (find_split(context, &task, centroidMin, centroidMax, &split))
+        {
+            // cost of traversing a node is assumed to be equal to cost of testing a single primitive
+            const float nodeArea = bounds_area(node->min, node->max);
+            const float splitCost = 1.0f + (nodeArea > 0.0f ? split.cost / nodeArea : 0.0f);
+            if (task.count <= context->maxLeafSize && (float)task.count <= splitCost)
+                continue;
+
+            const float scale = BVH_BIN_COUNT / (centroidMax[split.axis] - centroidMin[split.axis]);
+            uint32_t *begin = context->indices + task.first;
+            uint32_t *end = begin + task.count;
+            while (begin < end)
+            {
+                const float centroid = context->centroids[*begin * 3 + split.axis];
+                if (bin_index(centroid, centroidMin[split.axis], scale) < split.bin)
+                {
+                    begin++;
+                }
+                else
+                {
+                    uint32_t tmp = *--end;
+                    *end = *begin;
+                    *begin = tmp;
+                }
+            }
+
+            mid = (uint32_t)(begin - context->indices);
+        }
+        else
+        {
+            if (task.count <= context->maxLeafSize)
+                continue;
+
+            // primitives share the same centroid, any partition is equally good
+            mid = task.first + task.count / 2;
+        }
+
+        const uint32_t left = (uint32_t)nodes->count;
+        nodes->count += 2;
+        node->offset = left;
+        node->count = 0;
+
+        // right child is pushed first, so that left subtree is laid out right after its parent
+        if (!task_list_push(&stack, (BuildTask){left + 1, mid, task.first + task.count - mid, task.depth + 1}) ||
+            !task_list_push(&stack, (BuildTask){left, task.first, mid - task.first, task.depth + 1}))
+        {
+            result = false;
+            break;
+        }
+    }
+
+    PyMem_RawFree(stack.data);
+    return result;
+}
+
+static void build_subtree_job(void *userData, size_t index)
+{
+    SubtreeBuild *build = userData;
+    const BuildTask task = build->tasks[index];
+    NodeList *nodes = &build->subtrees[index];
+
+    nodes->data = PyMem_RawMalloc(sizeof(BVHNode) * (2 * task.count - 1));
+    nodes->count = 1;
+    build->depths[index] = 0;
+    build->failed[index] = nodes->data == NULL ||
+                           !build_tree(build->context, nodes, (BuildTask){0, task.first, task.count, task.depth}, NULL, &build->depths[index]);
+}
+
+static void centroids_job(void *userData, size_t index)
+{
+    BuildContext *context = userData;
+    const size_t first = index * _CENTROID_CHUNK_SIZE;
+    const size_t end = first + _CENTROID_CHUNK_SIZE < context->count ? first + _CENTROID_CHUNK_SIZE : context->count;
+
+    for (size_t i = first; i < end; i++)
+    {
+        const float *aabb = context->aabbs + i * _AABB_COMPONENTS;
+        float *centroid = context->centroids + i * 3;
+        centroid[0] = (aabb[0] + aabb[3]) * 0.5f;
+        centroid[1] = (aabb[1] + aabb[4]) * 0.5f;
+        centroid[2] = (aabb[2] + aabb[5]) * 0.5f;
+    }
+}
+
+// Copies subtrees built in parallel after the nodes built so far, replacing their placeholder nodes.
+static void merge_subtrees(NodeList *nodes, BuildTask *tasks, NodeList *subtrees, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        NodeList *subtree = &subtrees[i];
+        const uint32_t base = (uint32_t)nodes->count;
+
+        memcpy(nodes->data + base, subtree->data + 1, sizeof(BVHNode) * (subtree->count - 1));
+        nodes->data[tasks[i].node] = subtree->data[0];
+
+        // local node 0 is the placeholder, so local index n is moved to base + n - 1
+        if (!_IS_LEAF(&nodes->data[tasks[i].node]))
+            nodes->data[tasks[i].node].offset += base - 1;
+
+        for (uint32_t j = base; j < base + subtree->count - 1; j++)
+        {
+            if (!_IS_LEAF(&nodes->data[j]))
+                nodes->data[j].offset += base - 1;
+        }
+
+        nodes->count += subtree->count - 1;
+    }
+}
+
+static void gather_bounds(_SELF, const float *aabbs)
+{
+    for (Py_ssize_t i = 0; i < self->primitiveCount; i++)
+        memcpy(self->bounds + i * _AABB_COMPONENTS, aabbs + self->indices[i] * _AABB_COMPONENTS, _AABB_SIZE);
+}
+
+// Builds tree into `self`, which arrays have to be allocated for `count` primitives.
+static bool build(_SELF, const float *aabbs, size_t count)
+{
+    const size_t threadCount = thread_pool_get_thread_count();
+    BuildContext context = {
+        .aabbs = aabbs,
+        .centroids = PyMem_RawMalloc(sizeof(float) * 3 * count),
+        .indices = self->indices,
+        .count = count,
+        .maxLeafSize = self->maxLeafSize,
+        .deferThreshold = 0,
+    };
+    if (!context.centroids)
+        return false;
+
+    if (count >= BVH_PARALLEL_BUILD_THRESHOLD && threadCount > 1)
+    {
+        context.deferThreshold = count / (threadCount * 4);
+        if (context.deferThreshold < 1024)
+            context.deferThreshold = 1024;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        self->indices[i] = (uint32_t)i;
+
+    thread_pool_run(centroids_job, &context, (count + _CENTROID_CHUNK_SIZE - 1) / _CENTROID_CHUNK_SIZE);
+
+    NodeList nodes = {.data = self->nodes, .count = 1};
+    TaskList deferred = {0};
+    size_t depth = 0;
+    bool result = build_tree(&context, &nodes, (BuildTask){0, 0, (uint32_t)count, 0}, &deferred, &depth);
+
+    if (result && deferred.count > 0)
+    {
+        SubtreeBuild subtreeBuild = {
+            .context = &context,
+            .tasks = deferred.data,
+            .subtrees = PyMem_RawCalloc(deferred.count, sizeof(NodeList)),
+            .depths = PyMem_RawCalloc(deferred.count, sizeof(size_t)),
+            .failed = PyMem_RawCalloc(deferred.count, sizeof(bool)),
+        };
+
+        result = subtreeBuild.subtrees && subtreeBuild.depths && subtreeBuild.failed;
+        if (result)
+        {
+            thread_pool_run(build_subtree_job, &subtreeBuild, deferred.count);
+
+            for (size_t i = 0; i < deferred.count; i++)
+            {
+                result &= !subtreeBuild.failed[i];
+                if (subtreeBuild.depths[i] > depth)
+                    depth = subtreeBuild.depths[i];
+            }
+
+            if (result)
+                merge_subtrees(&nodes, deferred.data, subtreeBuild.subtrees, deferred.count);
+
+            for (size_t i = 0; i < deferred.count; i++)
+                PyMem_RawFree(subtreeBuild.subtrees[i].data);
+        }
+
+        PyMem_RawFree(subtreeBuild.subtrees);
+        PyMem_RawFree(subtreeBuild.depths);
+        PyMem_RawFree(subtreeBuild.failed);
+    }
+
+    PyMem_RawFree(deferred.data);
+    PyMem_RawFree(context.centroids);
+
+    if (!result)
+        return false;
+
+    self->nodeCount = nodes.count;
+    self->depth = depth;
+    gather_bounds(self, aabbs);
+
+    return true;
+}
+
+static void refit_kernel(_SELF, const float *aabbs)
+{
+    gather_bounds(self, aabbs);
+
+    // children are always stored after their parents, so iterating backwards visits them first
+    for (Py_ssize_t i = self->nodeCount - 1; i >= 0; i--)
+    {
+        BVHNode *node = &self->nodes[i];
+        bounds_reset(node->min, node->max);
+
+        if (_IS_LEAF(node))
+        {
+            for (uint32_t j = node->offset; j < node->offset + node->count; j++)
+            {
+                const float *aabb = self->bounds + j * _AABB_COMPONENTS;
+                bounds_grow(node->min, node->max, aabb, aabb + 3);
+            }
+        }
+        else
+        {
+            const BVHNode *left = &self->nodes[node->offset];
+            const BVHNode *right = left + 1;
+            bounds_grow(node->min, node->max, left->min, left->max);
+            bounds_grow(node->min, node->max, right->min, right->max);
+        }
+    }
+}
+
+static void free_tree(_SELF)
+{
+    PyMem_RawFree(self->nodes);
+    PyMem_RawFree(self->indices);
+    PyMem_RawFree(self->bounds);
+
+    self->nodes = NULL;
+    self->indices = NULL;
+    self->bounds = NULL;
+    self->nodeCount = 0;
+    self->primitiveCount = 0;
+    self->depth = 0;
+}
+
+static bool check_not_in_use(_SELF)
+{
+    THROW_IF(
+        self->activeQueries > 0 || self->isModified,
+        PyExc_RuntimeError,
+        "BVH cannot be modified while it is being queried or modified by another thread.",
+        false);
+
+    return true;
+}
+
+static int init(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"aabbs", "max_leaf_size", NULL};
+
+    PyObject *aabbsObj = NULL;
+    Py_ssize_t maxLeafSize = 4;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", kwNames, &aabbsObj, &maxLeafSize))
+        return -1;
+
+    THROW_IF(maxLeafSize < 1, PyExc_ValueError, "Maximum leaf size has to be at least 1.", -1);
+
+    if (!check_not_in_use(self))
+        return -1;
+
+    Py_buffer aabbs;
+    Py_ssize_t count = 0;
+    if (!utils_get_float_buffer(aabbsObj, _AABB_COMPONENTS, &aabbs, &count))
+        return -1;
+
+    if ((size_t)count > _MAX_PRIMITIVES)
+    {
+        PyBuffer_Release(&aabbs);
+        PyErr_SetString(PyExc_OverflowError, "Too many primitives to build BVH.");
+        return -1;
+    }
+
+    free_tree(self);
+    self->maxLeafSize = maxLeafSize;
+
+    if (count == 0)
+    {
+        PyBuffer_Release(&aabbs);
+        return 0;
+    }
+
+    self->nodes = PyMem_RawMalloc(sizeof(BVHNode) * (2 * count - 1));
+    self->indices = PyMem_RawMalloc(sizeof(uint32_t) * count);
+    self->bounds = PyMem_RawMalloc(_AABB_SIZE * count);
+    self->primitiveCount = count;
+
+    bool result = self->nodes && self->indices && self->bounds;
+    if (result)
+    {
+        self->isModified = true;
+
+        if (count >= BVH_RELEASE_GIL_THRESHOLD)
+        {
+            Py_BEGIN_ALLOW_THREADS;
+            result = build(self, aabbs.buf, count);
+            Py_END_ALLOW_THREADS;
+        }
+        else
+        {
+            result = build(self, aabbs.buf, count);
+        }
+
+        self->isModified = false;
+    }
+
+    PyBuffer_Release(&aabbs);
+
+    if (!result)
+    {
+        free_tree(self);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    return 0;
+}
+
+static void dealloc(_SELF)
+{
+    free_tree(self);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *refit(_SELF, PyObject *aabbsObj)
+{
+    if (!check_not_in_use(self))
+        return NULL;
+
+    Py_buffer aabbs;
+    Py_ssize_t count = 0;
+    if (!utils_get_float_buffer(aabbsObj, _AABB_COMPONENTS, &aabbs, &count))
+        return NULL;
+
+    if (count != self->primitiveCount)
+    {
+        PyBuffer_Release(&aabbs);
+        PyErr_Format(PyExc_ValueError, "Expected %zd bounding boxes, got: %zd.", self->primitiveCount, count);
+        return NULL;
+    }
+
+    self->isModified = true;
+
+    if (count >= BVH_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        refit_kernel(self, aabbs.buf);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        refit_kernel(self, aabbs.buf);
+    }
+
+    self->isModified = false;
+    PyBuffer_Release(&aabbs);
+
+    Py_RETURN_NONE;
+}
+
+static bool begin_query(_SELF)
+{
+    THROW_IF(
+        self->isModified,
+        PyExc_RuntimeError,
+        "BVH cannot be queried while it is being modified by another thread.",
+        false);
+
+    self->activeQueries++;
+    return true;
+}
+
+static PyObject *end_query(_SELF, PyObject *result)
+{
+    self->activeQueries--;
+    return result;
+}
+
+static PyObject *index_list_to_view(IndexList *list)
+{
+    void *data = NULL;
+    PyObject *result = utils_new_typed_view(list->count, "I", sizeof(uint32_t), &data);
+    if (result && list->count > 0)
+        memcpy(data, list->data, sizeof(uint32_t) * list->count);
+
+    PyMem_RawFree(list->data);
+    return result;
+}
+
+static inline void node_aabb(const BVHNode *node, float *aabb)
+{
+    memcpy(aabb, node->min, sizeof(float) * 3);
+    memcpy(aabb + 3, node->max, sizeof(float) * 3);
+}
+
+// Returns range of primitives contained by subtree rooted at `index`. Primitives of every subtree are stored
+// contiguously, so it is enough to find leftmost and rightmost leaf.
+static void subtree_range(_SELF, uint32_t index, uint32_t *first, uint32_t *end)
+{
+    const BVHNode *node = &self->nodes[index];
+    while (!_IS_LEAF(node))
+        node = &self->nodes[node->offset];
+    *first = node->offset;
+
+    node = &self->nodes[index];
+    while (!_IS_LEAF(node))
+        node = &self->nodes[node->offset + 1];
+    *end = node->offset + node->count;
+}
+
+static bool query_frustum_kernel(_SELF, const FrustumLanes *lanes, uint32_t *stack, IndexList *result)
+{
+    size_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const uint32_t index = stack[--top];
+        const BVHNode *node = &self->nodes[index];
+
+        float aabb[_AABB_COMPONENTS];
+        node_aabb(node, aabb);
+
+        const FrustumTestResult test = frustum_aabb_test(lanes, aabb);
+        if (test == FRUSTUM_OUTSIDE)
+            continue;
+
+        if (test == FRUSTUM_INSIDE)
+        {
+            uint32_t first, end;
+            subtree_range(self, index, &first, &end);
+            if (!index_list_push(result, self->indices + first, end - first))
+                return false;
+        }
+        else if (_IS_LEAF(node))
+        {
+            for (uint32_t i = node->offset; i < node->offset + node->count; i++)
+            {
+                if (frustum_aabb_test(lanes, self->bounds + i * _AABB_COMPONENTS) != FRUSTUM_OUTSIDE &&
+                    !index_list_push(result, &self->indices[i], 1))
+                    return false;
+            }
+        }
+        else
+        {
+            stack[top++] = node->offset + 1;
+            stack[top++] = node->offset;
+        }
+    }
+
+    return true;
+}
+
+static PyObject *query_frustum(_SELF, PyObject *frustum)
+{
+    if (!utils_check_arg_type(frustum, &pyFrustumType, "frustum") || !begin_query(self))
+        return NULL;
+
+    IndexList result = {0};
+    if (self->nodeCount == 0)
+        return end_query(self, index_list_to_view(&result));
+
+    FrustumLanes lanes;
+    frustum_get_lanes((Frustum *)frustum, &lanes);
+
+    // depth first traversal never holds more than one pending node per level
+    uint32_t *stack = PyMem_RawMalloc(sizeof(uint32_t) * (self->depth + 2));
+    if (!stack)
+        return end_query(self, PyErr_NoMemory());
+
+    bool success;
+    if (self->primitiveCount >= BVH_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        success = query_frustum_kernel(self, &lanes, stack, &result);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        success = query_frustum_kernel(self, &lanes, stack, &result);
+    }
+
+    PyMem_RawFree(stack);
+
+    if (!success)
+    {
+        PyMem_RawFree(result.data);
+        return end_query(self, PyErr_NoMemory());
+    }
+
+    return end_query(self, index_list_to_view(&result));
+}
+
+typedef struct
+{
+    BVH *bvh;
+    const float *origins;
+    const float *directions;
+    float maxDistance;
+    size_t count;
+    uint32_t *hits;
+    float *distances;
+    bool failed;
+} RayQuery;
+
+// Returns distance along the ray at which it enters the box or INFINITY if the box is missed or further than `maxDistance`.
+static inline float ray_box_distance(const float *min, const float *max, const float *origin, const float *invDirection, float maxDistance)
+{
+    float entry = 0.0f;
+    float exit = maxDistance;
+    for (size_t i = 0; i < 3; i++)
+    {
+        const float t1 = (min[i] - origin[i]) * invDirection[i];
+        const float t2 = (max[i] - origin[i]) * invDirection[i];
+        const float near = t1 < t2 ? t1 : t2;
+        const float far = t1 < t2 ? t2 : t1;
+
+        // NaN (ray parallel to the slab, starting exactly on its plane) fails both comparisons and is ignored
+        entry = near > entry ? near : entry;
+        exit = far < exit ? far : exit;
+    }
+
+    return entry <= exit ? entry : INFINITY;
+}
+
+// Finds closest primitive hit by the ray, traversing closer child first so that further subtrees can be skipped.
+static uint32_t ray_closest_hit(BVH *bvh, const float *origin, const float *direction, float maxDistance, uint32_t *stack, float *distance)
+{
+    const float invDirection[3] = {1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]};
+
+    uint32_t hit = _MISS_INDEX;
+    float closest = maxDistance;
+
+    size_t top = 0;
+    if (ray_box_distance(bvh->nodes[0].min, bvh->nodes[0].max, origin, invDirection, closest) != INFINITY)
+        stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const BVHNode *node = &bvh->nodes[stack[--top]];
+        if (ray_box_distance(node->min, node->max, origin, invDirection, closest) == INFINITY)
+            continue;
+
+        if (_IS_LEAF(node))
+        {
+            for (uint32_t i = node->offset; i < node->offset + node->count; i++)
+            {
+                const float *aabb = bvh->bounds + i * _AABB_COMPONENTS;
+                const float t = ray_box_distance(aabb, aabb + 3, origin, invDirection, closest);
+                // boxes at exactly `maxDistance` count as hit, missed boxes return INFINITY which may equal it
+                if (t != INFINITY && (t < closest || (t == closest && hit == _MISS_INDEX)))
+                {
+                    closest = t;
+                    hit = bvh->indices[i];
+                }
+            }
+
+            continue;
+        }
+
+        const BVHNode *left = &bvh->nodes[node->offset];
+        const BVHNode *right = left + 1;
+        const float leftDistance = ray_box_distance(left->min, left->max, origin, invDirection, closest);
+        const float rightDistance = ray_box_distance(right->min, right->max, origin, invDirection, closest);
+
+        const bool leftFirst = leftDistance <= rightDistance;
+        const float nearDistance = leftFirst ? leftDistance : rightDistance;
+        const float farDistance = leftFirst ? rightDistance : leftDistance;
+        const uint32_t nearIndex = leftFirst ? node->offset : node->offset + 1;
+        const uint32_t farIndex = leftFirst ? node->offset + 1 : node->offset;
+
+        if (farDistance != INFINITY)
+            stack[top++] = farIndex;
+        if (nearDistance != INFINITY)
+            stack[top++] = nearIndex;
+    }
+
+    *distance = hit == _MISS_INDEX ? INFINITY : closest;
+    return hit;
+}
+
+static void query_rays_job(void *userData, size_t index)
+{
+    RayQuery *query = userData;
+    const size_t first = index * BVH_RAY_CHUNK_SIZE;
+    const size_t end = first + BVH_RAY_CHUNK_SIZE < query->count ? first + BVH_RAY_CHUNK_SIZE : query->count;
+
+    // every pending node is a sibling of a node on the current path, so stack never exceeds depth + 1
+    uint32_t *stack = PyMem_RawMalloc(sizeof(uint32_t) * (query->bvh->depth + 2));
+    if (!stack)
+    {
+        query->failed = true;
+        return;
+    }
+
+    for (size_t i = first; i < end; i++)
+    {
+        query->hits[i] = ray_closest_hit(
+            query->bvh,
+            query->origins + i * 3,
+            query->directions + i * 3,
+            query->maxDistance,
+            stack,
+            &query->distances[i]);
+    }
+
+    PyMem_RawFree(stack);
+}
+
+static PyObject *query_rays(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"origins", "directions", "max_distance", NULL};
+
+    PyObject *values[3] = {NULL, NULL, NULL};
+    float maxDistance = INFINITY;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        (values[2] != NULL && !utils_as_float(values[2], &maxDistance)))
+        return NULL;
+
+    Py_buffer origins;
+    Py_ssize_t count = 0;
+    if (!utils_get_float_buffer(values[0], 3, &origins, &count))
+        return NULL;
+
+    Py_buffer directions;
+    Py_ssize_t directionsCount = 0;
+    if (!utils_get_float_buffer(values[1], 3, &directions, &directionsCount))
+    {
+        PyBuffer_Release(&origins);
+        return NULL;
+    }
+
+    PyObject *result = NULL;
+    PyObject *hits = NULL;
+    PyObject *distances = NULL;
+    RayQuery query = {
+        .bvh = self,
+        .origins = origins.buf,
+        .directions = directions.buf,
+        .maxDistance = maxDistance,
+        .count = count,
+        .failed = false,
+    };
+
+    THROW_IF_GOTO(
+        count != directionsCount,
+        PyExc_ValueError,
+        "Number of ray origins and directions has to be the same.",
+        end);
+
+    hits = utils_new_typed_view(count, "I", sizeof(uint32_t), (void **)&query.hits);
+    distances = utils_new_typed_view(count, "f", sizeof(float), (void **)&query.distances);
+    if (!hits || !distances || !begin_query(self))
+        goto end;
+
+    if (self->nodeCount == 0)
+    {
+        for (Py_ssize_t i = 0; i < count; i++)
+        {
+            query.hits[i] = _MISS_INDEX;
+            query.distances[i] = INFINITY;
+        }
+    }
+    else if (count >= BVH_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        thread_pool_run(query_rays_job, &query, (count + BVH_RAY_CHUNK_SIZE - 1) / BVH_RAY_CHUNK_SIZE);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        for (size_t i = 0; i < (count + BVH_RAY_CHUNK_SIZE - 1) / BVH_RAY_CHUNK_SIZE; i++)
+            query_rays_job(&query, i);
+    }
+
+    end_query(self, NULL);
+
+    if (query.failed)
+    {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    result = PyTuple_Pack(2, hits, distances);
+
+end:
+    Py_XDECREF(hits);
+    Py_XDECREF(distances);
+    PyBuffer_Release(&origins);
+    PyBuffer_Release(&directions);
+
+    return result;
+}
+
+static bool query_aabbs_kernel(_SELF, const float *aabbs, size_t count, uint32_t *stack, uint32_t *offsets, IndexList *result)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float *aabb = aabbs + i * _AABB_COMPONENTS;
+        offsets[i] = (uint32_t)result->count;
+
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const BVHNode *node = &self->nodes[stack[--top]];
+            if (!bounds_overlap(node->min, node->max, aabb))
+                continue;
+
+            if (!_IS_LEAF(node))
+            {
+                stack[top++] = node->offset + 1;
+                stack[top++] = node->offset;
+                continue;
+            }
+
+            for (uint32_t j = node->offset; j < node->offset + node->count; j++)
+            {
+                const float *primitive = self->bounds + j * _AABB_COMPONENTS;
+                if (bounds_overlap(primitive, primitive + 3, aabb) && !index_list_push(result, &self->indices[j], 1))
+                    return false;
+            }
+        }
+
+        // offsets are 32-bit to be directly usable by GPU, which also limits number of results
+        if (result->count > UINT32_MAX)
+            return false;
+    }
+
+    offsets[count] = (uint32_t)result->count;
+    return true;
+}
+
+static PyObject *query_aabbs(_SELF, PyObject *aabbsObj)
+{
+    Py_buffer aabbs;
+    Py_ssize_t count = 0;
+    if (!utils_get_float_buffer(aabbsObj, _AABB_COMPONENTS, &aabbs, &count))
+        return NULL;
+
+    PyObject *result = NULL;
+    uint32_t *offsetsData = NULL;
+    PyObject *offsets = utils_new_typed_view(count + 1, "I", sizeof(uint32_t), (void **)&offsetsData);
+    uint32_t *stack = PyMem_RawMalloc(sizeof(uint32_t) * (self->depth + 2));
+    IndexList indices = {0};
+    if (!offsets || !stack || !begin_query(self))
+    {
+        if (!stack && !PyErr_Occurred())
+            PyErr_NoMemory();
+
+        goto end;
+    }
+
+    bool success = true;
+    if (self->nodeCount == 0)
+    {
+        memset(offsetsData, 0, sizeof(uint32_t) * (count + 1));
+    }
+    else if (count >= BVH_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        success = query_aabbs_kernel(self, aabbs.buf, count, stack, offsetsData, &indices);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        success = query_aabbs_kernel(self, aabbs.buf, count, stack, offsetsData, &indices);
+    }
+
+    end_query(self, NULL);
+
+    if (!success)
+    {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    PyObject *indicesView = index_list_to_view(&indices);
+    indices.data = NULL;
+    if (indicesView)
+        result = PyTuple_Pack(2, offsets, indicesView);
+
+    Py_XDECREF(indicesView);
+
+end:
+    Py_XDECREF(offsets);
+    PyMem_RawFree(stack);
+    PyMem_RawFree(indices.data);
+    PyBuffer_Release(&aabbs);
+
+    return result;
+}
+
+static PyObject *bounds_get(_SELF, void *Py_UNUSED(closure))
+{
+    void *data = NULL;
+    PyObject *result = utils_new_typed_view(_AABB_COMPONENTS, "f", sizeof(float), &data);
+    if (!result)
+        return NULL;
+
+    if (self->nodeCount == 0)
+        memset(data, 0, _AABB_SIZE);
+    else
+        node_aabb(&self->nodes[0], data);
+
+    return result;
+}
+
+PyTypeObject pyBVHType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.BVH",
+    .tp_basicsize = sizeof(BVH),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_getset = (PyGetSetDef[]){
+        {"bounds", (getter)bounds_get, NULL, NULL, NULL},
+        {0},
+    },
+    .tp_members = (PyMemberDef[]){
+        {"count", Py_T_PYSSIZET, offsetof(BVH, primitiveCount), Py_READONLY, NULL},
+        {"node_count", Py_T_PYSSIZET, offsetof(BVH, nodeCount), Py_READONLY, NULL},
+        {"depth", Py_T_PYSSIZET, offsetof(BVH, depth), Py_READONLY, NULL},
+        {"max_leaf_size", Py_T_PYSSIZET, offsetof(BVH, maxLeafSize), Py_READONLY, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"refit", (PyCFunction)refit, METH_O, NULL},
+        {"query_frustum", (PyCFunction)query_frustum, METH_O, NULL},
+        {"query_rays", (PyCFunction)query_rays, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"query_aabbs", (PyCFunction)query_aabbs, METH_O, NULL},
+        {0},
+    },
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <Python.h>
+
+// Number of primitives above which BVH build is split into subtrees built in parallel by the thread pool.
+#define BVH_PARALLEL_BUILD_THRESHOLD 16384
+// Number of primitives (or rays) above which BVH functions release the GIL.
+#define BVH_RELEASE_GIL_THRESHOLD 1024
+// Number of rays processed by a single thread pool job.
+#define BVH_RAY_CHUNK_SIZE 256
+// Number of bins used to evaluate surface area heuristic.
+#define BVH_BIN_COUNT 16
+
+// Flattened BVH node. Children of internal node are always stored next to each other and after their parent.
+typedef struct
+{
+    float min[3];
+    // index of left child for internal nodes (right child is stored right after it), first primitive for leaves
+    uint32_t offset;
+    float max[3];
+    // number of primitives for leaves, 0 for internal nodes
+    uint32_t count;
+} BVHNode;
+
+typedef struct
+{
+    PyObject_HEAD
+    BVHNode *nodes;
+    // primitive indices in leaf order
+    uint32_t *indices;
+    // primitive AABBs in leaf order
+    float *bounds;
+    Py_ssize_t nodeCount;
+    Py_ssize_t primitiveCount;
+    Py_ssize_t depth;
+    Py_ssize_t maxLeafSize;
+    // number of queries running without the GIL, tree cannot be modified while any of them is in progress
+    Py_ssize_t activeQueries;
+    bool isModified;
+} BVH;
+
+extern PyTypeObject pyBVHType;
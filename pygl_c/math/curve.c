@@ -0,0 +1,574 @@
+#include "curve.h"
+#include <string.h>
+#include <cglm/vec4.h>
+#include "vector/vector.h"
+#include "../buffers/buffer.h"
+#include "../threadPool.h"
+#include "../utility.h"
+
+#define _COEFFICIENTS_ALIGNMENT 16
+
+typedef enum
+{
+    CURVE_OUTPUT_POSITIONS,
+    CURVE_OUTPUT_TANGENTS,
+    CURVE_OUTPUT_UNIT_TANGENTS,
+} CurveOutput;
+
+typedef struct
+{
+    const Curve *curve;
+    // NULL if parameters are evenly spaced over the whole curve
+    const float *params;
+    size_t count;
+    CurveOutput output;
+    bool arcLength;
+    char *dst;
+    Py_ssize_t stride;
+} CurveJob;
+
+static void eval_position(const vec4 *c, float t, vec4 dest)
+{
+    // Horner scheme: ((a * t + b) * t + c) * t + d
+    glm_vec4_scale((float *)c[0], t, dest);
+    glm_vec4_add(dest, (float *)c[1], dest);
+    glm_vec4_scale(dest, t, dest);
+    glm_vec4_add(dest, (float *)c[2], dest);
+    glm_vec4_scale(dest, t, dest);
+    glm_vec4_add(dest, (float *)c[3], dest);
+}
+
+// Derivative with respect to segment-local parameter: (3a * t + 2b) * t + c
+static void eval_tangent(const vec4 *c, float t, vec4 dest)
+{
+    glm_vec4_scale((float *)c[0], 3.0f * t, dest);
+    glm_vec4_muladds((float *)c[1], 2.0f, dest);
+    glm_vec4_scale(dest, t, dest);
+    glm_vec4_add(dest, (float *)c[2], dest);
+}
+
+// Converts normalized arc length into parameter expressed in segments, i.e. in range [0, segmentCount].
+static float arc_length_to_parameter(const Curve *curve, float s)
+{
+    const float target = s * curve->length;
+    const float *lengths = curve->arcLengths;
+
+    Py_ssize_t low = 0;
+    Py_ssize_t high = curve->segmentCount * CURVE_ARC_LENGTH_SAMPLES;
+    while (high - low > 1)
+    {
+        const Py_ssize_t mid = (low + high) / 2;
+        if (lengths[mid] <= target)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    const float span = lengths[high] - lengths[low];
+    const float fraction = span > 0.0f ? glm_clamp((target - lengths[low]) / span, 0.0f, 1.0f) : 0.0f;
+
+    return (low + fraction) / CURVE_ARC_LENGTH_SAMPLES;
+}
+
+static const vec4 *locate(const Curve *curve, float t, bool arcLength, float *local)
+{
+    t = glm_clamp(t, 0.0f, 1.0f);
+
+    const float u = arcLength ? arc_length_to_parameter(curve, t) : t * curve->segmentCount;
+    Py_ssize_t segment = (Py_ssize_t)u;
+    if (segment >= curve->segmentCount)
+        segment = curve->segmentCount - 1;
+
+    *local = u - segment;
+    return curve->coefficients + segment * 4;
+}
+
+static void evaluate(const Curve *curve, float t, CurveOutput output, bool arcLength, vec4 dest)
+{
+    float local;
+    const vec4 *c = locate(curve, t, arcLength, &local);
+
+    if (output == CURVE_OUTPUT_POSITIONS)
+    {
+        eval_position(c, local, dest);
+        return;
+    }
+
+    eval_tangent(c, local, dest);
+    if (output == CURVE_OUTPUT_UNIT_TANGENTS)
+        glm_vec4_normalize(dest);
+    else if (arcLength)
+        // parameter moves along the curve at constant speed, so derivative has length of the whole curve
+        glm_vec4_scale_as(dest, curve->length, dest);
+    else
+        glm_vec4_scale(dest, (float)curve->segmentCount, dest);
+}
+
+static void curve_job(void *userData, size_t index)
+{
+    const CurveJob *job = userData;
+
+    const size_t begin = index * CURVE_CHUNK_SIZE;
+    const size_t end = begin + CURVE_CHUNK_SIZE < job->count ? begin + CURVE_CHUNK_SIZE : job->count;
+    const float step = job->count > 1 ? 1.0f / (job->count - 1) : 0.0f;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        const float t = job->params != NULL ? job->params[i] : i * step;
+
+        vec4 result;
+        evaluate(job->curve, t, job->output, job->arcLength, result);
+        memcpy(job->dst + i * job->stride, result, sizeof(vec3));
+    }
+}
+
+static bool check_initialized(const Curve *curve)
+{
+    THROW_IF(curve->coefficients == NULL, PyExc_RuntimeError, "Curve is not initialized.", false);
+    return true;
+}
+
+// Allocates storage for segments of uninitialized curve.
+static bool alloc_segments(Curve *self, Py_ssize_t segmentCount)
+{
+    // curves are read without the GIL while being evaluated, so their data cannot be replaced
+    THROW_IF(self->coefficients != NULL, PyExc_RuntimeError, "Curve is already initialized.", false);
+
+    self->coefficients = utils_aligned_malloc(sizeof(vec4) * 4 * segmentCount, _COEFFICIENTS_ALIGNMENT);
+    self->arcLengths = PyMem_Malloc(sizeof(float) * (segmentCount * CURVE_ARC_LENGTH_SAMPLES + 1));
+    if (!self->coefficients || !self->arcLengths)
+    {
+        utils_aligned_free(self->coefficients);
+        PyMem_Free(self->arcLengths);
+        self->coefficients = NULL;
+        self->arcLengths = NULL;
+
+        PyErr_NoMemory();
+        return false;
+    }
+
+    self->segmentCount = segmentCount;
+    return true;
+}
+
+// Arc length is approximated with lengths of chords between evenly spaced samples.
+static void build_arc_lengths(Curve *self)
+{
+    vec4 previous;
+    eval_position(self->coefficients, 0.0f, previous);
+
+    self->arcLengths[0] = 0.0f;
+    for (Py_ssize_t i = 0; i < self->segmentCount; i++)
+    {
+        for (Py_ssize_t j = 1; j <= CURVE_ARC_LENGTH_SAMPLES; j++)
+        {
+            const Py_ssize_t index = i * CURVE_ARC_LENGTH_SAMPLES + j;
+
+            vec4 current;
+            eval_position(self->coefficients + i * 4, (float)j / CURVE_ARC_LENGTH_SAMPLES, current);
+            self->arcLengths[index] = self->arcLengths[index - 1] + glm_vec4_distance(previous, current);
+            glm_vec4_copy(current, previous);
+        }
+    }
+
+    self->length = self->arcLengths[self->segmentCount * CURVE_ARC_LENGTH_SAMPLES];
+}
+
+static void load_point(const float *src, vec4 dest)
+{
+    dest[0] = src[0];
+    dest[1] = src[1];
+    dest[2] = src[2];
+    dest[3] = 0.0f;
+}
+
+static void hermite_coefficients(vec4 p0, vec4 m0, vec4 p1, vec4 m1, vec4 *dest)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        dest[0][i] = 2.0f * p0[i] - 2.0f * p1[i] + m0[i] + m1[i];
+        dest[1][i] = -3.0f * p0[i] + 3.0f * p1[i] - 2.0f * m0[i] - m1[i];
+        dest[2][i] = m0[i];
+        dest[3][i] = p0[i];
+    }
+}
+
+static void bezier_coefficients(vec4 p0, vec4 p1, vec4 p2, vec4 p3, vec4 *dest)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        dest[0][i] = -p0[i] + 3.0f * p1[i] - 3.0f * p2[i] + p3[i];
+        dest[1][i] = 3.0f * p0[i] - 6.0f * p1[i] + 3.0f * p2[i];
+        dest[2][i] = -3.0f * p0[i] + 3.0f * p1[i];
+        dest[3][i] = p0[i];
+    }
+}
+
+static bool get_points(PyObject *obj, const char *name, Py_buffer *view, Py_ssize_t *count)
+{
+    if (!utils_get_float_buffer(obj, 3, view, count))
+        return false;
+
+    if (*count < 2)
+    {
+        PyErr_Format(PyExc_ValueError, "Curve requires at least 2 %s.", name);
+        PyBuffer_Release(view);
+        return false;
+    }
+
+    return true;
+}
+
+static int bezier_init(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"points", NULL};
+
+    PyObject *pointsObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwNames, &pointsObj))
+        return -1;
+
+    Py_buffer points;
+    Py_ssize_t count = 0;
+    if (!get_points(pointsObj, "points", &points, &count))
+        return -1;
+
+    THROW_IF_GOTO(
+        count < 4 || (count - 1) % 3 != 0,
+        PyExc_ValueError,
+        "Bezier curve requires 3 * n + 1 control points (n >= 1).",
+        fail);
+
+    if (!alloc_segments(self, (count - 1) / 3))
+        goto fail;
+
+    const float *data = points.buf;
+    for (Py_ssize_t i = 0; i < self->segmentCount; i++)
+    {
+        vec4 p[4];
+        for (int j = 0; j < 4; j++)
+            load_point(data + (i * 3 + j) * 3, p[j]);
+
+        bezier_coefficients(p[0], p[1], p[2], p[3], self->coefficients + i * 4);
+    }
+
+    build_arc_lengths(self);
+
+    PyBuffer_Release(&points);
+    return 0;
+
+fail:
+    PyBuffer_Release(&points);
+    return -1;
+}
+
+static int catmull_rom_init(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"points", "closed", NULL};
+
+    PyObject *pointsObj = NULL;
+    int closed = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", kwNames, &pointsObj, &closed))
+        return -1;
+
+    Py_buffer points;
+    Py_ssize_t count = 0;
+    if (!get_points(pointsObj, "points", &points, &count))
+        return -1;
+
+    if (!alloc_segments(self, closed ? count : count - 1))
+    {
+        PyBuffer_Release(&points);
+        return -1;
+    }
+
+    const float *data = points.buf;
+    for (Py_ssize_t i = 0; i < self->segmentCount; i++)
+    {
+        vec4 p[4];
+        for (Py_ssize_t j = 0; j < 4; j++)
+        {
+            // open curves repeat their end points, closed ones wrap around
+            Py_ssize_t index = i + j - 1;
+            if (closed)
+                index = (index + count) % count;
+            else
+                index = index < 0 ? 0 : (index >= count ? count - 1 : index);
+
+            load_point(data + index * 3, p[j]);
+        }
+
+        vec4 m0;
+        vec4 m1;
+        glm_vec4_sub(p[2], p[0], m0);
+        glm_vec4_scale(m0, 0.5f, m0);
+        glm_vec4_sub(p[3], p[1], m1);
+        glm_vec4_scale(m1, 0.5f, m1);
+
+        hermite_coefficients(p[1], m0, p[2], m1, self->coefficients + i * 4);
+    }
+
+    build_arc_lengths(self);
+
+    PyBuffer_Release(&points);
+    return 0;
+}
+
+static int hermite_init(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"points", "tangents", NULL};
+
+    PyObject *pointsObj = NULL;
+    PyObject *tangentsObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", kwNames, &pointsObj, &tangentsObj))
+        return -1;
+
+    Py_buffer points;
+    Py_ssize_t count = 0;
+    if (!get_points(pointsObj, "points", &points, &count))
+        return -1;
+
+    Py_buffer tangents;
+    Py_ssize_t tangentCount = 0;
+    if (!get_points(tangentsObj, "tangents", &tangents, &tangentCount))
+    {
+        PyBuffer_Release(&points);
+        return -1;
+    }
+
+    int result = -1;
+    THROW_IF_GOTO(tangentCount != count, PyExc_ValueError, "Number of tangents has to match number of points.", end);
+
+    if (!alloc_segments(self, count - 1))
+        goto end;
+
+    const float *pointData = points.buf;
+    const float *tangentData = tangents.buf;
+    for (Py_ssize_t i = 0; i < self->segmentCount; i++)
+    {
+        vec4 p0, m0, p1, m1;
+        load_point(pointData + i * 3, p0);
+        load_point(tangentData + i * 3, m0);
+        load_point(pointData + (i + 1) * 3, p1);
+        load_point(tangentData + (i + 1) * 3, m1);
+
+        hermite_coefficients(p0, m0, p1, m1, self->coefficients + i * 4);
+    }
+
+    build_arc_lengths(self);
+    result = 0;
+
+end:
+    PyBuffer_Release(&points);
+    PyBuffer_Release(&tangents);
+    return result;
+}
+
+static void curve_dealloc(Curve *self)
+{
+    utils_aligned_free(self->coefficients);
+    PyMem_Free(self->arcLengths);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *evaluate_batch(Curve *self, CurveOutput output, PyObject *paramsObj, PyObject *dstObj, Py_ssize_t stride, Py_ssize_t offset, bool arcLength)
+{
+    THROW_IF(
+        stride < (Py_ssize_t)sizeof(vec3),
+        PyExc_ValueError,
+        "Stride has to be at least 12 bytes (size of a single 3-component vertex).",
+        NULL);
+    THROW_IF(
+        offset < 0 || offset > stride - (Py_ssize_t)sizeof(vec3),
+        PyExc_ValueError,
+        "Offset has to point to a 3-component vertex placed inside a single stride.",
+        NULL);
+
+    CurveJob job = {
+        .curve = self,
+        .output = output,
+        .arcLength = arcLength,
+        .stride = stride,
+    };
+
+    // integer count samples the whole curve at evenly spaced parameters
+    Py_buffer params = {0};
+    if (PyLong_Check(paramsObj))
+    {
+        const Py_ssize_t count = PyLong_AsSsize_t(paramsObj);
+        if (count == -1 && PyErr_Occurred())
+            return NULL;
+
+        THROW_IF(count < 0, PyExc_ValueError, "Sample count cannot be negative.", NULL);
+        job.count = count;
+    }
+    else
+    {
+        Py_ssize_t count = 0;
+        if (!utils_get_float_buffer(paramsObj, 1, &params, &count))
+            return NULL;
+
+        job.params = params.buf;
+        job.count = count;
+    }
+
+    if (job.count == 0)
+    {
+        if (params.obj != NULL)
+            PyBuffer_Release(&params);
+
+        Py_RETURN_NONE;
+    }
+
+    WriteTarget dst;
+    if (!py_buffer_acquire_write_target(dstObj, -1, offset + (job.count - 1) * stride + sizeof(vec3), &dst))
+    {
+        if (params.obj != NULL)
+            PyBuffer_Release(&params);
+
+        return NULL;
+    }
+
+    job.dst = (char *)dst.data + offset;
+
+    const size_t chunkCount = (job.count + CURVE_CHUNK_SIZE - 1) / CURVE_CHUNK_SIZE;
+    if (job.count >= CURVE_PARALLEL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        thread_pool_run(curve_job, &job, chunkCount);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        for (size_t i = 0; i < chunkCount; i++)
+            curve_job(&job, i);
+    }
+
+    py_buffer_release_write_target(&dst);
+    if (params.obj != NULL)
+        PyBuffer_Release(&params);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *curve_evaluate(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"params", "dst", "stride", "offset", "arc_length", NULL};
+
+    PyObject *paramsObj = NULL;
+    PyObject *dstObj = NULL;
+    Py_ssize_t stride = sizeof(vec3);
+    Py_ssize_t offset = 0;
+    int arcLength = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|nn$p", kwNames, &paramsObj, &dstObj, &stride, &offset, &arcLength) ||
+        !check_initialized(self))
+        return NULL;
+
+    return evaluate_batch(self, CURVE_OUTPUT_POSITIONS, paramsObj, dstObj, stride, offset, arcLength);
+}
+
+static PyObject *curve_evaluate_tangents(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"params", "dst", "stride", "offset", "arc_length", "normalize", NULL};
+
+    PyObject *paramsObj = NULL;
+    PyObject *dstObj = NULL;
+    Py_ssize_t stride = sizeof(vec3);
+    Py_ssize_t offset = 0;
+    int arcLength = 0;
+    int normalize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|nn$pp", kwNames, &paramsObj, &dstObj, &stride, &offset, &arcLength, &normalize) ||
+        !check_initialized(self))
+        return NULL;
+
+    return evaluate_batch(
+        self,
+        normalize ? CURVE_OUTPUT_UNIT_TANGENTS : CURVE_OUTPUT_TANGENTS,
+        paramsObj,
+        dstObj,
+        stride,
+        offset,
+        arcLength);
+}
+
+static PyObject *evaluate_single(Curve *self, CurveOutput output, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"t", "arc_length", NULL};
+
+    float t = 0.0f;
+    int arcLength = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "f|$p", kwNames, &t, &arcLength) ||
+        !check_initialized(self))
+        return NULL;
+
+    vec4 value;
+    evaluate(self, t, output, arcLength, value);
+
+    Vector3 *result = py_vector3_new();
+    if (!result)
+        return NULL;
+
+    glm_vec3_copy(value, result->data);
+
+    return (PyObject *)result;
+}
+
+static PyObject *curve_point_at(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    return evaluate_single(self, CURVE_OUTPUT_POSITIONS, args, kwargs);
+}
+
+static PyObject *curve_tangent_at(Curve *self, PyObject *args, PyObject *kwargs)
+{
+    return evaluate_single(self, CURVE_OUTPUT_TANGENTS, args, kwargs);
+}
+
+PyTypeObject pyCurveType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_name = "pygl.math.Curve",
+    .tp_basicsize = sizeof(Curve),
+    .tp_dealloc = (destructor)curve_dealloc,
+    .tp_members = (PyMemberDef[]){
+        {"segment_count", Py_T_PYSSIZET, offsetof(Curve, segmentCount), Py_READONLY, NULL},
+        {"length", Py_T_FLOAT, offsetof(Curve, length), Py_READONLY, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"evaluate", (PyCFunction)curve_evaluate, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"evaluate_tangents", (PyCFunction)curve_evaluate_tangents, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"point_at", (PyCFunction)curve_point_at, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"tangent_at", (PyCFunction)curve_tangent_at, METH_VARARGS | METH_KEYWORDS, NULL},
+        {0},
+    },
+};
+
+PyTypeObject pyBezierCurveType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_base = &pyCurveType,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.BezierCurve",
+    .tp_basicsize = sizeof(Curve),
+    .tp_init = (initproc)bezier_init,
+};
+
+PyTypeObject pyCatmullRomCurveType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_base = &pyCurveType,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.CatmullRomCurve",
+    .tp_basicsize = sizeof(Curve),
+    .tp_init = (initproc)catmull_rom_init,
+};
+
+PyTypeObject pyHermiteCurveType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_base = &pyCurveType,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.HermiteCurve",
+    .tp_basicsize = sizeof(Curve),
+    .tp_init = (initproc)hermite_init,
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <Python.h>
+#include <cglm/types.h>
+
+// Number of parameters above which curve evaluation releases the GIL and is split across the thread pool.
+#define CURVE_PARALLEL_THRESHOLD 16384
+// Number of parameters evaluated by a single thread pool job.
+#define CURVE_CHUNK_SIZE 4096
+// Number of samples per segment used to build arc length table.
+#define CURVE_ARC_LENGTH_SAMPLES 32
+
+typedef struct
+{
+    PyObject_HEAD
+    Py_ssize_t segmentCount;
+    // every segment is stored as 4 power basis coefficients (a, b, c, d) of p(t) = a*t^3 + b*t^2 + c*t + d,
+    // so evaluation doesn't depend on curve type and uses aligned vec4 operations
+    vec4 *coefficients;
+    // cumulative length of the curve at `CURVE_ARC_LENGTH_SAMPLES` evenly spaced parameters of every segment
+    float *arcLengths;
+    float length;
+} Curve;
+
+extern PyTypeObject pyCurveType;
+extern PyTypeObject pyBezierCurveType;
+extern PyTypeObject pyCatmullRomCurveType;
+extern PyTypeObject pyHermiteCurveType;
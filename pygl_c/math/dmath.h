@@ -0,0 +1,350 @@
+#pragma once
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Double precision counterparts of cglm types and routines used by vector and matrix templates. Names and
+// semantics mirror cglm (column-major matrices, right-handed clip space with [-1, 1] depth), so templates can
+// switch between them just by changing function prefix.
+
+typedef double dvec2[2];
+typedef double dvec3[3];
+typedef double dvec4[4];
+typedef dvec4 dmat4[4];
+
+#define _DGLM_VEC_FUNCS(N)                                                                       \
+    static inline void dglm_vec##N##_copy(const double *v, double *dest)                         \
+    {                                                                                            \
+        memcpy(dest, v, sizeof(double) * N);                                                     \
+    }                                                                                            \
+    static inline double dglm_vec##N##_dot(const double *a, const double *b)                     \
+    {                                                                                            \
+        double result = 0.0;                                                                     \
+        for (int i = 0; i < N; i++)                                                              \
+            result += a[i] * b[i];                                                               \
+        return result;                                                                           \
+    }                                                                                            \
+    static inline void dglm_vec##N##_scale(const double *v, double s, double *dest)              \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            dest[i] = v[i] * s;                                                                  \
+    }                                                                                            \
+    static inline void dglm_vec##N##_normalize_to(const double *v, double *dest)                 \
+    {                                                                                            \
+        const double norm = sqrt(dglm_vec##N##_dot(v, v));                                       \
+        if (norm == 0.0)                                                                         \
+        {                                                                                        \
+            memset(dest, 0, sizeof(double) * N);                                                 \
+            return;                                                                              \
+        }                                                                                        \
+        dglm_vec##N##_scale(v, 1.0 / norm, dest);                                                \
+    }                                                                                            \
+    static inline void dglm_vec##N##_normalize(double *v)                                        \
+    {                                                                                            \
+        dglm_vec##N##_normalize_to(v, v);                                                        \
+    }                                                                                            \
+    static inline void dglm_vec##N##_add(const double *a, const double *b, double *dest)         \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            dest[i] = a[i] + b[i];                                                               \
+    }                                                                                            \
+    static inline void dglm_vec##N##_sub(const double *a, const double *b, double *dest)         \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            dest[i] = a[i] - b[i];                                                               \
+    }                                                                                            \
+    static inline void dglm_vec##N##_mul(const double *a, const double *b, double *dest)         \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            dest[i] = a[i] * b[i];                                                               \
+    }                                                                                            \
+    static inline void dglm_vec##N##_negate_to(const double *v, double *dest)                    \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            dest[i] = -v[i];                                                                     \
+    }                                                                                            \
+    static inline double dglm_vec##N##_distance(const double *a, const double *b)                \
+    {                                                                                            \
+        double result = 0.0;                                                                     \
+        for (int i = 0; i < N; i++)                                                              \
+            result += (a[i] - b[i]) * (a[i] - b[i]);                                             \
+        return sqrt(result);                                                                     \
+    }                                                                                            \
+    static inline void dglm_vec##N##_lerp(const double *a, const double *b, double t, double *dest) \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            dest[i] = a[i] + t * (b[i] - a[i]);                                                  \
+    }                                                                                            \
+    static inline bool dglm_vec##N##_eqv(const double *a, const double *b)                       \
+    {                                                                                            \
+        for (int i = 0; i < N; i++)                                                              \
+            if (a[i] != b[i])                                                                    \
+                return false;                                                                    \
+        return true;                                                                             \
+    }
+
+_DGLM_VEC_FUNCS(2)
+_DGLM_VEC_FUNCS(3)
+_DGLM_VEC_FUNCS(4)
+
+static inline double dglm_vec2_cross(const double *a, const double *b)
+{
+    return a[0] * b[1] - a[1] * b[0];
+}
+
+static inline void dglm_vec3_cross(const double *a, const double *b, double *dest)
+{
+    dvec3 c = {
+        a[1] * b[2] - a[2] * b[1],
+        a[2] * b[0] - a[0] * b[2],
+        a[0] * b[1] - a[1] * b[0],
+    };
+    dglm_vec3_copy(c, dest);
+}
+
+static inline void dglm_mat4_copy(dmat4 m, dmat4 dest)
+{
+    memcpy(dest, m, sizeof(dmat4));
+}
+
+static inline void dglm_mat4_zero(dmat4 m)
+{
+    memset(m, 0, sizeof(dmat4));
+}
+
+static inline void dglm_mat4_identity(dmat4 m)
+{
+    dglm_mat4_zero(m);
+    m[0][0] = m[1][1] = m[2][2] = m[3][3] = 1.0;
+}
+
+static inline void dglm_mat4_transpose_to(dmat4 m, dmat4 dest)
+{
+    dmat4 t;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            t[j][i] = m[i][j];
+
+    dglm_mat4_copy(t, dest);
+}
+
+static inline void dglm_mat4_transpose(dmat4 m)
+{
+    dglm_mat4_transpose_to(m, m);
+}
+
+static inline void dglm_mat4_mul(dmat4 a, dmat4 b, dmat4 dest)
+{
+    dmat4 r;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            r[i][j] = a[0][j] * b[i][0] + a[1][j] * b[i][1] + a[2][j] * b[i][2] + a[3][j] * b[i][3];
+
+    dglm_mat4_copy(r, dest);
+}
+
+static inline void dglm_mat4_mulv(dmat4 m, const double *v, double *dest)
+{
+    dvec4 r;
+    for (int j = 0; j < 4; j++)
+        r[j] = m[0][j] * v[0] + m[1][j] * v[1] + m[2][j] * v[2] + m[3][j] * v[3];
+
+    dglm_vec4_copy(r, dest);
+}
+
+static inline void dglm_mat4_inv(dmat4 m, dmat4 dest)
+{
+    const double a = m[0][0], b = m[0][1], c = m[0][2], d = m[0][3],
+                 e = m[1][0], f = m[1][1], g = m[1][2], h = m[1][3],
+                 i = m[2][0], j = m[2][1], k = m[2][2], l = m[2][3],
+                 mm = m[3][0], n = m[3][1], o = m[3][2], p = m[3][3];
+
+    const double t1 = k * p - o * l, t2 = j * p - n * l, t3 = j * o - n * k,
+                 t4 = i * p - mm * l, t5 = i * o - mm * k, t6 = i * n - mm * j;
+
+    dmat4 r;
+    r[0][0] = f * t1 - g * t2 + h * t3;
+    r[1][0] = -(e * t1 - g * t4 + h * t5);
+    r[2][0] = e * t2 - f * t4 + h * t6;
+    r[3][0] = -(e * t3 - f * t5 + g * t6);
+
+    r[0][1] = -(b * t1 - c * t2 + d * t3);
+    r[1][1] = a * t1 - c * t4 + d * t5;
+    r[2][1] = -(a * t2 - b * t4 + d * t6);
+    r[3][1] = a * t3 - b * t5 + c * t6;
+
+    const double u1 = g * p - o * h, u2 = f * p - n * h, u3 = f * o - n * g,
+                 u4 = e * p - mm * h, u5 = e * o - mm * g, u6 = e * n - mm * f;
+
+    r[0][2] = b * u1 - c * u2 + d * u3;
+    r[1][2] = -(a * u1 - c * u4 + d * u5);
+    r[2][2] = a * u2 - b * u4 + d * u6;
+    r[3][2] = -(a * u3 - b * u5 + c * u6);
+
+    const double v1 = g * l - k * h, v2 = f * l - j * h, v3 = f * k - j * g,
+                 v4 = e * l - i * h, v5 = e * k - i * g, v6 = e * j - i * f;
+
+    r[0][3] = -(b * v1 - c * v2 + d * v3);
+    r[1][3] = a * v1 - c * v4 + d * v5;
+    r[2][3] = -(a * v2 - b * v4 + d * v6);
+    r[3][3] = a * v3 - b * v5 + c * v6;
+
+    const double det = 1.0 / (a * r[0][0] + b * r[1][0] + c * r[2][0] + d * r[3][0]);
+    for (int x = 0; x < 4; x++)
+        dglm_vec4_scale(r[x], det, r[x]);
+
+    dglm_mat4_copy(r, dest);
+}
+
+// Multiplies two affine matrices, skipping computation of the last row (glm_mul).
+static inline void dglm_mul(dmat4 a, dmat4 b, dmat4 dest)
+{
+    dmat4 r;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 3; j++)
+            r[i][j] = a[0][j] * b[i][0] + a[1][j] * b[i][1] + a[2][j] * b[i][2] + a[3][j] * b[i][3];
+
+    r[0][3] = r[1][3] = r[2][3] = 0.0;
+    r[3][3] = 1.0;
+    dglm_mat4_copy(r, dest);
+}
+
+// Inverts rotation and translation matrix in place (glm_inv_tr).
+static inline void dglm_inv_tr(dmat4 m)
+{
+    const dvec3 t = {m[3][0], m[3][1], m[3][2]};
+
+    dmat4 r;
+    dglm_mat4_transpose_to(m, r);
+    for (int i = 0; i < 3; i++)
+    {
+        m[i][0] = r[i][0];
+        m[i][1] = r[i][1];
+        m[i][2] = r[i][2];
+        m[3][i] = -(r[0][i] * t[0] + r[1][i] * t[1] + r[2][i] * t[2]);
+    }
+
+    m[0][3] = m[1][3] = m[2][3] = 0.0;
+    m[3][3] = 1.0;
+}
+
+// Converts single precision quaternion (x, y, z, w) into rotation matrix.
+static inline void dglm_quat_mat4(const float *q, dmat4 dest)
+{
+    const double x = q[0], y = q[1], z = q[2], w = q[3];
+    const double norm = x * x + y * y + z * z + w * w;
+    const double s = norm > 0.0 ? 2.0 / norm : 0.0;
+
+    const double xx = s * x * x, xy = s * x * y, wx = s * w * x,
+                 yy = s * y * y, yz = s * y * z, wy = s * w * y,
+                 zz = s * z * z, xz = s * x * z, wz = s * w * z;
+
+    dglm_mat4_identity(dest);
+    dest[0][0] = 1.0 - yy - zz;
+    dest[1][1] = 1.0 - xx - zz;
+    dest[2][2] = 1.0 - xx - yy;
+
+    dest[0][1] = xy + wz;
+    dest[1][2] = yz + wx;
+    dest[2][0] = xz + wy;
+
+    dest[1][0] = xy - wz;
+    dest[2][1] = yz - wx;
+    dest[0][2] = xz - wy;
+}
+
+static inline void dglm_translate(dmat4 m, const double *v)
+{
+    for (int i = 0; i < 4; i++)
+        m[3][i] += m[0][i] * v[0] + m[1][i] * v[1] + m[2][i] * v[2];
+}
+
+static inline void dglm_scale(dmat4 m, const double *v)
+{
+    dglm_vec4_scale(m[0], v[0], m[0]);
+    dglm_vec4_scale(m[1], v[1], m[1]);
+    dglm_vec4_scale(m[2], v[2], m[2]);
+}
+
+static inline void dglm_quat_rotate(dmat4 m, const float *q, dmat4 dest)
+{
+    dmat4 rotation;
+    dglm_quat_mat4(q, rotation);
+    dglm_mat4_mul(m, rotation, dest);
+}
+
+static inline void dglm_lookat(const double *eye, const double *center, const double *up, dmat4 dest)
+{
+    dvec3 f, s, u;
+    dglm_vec3_sub(center, eye, f);
+    dglm_vec3_normalize(f);
+
+    dglm_vec3_cross(f, up, s);
+    dglm_vec3_normalize(s);
+    dglm_vec3_cross(s, f, u);
+
+    dest[0][0] = s[0];
+    dest[0][1] = u[0];
+    dest[0][2] = -f[0];
+    dest[1][0] = s[1];
+    dest[1][1] = u[1];
+    dest[1][2] = -f[1];
+    dest[2][0] = s[2];
+    dest[2][1] = u[2];
+    dest[2][2] = -f[2];
+    dest[3][0] = -dglm_vec3_dot(s, eye);
+    dest[3][1] = -dglm_vec3_dot(u, eye);
+    dest[3][2] = dglm_vec3_dot(f, eye);
+    dest[0][3] = dest[1][3] = dest[2][3] = 0.0;
+    dest[3][3] = 1.0;
+}
+
+static inline void dglm_look(const double *eye, const double *dir, const double *up, dmat4 dest)
+{
+    dvec3 target;
+    dglm_vec3_add(eye, dir, target);
+    dglm_lookat(eye, target, up, dest);
+}
+
+static inline void dglm_quat_look(const double *eye, const float *orientation, dmat4 dest)
+{
+    dglm_quat_mat4(orientation, dest);
+    dglm_mat4_transpose(dest);
+
+    dvec4 position = {eye[0], eye[1], eye[2], 1.0};
+    dvec4 t;
+    dglm_mat4_mulv(dest, position, t);
+
+    dest[3][0] = -t[0];
+    dest[3][1] = -t[1];
+    dest[3][2] = -t[2];
+}
+
+static inline void dglm_ortho(double left, double right, double bottom, double top, double nearZ, double farZ, dmat4 dest)
+{
+    const double rl = 1.0 / (right - left);
+    const double tb = 1.0 / (top - bottom);
+    const double fn = -1.0 / (farZ - nearZ);
+
+    dglm_mat4_zero(dest);
+    dest[0][0] = 2.0 * rl;
+    dest[1][1] = 2.0 * tb;
+    dest[2][2] = 2.0 * fn;
+    dest[3][0] = -(right + left) * rl;
+    dest[3][1] = -(top + bottom) * tb;
+    dest[3][2] = (farZ + nearZ) * fn;
+    dest[3][3] = 1.0;
+}
+
+static inline void dglm_perspective(double fovy, double aspect, double nearZ, double farZ, dmat4 dest)
+{
+    const double f = 1.0 / tan(fovy * 0.5);
+    const double fn = 1.0 / (nearZ - farZ);
+
+    dglm_mat4_zero(dest);
+    dest[0][0] = f / aspect;
+    dest[1][1] = f;
+    dest[2][2] = (nearZ + farZ) * fn;
+    dest[2][3] = -1.0;
+    dest[3][2] = 2.0 * nearZ * farZ * fn;
+}
@@ -0,0 +1,142 @@
+#include "freeList.h"
+#include <string.h>
+#include "quaternion.h"
+#include "vector/vector.h"
+#include "matrix/matrix.h"
+#include "../utility.h"
+
+#define _FREE_LIST_INIT(pyType, objType) {.type = &pyType, .alignment = _Alignof(objType), .capacity = FREE_LIST_DEFAULT_CAPACITY}
+
+FreeList mathFreeLists[FREE_LIST_COUNT] = {
+    [FREE_LIST_VECTOR2] = _FREE_LIST_INIT(pyVector2Type, Vector2),
+    [FREE_LIST_VECTOR3] = _FREE_LIST_INIT(pyVector3Type, Vector3),
+    [FREE_LIST_VECTOR4] = _FREE_LIST_INIT(pyVector4Type, Vector4),
+    [FREE_LIST_MATRIX2] = _FREE_LIST_INIT(pyMatrix2Type, Matrix2),
+    [FREE_LIST_MATRIX3] = _FREE_LIST_INIT(pyMatrix3Type, Matrix3),
+    [FREE_LIST_MATRIX4] = _FREE_LIST_INIT(pyMatrix4Type, Matrix4),
+    [FREE_LIST_QUATERNION] = _FREE_LIST_INIT(pyQuaternionType, Quaternion),
+    [FREE_LIST_DVECTOR2] = _FREE_LIST_INIT(pyDVector2Type, DVector2),
+    [FREE_LIST_DVECTOR3] = _FREE_LIST_INIT(pyDVector3Type, DVector3),
+    [FREE_LIST_DVECTOR4] = _FREE_LIST_INIT(pyDVector4Type, DVector4),
+    [FREE_LIST_DMATRIX4] = _FREE_LIST_INIT(pyDMatrix4Type, DMatrix4),
+};
+
+static FreeList *get_free_list(PyTypeObject *type)
+{
+    for (size_t i = 0; i < FREE_LIST_COUNT; i++)
+    {
+        if (mathFreeLists[i].type == type)
+            return &mathFreeLists[i];
+    }
+
+    return NULL;
+}
+
+PyObject *free_list_object_malloc(const FreeList *list)
+{
+    void *obj = list->alignment > FREE_LIST_MALLOC_ALIGNMENT
+                    ? utils_aligned_malloc(list->type->tp_basicsize, list->alignment)
+                    : PyObject_Malloc(list->type->tp_basicsize);
+    if (!obj)
+        return PyErr_NoMemory();
+
+    return obj;
+}
+
+void free_list_object_free(const FreeList *list, PyObject *obj)
+{
+    if (list->alignment > FREE_LIST_MALLOC_ALIGNMENT)
+        utils_aligned_free(obj);
+    else
+        PyObject_Free(obj);
+}
+
+static void set_capacity(FreeList *list, Py_ssize_t capacity)
+{
+    list->capacity = capacity;
+
+    while (list->size > capacity)
+    {
+        PyObject *obj = list->head;
+        list->head = (PyObject *)Py_TYPE(obj);
+        list->size--;
+
+        free_list_object_free(list, obj);
+    }
+}
+
+PyObject *free_list_tp_alloc(PyTypeObject *type, Py_ssize_t Py_UNUSED(nitems))
+{
+    FreeList *list = get_free_list(type);
+    if (!list)
+        return PyType_GenericAlloc(type, 0);
+
+    PyObject *obj = free_list_alloc(list);
+    if (!obj)
+        return NULL;
+
+    // keep the same guarantees as PyType_GenericAlloc
+    memset((char *)obj + sizeof(PyObject), 0, type->tp_basicsize - sizeof(PyObject));
+
+    return obj;
+}
+
+PyObject *math_get_free_list_stats(PyObject *Py_UNUSED(self), PyObject *Py_UNUSED(args))
+{
+    PyObject *result = PyDict_New();
+    if (!result)
+        return NULL;
+
+    for (size_t i = 0; i < FREE_LIST_COUNT; i++)
+    {
+        const FreeList *list = &mathFreeLists[i];
+
+        PyObject *stats = Py_BuildValue(
+            "{s:n,s:n,s:n,s:n}",
+            "hits", list->hits,
+            "misses", list->misses,
+            "size", list->size,
+            "capacity", list->capacity);
+        if (!stats || PyDict_SetItemString(result, list->type->tp_name, stats) == -1)
+        {
+            Py_XDECREF(stats);
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        Py_DECREF(stats);
+    }
+
+    return result;
+}
+
+PyObject *math_set_free_list_capacity(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"capacity", "type", NULL};
+
+    Py_ssize_t capacity;
+    PyObject *type = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|O", kwNames, &capacity, &type))
+        return NULL;
+
+    THROW_IF(capacity < 0, PyExc_ValueError, "Free list capacity cannot be negative.", NULL);
+
+    if (type == Py_None)
+    {
+        for (size_t i = 0; i < FREE_LIST_COUNT; i++)
+            set_capacity(&mathFreeLists[i], capacity);
+
+        Py_RETURN_NONE;
+    }
+
+    FreeList *list = PyType_Check(type) ? get_free_list((PyTypeObject *)type) : NULL;
+    if (!list)
+    {
+        PyErr_Format(PyExc_TypeError, "Free lists are not available for type: %R.", type);
+        return NULL;
+    }
+
+    set_capacity(list, capacity);
+
+    Py_RETURN_NONE;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <Python.h>
+
+// Default maximum number of cached objects per type.
+#define FREE_LIST_DEFAULT_CAPACITY 128
+
+// Alignment guaranteed by PyObject_Malloc. Objects of types which require stricter alignment (e.g. mat4
+// with AVX enabled) are allocated with utils_aligned_malloc instead.
+#define FREE_LIST_MALLOC_ALIGNMENT (2 * SIZEOF_VOID_P)
+
+typedef enum
+{
+    FREE_LIST_VECTOR2,
+    FREE_LIST_VECTOR3,
+    FREE_LIST_VECTOR4,
+    FREE_LIST_MATRIX2,
+    FREE_LIST_MATRIX3,
+    FREE_LIST_MATRIX4,
+    FREE_LIST_QUATERNION,
+    FREE_LIST_DVECTOR2,
+    FREE_LIST_DVECTOR3,
+    FREE_LIST_DVECTOR4,
+    FREE_LIST_DMATRIX4,
+    FREE_LIST_COUNT,
+} FreeListKind;
+
+typedef struct
+{
+    PyTypeObject *type;
+    // required alignment of type's instances, so that their vector data can be used with aligned SIMD loads
+    size_t alignment;
+    PyObject *head;
+    Py_ssize_t size;
+    Py_ssize_t capacity;
+    Py_ssize_t hits;
+    Py_ssize_t misses;
+} FreeList;
+
+extern FreeList mathFreeLists[FREE_LIST_COUNT];
+
+PyObject *free_list_object_malloc(const FreeList *list);
+void free_list_object_free(const FreeList *list, PyObject *obj);
+
+// Returns uninitialized (apart from object header) instance of list's type, reusing cached object if possible.
+static inline PyObject *free_list_alloc(FreeList *list)
+{
+    PyObject *obj = list->head;
+    if (obj != NULL)
+    {
+        // cached objects are linked through their ob_type field, the same way CPython float free list does
+        list->head = (PyObject *)Py_TYPE(obj);
+        list->size--;
+        list->hits++;
+    }
+    else
+    {
+        obj = free_list_object_malloc(list);
+        if (!obj)
+            return NULL;
+
+        list->misses++;
+    }
+
+    return PyObject_Init(obj, list->type);
+}
+
+static inline void free_list_dealloc(FreeList *list, PyObject *obj)
+{
+    if (list->size >= list->capacity)
+    {
+        free_list_object_free(list, obj);
+        return;
+    }
+
+    Py_SET_TYPE(obj, (PyTypeObject *)list->head);
+    list->head = obj;
+    list->size++;
+}
+
+// Allocator used as `tp_alloc`, so objects created through type constructors also use the free list.
+PyObject *free_list_tp_alloc(PyTypeObject *type, Py_ssize_t nitems);
+
+PyObject *math_get_free_list_stats(PyObject *self, PyObject *args);
+PyObject *math_set_free_list_capacity(PyObject *self, PyObject *args, PyObject *kwargs);
@@ -0,0 +1,306 @@
+#include "frustum.h"
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
+#include <cglm/frustum.h>
+#include "plane.h"
+#include "vector/vector.h"
+#include "matrix/matrix.h"
+#include "../utility.h"
+
+#define _SELF Frustum *self
+
+typedef enum
+{
+    CULL_SPHERES,
+    CULL_AABBS,
+} CullKind;
+
+static void set_matrix(_SELF, Matrix4 *matrix)
+{
+    glm_frustum_planes(matrix->data, self->planes);
+}
+
+static bool set_values(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"view_projection", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !utils_check_arg_type(values[0], &pyMatrix4Type, "view_projection"))
+        return false;
+
+    set_matrix(self, (Matrix4 *)values[0]);
+
+    return true;
+}
+
+static int init(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"view_projection", NULL};
+
+    Matrix4 *matrix = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!", kwNames, &pyMatrix4Type, &matrix))
+        return -1;
+
+    set_matrix(self, matrix);
+
+    return 0;
+}
+
+static PyObject *vectorcall(PyTypeObject *Py_UNUSED(type), PyObject *const *args, size_t nargsf, PyObject *kwnames)
+{
+    Frustum *result = PyObject_New(Frustum, &pyFrustumType);
+    if (!result)
+        return NULL;
+
+    if (!set_values(result, args, PyVectorcall_NARGS(nargsf), kwnames))
+    {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
+}
+
+static PyObject *update(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (!set_values(self, args, nargs, kwnames))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+void frustum_get_lanes(_SELF, FrustumLanes *lanes)
+{
+    for (size_t i = 0; i < FRUSTUM_LANES; i++)
+    {
+        const bool padding = i >= FRUSTUM_PLANE_COUNT;
+        lanes->x[i] = padding ? 0.0f : self->planes[i][0];
+        lanes->y[i] = padding ? 0.0f : self->planes[i][1];
+        lanes->z[i] = padding ? 0.0f : self->planes[i][2];
+        lanes->d[i] = padding ? FLT_MAX : self->planes[i][3];
+        lanes->absX[i] = fabsf(lanes->x[i]);
+        lanes->absY[i] = fabsf(lanes->y[i]);
+        lanes->absZ[i] = fabsf(lanes->z[i]);
+    }
+}
+
+// Writes visibility of each volume either as bit into zeroed `mask` (least significant bit first) or as compacted
+// list of visible volume indices into `indices`. Returns number of visible volumes.
+static Py_ssize_t cull_kernel(CullKind kind, const FrustumLanes *lanes, const float *volumes, Py_ssize_t count, uint8_t *mask, uint32_t *indices)
+{
+    const Py_ssize_t components = kind == CULL_SPHERES ? 4 : 6;
+
+    Py_ssize_t visibleCount = 0;
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        const float *volume = volumes + i * components;
+        const bool visible = kind == CULL_SPHERES
+                                 ? frustum_sphere_visible(lanes, volume)
+                                 : frustum_aabb_test(lanes, volume) != FRUSTUM_OUTSIDE;
+
+        if (mask != NULL)
+        {
+            mask[i >> 3] |= (uint8_t)(visible << (i & 7));
+        }
+        else
+        {
+            // branchless compaction, slot is overwritten by the next index if volume is not visible
+            indices[visibleCount] = (uint32_t)i;
+        }
+
+        visibleCount += visible;
+    }
+
+    return visibleCount;
+}
+
+static PyObject *cull(_SELF, CullKind kind, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"volumes", "indices", NULL};
+
+    PyObject *values[2] = {NULL, NULL};
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values))
+        return NULL;
+
+    int returnIndices = values[1] != NULL ? PyObject_IsTrue(values[1]) : 0;
+    if (returnIndices == -1)
+        return NULL;
+
+    Py_buffer volumes;
+    Py_ssize_t count = 0;
+    if (!utils_get_float_buffer(values[0], kind == CULL_SPHERES ? 4 : 6, &volumes, &count))
+        return NULL;
+
+    if (returnIndices && (size_t)count > UINT32_MAX)
+    {
+        PyBuffer_Release(&volumes);
+        PyErr_SetString(PyExc_OverflowError, "Too many bounding volumes to represent them using 32-bit indices.");
+        return NULL;
+    }
+
+    PyObject *result = NULL;
+    uint8_t *mask = NULL;
+    uint32_t *indices = NULL;
+    if (returnIndices)
+    {
+        indices = PyMem_Malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+        if (!indices)
+        {
+            PyBuffer_Release(&volumes);
+            return PyErr_NoMemory();
+        }
+    }
+    else
+    {
+        result = utils_new_typed_view((count + 7) / 8, "B", sizeof(uint8_t), (void **)&mask);
+        if (!result)
+        {
+            PyBuffer_Release(&volumes);
+            return NULL;
+        }
+
+        memset(mask, 0, (count + 7) / 8);
+    }
+
+    FrustumLanes lanes;
+    frustum_get_lanes(self, &lanes);
+
+    Py_ssize_t visibleCount = 0;
+    if (count >= FRUSTUM_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        visibleCount = cull_kernel(kind, &lanes, volumes.buf, count, mask, indices);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        visibleCount = cull_kernel(kind, &lanes, volumes.buf, count, mask, indices);
+    }
+
+    PyBuffer_Release(&volumes);
+
+    if (returnIndices)
+    {
+        void *data = NULL;
+        result = utils_new_typed_view(visibleCount, "I", sizeof(uint32_t), &data);
+        if (result)
+            memcpy(data, indices, sizeof(uint32_t) * visibleCount);
+
+        PyMem_Free(indices);
+    }
+
+    return result;
+}
+
+static PyObject *cull_spheres(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    return cull(self, CULL_SPHERES, args, nargs, kwnames);
+}
+
+static PyObject *cull_aabbs(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    return cull(self, CULL_AABBS, args, nargs, kwnames);
+}
+
+static PyObject *contains_point(_SELF, PyObject *point)
+{
+    if (!utils_check_arg_type(point, &pyVector3Type, "point"))
+        return NULL;
+
+    float *data = ((Vector3 *)point)->data;
+    const float sphere[4] = {data[0], data[1], data[2], 0.0f};
+
+    FrustumLanes lanes;
+    frustum_get_lanes(self, &lanes);
+
+    return PyBool_FromLong(frustum_sphere_visible(&lanes, sphere));
+}
+
+static PyObject *intersects_sphere(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"center", "radius", NULL};
+
+    PyObject *values[2];
+    float radius = 0.0f;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[0], &pyVector3Type, "center") ||
+        !utils_as_float(values[1], &radius))
+        return NULL;
+
+    float *center = ((Vector3 *)values[0])->data;
+    const float sphere[4] = {center[0], center[1], center[2], radius};
+
+    FrustumLanes lanes;
+    frustum_get_lanes(self, &lanes);
+
+    return PyBool_FromLong(frustum_sphere_visible(&lanes, sphere));
+}
+
+static PyObject *intersects_aabb(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"min", "max", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[0], &pyVector3Type, "min") ||
+        !utils_check_arg_type(values[1], &pyVector3Type, "max"))
+        return NULL;
+
+    float aabb[6];
+    memcpy(aabb, ((Vector3 *)values[0])->data, sizeof(vec3));
+    memcpy(aabb + 3, ((Vector3 *)values[1])->data, sizeof(vec3));
+
+    FrustumLanes lanes;
+    frustum_get_lanes(self, &lanes);
+
+    return PyBool_FromLong(frustum_aabb_test(&lanes, aabb) != FRUSTUM_OUTSIDE);
+}
+
+static PyObject *planes_get(_SELF, void *Py_UNUSED(closure))
+{
+    PyObject *result = PyTuple_New(FRUSTUM_PLANE_COUNT);
+    if (!result)
+        return NULL;
+
+    for (size_t i = 0; i < FRUSTUM_PLANE_COUNT; i++)
+    {
+        Plane *plane = py_plane_new();
+        if (!plane)
+        {
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        glm_vec3_copy(self->planes[i], plane->normal);
+        plane->distance = self->planes[i][3];
+
+        PyTuple_SET_ITEM(result, i, (PyObject *)plane);
+    }
+
+    return result;
+}
+
+PyTypeObject pyFrustumType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.Frustum",
+    .tp_basicsize = sizeof(Frustum),
+    .tp_init = (initproc)init,
+    .tp_vectorcall = (vectorcallfunc)vectorcall,
+    .tp_getset = (PyGetSetDef[]){
+        {"planes", (getter)planes_get, NULL, NULL, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"update", (PyCFunction)update, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"contains_point", (PyCFunction)contains_point, METH_O, NULL},
+        {"intersects_sphere", (PyCFunction)intersects_sphere, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"intersects_aabb", (PyCFunction)intersects_aabb, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"cull_spheres", (PyCFunction)cull_spheres, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"cull_aabbs", (PyCFunction)cull_aabbs, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {0},
+    },
+};
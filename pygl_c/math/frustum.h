@@ -0,0 +1,95 @@
+#pragma once
+#include <Python.h>
+#include <stdbool.h>
+#include <cglm/vec4.h>
+
+// Number of bounding volumes above which batched culling functions release the GIL.
+#define FRUSTUM_RELEASE_GIL_THRESHOLD 4096
+
+typedef enum
+{
+    FRUSTUM_PLANE_LEFT,
+    FRUSTUM_PLANE_RIGHT,
+    FRUSTUM_PLANE_BOTTOM,
+    FRUSTUM_PLANE_TOP,
+    FRUSTUM_PLANE_NEAR,
+    FRUSTUM_PLANE_FAR,
+    FRUSTUM_PLANE_COUNT,
+} FrustumPlane;
+
+typedef struct
+{
+    PyObject_HEAD
+    // Normalized planes in form of (normal, distance), with normals pointing inside of the frustum.
+    vec4 planes[FRUSTUM_PLANE_COUNT];
+} Frustum;
+
+// Planes transposed into structure of arrays, so that a single volume is tested against all planes at once
+// with SIMD lanes. Two padding lanes hold planes that every volume passes.
+#define FRUSTUM_LANES 8
+
+typedef struct
+{
+    float x[FRUSTUM_LANES];
+    float y[FRUSTUM_LANES];
+    float z[FRUSTUM_LANES];
+    float d[FRUSTUM_LANES];
+    // absolute values of normals, used to project AABB extents onto plane normals
+    float absX[FRUSTUM_LANES];
+    float absY[FRUSTUM_LANES];
+    float absZ[FRUSTUM_LANES];
+} FrustumLanes;
+
+typedef enum
+{
+    FRUSTUM_OUTSIDE,
+    FRUSTUM_INTERSECTS,
+    FRUSTUM_INSIDE,
+} FrustumTestResult;
+
+extern PyTypeObject pyFrustumType;
+
+void frustum_get_lanes(Frustum *frustum, FrustumLanes *lanes);
+
+// Tests sphere packed as (x, y, z, radius).
+static inline bool frustum_sphere_visible(const FrustumLanes *lanes, const float *sphere)
+{
+    const float x = sphere[0];
+    const float y = sphere[1];
+    const float z = sphere[2];
+    const float radius = sphere[3];
+
+    bool visible = true;
+    for (size_t i = 0; i < FRUSTUM_LANES; i++)
+        visible &= lanes->x[i] * x + lanes->y[i] * y + lanes->z[i] * z + lanes->d[i] >= -radius;
+
+    return visible;
+}
+
+// Tests box packed as (min_x, min_y, min_z, max_x, max_y, max_z). Box is tested in center-extent form: it is
+// outside of a plane if its center is further behind the plane than the projection of its extent onto plane normal
+// and fully inside if its center is further in front of every plane than that projection.
+static inline FrustumTestResult frustum_aabb_test(const FrustumLanes *lanes, const float *aabb)
+{
+    const float cx = (aabb[0] + aabb[3]) * 0.5f;
+    const float cy = (aabb[1] + aabb[4]) * 0.5f;
+    const float cz = (aabb[2] + aabb[5]) * 0.5f;
+    const float ex = (aabb[3] - aabb[0]) * 0.5f;
+    const float ey = (aabb[4] - aabb[1]) * 0.5f;
+    const float ez = (aabb[5] - aabb[2]) * 0.5f;
+
+    bool visible = true;
+    bool inside = true;
+    for (size_t i = 0; i < FRUSTUM_LANES; i++)
+    {
+        const float distance = lanes->x[i] * cx + lanes->y[i] * cy + lanes->z[i] * cz + lanes->d[i];
+        const float radius = lanes->absX[i] * ex + lanes->absY[i] * ey + lanes->absZ[i] * ez;
+        visible &= distance >= -radius;
+        inside &= distance >= radius;
+    }
+
+    if (!visible)
+        return FRUSTUM_OUTSIDE;
+
+    return inside ? FRUSTUM_INSIDE : FRUSTUM_INTERSECTS;
+}
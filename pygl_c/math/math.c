@@ -2,8 +2,21 @@
 #include <cglm/util.h>
 #include "quaternion.h"
 #include "vector/vector.h"
+#include "vector/vectorArray.h"
 #include "matrix/matrix.h"
+#include "matrix/matrix4Array.h"
+#include "transform.h"
+#include "plane.h"
+#include "frustum.h"
+#include "bvh.h"
+#include "animation.h"
+#include "transformTree.h"
+#include "curve.h"
+#include "noise.h"
+#include "packing.h"
+#include "freeList.h"
 #include "../module.h"
+#include "../utility.h"
 
 static PyObject* get_closest_factors(PyObject* Py_UNUSED(self), PyObject* value)
 {
@@ -21,13 +34,18 @@ static PyObject* get_closest_factors(PyObject* Py_UNUSED(self), PyObject* value)
     return PyTuple_Pack(2, PyLong_FromLongLong(val), PyLong_FromDouble(orig / (double)val));
 }
 
-static PyObject* interpolate(PyObject* Py_UNUSED(self), PyObject* args)
+static PyObject* interpolate(PyObject* Py_UNUSED(self), PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames)
 {
-    PyObject* a = NULL;
-    PyObject* b = NULL;
-    float factor = 0.0f;
+    static const char* const kwNames[] = {"x", "y", "factor", NULL};
 
-    if (!PyArg_ParseTuple(args, "OOf", &a, &b, &factor))
+    PyObject* values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 3, values))
+        return NULL;
+
+    PyObject* a = values[0];
+    PyObject* b = values[1];
+    float factor = 0.0f;
+    if (!utils_as_float(values[2], &factor))
         return NULL;
 
     if (Py_TYPE(a) != Py_TYPE(b))
@@ -44,9 +62,12 @@ static PyObject* interpolate(PyObject* Py_UNUSED(self), PyObject* args)
             factor);
         return PyFloat_FromDouble(res);
     }
-    else if (PyObject_IsInstance(a, (PyObject*)&pyVector2Type))
+    else if (Py_IS_TYPE(a, &pyVector2Type))
     {
-        Vector2* res = PyObject_New(Vector2, &pyVector2Type);
+        Vector2* res = py_vector2_new();
+        if (!res)
+            return NULL;
+
         glm_vec2_lerp(
             ((Vector2*)a)->data,
             ((Vector2*)b)->data,
@@ -54,9 +75,12 @@ static PyObject* interpolate(PyObject* Py_UNUSED(self), PyObject* args)
             res->data);
         return (PyObject*)res;
     }
-    else if (PyObject_IsInstance(a, (PyObject*)&pyVector3Type))
+    else if (Py_IS_TYPE(a, &pyVector3Type))
     {
-        Vector3* res = PyObject_New(Vector3, &pyVector3Type);
+        Vector3* res = py_vector3_new();
+        if (!res)
+            return NULL;
+
         glm_vec3_lerp(
             ((Vector3*)a)->data,
             ((Vector3*)b)->data,
@@ -64,9 +88,12 @@ static PyObject* interpolate(PyObject* Py_UNUSED(self), PyObject* args)
             res->data);
         return (PyObject*)res;
     }
-    else if (PyObject_IsInstance(a, (PyObject*)&pyVector4Type))
+    else if (Py_IS_TYPE(a, &pyVector4Type))
     {
-        Vector4* res = PyObject_New(Vector4, &pyVector4Type);
+        Vector4* res = py_vector4_new();
+        if (!res)
+            return NULL;
+
         glm_vec4_lerp(
             ((Vector4*)a)->data,
             ((Vector4*)b)->data,
@@ -74,9 +101,12 @@ static PyObject* interpolate(PyObject* Py_UNUSED(self), PyObject* args)
             res->data);
         return (PyObject*)res;
     }
-    else if (PyObject_IsInstance(a, (PyObject*)&pyQuaternionType))
+    else if (Py_IS_TYPE(a, &pyQuaternionType))
     {
-        Quaternion* res = PyObject_New(Quaternion, &pyQuaternionType);
+        Quaternion* res = py_quaternion_new();
+        if (!res)
+            return NULL;
+
         glm_quat_lerp(
             ((Quaternion*)a)->data,
             ((Quaternion*)b)->data,
@@ -111,6 +141,32 @@ static PyObject* rad_to_deg(PyObject* Py_UNUSED(self), PyObject* angle)
     return PyFloat_FromDouble(glm_deg(PyFloat_AS_DOUBLE(angle)));
 }
 
+static EnumDef matrixKindEnum = {
+    .enumName = "MatrixKind",
+    .values = (EnumValue[]){
+        {"GENERAL", MATRIX_KIND_GENERAL},
+        {"AFFINE", MATRIX_KIND_AFFINE},
+        {"RIGID", MATRIX_KIND_RIGID},
+        {"TRANSLATION", MATRIX_KIND_TRANSLATION},
+        {"IDENTITY", MATRIX_KIND_IDENTITY},
+        {0}},
+};
+
+static EnumDef packFormatEnum = {
+    .enumName = "PackFormat",
+    .values = (EnumValue[]){
+        {"HALF_FLOAT", PACK_FORMAT_HALF_FLOAT},
+        {"SNORM8", PACK_FORMAT_SNORM8},
+        {"SNORM16", PACK_FORMAT_SNORM16},
+        {"UNORM8", PACK_FORMAT_UNORM8},
+        {"UNORM16", PACK_FORMAT_UNORM16},
+        {"INT_2_10_10_10_REV", PACK_FORMAT_INT_2_10_10_10_REV},
+        {"UNSIGNED_INT_2_10_10_10_REV", PACK_FORMAT_UNSIGNED_INT_2_10_10_10_REV},
+        {"OCTAHEDRAL8", PACK_FORMAT_OCTAHEDRAL8},
+        {"OCTAHEDRAL16", PACK_FORMAT_OCTAHEDRAL16},
+        {0}},
+};
+
 static ModuleInfo modInfo = {
     .def = {
         PyModuleDef_HEAD_INIT,
@@ -118,23 +174,69 @@ static ModuleInfo modInfo = {
         .m_size = -1,
         .m_methods = (PyMethodDef[]) {
             {"get_closest_factors", get_closest_factors, METH_O, NULL},
-            {"interpolate", interpolate, METH_VARARGS, NULL},
+            {"interpolate", (PyCFunction)interpolate, METH_FASTCALL | METH_KEYWORDS, NULL},
             {"deg_to_rad", deg_to_rad, METH_O, NULL},
             {"rad_to_deg", rad_to_deg, METH_O, NULL},
+            {"transform_points", (PyCFunction)math_transform_points, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"transform_directions", (PyCFunction)math_transform_directions, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"transform_normals", (PyCFunction)math_transform_normals, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"to_camera_relative", (PyCFunction)math_to_camera_relative, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"pack_vertices", (PyCFunction)math_pack_vertices, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"unpack_vertices", (PyCFunction)math_unpack_vertices, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"get_packed_size", (PyCFunction)math_get_packed_size, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"get_free_list_stats", math_get_free_list_stats, METH_NOARGS, NULL},
+            {"set_free_list_capacity", (PyCFunction)math_set_free_list_capacity, METH_VARARGS | METH_KEYWORDS, NULL},
             {0}}},
     .types = (PyTypeObject*[]) {
         &pyVector2Type,
         &pyVector3Type,
         &pyVector4Type,
+        &pyDVector2Type,
+        &pyDVector3Type,
+        &pyDVector4Type,
+        &pyVector2ArrayType,
+        &pyVector3ArrayType,
+        &pyVector4ArrayType,
         &pyQuaternionType,
         &pyMatrix2Type,
         &pyMatrix3Type,
         &pyMatrix4Type,
+        &pyDMatrix4Type,
+        &pyMatrix4ArrayType,
+        &pyPlaneType,
+        &pyFrustumType,
+        &pyBVHType,
+        &pyAnimationClipType,
+        &pySkeletonType,
+        &pyTransformTreeType,
+        &pyCurveType,
+        &pyBezierCurveType,
+        &pyCatmullRomCurveType,
+        &pyHermiteCurveType,
+        NULL},
+    .enums = (EnumDef *[]){
+        &matrixKindEnum,
+        &packFormatEnum,
         NULL},
 };
 
 
 PyMODINIT_FUNC PyInit_math()
 {
-    return module_create_from_info(&modInfo);
+    PyObject *module = module_create_from_info(&modInfo);
+    if (!module)
+        return NULL;
+
+    // `pygl.math.noise` lives in the same extension, so it is registered manually to be importable by its full name
+    PyObject *noise = noise_module_create();
+    if (!noise ||
+        PyDict_SetItemString(PyImport_GetModuleDict(), "pygl.math.noise", noise) ||
+        PyModule_AddObject(module, "noise", noise))
+    {
+        Py_XDECREF(noise);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    return module;
 }
@@ -0,0 +1,3 @@
+#define MAT_LEN 4
+#define MAT_DOUBLE
+#include "matrix_template.h"
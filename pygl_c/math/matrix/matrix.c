@@ -3,9 +3,9 @@
 
 bool PyMatrix_Check(PyObject *obj)
 {
-    return PyObject_IsInstance(obj, (PyObject *)&pyMatrix2Type) ||
-           PyObject_IsInstance(obj, (PyObject *)&pyMatrix3Type) ||
-           PyObject_IsInstance(obj, (PyObject *)&pyMatrix4Type);
+    return Py_IS_TYPE(obj, &pyMatrix2Type) ||
+           Py_IS_TYPE(obj, &pyMatrix3Type) ||
+           Py_IS_TYPE(obj, &pyMatrix4Type);
 }
 
 void *PyMatrix_GetData(PyObject *matrix)
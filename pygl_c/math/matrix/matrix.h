@@ -7,9 +7,25 @@
 // NOTE cglm/mat2 MUST be included after anything that provides cglm_vec4_ucopy, because it
 // doesn't include it itself (this is a cglm bug).
 #include <cglm/mat2.h>
+#include "../dmath.h"
 
 #define PyMatrix_HEAD PyObject_HEAD size_t length
 
+// Structural class of a 4x4 matrix, used to dispatch inverse and multiplication to cheaper kernels. Kinds are
+// ordered from the most general one, so kind of a product is the lesser of its factors' kinds. Zero-initialized
+// matrices are general.
+typedef enum
+{
+    MATRIX_KIND_GENERAL,
+    // last row is (0, 0, 0, 1)
+    MATRIX_KIND_AFFINE,
+    // rotation and translation
+    MATRIX_KIND_RIGID,
+    MATRIX_KIND_TRANSLATION,
+    MATRIX_KIND_IDENTITY,
+    MATRIX_KIND_COUNT,
+} MatrixKind;
+
 typedef struct
 {
     PyMatrix_HEAD;
@@ -26,11 +42,29 @@ typedef struct
 {
     PyMatrix_HEAD;
     mat4 data;
+    MatrixKind kind;
 } Matrix4;
 
+typedef struct
+{
+    PyMatrix_HEAD;
+    dmat4 data;
+    MatrixKind kind;
+} DMatrix4;
+
 extern PyTypeObject pyMatrix2Type;
 extern PyTypeObject pyMatrix3Type;
 extern PyTypeObject pyMatrix4Type;
+extern PyTypeObject pyDMatrix4Type;
+
+Matrix2 *py_matrix2_new(void);
+Matrix3 *py_matrix3_new(void);
+Matrix4 *py_matrix4_new(void);
+DMatrix4 *py_dmatrix4_new(void);
+
+// Invert matrix using kernel selected by its kind.
+void py_matrix4_inv(Matrix4 *matrix, mat4 dest);
+void py_dmatrix4_inv(DMatrix4 *matrix, dmat4 dest);
 
 bool PyMatrix_Check(PyObject *obj);
 void *PyMatrix_GetData(PyObject *matrix);
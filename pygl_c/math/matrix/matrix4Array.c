@@ -0,0 +1,584 @@
+#include "matrix4Array.h"
+#include <string.h>
+#include <cglm/quat.h>
+#include "../../buffers/buffer.h"
+#include "../../utility.h"
+
+#define _SELF Matrix4Array *self
+#define _OUT_AT(out, idx) ((char *)(out) + (idx) * sizeof(mat4))
+#define _NEW(var, count)                                \
+    Matrix4Array *var = py_matrix4_array_new(count);    \
+    if (!var)                                           \
+    return NULL
+
+bool py_matrix4_array_allocate(Matrix4Array *array, Py_ssize_t count)
+{
+    // always allocate at least a single matrix so `data` is never NULL for valid arrays
+    mat4 *data = utils_aligned_malloc(sizeof(mat4) * (count > 0 ? count : 1), MATRIX_ARRAY_ALIGNMENT);
+    if (!data)
+    {
+        PyErr_NoMemory();
+        return false;
+    }
+
+    utils_aligned_free(array->data);
+
+    array->data = data;
+    array->count = count;
+    array->shape[0] = count;
+    array->shape[1] = 4;
+    array->shape[2] = 4;
+    array->strides[0] = sizeof(mat4);
+    array->strides[1] = sizeof(vec4);
+    array->strides[2] = sizeof(float);
+
+    return true;
+}
+
+Matrix4Array *py_matrix4_array_new(Py_ssize_t count)
+{
+    Matrix4Array *array = PyObject_New(Matrix4Array, &pyMatrix4ArrayType);
+    if (!array)
+        return NULL;
+
+    array->data = NULL;
+    array->exports = 0;
+
+    if (!py_matrix4_array_allocate(array, count))
+    {
+        Py_DECREF(array);
+        return NULL;
+    }
+
+    return array;
+}
+
+Py_ssize_t py_matrix4_array_size(const Matrix4Array *array)
+{
+    return array->count * sizeof(mat4);
+}
+
+void *py_matrix4_array_acquire_output(PyObject *out, Py_ssize_t offset, Py_ssize_t count, WriteTarget *target, PyObject **result)
+{
+    if (out == NULL || out == Py_None)
+    {
+        Matrix4Array *array = py_matrix4_array_new(count);
+        if (!array)
+            return NULL;
+
+        *target = (WriteTarget){.data = array->data};
+        *result = (PyObject *)array;
+
+        return target->data;
+    }
+
+    if (!py_buffer_acquire_write_target(out, offset, count * sizeof(mat4), target))
+        return NULL;
+
+    *result = Py_NewRef(Py_None);
+
+    return target->data;
+}
+
+// Output memory might not be aligned (e.g. arbitrary offset into mapped buffer), so all kernels below compute
+// results into local matrices and copy them afterwards.
+static void compose_kernel(const float *translations, const float *scales, const float *rotations, Py_ssize_t count, void *out)
+{
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        versor rotation;
+        if (rotations != NULL)
+            memcpy(rotation, rotations + i * 4, sizeof(versor));
+
+        mat4 matrix;
+        matrix4_compose_trs(translations + i * 3, rotations != NULL ? rotation : NULL, scales != NULL ? scales + i * 3 : NULL, matrix);
+
+        memcpy(_OUT_AT(out, i), matrix, sizeof(mat4));
+    }
+}
+
+static void matmul_kernel(mat4 *left, Py_ssize_t leftStride, mat4 *right, Py_ssize_t rightStride, Py_ssize_t count, void *out)
+{
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        mat4 result;
+        glm_mat4_mul(left[i * leftStride], right[i * rightStride], result);
+        memcpy(_OUT_AT(out, i), result, sizeof(mat4));
+    }
+}
+
+static void inverse_kernel(mat4 *matrices, Py_ssize_t count, void *out)
+{
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        mat4 result;
+        glm_mat4_inv(matrices[i], result);
+        memcpy(_OUT_AT(out, i), result, sizeof(mat4));
+    }
+}
+
+static void transpose_kernel(mat4 *matrices, Py_ssize_t count, void *out)
+{
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        mat4 result;
+        glm_mat4_transpose_to(matrices[i], result);
+        memcpy(_OUT_AT(out, i), result, sizeof(mat4));
+    }
+}
+
+// Resolves matrix product operand into matrices pointer and stride (0 when single matrix is broadcasted to all elements).
+// Single matrix is copied into `single`, so the kernel always operates on aligned memory.
+static mat4 *get_operand(PyObject *obj, Py_ssize_t count, mat4 single, Py_ssize_t *stride)
+{
+    if (Py_IS_TYPE(obj, &pyMatrix4ArrayType))
+    {
+        Matrix4Array *array = (Matrix4Array *)obj;
+        if (array->count != count)
+        {
+            PyErr_Format(PyExc_ValueError, "Arrays have to be of the same length (%zd != %zd).", count, array->count);
+            return NULL;
+        }
+
+        *stride = 1;
+        return array->data;
+    }
+
+    glm_mat4_copy(((Matrix4 *)obj)->data, single);
+    *stride = 0;
+
+    return (mat4 *)single;
+}
+
+static bool is_matmul_operand(PyObject *obj)
+{
+    return Py_IS_TYPE(obj, &pyMatrix4ArrayType) || Py_IS_TYPE(obj, &pyMatrix4Type);
+}
+
+// Computes `left[i] @ right[i]`, where at least one of the operands is a matrix array.
+static PyObject *matmul_arrays(PyObject *left, PyObject *right, PyObject *out, Py_ssize_t offset)
+{
+    Py_ssize_t count = Py_IS_TYPE(left, &pyMatrix4ArrayType) ? ((Matrix4Array *)left)->count : ((Matrix4Array *)right)->count;
+
+    mat4 leftSingle, rightSingle;
+    Py_ssize_t leftStride, rightStride;
+    mat4 *leftData = get_operand(left, count, leftSingle, &leftStride);
+    if (!leftData)
+        return NULL;
+
+    mat4 *rightData = get_operand(right, count, rightSingle, &rightStride);
+    if (!rightData)
+        return NULL;
+
+    PyObject *result = NULL;
+    WriteTarget target;
+    void *outData = py_matrix4_array_acquire_output(out, offset, count, &target, &result);
+    if (!outData)
+        return NULL;
+
+    matmul_kernel(leftData, leftStride, rightData, rightStride, count, outData);
+
+    if (result == Py_None)
+        py_buffer_release_write_target(&target);
+
+    return result;
+}
+
+static int init(_SELF, PyObject *args, PyObject *Py_UNUSED(kwargs))
+{
+    PyObject *arg = NULL;
+    if (!PyArg_ParseTuple(args, "O", &arg))
+        return -1;
+
+    if (self->exports > 0)
+    {
+        PyErr_SetString(PyExc_BufferError, "Cannot reinitialize array while its buffer is exported.");
+        return -1;
+    }
+
+    if (PyLong_Check(arg)) // Matrix4Array.__init__(int)
+    {
+        Py_ssize_t count = PyLong_AsSsize_t(arg);
+        if (count < 0)
+        {
+            if (!PyErr_Occurred())
+                PyErr_SetString(PyExc_ValueError, "Array length cannot be negative.");
+            return -1;
+        }
+
+        if (!py_matrix4_array_allocate(self, count))
+            return -1;
+
+        memset(self->data, 0, py_matrix4_array_size(self));
+    }
+    else if (PyObject_CheckBuffer(arg)) // Matrix4Array.__init__(Buffer)
+    {
+        Py_buffer buf;
+        Py_ssize_t count;
+        if (!utils_get_float_buffer(arg, 16, &buf, &count))
+            return -1;
+
+        if (!py_matrix4_array_allocate(self, count))
+        {
+            PyBuffer_Release(&buf);
+            return -1;
+        }
+
+        memcpy(self->data, buf.buf, buf.len);
+        PyBuffer_Release(&buf);
+    }
+    else // Matrix4Array.__init__(Sequence[Matrix4])
+    {
+        PyObject *seq = PySequence_Fast(arg, "Expected argument to be of type int, support buffer protocol or be a sequence of pygl.math.Matrix4.");
+        if (!seq)
+            return -1;
+
+        Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+        if (!py_matrix4_array_allocate(self, count))
+        {
+            Py_DECREF(seq);
+            return -1;
+        }
+
+        PyObject **items = PySequence_Fast_ITEMS(seq);
+        for (Py_ssize_t i = 0; i < count; i++)
+        {
+            if (!Py_IS_TYPE(items[i], &pyMatrix4Type))
+            {
+                PyErr_Format(PyExc_TypeError, "Expected all items to be of type pygl.math.Matrix4, got %s at index %zd.", Py_TYPE(items[i])->tp_name, i);
+                Py_DECREF(seq);
+                return -1;
+            }
+
+            glm_mat4_copy(((Matrix4 *)items[i])->data, self->data[i]);
+        }
+
+        Py_DECREF(seq);
+    }
+
+    return 0;
+}
+
+static void dealloc(_SELF)
+{
+    utils_aligned_free(self->data);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *repr(_SELF)
+{
+    return PyUnicode_FromFormat(
+        "<%s object at %p (count: %zd)>",
+        Py_TYPE(self)->tp_name,
+        self,
+        self->count);
+}
+
+static PyObject *identity(PyTypeObject *Py_UNUSED(cls), PyObject *arg)
+{
+    Py_ssize_t count = PyLong_AsSsize_t(arg);
+    if (count < 0)
+    {
+        if (!PyErr_Occurred())
+            PyErr_SetString(PyExc_ValueError, "Array length cannot be negative.");
+        return NULL;
+    }
+
+    _NEW(result, count);
+    for (Py_ssize_t i = 0; i < count; i++)
+        glm_mat4_identity(result->data[i]);
+
+    return (PyObject *)result;
+}
+
+static PyObject *compose(PyTypeObject *Py_UNUSED(cls), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"translations", "scales", "rotations", "out", "offset", NULL};
+
+    PyObject *translationsObj = NULL;
+    PyObject *scalesObj = Py_None;
+    PyObject *rotationsObj = Py_None;
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OO$On", kwNames, &translationsObj, &scalesObj, &rotationsObj, &out, &offset))
+        return NULL;
+
+    PyObject *result = NULL;
+    Py_buffer translations = {0};
+    Py_buffer scales = {0};
+    Py_buffer rotations = {0};
+    Py_ssize_t count, scalesCount, rotationsCount;
+
+    if (!utils_get_float_buffer(translationsObj, 3, &translations, &count))
+        return NULL;
+
+    if (scalesObj != Py_None)
+    {
+        if (!utils_get_float_buffer(scalesObj, 3, &scales, &scalesCount))
+            goto end;
+
+        if (scalesCount != count)
+        {
+            PyErr_Format(PyExc_ValueError, "Expected %zd scales, got %zd.", count, scalesCount);
+            goto end;
+        }
+    }
+
+    if (rotationsObj != Py_None)
+    {
+        if (!utils_get_float_buffer(rotationsObj, 4, &rotations, &rotationsCount))
+            goto end;
+
+        if (rotationsCount != count)
+        {
+            PyErr_Format(PyExc_ValueError, "Expected %zd rotations, got %zd.", count, rotationsCount);
+            goto end;
+        }
+    }
+
+    WriteTarget target;
+    void *outData = py_matrix4_array_acquire_output(out, offset, count, &target, &result);
+    if (!outData)
+        goto end;
+
+    compose_kernel(translations.buf, scales.buf, rotations.buf, count, outData);
+
+    if (result == Py_None)
+        py_buffer_release_write_target(&target);
+
+end:
+    PyBuffer_Release(&translations);
+    if (scales.obj != NULL)
+        PyBuffer_Release(&scales);
+    if (rotations.obj != NULL)
+        PyBuffer_Release(&rotations);
+
+    return result;
+}
+
+static PyObject *matmul_method(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"other", "out", "offset", NULL};
+
+    PyObject *other = NULL;
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$On", kwNames, &other, &out, &offset))
+        return NULL;
+
+    if (!is_matmul_operand(other))
+    {
+        PyErr_Format(PyExc_TypeError, "Expected argument to be of type pygl.math.Matrix4Array or pygl.math.Matrix4, got: %s.", Py_TYPE(other)->tp_name);
+        return NULL;
+    }
+
+    return matmul_arrays((PyObject *)self, other, out, offset);
+}
+
+static PyObject *rmatmul_method(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"other", "out", "offset", NULL};
+
+    PyObject *other = NULL;
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$On", kwNames, &other, &out, &offset))
+        return NULL;
+
+    if (!is_matmul_operand(other))
+    {
+        PyErr_Format(PyExc_TypeError, "Expected argument to be of type pygl.math.Matrix4Array or pygl.math.Matrix4, got: %s.", Py_TYPE(other)->tp_name);
+        return NULL;
+    }
+
+    return matmul_arrays(other, (PyObject *)self, out, offset);
+}
+
+static PyObject *inverse(_SELF, PyObject *Py_UNUSED(args))
+{
+    inverse_kernel(self->data, self->count, self->data);
+    Py_RETURN_NONE;
+}
+
+static PyObject *inversed(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"out", "offset", NULL};
+
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$On", kwNames, &out, &offset))
+        return NULL;
+
+    PyObject *result = NULL;
+    WriteTarget target;
+    void *outData = py_matrix4_array_acquire_output(out, offset, self->count, &target, &result);
+    if (!outData)
+        return NULL;
+
+    inverse_kernel(self->data, self->count, outData);
+
+    if (result == Py_None)
+        py_buffer_release_write_target(&target);
+
+    return result;
+}
+
+static PyObject *transpose(_SELF, PyObject *Py_UNUSED(args))
+{
+    transpose_kernel(self->data, self->count, self->data);
+    Py_RETURN_NONE;
+}
+
+static PyObject *transposed(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"out", "offset", NULL};
+
+    PyObject *out = Py_None;
+    Py_ssize_t offset = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$On", kwNames, &out, &offset))
+        return NULL;
+
+    PyObject *result = NULL;
+    WriteTarget target;
+    void *outData = py_matrix4_array_acquire_output(out, offset, self->count, &target, &result);
+    if (!outData)
+        return NULL;
+
+    transpose_kernel(self->data, self->count, outData);
+
+    if (result == Py_None)
+        py_buffer_release_write_target(&target);
+
+    return result;
+}
+
+static PyObject *matmul(PyObject *left, PyObject *right)
+{
+    if (!is_matmul_operand(left) || !is_matmul_operand(right))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    return matmul_arrays(left, right, Py_None, -1);
+}
+
+static PyObject *imatmul(_SELF, PyObject *other)
+{
+    if (!is_matmul_operand(other))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    mat4 single;
+    Py_ssize_t stride;
+    mat4 *otherData = get_operand(other, self->count, single, &stride);
+    if (!otherData)
+        return NULL;
+
+    matmul_kernel(self->data, 1, otherData, stride, self->count, self->data);
+
+    return Py_NewRef(self);
+}
+
+static Py_ssize_t len(_SELF)
+{
+    return self->count;
+}
+
+static PyObject *item(_SELF, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->count)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range.");
+        return NULL;
+    }
+
+    Matrix4 *result = py_matrix4_new();
+    if (!result)
+        return NULL;
+
+    glm_mat4_copy(self->data[index], result->data);
+
+    return (PyObject *)result;
+}
+
+static int assign_item(_SELF, Py_ssize_t index, PyObject *value)
+{
+    if (index < 0 || index >= self->count)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range.");
+        return -1;
+    }
+
+    if (value == NULL || !Py_IS_TYPE(value, &pyMatrix4Type))
+    {
+        PyErr_SetString(PyExc_TypeError, "Expected value to be of type pygl.math.Matrix4.");
+        return -1;
+    }
+
+    glm_mat4_copy(((Matrix4 *)value)->data, self->data[index]);
+
+    return 0;
+}
+
+static int get_buffer(_SELF, Py_buffer *buffer, int flags)
+{
+    if (PyBuffer_FillInfo(buffer, (PyObject *)self, self->data, py_matrix4_array_size(self), 0, flags) == -1)
+        return -1;
+
+    // without format consumer assumes unsigned bytes, so only flat byte view filled above is consistent then
+    if (FLAG_IS_SET(flags, PyBUF_ND | PyBUF_FORMAT))
+    {
+        buffer->itemsize = sizeof(float);
+        buffer->ndim = 3;
+        buffer->shape = self->shape;
+        buffer->format = "f";
+
+        if (FLAG_IS_SET(flags, PyBUF_STRIDES))
+            buffer->strides = self->strides;
+    }
+
+    self->exports++;
+
+    return 0;
+}
+
+static void release_buffer(_SELF, Py_buffer *Py_UNUSED(buffer))
+{
+    self->exports--;
+}
+
+PyTypeObject pyMatrix4ArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_new = PyType_GenericNew,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.math.Matrix4Array",
+    .tp_basicsize = sizeof(Matrix4Array),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_members = (PyMemberDef[]){
+        {"count", T_PYSSIZET, offsetof(Matrix4Array, count), READONLY, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"identity", (PyCFunction)identity, METH_CLASS | METH_O, NULL},
+        {"compose", (PyCFunction)compose, METH_CLASS | METH_VARARGS | METH_KEYWORDS, NULL},
+        {"matmul", (PyCFunction)matmul_method, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"rmatmul", (PyCFunction)rmatmul_method, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"inverse", (PyCFunction)inverse, METH_NOARGS, NULL},
+        {"inversed", (PyCFunction)inversed, METH_VARARGS | METH_KEYWORDS, NULL},
+        {"transpose", (PyCFunction)transpose, METH_NOARGS, NULL},
+        {"transposed", (PyCFunction)transposed, METH_VARARGS | METH_KEYWORDS, NULL},
+        {0},
+    },
+    .tp_as_sequence = &(PySequenceMethods){
+        .sq_length = (lenfunc)len,
+        .sq_item = (ssizeargfunc)item,
+        .sq_ass_item = (ssizeobjargproc)assign_item,
+    },
+    .tp_as_number = &(PyNumberMethods){
+        .nb_matrix_multiply = (binaryfunc)matmul,
+        .nb_inplace_matrix_multiply = (binaryfunc)imatmul,
+    },
+    .tp_as_buffer = &(PyBufferProcs){
+        .bf_getbuffer = (getbufferproc)get_buffer,
+        .bf_releasebuffer = (releasebufferproc)release_buffer,
+    },
+};
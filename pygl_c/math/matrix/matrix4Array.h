@@ -0,0 +1,51 @@
+#pragma once
+#include <stdbool.h>
+#include <Python.h>
+#include <cglm/quat.h>
+#include "matrix.h"
+#include "../../buffers/buffer.h"
+
+// Alignment of matrix arrays storage. Matches alignment required by cglm for mat4 AVX paths.
+#define MATRIX_ARRAY_ALIGNMENT 32
+
+typedef struct
+{
+    PyObject_HEAD
+    Py_ssize_t count;
+    Py_ssize_t exports;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+    mat4 *data;
+} Matrix4Array;
+
+extern PyTypeObject pyMatrix4ArrayType;
+
+bool py_matrix4_array_allocate(Matrix4Array *array, Py_ssize_t count);
+Matrix4Array *py_matrix4_array_new(Py_ssize_t count);
+Py_ssize_t py_matrix4_array_size(const Matrix4Array *array);
+
+// Resolves memory for `count` output matrices. If `out` is None, new array is created and returned
+// through `result`, otherwise matrices are written into `out` and `result` is set to None, in which case
+// `target` has to be released by the caller.
+void *py_matrix4_array_acquire_output(PyObject *out, Py_ssize_t offset, Py_ssize_t count, WriteTarget *target, PyObject **result);
+
+// Writes T * R * S into `dest` without performing full matrix multiplications. Missing rotation or scale (NULL)
+// is treated as identity.
+static inline void matrix4_compose_trs(const float *translation, versor rotation, const float *scale, mat4 dest)
+{
+    if (rotation != NULL)
+        glm_quat_mat4(rotation, dest);
+    else
+        glm_mat4_identity(dest);
+
+    if (scale != NULL)
+    {
+        glm_vec4_scale(dest[0], scale[0], dest[0]);
+        glm_vec4_scale(dest[1], scale[1], dest[1]);
+        glm_vec4_scale(dest[2], scale[2], dest[2]);
+    }
+
+    dest[3][0] = translation[0];
+    dest[3][1] = translation[1];
+    dest[3][2] = translation[2];
+}
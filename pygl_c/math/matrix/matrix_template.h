@@ -11,29 +11,214 @@
 #include "matrix.h"
 #include "../quaternion.h"
 #include "../vector/vector.h"
+#include "../freeList.h"
 #include "../../utility.h"
 
+// MAT_DOUBLE selects double precision variant (DMatrix*) built on top of dmath.h routines
+#ifdef MAT_DOUBLE
+#define _TYPE CAT(DMatrix, MAT_LEN)
+#define _PY_TYPE CAT(CAT(pyDMatrix, MAT_LEN), Type)
+#define _GLM_TYPE CAT(dmat, MAT_LEN)
+#define _GLM_VEC_TYPE CAT(dvec, MAT_LEN)
+#define _VEC_TYPE CAT(DVector, MAT_LEN)
+#define _VEC_PY_TYPE CAT(CAT(pyDVector, MAT_LEN), Type)
+#define _VEC3_TYPE DVector3
+#define _VEC3_PY_TYPE pyDVector3Type
+#define _NEW_FUNC CAT(CAT(py_dmatrix, MAT_LEN), _new)
+#define _INV_FUNC CAT(CAT(py_dmatrix, MAT_LEN), _inv)
+#define _VEC_NEW_FUNC CAT(CAT(py_dvector, MAT_LEN), _new)
+#define _FREE_LIST (&mathFreeLists[CAT(FREE_LIST_DMATRIX, MAT_LEN)])
+#define _GLM_PREFIX dglm_
+#define _SCALAR double
+#define _SCALAR_FORMAT "d"
+#else
 #define _TYPE CAT(Matrix, MAT_LEN)
 #define _PY_TYPE CAT(CAT(pyMatrix, MAT_LEN), Type)
 #define _GLM_TYPE CAT(mat, MAT_LEN)
+#define _GLM_VEC_TYPE CAT(vec, MAT_LEN)
 #define _VEC_TYPE CAT(Vector, MAT_LEN)
 #define _VEC_PY_TYPE CAT(CAT(pyVector, MAT_LEN), Type)
+#define _VEC3_TYPE Vector3
+#define _VEC3_PY_TYPE pyVector3Type
+#define _NEW_FUNC CAT(CAT(py_matrix, MAT_LEN), _new)
+#define _INV_FUNC CAT(CAT(py_matrix, MAT_LEN), _inv)
+#define _VEC_NEW_FUNC CAT(CAT(py_vector, MAT_LEN), _new)
+#define _FREE_LIST (&mathFreeLists[CAT(FREE_LIST_MATRIX, MAT_LEN)])
+#define _GLM_PREFIX glm_
+#define _SCALAR float
+#define _SCALAR_FORMAT "f"
+#endif
 #define _SELF _TYPE *self
-#define _GLM_INVOKE(func, ...) CAT(CAT(CAT(glm_mat, MAT_LEN), _), func)(__VA_ARGS__)
-#define _NEW(var)                                \
-    _TYPE *var = PyObject_New(_TYPE, &_PY_TYPE); \
-    var->length = MAT_LEN * MAT_LEN
-#define _GLM_VEC_COPY(src, dst) CAT(CAT(glm_vec, MAT_LEN), _copy)(src, dst)
+#define _GLM_FUNC(func) CAT(_GLM_PREFIX, func)
+#define _GLM_INVOKE(func, ...) CAT(CAT(CAT(_GLM_FUNC(mat), MAT_LEN), _), func)(__VA_ARGS__)
+#define _NEW(var)            \
+    _TYPE *var = _NEW_FUNC(); \
+    if (!var)                \
+    return NULL
+#define _GLM_VEC_COPY(src, dst) CAT(CAT(_GLM_FUNC(vec), MAT_LEN), _copy)(src, dst)
+// only 4x4 matrices track their kind, smaller ones always use general kernels
+#if MAT_LEN == 4
+#define _GET_KIND(obj) ((obj)->kind)
+#define _SET_KIND(obj, value) ((obj)->kind = (value))
+#define _RECLASSIFY(obj) ((obj)->kind = classify((obj)->data[0]))
+#else
+#define _GET_KIND(obj) MATRIX_KIND_GENERAL
+#define _SET_KIND(obj, value) ((void)(obj), (void)(value))
+#define _RECLASSIFY(obj) ((void)(obj))
+#endif
 #define _MAT_OP_CHECK_TYPE(obj)                                           \
     do                                                                    \
     {                                                                     \
-        if (!PyObject_IsInstance((PyObject *)obj, (PyObject *)&_PY_TYPE)) \
+        if (!Py_IS_TYPE((PyObject *)obj, &_PY_TYPE))                      \
             Py_RETURN_NOTIMPLEMENTED;                                     \
     } while (0)
 
-static int init(_SELF, PyObject *args, PyObject *kwargs)
+_TYPE *_NEW_FUNC(void)
+{
+    _TYPE *result = (_TYPE *)free_list_alloc(_FREE_LIST);
+    if (result != NULL)
+    {
+        result->length = MAT_LEN * MAT_LEN;
+        _SET_KIND(result, MATRIX_KIND_GENERAL);
+    }
+
+    return result;
+}
+
+#if MAT_LEN == 4
+// Detects kind of matrix with arbitrary values. Rigid matrices can't be told apart from affine ones without
+// tolerance checks, so they are conservatively reported as affine. Values are read as flat column-major array.
+static MatrixKind classify(const _SCALAR *m)
+{
+    if (m[3] != 0.0 || m[7] != 0.0 || m[11] != 0.0 || m[15] != 1.0)
+        return MATRIX_KIND_GENERAL;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            if (m[i * 4 + j] != (i == j ? 1.0 : 0.0))
+                return MATRIX_KIND_AFFINE;
+        }
+    }
+
+    if (m[12] != 0.0 || m[13] != 0.0 || m[14] != 0.0)
+        return MATRIX_KIND_TRANSLATION;
+
+    return MATRIX_KIND_IDENTITY;
+}
+
+// Inverts upper 3x3 part using rows built from cross products of its columns and applies it to translation.
+static void affine_inv(_GLM_TYPE m, _GLM_TYPE dest)
+{
+    const _SCALAR *c0 = m[0];
+    const _SCALAR *c1 = m[1];
+    const _SCALAR *c2 = m[2];
+
+    _SCALAR rows[3][3] = {
+        {c1[1] * c2[2] - c1[2] * c2[1], c1[2] * c2[0] - c1[0] * c2[2], c1[0] * c2[1] - c1[1] * c2[0]},
+        {c2[1] * c0[2] - c2[2] * c0[1], c2[2] * c0[0] - c2[0] * c0[2], c2[0] * c0[1] - c2[1] * c0[0]},
+        {c0[1] * c1[2] - c0[2] * c1[1], c0[2] * c1[0] - c0[0] * c1[2], c0[0] * c1[1] - c0[1] * c1[0]},
+    };
+    const _SCALAR invDet = 1.0 / (c0[0] * rows[0][0] + c0[1] * rows[0][1] + c0[2] * rows[0][2]);
+    const _SCALAR t[3] = {m[3][0], m[3][1], m[3][2]};
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            dest[j][i] = rows[i][j] * invDet;
+
+        dest[i][3] = 0.0;
+    }
+
+    for (size_t i = 0; i < 3; i++)
+        dest[3][i] = -(dest[0][i] * t[0] + dest[1][i] * t[1] + dest[2][i] * t[2]);
+
+    dest[3][3] = 1.0;
+}
+#endif
+
+// `dest` must not alias data of `self`.
+static void inv_impl(_SELF, _GLM_TYPE dest)
+{
+    switch (_GET_KIND(self))
+    {
+#if MAT_LEN == 4
+    case MATRIX_KIND_IDENTITY:
+        _GLM_INVOKE(identity, dest);
+        break;
+    case MATRIX_KIND_TRANSLATION:
+        _GLM_INVOKE(identity, dest);
+        dest[3][0] = -self->data[3][0];
+        dest[3][1] = -self->data[3][1];
+        dest[3][2] = -self->data[3][2];
+        break;
+    case MATRIX_KIND_RIGID:
+        _GLM_INVOKE(copy, self->data, dest);
+        _GLM_FUNC(inv_tr)(dest);
+        break;
+    case MATRIX_KIND_AFFINE:
+        affine_inv(self->data, dest);
+        break;
+#endif
+    default:
+        _GLM_INVOKE(inv, self->data, dest);
+        break;
+    }
+}
+
+// `dest` must not alias data of `self` or `other`.
+static void mul_impl(_SELF, _TYPE *other, _GLM_TYPE dest)
+{
+#if MAT_LEN == 4
+    const MatrixKind kind = _GET_KIND(self);
+    const MatrixKind otherKind = _GET_KIND(other);
+    if (kind == MATRIX_KIND_IDENTITY)
+    {
+        _GLM_INVOKE(copy, other->data, dest);
+    }
+    else if (otherKind == MATRIX_KIND_IDENTITY)
+    {
+        _GLM_INVOKE(copy, self->data, dest);
+    }
+    else if (kind == MATRIX_KIND_TRANSLATION && otherKind >= MATRIX_KIND_AFFINE)
+    {
+        // basis vectors of affine matrix are not affected by translation
+        _GLM_INVOKE(copy, other->data, dest);
+        dest[3][0] += self->data[3][0];
+        dest[3][1] += self->data[3][1];
+        dest[3][2] += self->data[3][2];
+    }
+    else if (kind >= MATRIX_KIND_AFFINE && otherKind >= MATRIX_KIND_AFFINE)
+    {
+        _GLM_FUNC(mul)(self->data, other->data, dest);
+    }
+    else
+#endif
+    {
+        _GLM_INVOKE(mul, self->data, other->data, dest);
+    }
+}
+
+static MatrixKind product_kind(MatrixKind kind, MatrixKind otherKind)
+{
+    return kind < otherKind ? kind : otherKind;
+}
+
+#if MAT_LEN == 4
+void _INV_FUNC(_SELF, _GLM_TYPE dest)
+{
+    inv_impl(self, dest);
+}
+#endif
+
+static void dealloc(_SELF)
+{
+    free_list_dealloc(_FREE_LIST, (PyObject *)self);
+}
+
+static bool set_values(_SELF, PyObject *const *args, Py_ssize_t argsLen)
 {
-    size_t argsLen = PyTuple_GET_SIZE(args);
 
     if (argsLen == 0)
     {
@@ -41,11 +226,11 @@ static int init(_SELF, PyObject *args, PyObject *kwargs)
     }
     else if (argsLen == 1) // Matrix*.__init__(float | Buffer | list[float])
     {
-        PyObject *arg = PyTuple_GET_ITEM(args, 0);
+        PyObject *arg = args[0];
 
         if (PyFloat_Check(arg))
         {
-            float diag = PyFloat_AS_DOUBLE(arg);
+            _SCALAR diag = (_SCALAR)PyFloat_AS_DOUBLE(arg);
 
             _GLM_INVOKE(zero, self->data);
 
@@ -58,7 +243,7 @@ static int init(_SELF, PyObject *args, PyObject *kwargs)
             if (PyObject_GetBuffer(arg, &buf, PyBUF_C_CONTIGUOUS) == -1)
             {
                 raise_buffer_not_contiguous();
-                return -1;
+                return false;
             }
 
             PyBuffer_ToContiguous(self->data, &buf, sizeof(_GLM_TYPE), 'C');
@@ -72,36 +257,42 @@ static int init(_SELF, PyObject *args, PyObject *kwargs)
             if (valuesCount != MAT_LEN * MAT_LEN)
             {
                 PyErr_Format(PyExc_ValueError, "List of matrix values must contain %d elements.", MAT_LEN * MAT_LEN);
-                return -1;
+                Py_DECREF(seq);
+                return false;
             }
 
             PyObject **values = PySequence_Fast_ITEMS(seq);
             for (size_t i = 0; i < valuesCount; i++)
             {
-                ((float *)self->data)[i] = PyFloat_AsDouble(values[i]);
+                ((_SCALAR *)self->data)[i] = (_SCALAR)PyFloat_AsDouble(values[i]);
                 if (PyErr_Occurred())
-                    return -1;
+                {
+                    Py_DECREF(seq);
+                    return false;
+                }
             }
+
+            Py_DECREF(seq);
         }
         else
         {
             PyErr_Format(PyExc_TypeError, "Expected argument to be of type float or support buffer protocol, got %s.", Py_TYPE(arg)->tp_name);
-            return -1;
+            return false;
         }
     }
     else if (argsLen == MAT_LEN) // Matrix*.__init__(Vector*, Vector*, Vector*, Vector*)
     {
         for (size_t i = 0; i < MAT_LEN; i++)
         {
-            PyObject *row = PyTuple_GET_ITEM(args, 0);
-            if (!PyObject_IsInstance(row, (PyObject *)&_VEC_PY_TYPE))
+            PyObject *row = args[i];
+            if (!Py_IS_TYPE(row, &_VEC_PY_TYPE))
             {
                 PyErr_Format(
                     PyExc_TypeError,
-                    "Expected all arguments to be of type pygl.math.Vector" STRINGIFY(MAT_LEN) ", got %s at index %d.",
+                    "Expected all arguments to be of type pygl.math." STRINGIFY(_VEC_TYPE) ", got %s at index %zu.",
                     Py_TYPE(row)->tp_name,
                     i);
-                return -1;
+                return false;
             }
 
             void *rowData = ((_VEC_TYPE *)row)->data;
@@ -110,21 +301,44 @@ static int init(_SELF, PyObject *args, PyObject *kwargs)
     }
     else
     {
-        PyErr_SetString(PyExc_TypeError, "Invalid arguments provided. See usage of Matrix" STRINGIFY(MAT_LEN) ".__init__."); // TODO Add link to documentation
-        return -1;
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments provided. See usage of " STRINGIFY(_TYPE) ".__init__."); // TODO Add link to documentation
+        return false;
     }
 
     self->length = MAT_LEN * MAT_LEN;
+    _RECLASSIFY(self);
 
-    return 0;
+    return true;
+}
+
+static int init(_SELF, PyObject *args, PyObject *Py_UNUSED(kwargs))
+{
+    return set_values(self, &PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args)) ? 0 : -1;
+}
+
+static PyObject *vectorcall(PyTypeObject *Py_UNUSED(type), PyObject *const *args, size_t nargsf, PyObject *kwnames)
+{
+    THROW_IF(
+        kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0,
+        PyExc_TypeError,
+        "pygl.math." STRINGIFY(_TYPE) " does not take keyword arguments.",
+        NULL);
+
+    _NEW(result);
+    if (!set_values(result, args, PyVectorcall_NARGS(nargsf)))
+    {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
 }
 
 static PyObject *identity(PyTypeObject *cls, PyObject *Py_UNUSED(args))
 {
-    _TYPE *res = PyObject_New(_TYPE, cls);
+    _NEW(res);
     _GLM_INVOKE(identity, res->data);
-
-    res->length = MAT_LEN * MAT_LEN;
+    _SET_KIND(res, MATRIX_KIND_IDENTITY);
 
     return (PyObject *)res;
 }
@@ -132,44 +346,185 @@ static PyObject *identity(PyTypeObject *cls, PyObject *Py_UNUSED(args))
 static PyObject *transpose(_SELF, PyObject *Py_UNUSED(args))
 {
     _GLM_INVOKE(transpose, self->data);
+    if (_GET_KIND(self) != MATRIX_KIND_IDENTITY)
+        _SET_KIND(self, MATRIX_KIND_GENERAL);
+
     Py_RETURN_NONE;
 }
 
-static PyObject *transposed(_SELF, PyObject *Py_UNUSED(args))
+// Resolves object that receives result of an operation. If `out` is not provided new matrix is created,
+// otherwise new reference to `out` is returned, so results can be written without allocating.
+static _TYPE *get_out(PyObject *out)
 {
-    _NEW(res);
-    _GLM_INVOKE(transpose_to, self->data, res->data);
+    if (out == NULL || out == Py_None)
+        return _NEW_FUNC();
+
+    if (!utils_check_arg_type(out, &_PY_TYPE, "out"))
+        return NULL;
+
+    return (_TYPE *)Py_NewRef(out);
+}
+
+// Results are computed into temporaries first, as `out` may be the same object as `self`.
+static PyObject *transposed_impl(_SELF, PyObject *out)
+{
+    _TYPE *res = get_out(out);
+    if (!res)
+        return NULL;
+
+    _GLM_TYPE tmp;
+    _GLM_INVOKE(transpose_to, self->data, tmp);
+    _GLM_INVOKE(copy, tmp, res->data);
+    _SET_KIND(res, _GET_KIND(self) == MATRIX_KIND_IDENTITY ? MATRIX_KIND_IDENTITY : MATRIX_KIND_GENERAL);
+
     return (PyObject *)res;
 }
 
+static PyObject *transposed(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"out", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 0, values))
+        return NULL;
+
+    return transposed_impl(self, values[0]);
+}
+
+static PyObject *transposed_into(_SELF, PyObject *out)
+{
+    if (!utils_check_arg_type(out, &_PY_TYPE, "out"))
+        return NULL;
+
+    return transposed_impl(self, out);
+}
+
 static PyObject *inverse(_SELF, PyObject *Py_UNUSED(args))
 {
     _GLM_TYPE res;
-    _GLM_INVOKE(inv, self->data, res);
+    inv_impl(self, res);
     _GLM_INVOKE(copy, res, self->data);
 
     Py_RETURN_NONE;
 }
 
-static PyObject *inversed(_SELF, PyObject *Py_UNUSED(args))
+static PyObject *inversed_impl(_SELF, PyObject *out)
 {
-    _NEW(res);
-    _GLM_INVOKE(inv, self->data, res->data);
+    _TYPE *res = get_out(out);
+    if (!res)
+        return NULL;
+
+    // inverse keeps kind of the matrix
+    _GLM_TYPE tmp;
+    inv_impl(self, tmp);
+    _GLM_INVOKE(copy, tmp, res->data);
+    _SET_KIND(res, _GET_KIND(self));
+
     return (PyObject *)res;
 }
 
+static PyObject *inversed(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"out", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 0, values))
+        return NULL;
+
+    return inversed_impl(self, values[0]);
+}
+
+static PyObject *inversed_into(_SELF, PyObject *out)
+{
+    if (!utils_check_arg_type(out, &_PY_TYPE, "out"))
+        return NULL;
+
+    return inversed_impl(self, out);
+}
+
+// Multiplies matrix by another matrix or a vector, writing result into `out` (of the same type as `other`) if provided.
+static PyObject *matmul_impl(_SELF, PyObject *other, PyObject *out)
+{
+    const bool hasOut = out != NULL && out != Py_None;
+    if (Py_IS_TYPE(other, &_PY_TYPE))
+    {
+        _TYPE *res = get_out(out);
+        if (!res)
+            return NULL;
+
+        const MatrixKind kind = product_kind(_GET_KIND(self), _GET_KIND((_TYPE *)other));
+
+        _GLM_TYPE tmp;
+        mul_impl(self, (_TYPE *)other, tmp);
+        _GLM_INVOKE(copy, tmp, res->data);
+        _SET_KIND(res, kind);
+
+        return (PyObject *)res;
+    }
+    else if (Py_IS_TYPE(other, &_VEC_PY_TYPE))
+    {
+        if (hasOut && !utils_check_arg_type(out, &_VEC_PY_TYPE, "out"))
+            return NULL;
+
+        _VEC_TYPE *res = hasOut ? (_VEC_TYPE *)Py_NewRef(out) : _VEC_NEW_FUNC();
+        if (!res)
+            return NULL;
+
+        _GLM_VEC_TYPE tmp;
+        _GLM_INVOKE(mulv, self->data, ((_VEC_TYPE *)other)->data, tmp);
+        _GLM_VEC_COPY(tmp, res->data);
+
+        return (PyObject *)res;
+    }
+
+    PyErr_Format(
+        PyExc_TypeError,
+        "Expected argument to be of type pygl.math." STRINGIFY(_TYPE) " or pygl.math." STRINGIFY(_VEC_TYPE) ", got: %s.",
+        Py_TYPE(other)->tp_name);
+    return NULL;
+}
+
+static PyObject *matmul_method(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "out", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values))
+        return NULL;
+
+    return matmul_impl(self, values[0], values[1]);
+}
+
+static PyObject *matmul_into(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "out", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values))
+        return NULL;
+
+    if (values[1] == Py_None)
+    {
+        PyErr_SetString(PyExc_TypeError, "Output object has to be provided.");
+        return NULL;
+    }
+
+    return matmul_impl(self, values[0], values[1]);
+}
+
 static bool row_set(_SELF, PyObject *value, size_t rowIdx)
 {
     assert(rowIdx < MAT_LEN);
 
-    if (!PyObject_IsInstance(value, (PyObject *)&_VEC_PY_TYPE))
+    if (!Py_IS_TYPE(value, &_VEC_PY_TYPE))
     {
-        PyErr_SetString(PyExc_TypeError, "Value has to be of type pygl.math.Vector" STRINGIFY(MAT_LEN) ".");
+        PyErr_SetString(PyExc_TypeError, "Value has to be of type pygl.math." STRINGIFY(_VEC_TYPE) ".");
         return false;
     }
 
     void *rowData = ((_VEC_TYPE *)value)->data;
     _GLM_VEC_COPY(rowData, self->data[rowIdx]);
+    _RECLASSIFY(self);
 
     return true;
 }
@@ -178,7 +533,10 @@ static PyObject *row_get(_SELF, size_t rowIdx)
 {
     assert(rowIdx < MAT_LEN);
 
-    _VEC_TYPE *res = PyObject_New(_VEC_TYPE, &_VEC_PY_TYPE);
+    _VEC_TYPE *res = _VEC_NEW_FUNC();
+    if (!res)
+        return NULL;
+
     _GLM_VEC_COPY(self->data[rowIdx], res->data);
 
     return (PyObject *)res;
@@ -227,22 +585,10 @@ static int row3_set(_SELF, PyObject *value, void *Py_UNUSED(closure))
 #pragma region AS_NUMBER
 static PyObject *matmul(_SELF, PyObject *other)
 {
-    if (PyObject_IsInstance(other, (PyObject *)&_PY_TYPE))
-    {
-        _NEW(res);
-        _GLM_INVOKE(mul, self->data, ((_TYPE *)other)->data, res->data);
-
-        return (PyObject *)res;
-    }
-    else if (PyObject_IsInstance(other, (PyObject *)&_VEC_PY_TYPE))
-    {
-        _VEC_TYPE *res = PyObject_New(_VEC_TYPE, &_VEC_PY_TYPE);
-        _GLM_INVOKE(mulv, self->data, ((_VEC_TYPE *)other)->data, res->data);
-
-        return (PyObject *)res;
-    }
+    if (!Py_IS_TYPE(other, &_PY_TYPE) && !Py_IS_TYPE(other, &_VEC_PY_TYPE))
+        Py_RETURN_NOTIMPLEMENTED;
 
-    Py_RETURN_NOTIMPLEMENTED;
+    return matmul_impl(self, other, NULL);
 }
 
 static PyObject *imatmul(_SELF, PyObject *other)
@@ -250,64 +596,69 @@ static PyObject *imatmul(_SELF, PyObject *other)
     _MAT_OP_CHECK_TYPE(other);
 
     _GLM_TYPE res;
-    _GLM_INVOKE(mul, self->data, ((_TYPE *)other)->data, res);
+    mul_impl(self, (_TYPE *)other, res);
     _GLM_INVOKE(copy, res, self->data);
+    _SET_KIND(self, product_kind(_GET_KIND(self), _GET_KIND((_TYPE *)other)));
 
-    return (PyObject *)self;
+    return Py_NewRef(self);
 }
 
-static PyObject *add(_SELF, Matrix4 *other)
+static PyObject *add(_SELF, _TYPE *other)
 {
     _MAT_OP_CHECK_TYPE(other);
 
-    float *data = &self->data[0][0];
-    float *otherData = &other->data[0][0];
+    _SCALAR *data = &self->data[0][0];
+    _SCALAR *otherData = &other->data[0][0];
 
     _NEW(res);
     for (size_t i = 0; i < MAT_LEN * MAT_LEN; i++)
-        ((float *)res->data)[i] = data[i] + otherData[i];
+        ((_SCALAR *)res->data)[i] = data[i] + otherData[i];
 
+    _RECLASSIFY(res);
     return (PyObject *)res;
 }
 
-static PyObject *iadd(_SELF, Matrix4 *other)
+static PyObject *iadd(_SELF, _TYPE *other)
 {
     _MAT_OP_CHECK_TYPE(other);
 
-    float *data = &self->data[0][0];
-    float *otherData = &other->data[0][0];
+    _SCALAR *data = &self->data[0][0];
+    _SCALAR *otherData = &other->data[0][0];
 
     for (size_t i = 0; i < MAT_LEN * MAT_LEN; i++)
         data[i] = data[i] + otherData[i];
 
-    return (PyObject *)self;
+    _RECLASSIFY(self);
+    return Py_NewRef(self);
 }
 
-static PyObject *sub(_SELF, Matrix4 *other)
+static PyObject *sub(_SELF, _TYPE *other)
 {
     _MAT_OP_CHECK_TYPE(other);
 
-    float *data = &self->data[0][0];
-    float *otherData = &other->data[0][0];
+    _SCALAR *data = &self->data[0][0];
+    _SCALAR *otherData = &other->data[0][0];
 
     _NEW(res);
     for (size_t i = 0; i < MAT_LEN * MAT_LEN; i++)
-        ((float *)res->data)[i] = data[i] - otherData[i];
+        ((_SCALAR *)res->data)[i] = data[i] - otherData[i];
 
+    _RECLASSIFY(res);
     return (PyObject *)res;
 }
 
-static PyObject *isub(_SELF, Matrix4 *other)
+static PyObject *isub(_SELF, _TYPE *other)
 {
     _MAT_OP_CHECK_TYPE(other);
 
-    float *data = &self->data[0][0];
-    float *otherData = &other->data[0][0];
+    _SCALAR *data = &self->data[0][0];
+    _SCALAR *otherData = &other->data[0][0];
 
     for (size_t i = 0; i < MAT_LEN * MAT_LEN; i++)
         data[i] = data[i] - otherData[i];
 
-    return (PyObject *)self;
+    _RECLASSIFY(self);
+    return Py_NewRef(self);
 }
 
 #pragma endregion
@@ -364,194 +715,231 @@ static int subscript_assign(_SELF, PyObject *indices, PyObject *value)
     if (!get_indices(indices, &n, &m))
         return -1;
 
-    self->data[n][m] = PyFloat_AS_DOUBLE(value);
+    self->data[n][m] = (_SCALAR)PyFloat_AS_DOUBLE(value);
+    _RECLASSIFY(self);
 
     return 0;
 }
 #pragma endregion
 
+// shape and strides have to outlive the exported buffer, so they can't be stored on the stack
+static Py_ssize_t bufferFlatShape[] = {MAT_LEN * MAT_LEN};
+static Py_ssize_t bufferFlatStrides[] = {sizeof(_SCALAR)};
+static Py_ssize_t bufferShape[] = {MAT_LEN, MAT_LEN};
+static Py_ssize_t bufferStrides[] = {sizeof(_SCALAR), MAT_LEN * sizeof(_SCALAR)};
+
 static int get_buffer(_SELF, Py_buffer *buffer, int flags)
 {
-    int ndim;
-    Py_ssize_t *shape;
-    Py_ssize_t *strides;
-    if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS)
-    {
-        ndim = 1;
-        shape = (Py_ssize_t[]){MAT_LEN * MAT_LEN};
-        strides = (Py_ssize_t[]){sizeof(float)};
-    }
-    else
-    {
-        ndim = 2;
-        shape = (Py_ssize_t[]){MAT_LEN, MAT_LEN};
-        strides = (Py_ssize_t[]){sizeof(float), MAT_LEN * sizeof(float)};
-    }
+    const bool flat = FLAG_IS_SET(flags, PyBUF_C_CONTIGUOUS);
+
+    // data may be modified through the buffer, so kind can't be trusted anymore
+    if (FLAG_IS_SET(flags, PyBUF_WRITABLE))
+        _SET_KIND(self, MATRIX_KIND_GENERAL);
 
     *buffer = (Py_buffer){
         .obj = Py_NewRef(self),
         .buf = self->data,
-        .len = MAT_LEN * MAT_LEN * sizeof(float),
-        .itemsize = sizeof(float),
-        .readonly = !(flags & PyBUF_WRITABLE == PyBUF_WRITABLE),
-        .format = (flags & PyBUF_FORMAT == PyBUF_FORMAT) ? "f" : NULL,
-        .ndim = ndim,
-        .shape = shape,
-        .strides = strides,
+        .len = MAT_LEN * MAT_LEN * sizeof(_SCALAR),
+        .itemsize = sizeof(_SCALAR),
+        .readonly = !FLAG_IS_SET(flags, PyBUF_WRITABLE),
+        .format = FLAG_IS_SET(flags, PyBUF_FORMAT) ? _SCALAR_FORMAT : NULL,
+        .ndim = flat ? 1 : 2,
+        .shape = flat ? bufferFlatShape : bufferShape,
+        .strides = flat ? bufferFlatStrides : bufferStrides,
     };
 
     return 0;
 }
 
 #if MAT_LEN == 4
-static Matrix4 *ortho(PyTypeObject *cls, PyObject *args, PyObject *kwargs)
+static bool as_scalar(PyObject *obj, _SCALAR *out)
+{
+    const double value = PyFloat_AsDouble(obj);
+    if (value == -1.0 && PyErr_Occurred())
+        return false;
+
+    *out = (_SCALAR)value;
+    return true;
+}
+
+static _TYPE *ortho(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    static char *kwNames[] = {"left", "right", "bottom", "top", "z_near", "z_far", NULL};
+    static const char *const kwNames[] = {"left", "right", "bottom", "top", "z_near", "z_far", NULL};
 
-    float left, right, bottom, top;
-    float zNear = -1.0f;
-    float zFar = 1.0f;
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ffff|ff", kwNames, &left, &right, &bottom, &top, &zNear, &zFar))
+    PyObject *values[6];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 4, values))
         return NULL;
 
+    _SCALAR params[6] = {0.0, 0.0, 0.0, 0.0, -1.0, 1.0};
+    for (size_t i = 0; i < 6; i++)
+    {
+        if (values[i] != NULL && !as_scalar(values[i], &params[i]))
+            return NULL;
+    }
+
     _NEW(result);
 
-    glm_ortho(
-        left,
-        right,
-        bottom,
-        top,
-        zNear,
-        zFar,
+    _GLM_FUNC(ortho)(
+        params[0],
+        params[1],
+        params[2],
+        params[3],
+        params[4],
+        params[5],
         result->data);
+    result->kind = MATRIX_KIND_AFFINE;
 
     return result;
 }
 
-static Matrix4 *perspective(PyTypeObject *cls, PyObject *args, PyObject *kwargs)
+static _TYPE *perspective(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    static char *kwNames[] = {"fov", "aspect", "z_near", "z_far", NULL};
+    static const char *const kwNames[] = {"fov", "aspect", "z_near", "z_far", NULL};
 
-    float fov, aspect;
-    float zNear = -1.0f;
-    float zFar = 1.0f;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ff|ff", kwNames, &fov, &aspect, &zNear, &zFar))
+    PyObject *values[4];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values))
         return NULL;
 
+    _SCALAR params[4] = {0.0, 0.0, -1.0, 1.0};
+    for (size_t i = 0; i < 4; i++)
+    {
+        if (values[i] != NULL && !as_scalar(values[i], &params[i]))
+            return NULL;
+    }
+
     _NEW(result);
 
-    glm_perspective(
-        fov,
-        aspect,
-        zNear,
-        zFar,
+    _GLM_FUNC(perspective)(
+        params[0],
+        params[1],
+        params[2],
+        params[3],
         result->data);
+    result->kind = MATRIX_KIND_GENERAL;
 
     return result;
 }
 
-static Matrix4 *look_at(PyTypeObject *cls, PyObject *args, PyObject *kwargs)
+static _TYPE *look_at(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    static char *kwNames[] = {"eye", "center", "up", NULL};
+    static const char *const kwNames[] = {"eye", "center", "up", NULL};
 
-    Vector3 *eye, *center;
-    Vector3 *up = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O!|O!", kwNames, &pyVector3Type, &eye, &pyVector3Type, &center, &pyVector3Type, &up))
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[0], &_VEC3_PY_TYPE, "eye") ||
+        !utils_check_arg_type(values[1], &_VEC3_PY_TYPE, "center") ||
+        (values[2] != NULL && !utils_check_arg_type(values[2], &_VEC3_PY_TYPE, "up")))
         return NULL;
 
-    vec3 *upData = (up != NULL) ? &up->data : &(vec3){0.0f, 1.0f, 0.0f};
+    _VEC3_TYPE *eye = (_VEC3_TYPE *)values[0];
+    _VEC3_TYPE *center = (_VEC3_TYPE *)values[1];
+    _VEC3_TYPE *up = (_VEC3_TYPE *)values[2];
+
+    const _SCALAR *upData = (up != NULL) ? up->data : (_SCALAR[3]){0.0, 1.0, 0.0};
 
     _NEW(result);
-    glm_lookat(eye->data, center->data, *upData, result->data);
+    _GLM_FUNC(lookat)(eye->data, center->data, upData, result->data);
+    result->kind = MATRIX_KIND_RIGID;
 
     return result;
 }
 
-static Matrix4 *look(PyTypeObject *cls, PyObject *args, PyObject *kwargs)
+static _TYPE *look(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    static char *kwNames[] = {"eye", "dir", "up", NULL};
+    static const char *const kwNames[] = {"eye", "dir", "up", "orientation", NULL};
+
+    PyObject *values[4];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !utils_check_arg_type(values[0], &_VEC3_PY_TYPE, "eye"))
+        return NULL;
+
+    _VEC3_TYPE *eye = (_VEC3_TYPE *)values[0];
+
+    // Matrix4.look(Vector3, Quaternion)
+    PyObject *orientation = values[3];
+    if (orientation == NULL && values[1] != NULL && Py_IS_TYPE(values[1], &pyQuaternionType))
+        orientation = values[1];
 
-    if (PyTuple_GET_SIZE(args) == 2) // Matrix4.look(Vector3, Quaternion)
+    if (orientation != NULL)
     {
-        Vector3 *eye;
-        Quaternion *orientation;
-        if (!PyArg_ParseTuple(args, "O!O!", &pyVector3Type, &eye, &pyQuaternionType, &orientation))
+        if (!utils_check_arg_type(orientation, &pyQuaternionType, "orientation"))
             return NULL;
 
         _NEW(result);
-        glm_quat_look(eye->data, orientation->data, result->data);
+        _GLM_FUNC(quat_look)(eye->data, ((Quaternion *)orientation)->data, result->data);
+        result->kind = MATRIX_KIND_RIGID;
 
         return result;
     }
 
     // Matrix4.look(Vector3, Vector3, Vector3 = Vector3(0.0, 1.0, 0.0))
-    Vector3 *eye, *dir;
-    Vector3 *up = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O!|O!", kwNames, &pyVector3Type, &eye, &pyVector3Type, &dir, &pyVector3Type, &up))
+    THROW_IF(values[1] == NULL, PyExc_TypeError, "Missing required argument 'dir' (pos 2).", NULL);
+    if (!utils_check_arg_type(values[1], &_VEC3_PY_TYPE, "dir") ||
+        (values[2] != NULL && !utils_check_arg_type(values[2], &_VEC3_PY_TYPE, "up")))
         return NULL;
 
-    vec3 *upData = (up != NULL) ? &up->data : &(vec3){0.0f, 1.0f, 0.0f};
+    _VEC3_TYPE *dir = (_VEC3_TYPE *)values[1];
+    _VEC3_TYPE *up = (_VEC3_TYPE *)values[2];
+
+    const _SCALAR *upData = (up != NULL) ? up->data : (_SCALAR[3]){0.0, 1.0, 0.0};
 
     _NEW(result);
-    glm_look(eye->data, dir->data, *upData, result->data);
+    _GLM_FUNC(look)(eye->data, dir->data, upData, result->data);
+    result->kind = MATRIX_KIND_RIGID;
 
     return result;
 }
 
-static Matrix4 *transform(PyTypeObject *cls, PyObject *args, PyObject *kwargs)
+static _TYPE *transform(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    size_t argsCount = PyTuple_GET_SIZE(args);
-    if (argsCount == 0)
-    {
-        PyErr_SetString(PyExc_TypeError, "Function requires at least one argument.");
+    static const char *const kwNames[] = {"translation", "scale", "rotation", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !utils_check_arg_type(values[0], &_VEC3_PY_TYPE, "translation") ||
+        (values[1] != NULL && !utils_check_arg_type(values[1], &_VEC3_PY_TYPE, "scale")) ||
+        (values[2] != NULL && !utils_check_arg_type(values[2], &pyQuaternionType, "rotation")))
         return NULL;
-    }
 
-    mat4 matrix = GLM_MAT4_IDENTITY_INIT;
-    bool hasScale = false;
+    _GLM_TYPE matrix;
+    _GLM_INVOKE(identity, matrix);
+    _GLM_FUNC(translate)(matrix, ((_VEC3_TYPE *)values[0])->data);
 
-    if (argsCount >= 1)
-    {
-        Vector3 *translation = (Vector3 *)PyTuple_GET_ITEM(args, 0);
-        if (!PyObject_IsInstance((PyObject *)translation, (PyObject *)&pyVector3Type))
-        {
-            PyErr_Format(PyExc_TypeError, "Expected argument 1 to be of type pygl.math.Vector3, got: %s.", Py_TYPE(translation)->tp_name);
-            return NULL;
-        }
+    // scale has to be applied last to keep valid transformation order
+    if (values[2] != NULL)
+        _GLM_FUNC(quat_rotate)(matrix, ((Quaternion *)values[2])->data, matrix);
 
-        glm_translate(matrix, translation->data);
-    }
-    if (argsCount >= 2)
-        hasScale = true; // we have to defer applying scale to keep valid transformation order
-    if (argsCount >= 3)
-    {
-        Quaternion *rotation = (Quaternion *)PyTuple_GET_ITEM(args, 2);
-        if (!PyObject_IsInstance((PyObject *)rotation, (PyObject *)&pyQuaternionType))
-        {
-            PyErr_Format(PyExc_TypeError, "Expected argument 3 to be of type pygl.math.Quaternion, got: %s.", Py_TYPE(rotation)->tp_name);
-            return NULL;
-        }
+    if (values[1] != NULL)
+        _GLM_FUNC(scale)(matrix, ((_VEC3_TYPE *)values[1])->data);
 
-        glm_quat_rotate(matrix, rotation->data, matrix);
-    }
+    _NEW(result);
+    _GLM_INVOKE(copy, matrix, result->data);
+    result->kind = values[1] != NULL ? MATRIX_KIND_AFFINE : (values[2] != NULL ? MATRIX_KIND_RIGID : MATRIX_KIND_TRANSLATION);
 
-    if (hasScale)
-    {
-        Vector3 *scale = (Vector3 *)PyTuple_GET_ITEM(args, 1);
-        if (!PyObject_IsInstance((PyObject *)scale, (PyObject *)&pyVector3Type))
-        {
-            PyErr_Format(PyExc_TypeError, "Expected argument 1 to be of type pygl.math.Vector3, got: %s.", Py_TYPE(scale)->tp_name);
-            return NULL;
-        }
+    return result;
+}
+#endif
 
-        glm_scale(matrix, scale->data);
-    }
+#if MAT_LEN == 4
+static PyObject *kind_get(_SELF, void *Py_UNUSED(closure))
+{
+    return PyLong_FromLong(self->kind);
+}
 
-    _NEW(result);
-    glm_mat4_copy(matrix, result->data);
+// Allows declaring kind of matrices built from raw values, which can't be detected reliably (e.g. rigid ones).
+// Declared kind is trusted, so it has to match matrix values.
+static int kind_set(_SELF, PyObject *value, void *Py_UNUSED(closure))
+{
+    THROW_IF(value == NULL, PyExc_AttributeError, "Cannot delete matrix kind.", -1);
 
-    return result;
+    const long kind = PyLong_AsLong(value);
+    if (kind == -1 && PyErr_Occurred())
+        return -1;
+
+    THROW_IF(kind < 0 || kind >= MATRIX_KIND_COUNT, PyExc_ValueError, "Invalid matrix kind.", -1);
+
+    self->kind = (MatrixKind)kind;
+    return 0;
 }
 #endif
 
@@ -563,10 +951,13 @@ static PyObject *class_length(PyTypeObject *cls, PyObject *Py_UNUSED(args))
 PyTypeObject _PY_TYPE = {
     PyVarObject_HEAD_INIT(NULL, 0)
         .tp_new = PyType_GenericNew,
+    .tp_alloc = free_list_tp_alloc,
+    .tp_dealloc = (destructor)dealloc,
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_basicsize = sizeof(_TYPE),
-    .tp_name = "pygl.math.Matrix" STRINGIFY(MAT_LEN),
+    .tp_name = "pygl.math." STRINGIFY(_TYPE),
     .tp_init = (initproc)init,
+    .tp_vectorcall = (vectorcallfunc)vectorcall,
     .tp_as_buffer = &(PyBufferProcs){
         .bf_getbuffer = (getbufferproc)get_buffer,
     },
@@ -586,16 +977,20 @@ PyTypeObject _PY_TYPE = {
     .tp_methods = (PyMethodDef[]){
         {"identity", (PyCFunction)identity, METH_CLASS | METH_NOARGS, NULL},
         {"transpose", (PyCFunction)transpose, METH_NOARGS, NULL},
-        {"transposed", (PyCFunction)transposed, METH_NOARGS, NULL},
+        {"transposed", (PyCFunction)transposed, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"transposed_into", (PyCFunction)transposed_into, METH_O, NULL},
         {"inverse", (PyCFunction)inverse, METH_NOARGS, NULL},
-        {"inversed", (PyCFunction)inversed, METH_NOARGS, NULL},
+        {"inversed", (PyCFunction)inversed, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"inversed_into", (PyCFunction)inversed_into, METH_O, NULL},
+        {"matmul", (PyCFunction)matmul_method, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"matmul_into", (PyCFunction)matmul_into, METH_FASTCALL | METH_KEYWORDS, NULL},
         {"length", (PyCFunction)class_length, METH_CLASS | METH_NOARGS, NULL},
 #if MAT_LEN == 4
-        {"transform", (PyCFunction)transform, METH_VARARGS | METH_CLASS, NULL},
-        {"look", (PyCFunction)look, METH_VARARGS | METH_CLASS, NULL},
-        {"look_at", (PyCFunction)look_at, METH_VARARGS | METH_CLASS, NULL},
-        {"ortho", (PyCFunction)ortho, METH_VARARGS | METH_CLASS | METH_KEYWORDS, NULL},
-        {"perspective", (PyCFunction)perspective, METH_VARARGS | METH_CLASS | METH_KEYWORDS, NULL},
+        {"transform", (PyCFunction)transform, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, NULL},
+        {"look", (PyCFunction)look, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, NULL},
+        {"look_at", (PyCFunction)look_at, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, NULL},
+        {"ortho", (PyCFunction)ortho, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, NULL},
+        {"perspective", (PyCFunction)perspective, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, NULL},
 #endif
         {0},
     },
@@ -604,6 +999,9 @@ PyTypeObject _PY_TYPE = {
         {"row1", (getter)row1_get, (setter)row1_set, NULL, NULL},
         {"row2", (getter)row2_get, (setter)row2_set, NULL, NULL},
         {"row3", (getter)row3_get, (setter)row3_set, NULL, NULL},
+#if MAT_LEN == 4
+        {"kind", (getter)kind_get, (setter)kind_set, NULL, NULL},
+#endif
         {0},
     },
 };
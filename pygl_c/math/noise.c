@@ -0,0 +1,612 @@
+#include "noise.h"
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <cglm/util.h>
+#include "vector/vector.h"
+#include "../buffers/buffer.h"
+#include "../module.h"
+#include "../threadPool.h"
+#include "../utility.h"
+#include "../gl.h"
+
+#define _PRIME_X 501125321u
+#define _PRIME_Y 1136930381u
+#define _PRIME_Z 1720413743u
+#define _PRIME_W 1066037191u
+
+// Factors mapping raw noise values into range [-1, 1], measured over large number of random samples.
+#define _PERLIN_SCALE_2 1.4142f
+#define _PERLIN_SCALE_3 0.9650f
+#define _PERLIN_SCALE_4 0.8500f
+#define _SIMPLEX_SCALE_2 99.20f
+#define _SIMPLEX_SCALE_3 76.87f
+#define _SIMPLEX_SCALE_4 62.88f
+
+typedef float (*NoiseFunc)(const float *p, uint32_t seed);
+
+typedef struct
+{
+    NoiseType type;
+    FractalType fractal;
+    int dimensions;
+    int octaves;
+    float lacunarity;
+    float gain;
+    uint32_t seed;
+} NoiseSettings;
+
+typedef struct
+{
+    NoiseSettings settings;
+    float origin[4];
+    float scale;
+    Py_ssize_t width;
+    Py_ssize_t height;
+    size_t rowCount;
+    size_t rowsPerChunk;
+    bool unsignedByte;
+    char *dst;
+    Py_ssize_t rowStride;
+    Py_ssize_t sliceStride;
+} NoiseFillJob;
+
+static const float grad2[8][2] = {
+    {1.0f, 0.0f}, {-1.0f, 0.0f}, {0.0f, 1.0f}, {0.0f, -1.0f},
+    {GLM_SQRT1_2f, GLM_SQRT1_2f}, {-GLM_SQRT1_2f, GLM_SQRT1_2f}, {GLM_SQRT1_2f, -GLM_SQRT1_2f}, {-GLM_SQRT1_2f, -GLM_SQRT1_2f}};
+
+// edges of a cube, padded to 16 entries so gradient can be selected with a bit mask
+static const float grad3[16][3] = {
+    {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {-1.0f, -1.0f, 0.0f},
+    {1.0f, 0.0f, 1.0f}, {-1.0f, 0.0f, 1.0f}, {1.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, -1.0f},
+    {0.0f, 1.0f, 1.0f}, {0.0f, -1.0f, 1.0f}, {0.0f, 1.0f, -1.0f}, {0.0f, -1.0f, -1.0f},
+    {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 1.0f}, {0.0f, -1.0f, -1.0f}};
+
+// Lattice points are hashed arithmetically instead of through a permutation table, so noise does not repeat
+// and every seed produces a different pattern.
+static inline uint32_t hash_cell(uint32_t seed, const int32_t *cell, int dimensions)
+{
+    static const uint32_t primes[4] = {_PRIME_X, _PRIME_Y, _PRIME_Z, _PRIME_W};
+
+    uint32_t hash = seed;
+    for (int i = 0; i < dimensions; i++)
+        hash ^= (uint32_t)cell[i] * primes[i];
+
+    hash ^= hash >> 16;
+    hash *= 0x7feb352du;
+    hash ^= hash >> 15;
+    hash *= 0x846ca68bu;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+static inline float grad_dot(uint32_t hash, const float *d, int dimensions)
+{
+    if (dimensions == 2)
+    {
+        const float *g = grad2[hash & 7];
+        return g[0] * d[0] + g[1] * d[1];
+    }
+
+    if (dimensions == 3)
+    {
+        const float *g = grad3[hash & 15];
+        return g[0] * d[0] + g[1] * d[1] + g[2] * d[2];
+    }
+
+    // 32 gradients of form (0, ±1, ±1, ±1) with zero placed on any axis
+    const uint32_t zeroAxis = (hash >> 3) & 3;
+    float result = 0.0f;
+    uint32_t signBit = 0;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        if (i == zeroAxis)
+            continue;
+
+        result += (hash >> signBit++) & 1 ? -d[i] : d[i];
+    }
+
+    return result;
+}
+
+static inline float fade(float t)
+{
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static inline float perlin_impl(const float *p, uint32_t seed, const int dimensions)
+{
+    int32_t base[4];
+    float frac[4];
+    float weights[4];
+    for (int i = 0; i < dimensions; i++)
+    {
+        const float cell = floorf(p[i]);
+        base[i] = (int32_t)cell;
+        frac[i] = p[i] - cell;
+        weights[i] = fade(frac[i]);
+    }
+
+    // gradient contributions of all 2^n corners, bit `i` of corner index selects offset along axis `i`
+    float values[16];
+    const int cornerCount = 1 << dimensions;
+    for (int corner = 0; corner < cornerCount; corner++)
+    {
+        int32_t cell[4];
+        float d[4];
+        for (int i = 0; i < dimensions; i++)
+        {
+            const int offset = (corner >> i) & 1;
+            cell[i] = base[i] + offset;
+            d[i] = frac[i] - (float)offset;
+        }
+
+        values[corner] = grad_dot(hash_cell(seed, cell, dimensions), d, dimensions);
+    }
+
+    // collapse corners axis by axis
+    for (int i = 0; i < dimensions; i++)
+    {
+        const int half = cornerCount >> (i + 1);
+        for (int j = 0; j < half; j++)
+            values[j] = glm_lerp(values[j * 2], values[j * 2 + 1], weights[i]);
+    }
+
+    return values[0];
+}
+
+static inline float simplex_impl(const float *p, uint32_t seed, const int dimensions)
+{
+    // skewing factors transforming simplex grid into hypercubic one and back
+    const float n = (float)dimensions;
+    const float skew = (sqrtf(n + 1.0f) - 1.0f) / n;
+    const float unskew = (1.0f - 1.0f / sqrtf(n + 1.0f)) / n;
+
+    float sum = 0.0f;
+    for (int i = 0; i < dimensions; i++)
+        sum += p[i];
+
+    const float s = sum * skew;
+    int32_t base[4];
+    float cellSum = 0.0f;
+    for (int i = 0; i < dimensions; i++)
+    {
+        base[i] = (int32_t)floorf(p[i] + s);
+        cellSum += (float)base[i];
+    }
+
+    const float t = cellSum * unskew;
+    float x0[4];
+    for (int i = 0; i < dimensions; i++)
+        x0[i] = p[i] - ((float)base[i] - t);
+
+    // simplex is traversed along axes ordered by descending distance from cell origin
+    int rank[4];
+    for (int i = 0; i < dimensions; i++)
+    {
+        rank[i] = 0;
+        for (int j = 0; j < dimensions; j++)
+            rank[i] += x0[j] > x0[i] || (x0[j] == x0[i] && j < i);
+    }
+
+    float result = 0.0f;
+    for (int corner = 0; corner <= dimensions; corner++)
+    {
+        int32_t cell[4];
+        float d[4];
+        float falloff = 0.5f;
+        for (int i = 0; i < dimensions; i++)
+        {
+            const int offset = rank[i] < corner;
+            cell[i] = base[i] + offset;
+            d[i] = x0[i] - (float)offset + (float)corner * unskew;
+            falloff -= d[i] * d[i];
+        }
+
+        if (falloff > 0.0f)
+        {
+            falloff *= falloff;
+            result += falloff * falloff * grad_dot(hash_cell(seed, cell, dimensions), d, dimensions);
+        }
+    }
+
+    return result;
+}
+
+// Distance to the closest feature point, with one randomly placed feature point per cell.
+static inline float worley_impl(const float *p, uint32_t seed, const int dimensions)
+{
+    int32_t base[4];
+    float frac[4];
+    for (int i = 0; i < dimensions; i++)
+    {
+        const float cell = floorf(p[i]);
+        base[i] = (int32_t)cell;
+        frac[i] = p[i] - cell;
+    }
+
+    int neighbourCount = 1;
+    for (int i = 0; i < dimensions; i++)
+        neighbourCount *= 3;
+
+    float closest = FLT_MAX;
+    for (int neighbour = 0; neighbour < neighbourCount; neighbour++)
+    {
+        int32_t cell[4];
+        int offsets[4];
+        int index = neighbour;
+        for (int i = 0; i < dimensions; i++)
+        {
+            offsets[i] = index % 3 - 1;
+            cell[i] = base[i] + offsets[i];
+            index /= 3;
+        }
+
+        // 8 bits of the hash per axis position feature point inside the cell
+        const uint32_t hash = hash_cell(seed, cell, dimensions);
+        float distance = 0.0f;
+        for (int i = 0; i < dimensions; i++)
+        {
+            const float feature = (float)offsets[i] + (float)((hash >> (i * 8)) & 0xff) * (1.0f / 255.0f);
+            const float d = feature - frac[i];
+            distance += d * d;
+        }
+
+        closest = glm_min(closest, distance);
+    }
+
+    return glm_min(sqrtf(closest), 1.0f) * 2.0f - 1.0f;
+}
+
+static float perlin2(const float *p, uint32_t seed) { return perlin_impl(p, seed, 2) * _PERLIN_SCALE_2; }
+static float perlin3(const float *p, uint32_t seed) { return perlin_impl(p, seed, 3) * _PERLIN_SCALE_3; }
+static float perlin4(const float *p, uint32_t seed) { return perlin_impl(p, seed, 4) * _PERLIN_SCALE_4; }
+static float simplex2(const float *p, uint32_t seed) { return simplex_impl(p, seed, 2) * _SIMPLEX_SCALE_2; }
+static float simplex3(const float *p, uint32_t seed) { return simplex_impl(p, seed, 3) * _SIMPLEX_SCALE_3; }
+static float simplex4(const float *p, uint32_t seed) { return simplex_impl(p, seed, 4) * _SIMPLEX_SCALE_4; }
+static float worley2(const float *p, uint32_t seed) { return worley_impl(p, seed, 2); }
+static float worley3(const float *p, uint32_t seed) { return worley_impl(p, seed, 3); }
+static float worley4(const float *p, uint32_t seed) { return worley_impl(p, seed, 4); }
+
+static const NoiseFunc noiseFuncs[NOISE_TYPE_COUNT][3] = {
+    [NOISE_TYPE_PERLIN] = {perlin2, perlin3, perlin4},
+    [NOISE_TYPE_SIMPLEX] = {simplex2, simplex3, simplex4},
+    [NOISE_TYPE_WORLEY] = {worley2, worley3, worley4},
+};
+
+float noise_sample(NoiseType type, int dimensions, const float *p, uint32_t seed)
+{
+    return glm_clamp(noiseFuncs[type][dimensions - 2](p, seed), -1.0f, 1.0f);
+}
+
+static float fractal_sample(const NoiseSettings *settings, const float *p)
+{
+    const NoiseFunc func = noiseFuncs[settings->type][settings->dimensions - 2];
+    if (settings->fractal == FRACTAL_TYPE_NONE)
+        return glm_clamp(func(p, settings->seed), -1.0f, 1.0f);
+
+    float point[4];
+    for (int i = 0; i < settings->dimensions; i++)
+        point[i] = p[i];
+
+    float sum = 0.0f;
+    float amplitude = 1.0f;
+    float amplitudeSum = 0.0f;
+    for (int octave = 0; octave < settings->octaves; octave++)
+    {
+        float value = glm_clamp(func(point, settings->seed + (uint32_t)octave), -1.0f, 1.0f);
+        if (settings->fractal == FRACTAL_TYPE_RIDGED)
+        {
+            value = 1.0f - fabsf(value);
+            value *= value;
+        }
+
+        sum += value * amplitude;
+        amplitudeSum += amplitude;
+        amplitude *= settings->gain;
+
+        for (int i = 0; i < settings->dimensions; i++)
+            point[i] *= settings->lacunarity;
+    }
+
+    const float result = amplitudeSum > 0.0f ? sum / amplitudeSum : 0.0f;
+    return settings->fractal == FRACTAL_TYPE_RIDGED ? result * 2.0f - 1.0f : result;
+}
+
+static void fill_job(void *userData, size_t index)
+{
+    const NoiseFillJob *job = userData;
+
+    const size_t firstRow = index * job->rowsPerChunk;
+    const size_t lastRow = glm_min(firstRow + job->rowsPerChunk, job->rowCount);
+    for (size_t row = firstRow; row < lastRow; row++)
+    {
+        const Py_ssize_t y = row % job->height;
+        const Py_ssize_t z = row / job->height;
+
+        float p[4] = {0.0f, job->origin[1] + y * job->scale, job->origin[2] + z * job->scale, job->origin[3]};
+        char *dst = job->dst + z * job->sliceStride + y * job->rowStride;
+
+        if (job->unsignedByte)
+        {
+            // signed noise is remapped into the whole range of normalized unsigned texels
+            uint8_t *texels = (uint8_t *)dst;
+            for (Py_ssize_t x = 0; x < job->width; x++)
+            {
+                p[0] = job->origin[0] + x * job->scale;
+                texels[x] = (uint8_t)((fractal_sample(&job->settings, p) * 0.5f + 0.5f) * 255.0f + 0.5f);
+            }
+        }
+        else
+        {
+            float *texels = (float *)dst;
+            for (Py_ssize_t x = 0; x < job->width; x++)
+            {
+                p[0] = job->origin[0] + x * job->scale;
+                texels[x] = fractal_sample(&job->settings, p);
+            }
+        }
+    }
+}
+
+// Reads point coordinates from Vector2, Vector3 or Vector4 and returns their count, -1 on failure.
+static int get_point(PyObject *obj, float *dest)
+{
+    if (Py_IS_TYPE(obj, &pyVector2Type))
+    {
+        glm_vec2_copy(((Vector2 *)obj)->data, dest);
+        return 2;
+    }
+
+    if (Py_IS_TYPE(obj, &pyVector3Type))
+    {
+        glm_vec3_copy(((Vector3 *)obj)->data, dest);
+        return 3;
+    }
+
+    if (Py_IS_TYPE(obj, &pyVector4Type))
+    {
+        glm_vec4_ucopy(((Vector4 *)obj)->data, dest);
+        return 4;
+    }
+
+    PyErr_Format(PyExc_TypeError, "Expected point to be of type Vector2, Vector3 or Vector4, got: %s.", Py_TYPE(obj)->tp_name);
+    return -1;
+}
+
+static bool check_settings(const NoiseSettings *settings)
+{
+    THROW_IF(
+        settings->type < 0 || settings->type >= NOISE_TYPE_COUNT,
+        PyExc_ValueError,
+        "Invalid noise type.",
+        false);
+    THROW_IF(
+        settings->fractal < 0 || settings->fractal >= FRACTAL_TYPE_COUNT,
+        PyExc_ValueError,
+        "Invalid fractal type.",
+        false);
+    THROW_IF(
+        settings->octaves < 1 || settings->octaves > NOISE_MAX_OCTAVES,
+        PyExc_ValueError,
+        "Octave count has to be in range [1, " STRINGIFY(NOISE_MAX_OCTAVES) "].",
+        false);
+
+    return true;
+}
+
+static PyObject *sample_noise(NoiseType type, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"point", "seed", NULL};
+
+    PyObject *pointObj = NULL;
+    NoiseSettings settings = {.type = type, .fractal = FRACTAL_TYPE_NONE, .octaves = 1};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|I", kwNames, &pointObj, &settings.seed))
+        return NULL;
+
+    float point[4];
+    settings.dimensions = get_point(pointObj, point);
+    if (settings.dimensions == -1)
+        return NULL;
+
+    return PyFloat_FromDouble(fractal_sample(&settings, point));
+}
+
+static PyObject *noise_perlin(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    return sample_noise(NOISE_TYPE_PERLIN, args, kwargs);
+}
+
+static PyObject *noise_simplex(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    return sample_noise(NOISE_TYPE_SIMPLEX, args, kwargs);
+}
+
+static PyObject *noise_worley(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    return sample_noise(NOISE_TYPE_WORLEY, args, kwargs);
+}
+
+static PyObject *noise_sample_fractal(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"point", "noise_type", "fractal", "octaves", "lacunarity", "gain", "seed", NULL};
+
+    PyObject *pointObj = NULL;
+    NoiseSettings settings = {
+        .type = NOISE_TYPE_PERLIN,
+        .fractal = FRACTAL_TYPE_FBM,
+        .octaves = 4,
+        .lacunarity = 2.0f,
+        .gain = 0.5f,
+    };
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwargs, "O|i$iiffI", kwNames,
+            &pointObj, &settings.type, &settings.fractal, &settings.octaves, &settings.lacunarity, &settings.gain, &settings.seed) ||
+        !check_settings(&settings))
+        return NULL;
+
+    float point[4];
+    settings.dimensions = get_point(pointObj, point);
+    if (settings.dimensions == -1)
+        return NULL;
+
+    return PyFloat_FromDouble(fractal_sample(&settings, point));
+}
+
+static PyObject *noise_fill(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {
+        "dst", "width", "height", "depth",
+        "noise_type", "fractal", "octaves", "lacunarity", "gain", "seed",
+        "origin", "scale", "pixel_type", "alignment", "row_length", "image_height", "offset", NULL};
+
+    PyObject *dstObj = NULL;
+    Py_ssize_t width = 0;
+    Py_ssize_t height = 0;
+    Py_ssize_t depth = 1;
+    PyObject *originObj = Py_None;
+    GLenum pixelType = GL_FLOAT;
+    int alignment = 4;
+    Py_ssize_t rowLength = 0;
+    Py_ssize_t imageHeight = 0;
+    Py_ssize_t offset = -1;
+
+    NoiseFillJob job = {
+        .settings = {
+            .type = NOISE_TYPE_PERLIN,
+            .fractal = FRACTAL_TYPE_NONE,
+            .octaves = 4,
+            .lacunarity = 2.0f,
+            .gain = 0.5f,
+        },
+        .scale = 1.0f / 32.0f,
+    };
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwargs, "Onn|n$iiiffIOfIinnn", kwNames,
+            &dstObj, &width, &height, &depth,
+            &job.settings.type, &job.settings.fractal, &job.settings.octaves, &job.settings.lacunarity, &job.settings.gain, &job.settings.seed,
+            &originObj, &job.scale, &pixelType, &alignment, &rowLength, &imageHeight, &offset) ||
+        !check_settings(&job.settings))
+        return NULL;
+
+    THROW_IF(
+        width < 0 || height < 0 || depth < 0,
+        PyExc_ValueError,
+        "Image dimensions cannot be negative.",
+        NULL);
+    THROW_IF(
+        pixelType != GL_FLOAT && pixelType != GL_UNSIGNED_BYTE,
+        PyExc_ValueError,
+        "Noise can only be written as GL_FLOAT or GL_UNSIGNED_BYTE texels.",
+        NULL);
+    THROW_IF(
+        alignment != 1 && alignment != 2 && alignment != 4 && alignment != 8,
+        PyExc_ValueError,
+        "Row alignment has to be one of: 1, 2, 4, 8.",
+        NULL);
+    THROW_IF(
+        (rowLength != 0 && rowLength < width) || (imageHeight != 0 && imageHeight < height),
+        PyExc_ValueError,
+        "Row length and image height cannot be smaller than filled region.",
+        NULL);
+
+    // 3D images are always sampled with at least 3-dimensional noise, origin may add more dimensions
+    job.settings.dimensions = depth > 1 ? 3 : 2;
+    if (!Py_IsNone(originObj))
+    {
+        const int originDimensions = get_point(originObj, job.origin);
+        if (originDimensions == -1)
+            return NULL;
+
+        job.settings.dimensions = glm_max(job.settings.dimensions, originDimensions);
+    }
+
+    if (width == 0 || height == 0 || depth == 0)
+        Py_RETURN_NONE;
+
+    // rows are laid out the same way as GL_UNPACK_ROW_LENGTH, GL_UNPACK_IMAGE_HEIGHT and GL_UNPACK_ALIGNMENT describe
+    const Py_ssize_t texelSize = pixelType == GL_FLOAT ? sizeof(float) : sizeof(uint8_t);
+    job.rowStride = ((rowLength ? rowLength : width) * texelSize + alignment - 1) / alignment * alignment;
+    job.sliceStride = job.rowStride * (imageHeight ? imageHeight : height);
+    job.unsignedByte = pixelType == GL_UNSIGNED_BYTE;
+    job.width = width;
+    job.height = height;
+    job.rowCount = (size_t)height * (size_t)depth;
+    job.rowsPerChunk = glm_max(NOISE_CHUNK_TEXELS / width, 1);
+
+    const Py_ssize_t size = (depth - 1) * job.sliceStride + (height - 1) * job.rowStride + width * texelSize;
+
+    WriteTarget dst;
+    if (!py_buffer_acquire_write_target(dstObj, offset, size, &dst))
+        return NULL;
+
+    THROW_IF_GOTO(
+        pixelType == GL_FLOAT && ((uintptr_t)dst.data & (sizeof(float) - 1)) != 0,
+        PyExc_ValueError,
+        "Destination of GL_FLOAT texels has to be aligned to 4 bytes.",
+        end);
+
+    job.dst = dst.data;
+
+    const size_t chunkCount = (job.rowCount + job.rowsPerChunk - 1) / job.rowsPerChunk;
+    if ((size_t)width * job.rowCount >= NOISE_PARALLEL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        thread_pool_run(fill_job, &job, chunkCount);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        for (size_t i = 0; i < chunkCount; i++)
+            fill_job(&job, i);
+    }
+
+    py_buffer_release_write_target(&dst);
+    Py_RETURN_NONE;
+
+end:
+    py_buffer_release_write_target(&dst);
+    return NULL;
+}
+
+static EnumDef noiseTypeEnum = {
+    .enumName = "NoiseType",
+    .values = (EnumValue[]){
+        {"PERLIN", NOISE_TYPE_PERLIN},
+        {"SIMPLEX", NOISE_TYPE_SIMPLEX},
+        {"WORLEY", NOISE_TYPE_WORLEY},
+        {0}},
+};
+
+static EnumDef fractalTypeEnum = {
+    .enumName = "FractalType",
+    .values = (EnumValue[]){
+        {"NONE", FRACTAL_TYPE_NONE},
+        {"FBM", FRACTAL_TYPE_FBM},
+        {"RIDGED", FRACTAL_TYPE_RIDGED},
+        {0}},
+};
+
+static ModuleInfo modInfo = {
+    .def = {
+        PyModuleDef_HEAD_INIT,
+        .m_name = "pygl.math.noise",
+        .m_size = -1,
+        .m_methods = (PyMethodDef[]){
+            {"perlin", (PyCFunction)noise_perlin, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"simplex", (PyCFunction)noise_simplex, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"worley", (PyCFunction)noise_worley, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"fractal", (PyCFunction)noise_sample_fractal, METH_VARARGS | METH_KEYWORDS, NULL},
+            {"fill", (PyCFunction)noise_fill, METH_VARARGS | METH_KEYWORDS, NULL},
+            {0}}},
+    .enums = (EnumDef *[]){
+        &noiseTypeEnum,
+        &fractalTypeEnum,
+        NULL},
+};
+
+PyObject *noise_module_create(void)
+{
+    return module_create_from_info(&modInfo);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <Python.h>
+#include <stdint.h>
+
+// Number of texels above which `fill` releases the GIL and splits rows across the thread pool.
+#define NOISE_PARALLEL_THRESHOLD 4096
+// Approximate number of texels filled by a single thread pool job.
+#define NOISE_CHUNK_TEXELS 4096
+#define NOISE_MAX_OCTAVES 16
+
+typedef enum
+{
+    NOISE_TYPE_PERLIN,
+    NOISE_TYPE_SIMPLEX,
+    NOISE_TYPE_WORLEY,
+    NOISE_TYPE_COUNT,
+} NoiseType;
+
+typedef enum
+{
+    FRACTAL_TYPE_NONE,
+    FRACTAL_TYPE_FBM,
+    FRACTAL_TYPE_RIDGED,
+    FRACTAL_TYPE_COUNT,
+} FractalType;
+
+// Evaluates noise of dimension given by `dimensions` (2, 3 or 4) at point `p`. Result lies in range [-1, 1].
+float noise_sample(NoiseType type, int dimensions, const float *p, uint32_t seed);
+
+// Creates `pygl.math.noise` module. It is attached to `pygl.math` by its init function.
+PyObject *noise_module_create(void);
@@ -0,0 +1,485 @@
+#include "packing.h"
+#include <stdbool.h>
+#include "../buffers/buffer.h"
+#include "../utility.h"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+typedef struct
+{
+    PackFormat format;
+    int components;
+    const char *src;
+    char *dst;
+    Py_ssize_t count;
+    // distance between consecutive packed attributes, floats are always tightly packed
+    Py_ssize_t stride;
+} PackJob;
+
+static inline float sign_not_zero(float value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Projects unit vector onto octahedron and unfolds its lower half onto the square [-1, 1]^2.
+static inline void octahedral_encode(const float *normal, float *dest)
+{
+    const float l1 = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+    if (l1 == 0.0f)
+    {
+        dest[0] = dest[1] = 0.0f;
+        return;
+    }
+
+    float x = normal[0] / l1;
+    float y = normal[1] / l1;
+    if (normal[2] < 0.0f)
+    {
+        const float foldedX = (1.0f - fabsf(y)) * sign_not_zero(x);
+        y = (1.0f - fabsf(x)) * sign_not_zero(y);
+        x = foldedX;
+    }
+
+    dest[0] = x;
+    dest[1] = y;
+}
+
+static inline void octahedral_decode(float x, float y, float *dest)
+{
+    const float z = 1.0f - fabsf(x) - fabsf(y);
+    if (z < 0.0f)
+    {
+        const float unfoldedX = (1.0f - fabsf(y)) * sign_not_zero(x);
+        y = (1.0f - fabsf(x)) * sign_not_zero(y);
+        x = unfoldedX;
+    }
+
+    const float length = sqrtf(x * x + y * y + z * z);
+    dest[0] = x / length;
+    dest[1] = y / length;
+    dest[2] = z / length;
+}
+
+static Py_ssize_t get_packed_size(PackFormat format, int components)
+{
+    switch (format)
+    {
+    case PACK_FORMAT_HALF_FLOAT:
+    case PACK_FORMAT_SNORM16:
+    case PACK_FORMAT_UNORM16:
+        return components * 2;
+    case PACK_FORMAT_SNORM8:
+    case PACK_FORMAT_UNORM8:
+        return components;
+    case PACK_FORMAT_INT_2_10_10_10_REV:
+    case PACK_FORMAT_UNSIGNED_INT_2_10_10_10_REV:
+    case PACK_FORMAT_OCTAHEDRAL16:
+        return 4;
+    case PACK_FORMAT_OCTAHEDRAL8:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+static void pack_half(const PackJob *job)
+{
+    const Py_ssize_t total = job->count * job->components;
+    const float *src = (const float *)job->src;
+
+    // tightly packed attributes are converted 4 at a time, independently of vertex boundaries
+    if (job->stride == job->components * 2)
+    {
+        Py_ssize_t i = 0;
+#if defined(__F16C__)
+        for (; i + 4 <= total; i += 4)
+        {
+            const __m128i result = _mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storel_epi64((__m128i *)(job->dst + i * 2), result);
+        }
+#endif
+        for (; i < total; i++)
+        {
+            const uint16_t result = float_to_half(src[i]);
+            memcpy(job->dst + i * 2, &result, sizeof(result));
+        }
+
+        return;
+    }
+
+    for (Py_ssize_t i = 0; i < job->count; i++)
+    {
+        for (int j = 0; j < job->components; j++)
+        {
+            const uint16_t result = float_to_half(src[i * job->components + j]);
+            memcpy(job->dst + i * job->stride + j * sizeof(uint16_t), &result, sizeof(result));
+        }
+    }
+}
+
+// Format is resolved once per call, so every loop below converts a single kind of attribute. Components are
+// stored one by one with fixed size copies, tightly packed attributes are converted as a single flat array.
+#define _PACK_LOOP(job, packedType, convert, max)                                             \
+    if ((job)->stride == (job)->components * (Py_ssize_t)sizeof(packedType))                  \
+    {                                                                                         \
+        const float *src = (const float *)(job)->src;                                         \
+        for (Py_ssize_t i = 0; i < (job)->count * (job)->components; i++)                     \
+        {                                                                                     \
+            const packedType result = (packedType)convert(src[i], max);                       \
+            memcpy((job)->dst + i * sizeof(packedType), &result, sizeof(packedType));         \
+        }                                                                                     \
+    }                                                                                         \
+    else                                                                                      \
+    {                                                                                         \
+        for (Py_ssize_t i = 0; i < (job)->count; i++)                                         \
+        {                                                                                     \
+            const float *v = (const float *)(job)->src + i * (job)->components;               \
+            for (int j = 0; j < (job)->components; j++)                                       \
+            {                                                                                 \
+                const packedType result = (packedType)convert(v[j], max);                     \
+                memcpy((job)->dst + i * (job)->stride + j * sizeof(packedType), &result, sizeof(packedType)); \
+            }                                                                                 \
+        }                                                                                     \
+    }
+
+// Destination may be a buffer at arbitrary offset, so floats are copied instead of being stored directly.
+#define _UNPACK_LOOP(job, packedType, ...)                                                    \
+    for (Py_ssize_t i = 0; i < (job)->count; i++)                                             \
+    {                                                                                         \
+        char *dst = (job)->dst + i * (job)->components * sizeof(float);                       \
+        for (int j = 0; j < (job)->components; j++)                                           \
+        {                                                                                     \
+            packedType value;                                                                 \
+            memcpy(&value, (job)->src + i * (job)->stride + j * sizeof(packedType), sizeof(packedType)); \
+            const float result = (__VA_ARGS__);                                               \
+            memcpy(dst + j * sizeof(float), &result, sizeof(float));                          \
+        }                                                                                     \
+    }
+
+static void pack_kernel(const PackJob *job)
+{
+    switch (job->format)
+    {
+    case PACK_FORMAT_HALF_FLOAT:
+        pack_half(job);
+        break;
+    case PACK_FORMAT_SNORM8:
+        _PACK_LOOP(job, int8_t, pack_snorm, 127.0f);
+        break;
+    case PACK_FORMAT_SNORM16:
+        _PACK_LOOP(job, int16_t, pack_snorm, 32767.0f);
+        break;
+    case PACK_FORMAT_UNORM8:
+        _PACK_LOOP(job, uint8_t, pack_unorm, 255.0f);
+        break;
+    case PACK_FORMAT_UNORM16:
+        _PACK_LOOP(job, uint16_t, pack_unorm, 65535.0f);
+        break;
+    case PACK_FORMAT_INT_2_10_10_10_REV:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            const float *v = (const float *)job->src + i * job->components;
+
+            // w is commonly used for handedness of tangent frames, which fits into 2 bits as either -1 or 1
+            const float w = job->components == 4 ? v[3] : 0.0f;
+            const uint32_t result =
+                ((uint32_t)pack_snorm(v[0], 511.0f) & 0x3ffu) |
+                ((uint32_t)pack_snorm(v[1], 511.0f) & 0x3ffu) << 10 |
+                ((uint32_t)pack_snorm(v[2], 511.0f) & 0x3ffu) << 20 |
+                ((uint32_t)pack_snorm(w, 1.0f) & 0x3u) << 30;
+            memcpy(job->dst + i * job->stride, &result, sizeof(result));
+        }
+        break;
+    case PACK_FORMAT_UNSIGNED_INT_2_10_10_10_REV:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            const float *v = (const float *)job->src + i * job->components;
+
+            const float w = job->components == 4 ? v[3] : 1.0f;
+            const uint32_t result =
+                pack_unorm(v[0], 1023.0f) |
+                pack_unorm(v[1], 1023.0f) << 10 |
+                pack_unorm(v[2], 1023.0f) << 20 |
+                pack_unorm(w, 3.0f) << 30;
+            memcpy(job->dst + i * job->stride, &result, sizeof(result));
+        }
+        break;
+    case PACK_FORMAT_OCTAHEDRAL8:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            float encoded[2];
+            octahedral_encode((const float *)job->src + i * 3, encoded);
+
+            const int8_t result[2] = {(int8_t)pack_snorm(encoded[0], 127.0f), (int8_t)pack_snorm(encoded[1], 127.0f)};
+            memcpy(job->dst + i * job->stride, result, sizeof(result));
+        }
+        break;
+    case PACK_FORMAT_OCTAHEDRAL16:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            float encoded[2];
+            octahedral_encode((const float *)job->src + i * 3, encoded);
+
+            const int16_t result[2] = {(int16_t)pack_snorm(encoded[0], 32767.0f), (int16_t)pack_snorm(encoded[1], 32767.0f)};
+            memcpy(job->dst + i * job->stride, result, sizeof(result));
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Inverse of `pack_kernel`, reads packed attributes from `src` using `stride` and writes tightly packed floats.
+static void unpack_kernel(const PackJob *job)
+{
+    switch (job->format)
+    {
+    case PACK_FORMAT_HALF_FLOAT:
+        _UNPACK_LOOP(job, uint16_t, half_to_float(value));
+        break;
+    case PACK_FORMAT_SNORM8:
+        _UNPACK_LOOP(job, int8_t, unpack_snorm(value, 127.0f));
+        break;
+    case PACK_FORMAT_SNORM16:
+        _UNPACK_LOOP(job, int16_t, unpack_snorm(value, 32767.0f));
+        break;
+    case PACK_FORMAT_UNORM8:
+        _UNPACK_LOOP(job, uint8_t, value / 255.0f);
+        break;
+    case PACK_FORMAT_UNORM16:
+        _UNPACK_LOOP(job, uint16_t, value / 65535.0f);
+        break;
+    case PACK_FORMAT_INT_2_10_10_10_REV:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            uint32_t value;
+            memcpy(&value, job->src + i * job->stride, sizeof(value));
+
+            // shift fields to the top of the word, so arithmetic shift right extends their sign
+            const float result[4] = {
+                unpack_snorm((int32_t)(value << 22) >> 22, 511.0f),
+                unpack_snorm((int32_t)(value << 12) >> 22, 511.0f),
+                unpack_snorm((int32_t)(value << 2) >> 22, 511.0f),
+                unpack_snorm((int32_t)value >> 30, 1.0f),
+            };
+            memcpy(job->dst + i * job->components * sizeof(float), result, job->components * sizeof(float));
+        }
+        break;
+    case PACK_FORMAT_UNSIGNED_INT_2_10_10_10_REV:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            uint32_t value;
+            memcpy(&value, job->src + i * job->stride, sizeof(value));
+
+            const float result[4] = {
+                (value & 0x3ffu) / 1023.0f,
+                (value >> 10 & 0x3ffu) / 1023.0f,
+                (value >> 20 & 0x3ffu) / 1023.0f,
+                (value >> 30) / 3.0f,
+            };
+            memcpy(job->dst + i * job->components * sizeof(float), result, job->components * sizeof(float));
+        }
+        break;
+    case PACK_FORMAT_OCTAHEDRAL8:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            int8_t values[2];
+            memcpy(values, job->src + i * job->stride, sizeof(values));
+
+            float result[3];
+            octahedral_decode(unpack_snorm(values[0], 127.0f), unpack_snorm(values[1], 127.0f), result);
+            memcpy(job->dst + i * sizeof(vec3), result, sizeof(result));
+        }
+        break;
+    case PACK_FORMAT_OCTAHEDRAL16:
+        for (Py_ssize_t i = 0; i < job->count; i++)
+        {
+            int16_t values[2];
+            memcpy(values, job->src + i * job->stride, sizeof(values));
+
+            float result[3];
+            octahedral_decode(unpack_snorm(values[0], 32767.0f), unpack_snorm(values[1], 32767.0f), result);
+            memcpy(job->dst + i * sizeof(vec3), result, sizeof(result));
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static bool check_format(PackFormat format, int components)
+{
+    THROW_IF(
+        format < 0 || format >= PACK_FORMAT_COUNT,
+        PyExc_ValueError,
+        "Invalid pack format.",
+        false);
+
+    switch (format)
+    {
+    case PACK_FORMAT_INT_2_10_10_10_REV:
+    case PACK_FORMAT_UNSIGNED_INT_2_10_10_10_REV:
+        THROW_IF(
+            components != 3 && components != 4,
+            PyExc_ValueError,
+            "2_10_10_10 formats require 3 or 4 components.",
+            false);
+        break;
+    case PACK_FORMAT_OCTAHEDRAL8:
+    case PACK_FORMAT_OCTAHEDRAL16:
+        THROW_IF(
+            components != 3,
+            PyExc_ValueError,
+            "Octahedral encoding requires 3-component normals.",
+            false);
+        break;
+    default:
+        THROW_IF(
+            components < 1 || components > 4,
+            PyExc_ValueError,
+            "Component count has to be in range [1, 4].",
+            false);
+        break;
+    }
+
+    return true;
+}
+
+// Validates layout of packed attributes and replaces zero stride with size of a single packed attribute.
+static bool check_packed_layout(Py_ssize_t packedSize, Py_ssize_t *stride, Py_ssize_t offset)
+{
+    if (*stride == 0)
+        *stride = packedSize;
+
+    THROW_IF(
+        *stride < packedSize,
+        PyExc_ValueError,
+        "Stride cannot be smaller than size of a single packed attribute.",
+        false);
+    THROW_IF(
+        offset < 0 || offset > *stride - packedSize,
+        PyExc_ValueError,
+        "Offset has to point to an attribute placed inside a single stride.",
+        false);
+
+    return true;
+}
+
+static void run_job(void (*kernel)(const PackJob *), const PackJob *job)
+{
+    if (job->count >= PACK_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        kernel(job);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        kernel(job);
+    }
+}
+
+PyObject *math_pack_vertices(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"src", "dst", "format", "components", "stride", "offset", NULL};
+
+    PyObject *srcObj = NULL;
+    PyObject *dstObj = NULL;
+    PackJob job = {.components = 3};
+    Py_ssize_t offset = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOi|inn", kwNames, &srcObj, &dstObj, &job.format, &job.components, &job.stride, &offset) ||
+        !check_format(job.format, job.components))
+        return NULL;
+
+    const Py_ssize_t packedSize = get_packed_size(job.format, job.components);
+    if (!check_packed_layout(packedSize, &job.stride, offset))
+        return NULL;
+
+    Py_buffer src;
+    if (!utils_get_float_buffer(srcObj, job.components, &src, &job.count))
+        return NULL;
+
+    if (job.count == 0)
+    {
+        PyBuffer_Release(&src);
+        Py_RETURN_NONE;
+    }
+
+    WriteTarget dst;
+    if (!py_buffer_acquire_write_target(dstObj, -1, offset + (job.count - 1) * job.stride + packedSize, &dst))
+    {
+        PyBuffer_Release(&src);
+        return NULL;
+    }
+
+    job.src = src.buf;
+    job.dst = (char *)dst.data + offset;
+    run_job(pack_kernel, &job);
+
+    py_buffer_release_write_target(&dst);
+    PyBuffer_Release(&src);
+
+    Py_RETURN_NONE;
+}
+
+PyObject *math_unpack_vertices(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"src", "dst", "format", "components", "stride", "offset", NULL};
+
+    PyObject *srcObj = NULL;
+    PyObject *dstObj = NULL;
+    PackJob job = {.components = 3};
+    Py_ssize_t offset = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOi|inn", kwNames, &srcObj, &dstObj, &job.format, &job.components, &job.stride, &offset) ||
+        !check_format(job.format, job.components))
+        return NULL;
+
+    const Py_ssize_t packedSize = get_packed_size(job.format, job.components);
+    if (!check_packed_layout(packedSize, &job.stride, offset))
+        return NULL;
+
+    Py_buffer src;
+    if (PyObject_GetBuffer(srcObj, &src, PyBUF_CONTIG_RO) == -1)
+    {
+        raise_buffer_not_contiguous();
+        return NULL;
+    }
+
+    job.count = src.len >= offset + packedSize ? (src.len - offset - packedSize) / job.stride + 1 : 0;
+    if (job.count == 0)
+    {
+        PyBuffer_Release(&src);
+        Py_RETURN_NONE;
+    }
+
+    WriteTarget dst;
+    if (!py_buffer_acquire_write_target(dstObj, -1, job.count * job.components * sizeof(float), &dst))
+    {
+        PyBuffer_Release(&src);
+        return NULL;
+    }
+
+    job.src = (const char *)src.buf + offset;
+    job.dst = dst.data;
+    run_job(unpack_kernel, &job);
+
+    py_buffer_release_write_target(&dst);
+    PyBuffer_Release(&src);
+
+    Py_RETURN_NONE;
+}
+
+PyObject *math_get_packed_size(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"format", "components", NULL};
+
+    PackFormat format = PACK_FORMAT_HALF_FLOAT;
+    int components = 3;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|i", kwNames, &format, &components) ||
+        !check_format(format, components))
+        return NULL;
+
+    return PyLong_FromSsize_t(get_packed_size(format, components));
+}
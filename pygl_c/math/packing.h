@@ -0,0 +1,118 @@
+#pragma once
+#include <Python.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <cglm/types.h>
+#include <cglm/util.h>
+
+// Number of vertices above which packing functions release the GIL.
+#define PACK_RELEASE_GIL_THRESHOLD 4096
+
+typedef enum
+{
+    PACK_FORMAT_HALF_FLOAT,
+    PACK_FORMAT_SNORM8,
+    PACK_FORMAT_SNORM16,
+    PACK_FORMAT_UNORM8,
+    PACK_FORMAT_UNORM16,
+    PACK_FORMAT_INT_2_10_10_10_REV,
+    PACK_FORMAT_UNSIGNED_INT_2_10_10_10_REV,
+    PACK_FORMAT_OCTAHEDRAL8,
+    PACK_FORMAT_OCTAHEDRAL16,
+    PACK_FORMAT_COUNT,
+} PackFormat;
+
+PyObject *math_pack_vertices(PyObject *self, PyObject *args, PyObject *kwargs);
+PyObject *math_unpack_vertices(PyObject *self, PyObject *args, PyObject *kwargs);
+PyObject *math_get_packed_size(PyObject *self, PyObject *args, PyObject *kwargs);
+
+// Scalar conversions shared by packing kernels and pygl.buffers.RecordLayout.
+
+static inline uint32_t float_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float bits_float(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Converts float to IEEE 754 binary16 with rounding to nearest even. Values too large for half become infinity
+// and NaNs are preserved as quiet NaNs.
+static inline uint16_t float_to_half(float value)
+{
+    const uint32_t infinity = 255u << 23;
+    const uint32_t halfMax = (127u + 16u) << 23;
+    const uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t bits = float_bits(value);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint16_t result;
+    if (bits >= halfMax)
+    {
+        result = bits > infinity ? 0x7e00 : 0x7c00;
+    }
+    else if (bits < (113u << 23))
+    {
+        // denormals are rounded by floating point addition of a magic number
+        result = (uint16_t)(float_bits(bits_float(bits) + bits_float(denormMagic)) - denormMagic);
+    }
+    else
+    {
+        const uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += ((uint32_t)(15 - 127) << 23) + 0xfff;
+        bits += mantissaOdd;
+        result = (uint16_t)(bits >> 13);
+    }
+
+    return result | (uint16_t)(sign >> 16);
+}
+
+static inline float half_to_float(uint16_t value)
+{
+    const uint32_t shiftedExponent = 0x7c00u << 13;
+
+    uint32_t bits = (value & 0x7fffu) << 13;
+    const uint32_t exponent = bits & shiftedExponent;
+    bits += (127u - 15u) << 23;
+
+    if (exponent == shiftedExponent)
+    {
+        // infinity or NaN
+        bits += (128u - 16u) << 23;
+    }
+    else if (exponent == 0)
+    {
+        // zero or denormal
+        bits += 1u << 23;
+        bits = float_bits(bits_float(bits) - bits_float(113u << 23));
+    }
+
+    return bits_float(bits | (uint32_t)(value & 0x8000u) << 16);
+}
+
+// Rounds half away from zero, the same as roundf, but without a library call so loops can be vectorized.
+static inline int32_t pack_snorm(float value, float max)
+{
+    const float scaled = glm_clamp(value, -1.0f, 1.0f) * max;
+    return (int32_t)(scaled + copysignf(0.5f, scaled));
+}
+
+static inline uint32_t pack_unorm(float value, float max)
+{
+    return (uint32_t)(glm_clamp(value, 0.0f, 1.0f) * max + 0.5f);
+}
+
+// Follows OpenGL 4.2 conversion rules, so both -max and -max - 1 map onto -1.0.
+static inline float unpack_snorm(int32_t value, float max)
+{
+    return glm_max((float)value / max, -1.0f);
+}
@@ -1,5 +1,26 @@
 #include "plane.h"
 #include "vector/vector.h"
+#include "../utility.h"
+
+Plane *py_plane_new(void)
+{
+    return PyObject_New(Plane, &pyPlaneType);
+}
+
+static bool set_values(Plane *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"normal", "distance", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[0], &pyVector3Type, "normal") ||
+        !utils_as_float(values[1], &self->distance))
+        return false;
+
+    glm_vec3_copy(((Vector3 *)values[0])->data, self->normal);
+
+    return true;
+}
 
 static int init(Plane *self, PyObject *args, PyObject *kwargs)
 {
@@ -13,9 +34,24 @@ static int init(Plane *self, PyObject *args, PyObject *kwargs)
     return 0;
 }
 
+static PyObject *vectorcall(PyTypeObject *Py_UNUSED(type), PyObject *const *args, size_t nargsf, PyObject *kwnames)
+{
+    Plane *result = py_plane_new();
+    if (!result)
+        return NULL;
+
+    if (!set_values(result, args, PyVectorcall_NARGS(nargsf), kwnames))
+    {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
+}
+
 static PyObject *repr(Plane *self)
 {
-    const size_t length = strlen(Py_TYPE(self)->tp_name) + 8 * 4 + 15;
+    const size_t length = strlen(Py_TYPE(self)->tp_name) + 16 * 4 + 16;
     char *buffer = PyMem_Malloc(sizeof(char) * length);
     snprintf(
         buffer,
@@ -27,7 +63,7 @@ static PyObject *repr(Plane *self)
         self->normal[2],
         self->distance);
 
-    PyObject *result = PyUnicode_FromStringAndSize(buffer, length);
+    PyObject *result = PyUnicode_FromString(buffer);
     PyMem_Free(buffer);
 
     return result;
@@ -35,17 +71,26 @@ static PyObject *repr(Plane *self)
 
 static Vector3 *get_normal(Plane *self, void *Py_UNUSED(closure))
 {
-    Vector3 *pos = PyObject_New(Vector3, &pyVector3Type);
-    pos->length = 3;
+    Vector3 *pos = py_vector3_new();
+    if (!pos)
+        return NULL;
 
     glm_vec3_copy(self->normal, pos->data);
 
     return pos;
 }
 
+static PyObject *distance_to(Plane *self, PyObject *point)
+{
+    if (!utils_check_arg_type(point, &pyVector3Type, "point"))
+        return NULL;
+
+    return PyFloat_FromDouble(glm_vec3_dot(self->normal, ((Vector3 *)point)->data) + self->distance);
+}
+
 static int set_normal(Plane *self, Vector3 *value, void *closure)
 {
-    if (!PyObject_IsInstance((PyObject *)value, (PyObject *)&pyVector3Type))
+    if (!Py_IS_TYPE((PyObject *)value, &pyVector3Type))
     {
         PyErr_Format(PyExc_TypeError, "Expected value to be of type pygl.math.Vector3, got: %s.", Py_TYPE(value)->tp_name);
         return -1;
@@ -61,14 +106,16 @@ PyTypeObject pyPlaneType = {
         .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_new = PyType_GenericNew,
     .tp_name = "pygl.math.Plane",
-    .tp_itemsize = sizeof(Plane),
+    .tp_basicsize = sizeof(Plane),
     .tp_init = (initproc)init,
+    .tp_vectorcall = (vectorcallfunc)vectorcall,
     .tp_repr = (reprfunc)repr,
     .tp_getset = (PyGetSetDef[]){
         {"normal", (getter)get_normal, (setter)set_normal, NULL, NULL},
         {0},
     },
     .tp_methods = (PyMethodDef[]){
+        {"distance_to", (PyCFunction)distance_to, METH_O, NULL},
         {0},
     },
     .tp_members = (PyMemberDef[]){
@@ -9,4 +9,6 @@ typedef struct
     vec3 normal;
 } Plane;
 
-extern PyTypeObject pyPlaneType;
\ No newline at end of file
+extern PyTypeObject pyPlaneType;
+
+Plane *py_plane_new(void);
@@ -1,37 +1,88 @@
 #include "quaternion.h"
 #include "vector/vector.h"
+#include "freeList.h"
+#include "../utility.h"
 #include <cglm/cglm.h>
 
-#define NEW_QUAT(var) Quaternion *var = PyObject_New(Quaternion, &pyQuaternionType)
+#define NEW_QUAT(var)                      \
+    Quaternion *var = py_quaternion_new(); \
+    if (!var)                              \
+    return NULL
+
+Quaternion *py_quaternion_new(void)
+{
+    return (Quaternion *)free_list_alloc(&mathFreeLists[FREE_LIST_QUATERNION]);
+}
+
+static void dealloc(Quaternion *self)
+{
+    free_list_dealloc(&mathFreeLists[FREE_LIST_QUATERNION], (PyObject *)self);
+}
 
 void py_quaternion_copy(void *dst, Quaternion *quaternion)
 {
     glm_quat_copy(&quaternion->data[0], dst);
 }
 
-static int init(Quaternion *self, PyObject *args, PyObject *Py_UNUSED(kwargs))
+static bool set_values(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"x", "y", "z", "w", NULL};
+
+    PyObject *values[4];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 4, values))
+        return false;
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        if (!utils_as_float(values[i], &self->data[i]))
+            return false;
+    }
+
+    return true;
+}
+
+static int init(Quaternion *self, PyObject *args, PyObject *kwargs)
 {
-    if (!PyArg_ParseTuple(args, "ffff", &self->data[0], &self->data[1], &self->data[2], &self->data[3]))
+    static char *kwNames[] = {"x", "y", "z", "w", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ffff", kwNames, &self->data[0], &self->data[1], &self->data[2], &self->data[3]))
         return -1;
 
     return 0;
 }
 
+static PyObject *vectorcall(PyTypeObject *Py_UNUSED(type), PyObject *const *args, size_t nargsf, PyObject *kwnames)
+{
+    NEW_QUAT(result);
+    if (!set_values(result, args, PyVectorcall_NARGS(nargsf), kwnames))
+    {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
+}
+
 static PyObject *identity(PyTypeObject *cls, PyObject *Py_UNUSED(args))
 {
-    Quaternion *res = PyObject_New(Quaternion, cls);
+    NEW_QUAT(res);
     glm_quat_identity(res->data);
 
     return (PyObject *)res;
 }
 
-static PyObject *from_euler_deg(PyTypeObject *cls, PyObject *args)
+static PyObject *from_euler_deg(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    Vector3 *eulerAngles;
-    if (!PyArg_ParseTuple(args, "O!", &pyVector3Type, &eulerAngles))
+    static const char *const kwNames[] = {"rotation", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !utils_check_arg_type(values[0], &pyVector3Type, "rotation"))
         return NULL;
 
-    Quaternion *res = PyObject_New(Quaternion, cls);
+    Vector3 *eulerAngles = (Vector3 *)values[0];
+
+    NEW_QUAT(res);
 
     vec3 anglesRad;
     glm_vec3_scale(eulerAngles->data, GLM_PI / 180.0f, anglesRad);
@@ -40,27 +91,40 @@ static PyObject *from_euler_deg(PyTypeObject *cls, PyObject *args)
     return (PyObject *)res;
 }
 
-static PyObject *from_euler_rad(PyTypeObject *cls, PyObject *args)
+static PyObject *from_euler_rad(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    Vector3 *eulerAngles;
-    if (!PyArg_ParseTuple(args, "O!", &pyVector3Type, &eulerAngles))
+    static const char *const kwNames[] = {"rotation", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !utils_check_arg_type(values[0], &pyVector3Type, "rotation"))
         return NULL;
 
-    Quaternion *res = PyObject_New(Quaternion, cls);
+    Vector3 *eulerAngles = (Vector3 *)values[0];
+
+    NEW_QUAT(res);
 
     glm_euler_xyz_quat(eulerAngles->data, res->data);
 
     return (PyObject *)res;
 }
 
-static PyObject *from_axis(PyTypeObject *cls, PyObject *args)
+static PyObject *from_axis(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
+    static const char *const kwNames[] = {"angle", "axis", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[1], &pyVector3Type, "axis"))
+        return NULL;
+
     float angle;
-    Vector3 *axis;
-    if (!PyArg_ParseTuple(args, "fO!", &angle, &pyVector3Type, &axis))
+    if (!utils_as_float(values[0], &angle))
         return NULL;
 
-    Quaternion *res = PyObject_New(Quaternion, cls);
+    Vector3 *axis = (Vector3 *)values[1];
+
+    NEW_QUAT(res);
     glm_quatv(res->data, angle, axis->data);
 
     return (PyObject *)res;
@@ -72,17 +136,52 @@ static PyObject *normalize(Quaternion *self, PyObject *Py_UNUSED(args))
     Py_RETURN_NONE;
 }
 
-static PyObject *normalized(Quaternion *self, PyObject *Py_UNUSED(args))
+// Resolves object that receives result of an operation. If `out` is not provided new quaternion is created,
+// otherwise new reference to `out` is returned, so results can be written without allocating.
+static Quaternion *get_out(PyObject *out)
 {
-    NEW_QUAT(res);
+    if (out == NULL || out == Py_None)
+        return py_quaternion_new();
+
+    if (!utils_check_arg_type(out, &pyQuaternionType, "out"))
+        return NULL;
+
+    return (Quaternion *)Py_NewRef(out);
+}
+
+static PyObject *normalized_impl(Quaternion *self, PyObject *out)
+{
+    Quaternion *res = get_out(out);
+    if (!res)
+        return NULL;
+
     glm_quat_normalize_to(self->data, res->data);
 
     return (PyObject *)res;
 }
 
+static PyObject *normalized(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"out", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 0, values))
+        return NULL;
+
+    return normalized_impl(self, values[0]);
+}
+
+static PyObject *normalized_into(Quaternion *self, PyObject *out)
+{
+    if (!utils_check_arg_type(out, &pyQuaternionType, "out"))
+        return NULL;
+
+    return normalized_impl(self, out);
+}
+
 static PyObject *dot(Quaternion *self, PyObject *other)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE(other, &pyQuaternionType))
     {
         PyErr_Format(PyExc_TypeError, "Expected argument to be of type pygl.math.Quaternion, but got %s.", Py_TYPE(other)->tp_name);
         return NULL;
@@ -110,51 +209,135 @@ static PyObject *inverse(Quaternion *self, PyObject *Py_UNUSED(args))
     Py_RETURN_NONE;
 }
 
-static PyObject *inversed(Quaternion *self, PyObject *Py_UNUSED(args))
+static PyObject *inversed_impl(Quaternion *self, PyObject *out)
 {
-    NEW_QUAT(res);
-    glm_quat_inv(self->data, res->data);
+    Quaternion *res = get_out(out);
+    if (!res)
+        return NULL;
+
+    versor tmp;
+    glm_quat_inv(self->data, tmp);
+    glm_quat_copy(tmp, res->data);
 
     return (PyObject *)res;
 }
 
-static PyObject *look_at(PyTypeObject *cls, PyObject *args)
+static PyObject *inversed(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"out", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 0, values))
+        return NULL;
+
+    return inversed_impl(self, values[0]);
+}
+
+static PyObject *inversed_into(Quaternion *self, PyObject *out)
 {
-    Vector3 *dir;
-    Vector3 *up;
-    if (!PyArg_ParseTuple(args, "O!O!", &pyVector3Type, &dir, &pyVector3Type, &up))
+    if (!utils_check_arg_type(out, &pyQuaternionType, "out"))
         return NULL;
 
-    Quaternion *res = PyObject_New(Quaternion, cls);
+    return inversed_impl(self, out);
+}
+
+static PyObject *look_at(PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"dir", "up", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[0], &pyVector3Type, "dir") ||
+        !utils_check_arg_type(values[1], &pyVector3Type, "up"))
+        return NULL;
+
+    Vector3 *dir = (Vector3 *)values[0];
+    Vector3 *up = (Vector3 *)values[1];
+
+    NEW_QUAT(res);
     glm_quat_for(dir->data, up->data, res->data);
 
     return (PyObject *)res;
 }
 
-static PyObject *interpolate(Quaternion *self, PyObject *args)
+static PyObject *interpolate_impl(Quaternion *self, PyObject *const *values)
 {
-    Quaternion *other;
+    if (!utils_check_arg_type(values[0], &pyQuaternionType, "other"))
+        return NULL;
+
+    Quaternion *other = (Quaternion *)values[0];
     float factor;
-    if (!PyArg_ParseTuple(args, "O!f", &pyQuaternionType, &other, &factor))
+    if (!utils_as_float(values[1], &factor))
+        return NULL;
+
+    Quaternion *res = get_out(values[2]);
+    if (!res)
         return NULL;
 
-    NEW_QUAT(res);
     glm_quat_lerp(self->data, other->data, factor, res->data);
 
     return (PyObject *)res;
 }
 
-// inplace
-static PyObject *rotate_vector(Quaternion *self, Vector3 *vector)
+static PyObject *interpolate(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    if (!PyObject_IsInstance((PyObject *)vector, (PyObject *)&pyVector3Type))
-    {
-        PyErr_Format(PyExc_TypeError, "Expected argument to be of type pygl.math.Vector3, got: %s.", Py_TYPE(vector)->tp_name);
+    static const char *const kwNames[] = {"other", "factor", "out", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values))
         return NULL;
-    }
 
-    glm_quat_rotatev(self->data, vector->data, vector->data);
-    return Py_NewRef((PyObject *)vector);
+    return interpolate_impl(self, values);
+}
+
+static PyObject *interpolate_into(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "factor", "out", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 3, values) ||
+        !utils_check_arg_type(values[2], &pyQuaternionType, "out"))
+        return NULL;
+
+    return interpolate_impl(self, values);
+}
+
+// Rotates `vector` and stores result in `out`. Without `out` the vector is rotated in place.
+static PyObject *rotate_vector_impl(Quaternion *self, PyObject *vector, PyObject *out)
+{
+    if (!utils_check_arg_type(vector, &pyVector3Type, "vector"))
+        return NULL;
+
+    if (out == NULL || out == Py_None)
+        out = vector;
+    else if (!utils_check_arg_type(out, &pyVector3Type, "out"))
+        return NULL;
+
+    glm_quat_rotatev(self->data, ((Vector3 *)vector)->data, ((Vector3 *)out)->data);
+    return Py_NewRef(out);
+}
+
+static PyObject *rotate_vector(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"vector", "out", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values))
+        return NULL;
+
+    return rotate_vector_impl(self, values[0], values[1]);
+}
+
+static PyObject *rotate_vector_into(Quaternion *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"vector", "out", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[1], &pyVector3Type, "out"))
+        return NULL;
+
+    return rotate_vector_impl(self, values[0], values[1]);
 }
 
 #pragma region GETTERS
@@ -165,7 +348,10 @@ static PyObject *angle_get(Quaternion *self, void *Py_UNUSED(closure))
 
 static PyObject *axis_get(Quaternion *self, void *Py_UNUSED(closure))
 {
-    Vector3 *result = PyObject_New(Vector3, &pyVector3Type);
+    Vector3 *result = py_vector3_new();
+    if (!result)
+        return NULL;
+
     glm_quat_axis(self->data, result->data);
 
     return (PyObject *)result;
@@ -178,7 +364,10 @@ static PyObject *real_get(Quaternion *self, void *Py_UNUSED(closure))
 
 static PyObject *imag_get(Quaternion *self, void *Py_UNUSED(closure))
 {
-    Vector3 *result = PyObject_New(Vector3, &pyVector3Type);
+    Vector3 *result = py_vector3_new();
+    if (!result)
+        return NULL;
+
     glm_quat_imag(self->data, result->data);
 
     return (PyObject *)result;
@@ -188,7 +377,7 @@ static PyObject *imag_get(Quaternion *self, void *Py_UNUSED(closure))
 #pragma region NB_METHODS
 static PyObject *mul(Quaternion *self, Quaternion *other)
 {
-    if (!PyObject_IsInstance((PyObject *)other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE((PyObject *)other, &pyQuaternionType))
         Py_RETURN_NOTIMPLEMENTED;
 
     NEW_QUAT(res);
@@ -198,19 +387,19 @@ static PyObject *mul(Quaternion *self, Quaternion *other)
 
 static PyObject *imul(Quaternion *self, PyObject *other)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE(other, &pyQuaternionType))
         Py_RETURN_NOTIMPLEMENTED;
 
     versor res;
     glm_quat_mul(self->data, ((Quaternion *)other)->data, res);
     glm_quat_copy(res, self->data);
 
-    return (PyObject *)self;
+    return Py_NewRef(self);
 }
 
 static PyObject *sub(Quaternion *self, PyObject *other)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE(other, &pyQuaternionType))
         Py_RETURN_NOTIMPLEMENTED;
 
     NEW_QUAT(res);
@@ -221,19 +410,19 @@ static PyObject *sub(Quaternion *self, PyObject *other)
 
 static PyObject *isub(Quaternion *self, PyObject *other)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE(other, &pyQuaternionType))
         Py_RETURN_NOTIMPLEMENTED;
 
     versor res;
     glm_quat_sub(self->data, ((Quaternion *)other)->data, res);
     glm_quat_copy(res, self->data);
 
-    return (PyObject *)self;
+    return Py_NewRef(self);
 }
 
 static PyObject *add(Quaternion *self, PyObject *other)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE(other, &pyQuaternionType))
         Py_RETURN_NOTIMPLEMENTED;
 
     NEW_QUAT(res);
@@ -244,14 +433,14 @@ static PyObject *add(Quaternion *self, PyObject *other)
 
 static PyObject *iadd(Quaternion *self, PyObject *other)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&pyQuaternionType))
+    if (!Py_IS_TYPE(other, &pyQuaternionType))
         Py_RETURN_NOTIMPLEMENTED;
 
     versor res;
     glm_quat_add(self->data, ((Quaternion *)other)->data, res);
     glm_quat_copy(res, self->data);
 
-    return (PyObject *)self;
+    return Py_NewRef(self);
 }
 #pragma endregion
 
@@ -273,10 +462,13 @@ static PyObject *repr(Quaternion *self)
 PyTypeObject pyQuaternionType = {
     PyVarObject_HEAD_INIT(NULL, 0)
         .tp_new = PyType_GenericNew,
+    .tp_alloc = free_list_tp_alloc,
+    .tp_dealloc = (destructor)dealloc,
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_basicsize = sizeof(Quaternion),
     .tp_name = "pygl.math.Quaternion",
     .tp_init = (initproc)init,
+    .tp_vectorcall = (vectorcallfunc)vectorcall,
     .tp_repr = (reprfunc)repr,
     .tp_members = (PyMemberDef[]){
         {"x", T_FLOAT, offsetof(Quaternion, data[0]), 0, NULL},
@@ -286,19 +478,23 @@ PyTypeObject pyQuaternionType = {
         {0},
     },
     .tp_methods = (PyMethodDef[]){
-        {"from_axis", (PyCFunction)from_axis, METH_CLASS | METH_VARARGS, NULL},
-        {"from_euler_deg", (PyCFunction)from_euler_deg, METH_CLASS | METH_VARARGS, NULL},
-        {"from_euler_rad", (PyCFunction)from_euler_rad, METH_CLASS | METH_VARARGS, NULL},
+        {"from_axis", (PyCFunction)from_axis, METH_CLASS | METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"from_euler_deg", (PyCFunction)from_euler_deg, METH_CLASS | METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"from_euler_rad", (PyCFunction)from_euler_rad, METH_CLASS | METH_FASTCALL | METH_KEYWORDS, NULL},
         {"identity", (PyCFunction)identity, METH_CLASS | METH_NOARGS, NULL},
-        {"look_at", (PyCFunction)look_at, METH_CLASS | METH_VARARGS, NULL},
+        {"look_at", (PyCFunction)look_at, METH_CLASS | METH_FASTCALL | METH_KEYWORDS, NULL},
         {"normalize", (PyCFunction)normalize, METH_NOARGS, NULL},
-        {"normalized", (PyCFunction)normalized, METH_NOARGS, NULL},
+        {"normalized", (PyCFunction)normalized, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"normalized_into", (PyCFunction)normalized_into, METH_O, NULL},
         {"dot", (PyCFunction)dot, METH_O, NULL},
         {"conjugate", (PyCFunction)conjugate, METH_NOARGS, NULL},
         {"inverse", (PyCFunction)inverse, METH_NOARGS, NULL},
-        {"inversed", (PyCFunction)inversed, METH_NOARGS, NULL},
-        {"interpolate", (PyCFunction)interpolate, METH_VARARGS, NULL},
-        {"rotate_vector", (PyCFunction)rotate_vector, METH_O, NULL},
+        {"inversed", (PyCFunction)inversed, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"inversed_into", (PyCFunction)inversed_into, METH_O, NULL},
+        {"interpolate", (PyCFunction)interpolate, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"interpolate_into", (PyCFunction)interpolate_into, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"rotate_vector", (PyCFunction)rotate_vector, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"rotate_vector_into", (PyCFunction)rotate_vector_into, METH_FASTCALL | METH_KEYWORDS, NULL},
         {0},
     },
     .tp_getset = (PyGetSetDef[]){
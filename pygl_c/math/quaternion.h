@@ -11,4 +11,5 @@ typedef struct
 
 extern PyTypeObject pyQuaternionType;
 
+Quaternion *py_quaternion_new(void);
 void py_quaternion_copy(void *dst, Quaternion *quaternion);
@@ -0,0 +1,218 @@
+#include "transform.h"
+#include <string.h>
+#include <cglm/mat4.h>
+#include <cglm/vec3.h>
+#include "matrix/matrix.h"
+#include "vector/vector.h"
+#include "../buffers/buffer.h"
+#include "../utility.h"
+
+typedef enum
+{
+    TRANSFORM_POINTS,
+    TRANSFORM_DIRECTIONS,
+    TRANSFORM_NORMALS,
+} TransformKind;
+
+// Vertices might be interleaved with other attributes and have arbitrary alignment, so each one is loaded
+// into an aligned vec4 first, which lets glm_mat4_mulv use its SIMD path.
+static void transform_kernel(mat4 matrix, float w, bool normalize, const char *src, char *dst, Py_ssize_t count, Py_ssize_t stride)
+{
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        vec4 vertex;
+        memcpy(vertex, src + i * stride, sizeof(vec3));
+        vertex[3] = w;
+
+        vec4 result;
+        glm_mat4_mulv(matrix, vertex, result);
+
+        if (normalize)
+            glm_vec3_normalize(result);
+
+        memcpy(dst + i * stride, result, sizeof(vec3));
+    }
+}
+
+static PyObject *transform(TransformKind kind, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"matrix", "src", "dst", "stride", "offset", NULL};
+
+    Matrix4 *matrixObj = NULL;
+    PyObject *srcObj = NULL;
+    PyObject *dstObj = NULL;
+    Py_ssize_t stride = sizeof(vec3);
+    Py_ssize_t offset = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|nn", kwNames, &pyMatrix4Type, &matrixObj, &srcObj, &dstObj, &stride, &offset))
+        return NULL;
+
+    THROW_IF(
+        stride < (Py_ssize_t)sizeof(vec3),
+        PyExc_ValueError,
+        "Stride has to be at least 12 bytes (size of a single 3-component vertex).",
+        NULL);
+    THROW_IF(
+        offset < 0 || offset > stride - (Py_ssize_t)sizeof(vec3),
+        PyExc_ValueError,
+        "Offset has to point to a 3-component vertex placed inside a single stride.",
+        NULL);
+
+    Py_buffer src;
+    if (PyObject_GetBuffer(srcObj, &src, PyBUF_CONTIG_RO) == -1)
+    {
+        raise_buffer_not_contiguous();
+        return NULL;
+    }
+
+    Py_ssize_t count = src.len >= offset + (Py_ssize_t)sizeof(vec3) ? (src.len - offset - sizeof(vec3)) / stride + 1 : 0;
+    if (count == 0)
+    {
+        PyBuffer_Release(&src);
+        Py_RETURN_NONE;
+    }
+
+    // destination uses the same vertex layout as source, so only the transformed attribute is overwritten
+    WriteTarget dst;
+    if (!py_buffer_acquire_write_target(dstObj, -1, offset + (count - 1) * stride + sizeof(vec3), &dst))
+    {
+        PyBuffer_Release(&src);
+        return NULL;
+    }
+
+    mat4 matrix;
+    if (kind == TRANSFORM_NORMALS)
+    {
+        py_matrix4_inv(matrixObj, matrix);
+        glm_mat4_transpose(matrix);
+    }
+    else
+    {
+        glm_mat4_copy(matrixObj->data, matrix);
+    }
+
+    const float w = kind == TRANSFORM_POINTS ? 1.0f : 0.0f;
+    const bool normalize = kind == TRANSFORM_NORMALS;
+    const char *srcData = (const char *)src.buf + offset;
+    char *dstData = (char *)dst.data + offset;
+
+    if (count >= TRANSFORM_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        transform_kernel(matrix, w, normalize, srcData, dstData, count, stride);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        transform_kernel(matrix, w, normalize, srcData, dstData, count, stride);
+    }
+
+    py_buffer_release_write_target(&dst);
+    PyBuffer_Release(&src);
+
+    Py_RETURN_NONE;
+}
+
+PyObject *math_transform_points(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    return transform(TRANSFORM_POINTS, args, kwargs);
+}
+
+PyObject *math_transform_directions(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    return transform(TRANSFORM_DIRECTIONS, args, kwargs);
+}
+
+PyObject *math_transform_normals(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    return transform(TRANSFORM_NORMALS, args, kwargs);
+}
+
+// Subtraction is done in double precision, so only the (small) camera-relative result is rounded to float.
+static void camera_relative_kernel(const double *origin, const double *src, char *dst, Py_ssize_t count, Py_ssize_t stride)
+{
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        const double *position = src + i * 3;
+        const vec3 result = {
+            (float)(position[0] - origin[0]),
+            (float)(position[1] - origin[1]),
+            (float)(position[2] - origin[2]),
+        };
+
+        memcpy(dst + i * stride, result, sizeof(vec3));
+    }
+}
+
+PyObject *math_to_camera_relative(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"positions", "origin", "dst", "stride", "offset", NULL};
+
+    PyObject *srcObj = NULL;
+    DVector3 *origin = NULL;
+    PyObject *dstObj = NULL;
+    Py_ssize_t stride = sizeof(vec3);
+    Py_ssize_t offset = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO!O|nn", kwNames, &srcObj, &pyDVector3Type, &origin, &dstObj, &stride, &offset))
+        return NULL;
+
+    THROW_IF(
+        stride < (Py_ssize_t)sizeof(vec3),
+        PyExc_ValueError,
+        "Stride has to be at least 12 bytes (size of a single 3-component vertex).",
+        NULL);
+    THROW_IF(
+        offset < 0 || offset > stride - (Py_ssize_t)sizeof(vec3),
+        PyExc_ValueError,
+        "Offset has to point to a 3-component vertex placed inside a single stride.",
+        NULL);
+
+    Py_buffer src;
+    if (PyObject_GetBuffer(srcObj, &src, PyBUF_CONTIG_RO | PyBUF_FORMAT) == -1)
+    {
+        raise_buffer_not_contiguous();
+        return NULL;
+    }
+
+    THROW_IF_GOTO(
+        src.format == NULL || strcmp(src.format, "d") != 0,
+        PyExc_TypeError,
+        "Positions buffer has to contain double precision values (format \"d\").",
+        release_src);
+    THROW_IF_GOTO(
+        src.len % sizeof(dvec3) != 0,
+        PyExc_ValueError,
+        "Positions buffer size has to be a multiple of 24 bytes (size of a single 3-component double vertex).",
+        release_src);
+
+    const Py_ssize_t count = src.len / sizeof(dvec3);
+    if (count == 0)
+    {
+        PyBuffer_Release(&src);
+        Py_RETURN_NONE;
+    }
+
+    WriteTarget dst;
+    if (!py_buffer_acquire_write_target(dstObj, -1, offset + (count - 1) * stride + sizeof(vec3), &dst))
+        goto release_src;
+
+    char *dstData = (char *)dst.data + offset;
+    if (count >= TRANSFORM_RELEASE_GIL_THRESHOLD)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        camera_relative_kernel(origin->data, src.buf, dstData, count, stride);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        camera_relative_kernel(origin->data, src.buf, dstData, count, stride);
+    }
+
+    py_buffer_release_write_target(&dst);
+    PyBuffer_Release(&src);
+
+    Py_RETURN_NONE;
+
+release_src:
+    PyBuffer_Release(&src);
+    return NULL;
+}
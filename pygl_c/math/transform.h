@@ -0,0 +1,10 @@
+#pragma once
+#include <Python.h>
+
+// Number of vertices above which bulk transform functions release the GIL.
+#define TRANSFORM_RELEASE_GIL_THRESHOLD 4096
+
+PyObject *math_transform_points(PyObject *self, PyObject *args, PyObject *kwargs);
+PyObject *math_transform_directions(PyObject *self, PyObject *args, PyObject *kwargs);
+PyObject *math_transform_normals(PyObject *self, PyObject *args, PyObject *kwargs);
+PyObject *math_to_camera_relative(PyObject *self, PyObject *args, PyObject *kwargs);
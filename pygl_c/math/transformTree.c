@@ -0,0 +1,478 @@
+#include "transformTree.h"
+#include <string.h>
+#include <cglm/quat.h>
+#include "matrix/matrix.h"
+#include "matrix/matrix4Array.h"
+#include "vector/vector.h"
+#include "quaternion.h"
+#include "../utility.h"
+
+#define _SELF TransformTree *self
+#define _ROTATIONS_ALIGNMENT 16
+
+// Marks local transform of node as changed and extends update range by its whole subtree.
+static void mark_dirty(_SELF, Py_ssize_t index)
+{
+    self->dirty[index] = 1;
+
+    const Py_ssize_t end = (Py_ssize_t)self->subtreeEnds[index] + 1;
+    if (self->dirtyBegin >= self->dirtyEnd)
+    {
+        self->dirtyBegin = index;
+        self->dirtyEnd = end;
+        return;
+    }
+
+    if (index < self->dirtyBegin)
+        self->dirtyBegin = index;
+    if (end > self->dirtyEnd)
+        self->dirtyEnd = end;
+}
+
+static bool check_initialized(_SELF)
+{
+    THROW_IF(self->parents == NULL, PyExc_RuntimeError, "Transform tree is not initialized.", false);
+    return true;
+}
+
+static bool get_index(_SELF, PyObject *obj, Py_ssize_t *index)
+{
+    const Py_ssize_t value = PyLong_AsSsize_t(obj);
+    if (value == -1 && PyErr_Occurred())
+        return false;
+
+    if (value < 0 || value >= self->count)
+    {
+        PyErr_Format(PyExc_IndexError, "Node index %zd out of range [0, %zd).", value, self->count);
+        return false;
+    }
+
+    *index = value;
+    return true;
+}
+
+// Acquires optional buffer of `components` floats per node. Number of elements has to match `count`, unless it
+// is negative, in which case it is set to number of elements in the buffer.
+static bool get_node_values(PyObject *obj, Py_ssize_t components, const char *name, Py_buffer *view, Py_ssize_t *count)
+{
+    if (obj == NULL || obj == Py_None)
+        return true;
+
+    Py_ssize_t bufCount = 0;
+    if (!utils_get_float_buffer(obj, components, view, &bufCount))
+        return false;
+
+    if (*count < 0)
+        *count = bufCount;
+
+    if (bufCount != *count)
+    {
+        PyErr_Format(PyExc_ValueError, "Expected %zd %s, got: %zd.", *count, name, bufCount);
+        return false;
+    }
+
+    return true;
+}
+
+static int init(_SELF, PyObject *args, PyObject *kwargs)
+{
+    static char *kwNames[] = {"parents", NULL};
+
+    PyObject *parentsObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwNames, &parentsObj))
+        return -1;
+
+    // world matrices may be exported through the buffer protocol, so storage cannot be replaced
+    THROW_IF(self->parents != NULL, PyExc_RuntimeError, "Transform tree is already initialized.", -1);
+
+    PyObject *parentsSeq = PySequence_Fast(parentsObj, "Parents have to be a sequence of integers.");
+    if (!parentsSeq)
+        return -1;
+
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(parentsSeq);
+    const Py_ssize_t allocCount = count > 0 ? count : 1;
+    int32_t *parents = PyMem_Malloc(sizeof(int32_t) * allocCount);
+    int32_t *subtreeEnds = PyMem_Malloc(sizeof(int32_t) * allocCount);
+    vec3 *translations = PyMem_Malloc(sizeof(vec3) * allocCount);
+    vec3 *scales = PyMem_Malloc(sizeof(vec3) * allocCount);
+    uint8_t *dirty = PyMem_Malloc(allocCount);
+    versor *rotations = utils_aligned_malloc(sizeof(versor) * allocCount, _ROTATIONS_ALIGNMENT);
+    mat4 *worldMatrices = utils_aligned_malloc(sizeof(mat4) * allocCount, MATRIX_ARRAY_ALIGNMENT);
+    if (!parents || !subtreeEnds || !translations || !scales || !dirty || !rotations || !worldMatrices)
+    {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    THROW_IF_GOTO(count > INT32_MAX, PyExc_ValueError, "Too many nodes.", fail);
+
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        const long parent = PyLong_AsLong(PySequence_Fast_GET_ITEM(parentsSeq, i));
+        if (parent == -1 && PyErr_Occurred())
+            goto fail;
+
+        if (parent < -1 || parent >= i)
+        {
+            PyErr_Format(PyExc_ValueError, "Parent of node %zd has to be -1 or index of one of preceding nodes, got: %ld.", i, parent);
+            goto fail;
+        }
+
+        parents[i] = (int32_t)parent;
+        subtreeEnds[i] = (int32_t)i;
+        glm_vec3_zero(translations[i]);
+        glm_vec3_one(scales[i]);
+        glm_quat_identity(rotations[i]);
+        glm_mat4_identity(worldMatrices[i]);
+    }
+
+    for (Py_ssize_t i = count - 1; i >= 0; i--)
+    {
+        const int32_t parent = parents[i];
+        if (parent >= 0 && subtreeEnds[i] > subtreeEnds[parent])
+            subtreeEnds[parent] = subtreeEnds[i];
+    }
+
+    memset(dirty, 0, allocCount);
+
+    Py_DECREF(parentsSeq);
+
+    self->count = count;
+    self->shape[0] = count;
+    self->shape[1] = 4;
+    self->shape[2] = 4;
+    self->strides[0] = sizeof(mat4);
+    self->strides[1] = sizeof(vec4);
+    self->strides[2] = sizeof(float);
+    self->parents = parents;
+    self->subtreeEnds = subtreeEnds;
+    self->translations = translations;
+    self->rotations = rotations;
+    self->scales = scales;
+    self->worldMatrices = worldMatrices;
+    self->dirty = dirty;
+    self->dirtyBegin = 0;
+    self->dirtyEnd = 0;
+
+    return 0;
+
+fail:
+    Py_DECREF(parentsSeq);
+    PyMem_Free(parents);
+    PyMem_Free(subtreeEnds);
+    PyMem_Free(translations);
+    PyMem_Free(scales);
+    PyMem_Free(dirty);
+    utils_aligned_free(rotations);
+    utils_aligned_free(worldMatrices);
+    return -1;
+}
+
+static void dealloc(_SELF)
+{
+    PyMem_Free(self->parents);
+    PyMem_Free(self->subtreeEnds);
+    PyMem_Free(self->translations);
+    PyMem_Free(self->scales);
+    PyMem_Free(self->dirty);
+    utils_aligned_free(self->rotations);
+    utils_aligned_free(self->worldMatrices);
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *set_translation(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"index", "translation", NULL};
+
+    PyObject *values[2];
+    Py_ssize_t index = 0;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !check_initialized(self) ||
+        !get_index(self, values[0], &index) ||
+        !utils_check_arg_type(values[1], &pyVector3Type, "translation"))
+        return NULL;
+
+    glm_vec3_copy(((Vector3 *)values[1])->data, self->translations[index]);
+    mark_dirty(self, index);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_rotation(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"index", "rotation", NULL};
+
+    PyObject *values[2];
+    Py_ssize_t index = 0;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !check_initialized(self) ||
+        !get_index(self, values[0], &index) ||
+        !utils_check_arg_type(values[1], &pyQuaternionType, "rotation"))
+        return NULL;
+
+    glm_quat_copy(((Quaternion *)values[1])->data, self->rotations[index]);
+    mark_dirty(self, index);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_scale(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"index", "scale", NULL};
+
+    PyObject *values[2];
+    Py_ssize_t index = 0;
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !check_initialized(self) ||
+        !get_index(self, values[0], &index) ||
+        !utils_check_arg_type(values[1], &pyVector3Type, "scale"))
+        return NULL;
+
+    glm_vec3_copy(((Vector3 *)values[1])->data, self->scales[index]);
+    mark_dirty(self, index);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_transforms(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"indices", "translations", "rotations", "scales", NULL};
+
+    PyObject *values[4];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values) ||
+        !check_initialized(self))
+        return NULL;
+
+    PyObject *result = NULL;
+    Py_buffer indices = {0};
+    Py_buffer translations = {0};
+    Py_buffer rotations = {0};
+    Py_buffer scales = {0};
+
+    // if indices are None, values are assigned to the first nodes of the tree
+    Py_ssize_t count = -1;
+    if (values[0] != Py_None)
+    {
+        if (PyObject_GetBuffer(values[0], &indices, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1)
+            return NULL;
+
+        THROW_IF_GOTO(
+            indices.itemsize != sizeof(uint32_t) || strchr("Ii", indices.format[0]) == NULL,
+            PyExc_TypeError,
+            "Indices have to be a buffer of 32-bit integers.",
+            end);
+
+        count = indices.len / sizeof(uint32_t);
+    }
+
+    if (!get_node_values(values[1], 3, "translations", &translations, &count) ||
+        !get_node_values(values[2], 4, "rotations", &rotations, &count) ||
+        !get_node_values(values[3], 3, "scales", &scales, &count))
+        goto end;
+
+    if (count < 0)
+        count = 0;
+
+    THROW_IF_GOTO(indices.obj == NULL && count > self->count, PyExc_ValueError, "Got more values than there are nodes in the tree.", end);
+
+    const uint32_t *indexData = indices.buf;
+    for (Py_ssize_t i = 0; indexData != NULL && i < count; i++)
+    {
+        if (indexData[i] >= (uint32_t)self->count)
+        {
+            PyErr_Format(PyExc_IndexError, "Node index %u out of range [0, %zd).", indexData[i], self->count);
+            goto end;
+        }
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        const Py_ssize_t index = indexData != NULL ? (Py_ssize_t)indexData[i] : i;
+        if (translations.obj != NULL)
+            memcpy(self->translations[index], (float *)translations.buf + i * 3, sizeof(vec3));
+        if (rotations.obj != NULL)
+            memcpy(self->rotations[index], (float *)rotations.buf + i * 4, sizeof(versor));
+        if (scales.obj != NULL)
+            memcpy(self->scales[index], (float *)scales.buf + i * 3, sizeof(vec3));
+
+        mark_dirty(self, index);
+    }
+
+    result = Py_NewRef(Py_None);
+
+end:
+    if (indices.obj != NULL)
+        PyBuffer_Release(&indices);
+    if (translations.obj != NULL)
+        PyBuffer_Release(&translations);
+    if (rotations.obj != NULL)
+        PyBuffer_Release(&rotations);
+    if (scales.obj != NULL)
+        PyBuffer_Release(&scales);
+
+    return result;
+}
+
+// Recomputes world matrices of all nodes which local transform or any ancestor changed since last update.
+// Only nodes between the first changed node and the end of the last changed subtree are visited.
+static PyObject *update(_SELF, PyObject *Py_UNUSED(args))
+{
+    if (!check_initialized(self))
+        return NULL;
+
+    const Py_ssize_t begin = self->dirtyBegin;
+    const Py_ssize_t end = self->dirtyEnd;
+    if (begin >= end)
+        return Py_BuildValue("(nn)", (Py_ssize_t)0, (Py_ssize_t)0);
+
+    uint8_t *dirty = self->dirty;
+    for (Py_ssize_t i = begin; i < end; i++)
+    {
+        // parents before `begin` are never dirty, so their world matrices are up to date
+        const int32_t parent = self->parents[i];
+        if (!dirty[i] && (parent < 0 || !dirty[parent]))
+            continue;
+
+        dirty[i] = 1;
+
+        mat4 local;
+        matrix4_compose_trs(self->translations[i], self->rotations[i], self->scales[i], local);
+        if (parent < 0)
+            glm_mat4_copy(local, self->worldMatrices[i]);
+        else
+            glm_mat4_mul(self->worldMatrices[parent], local, self->worldMatrices[i]);
+    }
+
+    memset(dirty + begin, 0, end - begin);
+    self->dirtyBegin = 0;
+    self->dirtyEnd = 0;
+
+    return Py_BuildValue("(nn)", begin, end);
+}
+
+static PyObject *get_local(_SELF, PyObject *arg)
+{
+    Py_ssize_t index = 0;
+    if (!check_initialized(self) || !get_index(self, arg, &index))
+        return NULL;
+
+    Matrix4 *result = py_matrix4_new();
+    if (!result)
+        return NULL;
+
+    matrix4_compose_trs(self->translations[index], self->rotations[index], self->scales[index], result->data);
+    result->kind = MATRIX_KIND_AFFINE;
+
+    return (PyObject *)result;
+}
+
+static PyObject *get_world(_SELF, PyObject *arg)
+{
+    Py_ssize_t index = 0;
+    if (!check_initialized(self) || !get_index(self, arg, &index))
+        return NULL;
+
+    Matrix4 *result = py_matrix4_new();
+    if (!result)
+        return NULL;
+
+    glm_mat4_copy(self->worldMatrices[index], result->data);
+    result->kind = MATRIX_KIND_AFFINE;
+
+    return (PyObject *)result;
+}
+
+static PyObject *parents_get(_SELF, void *Py_UNUSED(closure))
+{
+    PyObject *result = PyTuple_New(self->count);
+    if (!result)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->count; i++)
+    {
+        PyObject *parent = PyLong_FromLong(self->parents[i]);
+        if (!parent)
+        {
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        PyTuple_SET_ITEM(result, i, parent);
+    }
+
+    return result;
+}
+
+static PyObject *is_dirty_get(_SELF, void *Py_UNUSED(closure))
+{
+    return PyBool_FromLong(self->dirtyBegin < self->dirtyEnd);
+}
+
+static Py_ssize_t len(_SELF)
+{
+    return self->count;
+}
+
+// Exposes world matrices as read-only (count, 4, 4) float buffer, so they can be uploaded with a single `Buffer.store`.
+static int get_buffer(_SELF, Py_buffer *buffer, int flags)
+{
+    if (!check_initialized(self))
+    {
+        buffer->obj = NULL;
+        return -1;
+    }
+
+    if (PyBuffer_FillInfo(buffer, (PyObject *)self, self->worldMatrices, self->count * sizeof(mat4), 1, flags) == -1)
+        return -1;
+
+    if (FLAG_IS_SET(flags, PyBUF_ND))
+    {
+        buffer->itemsize = sizeof(float);
+        buffer->ndim = 3;
+        buffer->shape = self->shape;
+
+        if (FLAG_IS_SET(flags, PyBUF_FORMAT))
+            buffer->format = "f";
+
+        if (FLAG_IS_SET(flags, PyBUF_STRIDES))
+            buffer->strides = self->strides;
+    }
+
+    return 0;
+}
+
+PyTypeObject pyTransformTreeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_name = "pygl.math.TransformTree",
+    .tp_basicsize = sizeof(TransformTree),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_members = (PyMemberDef[]){
+        {"count", Py_T_PYSSIZET, offsetof(TransformTree, count), Py_READONLY, NULL},
+        {0},
+    },
+    .tp_getset = (PyGetSetDef[]){
+        {"parents", (getter)parents_get, NULL, NULL, NULL},
+        {"is_dirty", (getter)is_dirty_get, NULL, NULL, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"set_translation", (PyCFunction)set_translation, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"set_rotation", (PyCFunction)set_rotation, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"set_scale", (PyCFunction)set_scale, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"set_transforms", (PyCFunction)set_transforms, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"update", (PyCFunction)update, METH_NOARGS, NULL},
+        {"get_local", (PyCFunction)get_local, METH_O, NULL},
+        {"get_world", (PyCFunction)get_world, METH_O, NULL},
+        {0},
+    },
+    .tp_as_sequence = &(PySequenceMethods){
+        .sq_length = (lenfunc)len,
+    },
+    .tp_as_buffer = &(PyBufferProcs){
+        .bf_getbuffer = (getbufferproc)get_buffer,
+    },
+};
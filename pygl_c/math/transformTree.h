@@ -0,0 +1,27 @@
+#pragma once
+#include <stdint.h>
+#include <Python.h>
+#include <cglm/types.h>
+
+typedef struct
+{
+    PyObject_HEAD
+    Py_ssize_t count;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+    // parent of every node is stored before it, roots have parent -1
+    int32_t *parents;
+    // highest index of a node in subtree of every node, used to bound update range
+    int32_t *subtreeEnds;
+    vec3 *translations;
+    versor *rotations;
+    vec3 *scales;
+    mat4 *worldMatrices;
+    // non-zero for nodes which local transform changed since last update
+    uint8_t *dirty;
+    // range of nodes that have to be visited during next update, empty if dirtyBegin >= dirtyEnd
+    Py_ssize_t dirtyBegin;
+    Py_ssize_t dirtyEnd;
+} TransformTree;
+
+extern PyTypeObject pyTransformTreeType;
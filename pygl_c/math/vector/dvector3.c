@@ -0,0 +1,6 @@
+#define VEC_LEN 3
+#define VEC_DOUBLE
+#define FORMAT_STRING "x: %f, y: %f, z: %f"
+#define FORMAT_DATA self->data[0], self->data[1], self->data[2]
+
+#include "vector_template.h"
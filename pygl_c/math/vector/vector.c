@@ -3,14 +3,26 @@
 
 bool py_vector_is_vector(PyObject *obj)
 {
-    return PyObject_IsInstance(obj, (PyObject *)&pyVector2Type) ||
-           PyObject_IsInstance(obj, (PyObject *)&pyVector3Type) ||
-           PyObject_IsInstance(obj, (PyObject *)&pyVector4Type);
+    return Py_IS_TYPE(obj, &pyVector2Type) ||
+           Py_IS_TYPE(obj, &pyVector3Type) ||
+           Py_IS_TYPE(obj, &pyVector4Type);
 }
 
 void py_vector_copy(void *dst, const Vector *vector)
 {
-    memcpy(dst, (char *)vector + sizeof(Vector), py_vector_size(vector));
+    // data of vec4 is padded to 16 byte boundary, so its offset can't be derived from size of the header
+    switch (vector->length)
+    {
+    case 2:
+        memcpy(dst, ((const Vector2 *)vector)->data, sizeof(vec2));
+        break;
+    case 3:
+        memcpy(dst, ((const Vector3 *)vector)->data, sizeof(vec3));
+        break;
+    case 4:
+        memcpy(dst, ((const Vector4 *)vector)->data, sizeof(vec4));
+        break;
+    }
 }
 
 uint8_t py_vector_size(const Vector *vector)
@@ -5,6 +5,7 @@
 #include <cglm/vec2.h>
 #include <cglm/vec3.h>
 #include <cglm/vec4.h>
+#include "../dmath.h"
 
 #pragma pack(push, 1)
 typedef struct
@@ -35,9 +36,40 @@ typedef struct
     vec4 data;
 } Vector4;
 
+typedef struct
+{
+    PyObject_HEAD
+        size_t length;
+    dvec2 data;
+} DVector2;
+
+typedef struct
+{
+    PyObject_HEAD
+        size_t length;
+    dvec3 data;
+} DVector3;
+
+typedef struct
+{
+    PyObject_HEAD
+        size_t length;
+    dvec4 data;
+} DVector4;
+
 extern PyTypeObject pyVector2Type;
 extern PyTypeObject pyVector3Type;
 extern PyTypeObject pyVector4Type;
+extern PyTypeObject pyDVector2Type;
+extern PyTypeObject pyDVector3Type;
+extern PyTypeObject pyDVector4Type;
+
+Vector2 *py_vector2_new(void);
+Vector3 *py_vector3_new(void);
+Vector4 *py_vector4_new(void);
+DVector2 *py_dvector2_new(void);
+DVector3 *py_dvector3_new(void);
+DVector4 *py_dvector4_new(void);
 
 bool py_vector_is_vector(PyObject *obj);
 void py_vector_copy(void *dst, const Vector *vector);
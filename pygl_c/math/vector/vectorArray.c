@@ -0,0 +1,57 @@
+#include "vectorArray.h"
+#include <string.h>
+#include "../../utility.h"
+
+bool py_vector_array_check(PyObject *obj)
+{
+    return Py_IS_TYPE(obj, &pyVector2ArrayType) ||
+           Py_IS_TYPE(obj, &pyVector3ArrayType) ||
+           Py_IS_TYPE(obj, &pyVector4ArrayType);
+}
+
+bool py_vector_array_allocate(VectorArray *array, Py_ssize_t length, Py_ssize_t count)
+{
+    // always allocate at least a single vector so `data` is never NULL for valid arrays
+    float *data = utils_aligned_malloc(sizeof(float) * length * (count > 0 ? count : 1), VECTOR_ARRAY_ALIGNMENT);
+    if (!data)
+    {
+        PyErr_NoMemory();
+        return false;
+    }
+
+    utils_aligned_free(array->data);
+
+    array->data = data;
+    array->length = length;
+    array->count = count;
+    array->shape[0] = count;
+    array->shape[1] = length;
+    array->strides[0] = sizeof(float) * length;
+    array->strides[1] = sizeof(float);
+
+    return true;
+}
+
+VectorArray *py_vector_array_new(PyTypeObject *type, Py_ssize_t count)
+{
+    VectorArray *array = PyObject_New(VectorArray, type);
+    if (!array)
+        return NULL;
+
+    array->data = NULL;
+    array->exports = 0;
+
+    Py_ssize_t length = type == &pyVector2ArrayType ? 2 : (type == &pyVector3ArrayType ? 3 : 4);
+    if (!py_vector_array_allocate(array, length, count))
+    {
+        Py_DECREF(array);
+        return NULL;
+    }
+
+    return array;
+}
+
+Py_ssize_t py_vector_array_size(const VectorArray *array)
+{
+    return array->count * array->length * sizeof(float);
+}
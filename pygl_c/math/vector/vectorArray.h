@@ -0,0 +1,27 @@
+#pragma once
+#include <stdbool.h>
+#include <Python.h>
+#include "vector.h"
+
+// Alignment of vector arrays storage. Big enough to satisfy both SSE and AVX aligned loads.
+#define VECTOR_ARRAY_ALIGNMENT 32
+
+typedef struct
+{
+    PyObject_HEAD
+    Py_ssize_t length;
+    Py_ssize_t count;
+    Py_ssize_t exports;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    float *data;
+} VectorArray;
+
+extern PyTypeObject pyVector2ArrayType;
+extern PyTypeObject pyVector3ArrayType;
+extern PyTypeObject pyVector4ArrayType;
+
+bool py_vector_array_check(PyObject *obj);
+bool py_vector_array_allocate(VectorArray *array, Py_ssize_t length, Py_ssize_t count);
+VectorArray *py_vector_array_new(PyTypeObject *type, Py_ssize_t count);
+Py_ssize_t py_vector_array_size(const VectorArray *array);
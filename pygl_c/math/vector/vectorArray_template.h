@@ -0,0 +1,523 @@
+#pragma once
+
+#ifndef VEC_LEN
+#error "Vector length not defined (VEC_LEN)"
+#endif
+
+#include <string.h>
+#include "vectorArray.h"
+#include "../../utility.h"
+
+#define _PY_TYPE CAT(CAT(pyVector, VEC_LEN), ArrayType)
+#define _VEC_TYPE CAT(Vector, VEC_LEN)
+#define _VEC_PY_TYPE CAT(CAT(pyVector, VEC_LEN), Type)
+#define _SELF VectorArray *self
+#define _GLM_INVOKE(func, ...) CAT(CAT(CAT(glm_vec, VEC_LEN), _), func)(__VA_ARGS__)
+#define _AT(array, idx) ((array)->data + (idx) * VEC_LEN)
+#define _NEW(var, count)                                 \
+    VectorArray *var = py_vector_array_new(&_PY_TYPE, count); \
+    if (!var)                                            \
+    return NULL
+#define _ARRAY_CHECK_COUNT(a, b, ret)                                                                                   \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if ((a)->count != (b)->count)                                                                                   \
+        {                                                                                                               \
+            PyErr_Format(PyExc_ValueError, "Arrays have to be of the same length (%zd != %zd).", (a)->count, (b)->count); \
+            return ret;                                                                                                 \
+        }                                                                                                               \
+    } while (0)
+
+typedef enum
+{
+    ARRAY_OP_ADD,
+    ARRAY_OP_SUB,
+    ARRAY_OP_MUL,
+} ArrayOp;
+
+// All kernels below operate on flat float storage, so that compiler can vectorize them regardless of VEC_LEN.
+static void op_arrays(ArrayOp op, float *dst, const float *a, const float *b, Py_ssize_t n)
+{
+    switch (op)
+    {
+    case ARRAY_OP_ADD:
+        for (Py_ssize_t i = 0; i < n; i++)
+            dst[i] = a[i] + b[i];
+        break;
+    case ARRAY_OP_SUB:
+        for (Py_ssize_t i = 0; i < n; i++)
+            dst[i] = a[i] - b[i];
+        break;
+    case ARRAY_OP_MUL:
+        for (Py_ssize_t i = 0; i < n; i++)
+            dst[i] = a[i] * b[i];
+        break;
+    }
+}
+
+static void op_vector(ArrayOp op, float *dst, const float *a, const float *v, Py_ssize_t count, bool vectorFirst)
+{
+    switch (op)
+    {
+    case ARRAY_OP_ADD:
+        for (Py_ssize_t i = 0; i < count; i++)
+            for (Py_ssize_t k = 0; k < VEC_LEN; k++)
+                dst[i * VEC_LEN + k] = a[i * VEC_LEN + k] + v[k];
+        break;
+    case ARRAY_OP_SUB:
+        if (vectorFirst)
+        {
+            for (Py_ssize_t i = 0; i < count; i++)
+                for (Py_ssize_t k = 0; k < VEC_LEN; k++)
+                    dst[i * VEC_LEN + k] = v[k] - a[i * VEC_LEN + k];
+        }
+        else
+        {
+            for (Py_ssize_t i = 0; i < count; i++)
+                for (Py_ssize_t k = 0; k < VEC_LEN; k++)
+                    dst[i * VEC_LEN + k] = a[i * VEC_LEN + k] - v[k];
+        }
+        break;
+    case ARRAY_OP_MUL:
+        for (Py_ssize_t i = 0; i < count; i++)
+            for (Py_ssize_t k = 0; k < VEC_LEN; k++)
+                dst[i * VEC_LEN + k] = a[i * VEC_LEN + k] * v[k];
+        break;
+    }
+}
+
+static void op_scale(float *dst, const float *a, float scale, Py_ssize_t n)
+{
+    for (Py_ssize_t i = 0; i < n; i++)
+        dst[i] = a[i] * scale;
+}
+
+static PyObject *binary_op(PyObject *left, PyObject *right, ArrayOp op, bool inplace)
+{
+    const bool arrayFirst = Py_IS_TYPE(left, &_PY_TYPE);
+    VectorArray *array = (VectorArray *)(arrayFirst ? left : right);
+    PyObject *other = arrayFirst ? right : left;
+    const Py_ssize_t n = array->count * VEC_LEN;
+
+    VectorArray *result = NULL;
+    if (Py_IS_TYPE(other, &_PY_TYPE))
+    {
+        _ARRAY_CHECK_COUNT(array, (VectorArray *)other, NULL);
+
+        if (inplace)
+            result = (VectorArray *)Py_NewRef(array);
+        else if (!(result = py_vector_array_new(&_PY_TYPE, array->count)))
+            return NULL;
+
+        op_arrays(op, result->data, ((VectorArray *)left)->data, ((VectorArray *)right)->data, n);
+    }
+    else if (Py_IS_TYPE(other, &_VEC_PY_TYPE))
+    {
+        if (inplace)
+            result = (VectorArray *)Py_NewRef(array);
+        else if (!(result = py_vector_array_new(&_PY_TYPE, array->count)))
+            return NULL;
+
+        op_vector(op, result->data, array->data, ((_VEC_TYPE *)other)->data, array->count, !arrayFirst);
+    }
+    else if (op == ARRAY_OP_MUL && (PyFloat_Check(other) || PyLong_Check(other)))
+    {
+        float scale = (float)PyFloat_AsDouble(other);
+        if (PyErr_Occurred())
+            return NULL;
+
+        if (inplace)
+            result = (VectorArray *)Py_NewRef(array);
+        else if (!(result = py_vector_array_new(&_PY_TYPE, array->count)))
+            return NULL;
+
+        op_scale(result->data, array->data, scale, n);
+    }
+    else
+    {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    return (PyObject *)result;
+}
+
+// Returns pointer to the second operand data and its stride in floats (0 for single vector broadcast)
+static const float *get_operand(_SELF, PyObject *other, Py_ssize_t *stride)
+{
+    if (Py_IS_TYPE(other, &_PY_TYPE))
+    {
+        _ARRAY_CHECK_COUNT(self, (VectorArray *)other, NULL);
+
+        *stride = VEC_LEN;
+        return ((VectorArray *)other)->data;
+    }
+    else if (Py_IS_TYPE(other, &_VEC_PY_TYPE))
+    {
+        *stride = 0;
+        return ((_VEC_TYPE *)other)->data;
+    }
+
+    PyErr_Format(
+        PyExc_TypeError,
+        "Expected argument to be of type pygl.math.Vector" STRINGIFY(VEC_LEN) "Array or pygl.math.Vector" STRINGIFY(VEC_LEN) ", got: %s.",
+        Py_TYPE(other)->tp_name);
+    return NULL;
+}
+
+static int init(_SELF, PyObject *args, PyObject *Py_UNUSED(kwargs))
+{
+    PyObject *arg = NULL;
+    if (!PyArg_ParseTuple(args, "O", &arg))
+        return -1;
+
+    if (self->exports > 0)
+    {
+        PyErr_SetString(PyExc_BufferError, "Cannot reinitialize array while its buffer is exported.");
+        return -1;
+    }
+
+    if (PyLong_Check(arg)) // Vector*Array.__init__(int)
+    {
+        Py_ssize_t count = PyLong_AsSsize_t(arg);
+        if (count < 0)
+        {
+            if (!PyErr_Occurred())
+                PyErr_SetString(PyExc_ValueError, "Array length cannot be negative.");
+            return -1;
+        }
+
+        if (!py_vector_array_allocate(self, VEC_LEN, count))
+            return -1;
+
+        memset(self->data, 0, py_vector_array_size(self));
+    }
+    else if (PyObject_CheckBuffer(arg)) // Vector*Array.__init__(Buffer)
+    {
+        Py_buffer buf;
+        Py_ssize_t count;
+        if (!utils_get_float_buffer(arg, VEC_LEN, &buf, &count))
+            return -1;
+
+        if (!py_vector_array_allocate(self, VEC_LEN, count))
+        {
+            PyBuffer_Release(&buf);
+            return -1;
+        }
+
+        memcpy(self->data, buf.buf, buf.len);
+        PyBuffer_Release(&buf);
+    }
+    else // Vector*Array.__init__(Sequence[Vector*])
+    {
+        PyObject *seq = PySequence_Fast(arg, "Expected argument to be of type int, support buffer protocol or be a sequence of pygl.math.Vector" STRINGIFY(VEC_LEN) ".");
+        if (!seq)
+            return -1;
+
+        Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+        if (!py_vector_array_allocate(self, VEC_LEN, count))
+        {
+            Py_DECREF(seq);
+            return -1;
+        }
+
+        PyObject **items = PySequence_Fast_ITEMS(seq);
+        for (Py_ssize_t i = 0; i < count; i++)
+        {
+            if (!Py_IS_TYPE(items[i], &_VEC_PY_TYPE))
+            {
+                PyErr_Format(
+                    PyExc_TypeError,
+                    "Expected all items to be of type pygl.math.Vector" STRINGIFY(VEC_LEN) ", got %s at index %zd.",
+                    Py_TYPE(items[i])->tp_name,
+                    i);
+                Py_DECREF(seq);
+                return -1;
+            }
+
+            memcpy(_AT(self, i), ((_VEC_TYPE *)items[i])->data, sizeof(float) * VEC_LEN);
+        }
+
+        Py_DECREF(seq);
+    }
+
+    return 0;
+}
+
+static void dealloc(_SELF)
+{
+    utils_aligned_free(self->data);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *repr(_SELF)
+{
+    return PyUnicode_FromFormat(
+        "<%s object at %p (count: %zd)>",
+        Py_TYPE(self)->tp_name,
+        self,
+        self->count);
+}
+
+static PyObject *normalize(_SELF, PyObject *Py_UNUSED(args))
+{
+    for (Py_ssize_t i = 0; i < self->count; i++)
+        _GLM_INVOKE(normalize, _AT(self, i));
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *normalized(_SELF, PyObject *Py_UNUSED(args))
+{
+    _NEW(result, self->count);
+    for (Py_ssize_t i = 0; i < self->count; i++)
+        _GLM_INVOKE(normalize_to, _AT(self, i), _AT(result, i));
+
+    return (PyObject *)result;
+}
+
+static PyObject *lengths(_SELF, PyObject *Py_UNUSED(args))
+{
+    float *out;
+    PyObject *result = utils_new_typed_view(self->count, "f", sizeof(float), (void **)&out);
+    if (!result)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->count; i++)
+        out[i] = _GLM_INVOKE(norm, _AT(self, i));
+
+    return result;
+}
+
+static PyObject *dot(_SELF, PyObject *other)
+{
+    Py_ssize_t stride;
+    const float *otherData = get_operand(self, other, &stride);
+    if (!otherData)
+        return NULL;
+
+    float *out;
+    PyObject *result = utils_new_typed_view(self->count, "f", sizeof(float), (void **)&out);
+    if (!result)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->count; i++)
+    {
+        const float *a = _AT(self, i);
+        const float *b = otherData + i * stride;
+
+        float sum = 0.0f;
+        for (Py_ssize_t k = 0; k < VEC_LEN; k++)
+            sum += a[k] * b[k];
+
+        out[i] = sum;
+    }
+
+    return result;
+}
+
+#if VEC_LEN != 4
+static PyObject *cross(_SELF, PyObject *other)
+{
+    Py_ssize_t stride;
+    const float *otherData = get_operand(self, other, &stride);
+    if (!otherData)
+        return NULL;
+
+#if VEC_LEN == 2
+    float *out;
+    PyObject *result = utils_new_typed_view(self->count, "f", sizeof(float), (void **)&out);
+    if (!result)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < self->count; i++)
+        out[i] = glm_vec2_cross(_AT(self, i), otherData + i * stride);
+
+    return result;
+#else
+    _NEW(result, self->count);
+    for (Py_ssize_t i = 0; i < self->count; i++)
+        glm_vec3_cross(_AT(self, i), otherData + i * stride, _AT(result, i));
+
+    return (PyObject *)result;
+#endif
+}
+#endif
+
+static PyObject *interpolate(_SELF, PyObject *args)
+{
+    PyObject *other = NULL;
+    float factor = 0.0f;
+    if (!PyArg_ParseTuple(args, "Of", &other, &factor))
+        return NULL;
+
+    if (factor < 0.0 || factor > 1.0)
+    {
+        PyErr_SetString(PyExc_ValueError, "Factor must be in range [0.0, 1.0].");
+        return NULL;
+    }
+
+    Py_ssize_t stride;
+    const float *otherData = get_operand(self, other, &stride);
+    if (!otherData)
+        return NULL;
+
+    _NEW(result, self->count);
+    for (Py_ssize_t i = 0; i < self->count; i++)
+        for (Py_ssize_t k = 0; k < VEC_LEN; k++)
+        {
+            const float a = self->data[i * VEC_LEN + k];
+            result->data[i * VEC_LEN + k] = a + factor * (otherData[i * stride + k] - a);
+        }
+
+    return (PyObject *)result;
+}
+
+static Py_ssize_t len(_SELF)
+{
+    return self->count;
+}
+
+static PyObject *item(_SELF, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->count)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range.");
+        return NULL;
+    }
+
+    _VEC_TYPE *result = CAT(CAT(py_vector, VEC_LEN), _new)();
+    if (!result)
+        return NULL;
+
+    memcpy(result->data, _AT(self, index), sizeof(float) * VEC_LEN);
+
+    return (PyObject *)result;
+}
+
+static int assign_item(_SELF, Py_ssize_t index, PyObject *value)
+{
+    if (index < 0 || index >= self->count)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range.");
+        return -1;
+    }
+
+    if (value == NULL || !Py_IS_TYPE(value, &_VEC_PY_TYPE))
+    {
+        PyErr_SetString(PyExc_TypeError, "Expected value to be of type pygl.math.Vector" STRINGIFY(VEC_LEN) ".");
+        return -1;
+    }
+
+    memcpy(_AT(self, index), ((_VEC_TYPE *)value)->data, sizeof(float) * VEC_LEN);
+
+    return 0;
+}
+
+static PyObject *add(PyObject *left, PyObject *right)
+{
+    return binary_op(left, right, ARRAY_OP_ADD, false);
+}
+
+static PyObject *iadd(PyObject *self, PyObject *other)
+{
+    return binary_op(self, other, ARRAY_OP_ADD, true);
+}
+
+static PyObject *sub(PyObject *left, PyObject *right)
+{
+    return binary_op(left, right, ARRAY_OP_SUB, false);
+}
+
+static PyObject *isub(PyObject *self, PyObject *other)
+{
+    return binary_op(self, other, ARRAY_OP_SUB, true);
+}
+
+static PyObject *mult(PyObject *left, PyObject *right)
+{
+    return binary_op(left, right, ARRAY_OP_MUL, false);
+}
+
+static PyObject *imult(PyObject *self, PyObject *other)
+{
+    return binary_op(self, other, ARRAY_OP_MUL, true);
+}
+
+static PyObject *negative(_SELF)
+{
+    _NEW(result, self->count);
+    op_scale(result->data, self->data, -1.0f, self->count * VEC_LEN);
+
+    return (PyObject *)result;
+}
+
+static int get_buffer(_SELF, Py_buffer *buffer, int flags)
+{
+    if (PyBuffer_FillInfo(buffer, (PyObject *)self, self->data, py_vector_array_size(self), 0, flags) == -1)
+        return -1;
+
+    // without format consumer assumes unsigned bytes, so only flat byte view filled above is consistent then
+    if (FLAG_IS_SET(flags, PyBUF_ND | PyBUF_FORMAT))
+    {
+        buffer->itemsize = sizeof(float);
+        buffer->ndim = 2;
+        buffer->shape = self->shape;
+        buffer->format = "f";
+
+        if (FLAG_IS_SET(flags, PyBUF_STRIDES))
+            buffer->strides = self->strides;
+    }
+
+    self->exports++;
+
+    return 0;
+}
+
+static void release_buffer(_SELF, Py_buffer *Py_UNUSED(buffer))
+{
+    self->exports--;
+}
+
+PyTypeObject _PY_TYPE = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_new = PyType_GenericNew,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_name = "pygl.math.Vector" STRINGIFY(VEC_LEN) "Array",
+    .tp_basicsize = sizeof(VectorArray),
+    .tp_init = (initproc)init,
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_members = (PyMemberDef[]){
+        {"count", T_PYSSIZET, offsetof(VectorArray, count), READONLY, NULL},
+        {0},
+    },
+    .tp_methods = (PyMethodDef[]){
+        {"normalize", (PyCFunction)normalize, METH_NOARGS, NULL},
+        {"normalized", (PyCFunction)normalized, METH_NOARGS, NULL},
+        {"lengths", (PyCFunction)lengths, METH_NOARGS, NULL},
+        {"dot", (PyCFunction)dot, METH_O, NULL},
+#if VEC_LEN != 4
+        {"cross", (PyCFunction)cross, METH_O, NULL},
+#endif
+        {"interpolate", (PyCFunction)interpolate, METH_VARARGS, NULL},
+        {0},
+    },
+    .tp_as_sequence = &(PySequenceMethods){
+        .sq_length = (lenfunc)len,
+        .sq_item = (ssizeargfunc)item,
+        .sq_ass_item = (ssizeobjargproc)assign_item,
+    },
+    .tp_as_number = &(PyNumberMethods){
+        .nb_add = (binaryfunc)add,
+        .nb_inplace_add = (binaryfunc)iadd,
+        .nb_subtract = (binaryfunc)sub,
+        .nb_inplace_subtract = (binaryfunc)isub,
+        .nb_multiply = (binaryfunc)mult,
+        .nb_inplace_multiply = (binaryfunc)imult,
+        .nb_negative = (unaryfunc)negative,
+    },
+    .tp_as_buffer = &(PyBufferProcs){
+        .bf_getbuffer = (getbufferproc)get_buffer,
+        .bf_releasebuffer = (releasebufferproc)release_buffer,
+    },
+};
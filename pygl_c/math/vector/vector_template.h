@@ -5,26 +5,49 @@
 #endif
 
 #include "vector.h"
+#include "../freeList.h"
 #include "../../utility.h"
 
+// VEC_DOUBLE selects double precision variant (DVector*) built on top of dmath.h routines
+#ifdef VEC_DOUBLE
+#define _TYPE CAT(DVector, VEC_LEN)
+#define _PY_TYPE CAT(CAT(pyDVector, VEC_LEN), Type)
+#define _GLM_TYPE CAT(dvec, VEC_LEN)
+#define _NEW_FUNC CAT(CAT(py_dvector, VEC_LEN), _new)
+#define _FREE_LIST (&mathFreeLists[CAT(FREE_LIST_DVECTOR, VEC_LEN)])
+#define _GLM_PREFIX dglm_vec
+#define _SCALAR double
+#define _SCALAR_FORMAT "d"
+#define _SCALAR_MEMBER T_DOUBLE
+#define _FMOD fmod
+#else
 #define _TYPE CAT(Vector, VEC_LEN)
 #define _PY_TYPE CAT(CAT(pyVector, VEC_LEN), Type)
 #define _GLM_TYPE CAT(vec, VEC_LEN)
+#define _NEW_FUNC CAT(CAT(py_vector, VEC_LEN), _new)
+#define _FREE_LIST (&mathFreeLists[CAT(FREE_LIST_VECTOR, VEC_LEN)])
+#define _GLM_PREFIX glm_vec
+#define _SCALAR float
+#define _SCALAR_FORMAT "f"
+#define _SCALAR_MEMBER T_FLOAT
+#define _FMOD fmodf
+#endif
 #define _SELF _TYPE *self
-#define _NEW(var)                                \
-    _TYPE *var = PyObject_New(_TYPE, &_PY_TYPE); \
-    var->length = VEC_LEN
-#define _GLM_INVOKE(func, ...) CAT(CAT(CAT(glm_vec, VEC_LEN), _), func)(__VA_ARGS__)
+#define _NEW(var)            \
+    _TYPE *var = _NEW_FUNC(); \
+    if (!var)                \
+    return NULL
+#define _GLM_INVOKE(func, ...) CAT(CAT(CAT(_GLM_PREFIX, VEC_LEN), _), func)(__VA_ARGS__)
 #define _VEC_CHECK(o)                                                                                                                              \
     do                                                                                                                                             \
     {                                                                                                                                              \
-        if (!PyObject_IsInstance((PyObject *)o, (PyObject *)&_PY_TYPE))                                                                            \
+        if (!Py_IS_TYPE((PyObject *)o, &_PY_TYPE))                                                                                                 \
         {                                                                                                                                          \
-            PyErr_Format(PyExc_TypeError, "Excepted argument to be of type pygl.math.Vector" STRINGIFY(VEC_LEN) " got: %s.", Py_TYPE(o)->tp_name); \
+            PyErr_Format(PyExc_TypeError, "Excepted argument to be of type pygl.math." STRINGIFY(_TYPE) " got: %s.", Py_TYPE(o)->tp_name); \
             return NULL;                                                                                                                           \
         }                                                                                                                                          \
     } while (0)
-#define _VEC_DATA_OFFSET(s, n) offsetof(s, data) + sizeof(float) * n
+#define _VEC_DATA_OFFSET(s, n) offsetof(s, data) + sizeof(_SCALAR) * n
 #define _VEC_CHECK_IDX(idx, len, ret)                                 \
     do                                                                \
     {                                                                 \
@@ -37,49 +60,85 @@
 #define _VEC_OP_CHECK_TYPE(obj)                                           \
     do                                                                    \
     {                                                                     \
-        if (!PyObject_IsInstance((PyObject *)obj, (PyObject *)&_PY_TYPE)) \
-            return (_TYPE *)Py_NotImplemented;                            \
+        if (!Py_IS_TYPE((PyObject *)obj, &_PY_TYPE))                      \
+            return (_TYPE *)Py_NewRef(Py_NotImplemented);                 \
     } while (0)
 
-static int vec_init(_SELF, PyObject *args, PyObject *_kwargs)
+_TYPE *_NEW_FUNC(void)
+{
+    _TYPE *result = (_TYPE *)free_list_alloc(_FREE_LIST);
+    if (result != NULL)
+        result->length = VEC_LEN;
+
+    return result;
+}
+
+static void vec_dealloc(_SELF)
+{
+    free_list_dealloc(_FREE_LIST, (PyObject *)self);
+}
+
+static bool vec_set_values(_SELF, PyObject *const *args, Py_ssize_t argsLen)
 {
-    size_t argsLen = PyTuple_GET_SIZE(args);
     if (argsLen == 1)
     {
-        PyObject *value = PyTuple_GET_ITEM(args, 0);
+        PyObject *value = args[0];
         if (!PyFloat_Check(value))
         {
             PyErr_Format(PyExc_TypeError, "Expected arugment to be of type float, got: %s.", Py_TYPE(value)->tp_name);
-            return -1;
+            return false;
         }
 
-        float floatValue = (float)PyFloat_AS_DOUBLE(value);
+        _SCALAR scalarValue = (_SCALAR)PyFloat_AS_DOUBLE(value);
         for (size_t i = 0; i < VEC_LEN; i++)
-            self->data[i] = floatValue;
+            self->data[i] = scalarValue;
     }
     else if (argsLen == VEC_LEN)
     {
-        for (size_t i = 0; i < argsLen; i++)
+        for (Py_ssize_t i = 0; i < argsLen; i++)
         {
-            PyObject *value = PyTuple_GET_ITEM(args, i);
+            PyObject *value = args[i];
             if (!PyFloat_Check(value))
             {
-                PyErr_Format(PyExc_TypeError, "Expected arguments to be of type float but argument %d has type %s.", i + 1, Py_TYPE(value)->tp_name);
-                return -1;
+                PyErr_Format(PyExc_TypeError, "Expected arguments to be of type float but argument %zd has type %s.", i + 1, Py_TYPE(value)->tp_name);
+                return false;
             }
 
-            self->data[i] = (float)PyFloat_AS_DOUBLE(value);
+            self->data[i] = (_SCALAR)PyFloat_AS_DOUBLE(value);
         }
     }
     else
     {
         PyErr_Format(PyExc_TypeError, "Expected argument to be either single float value or %d float values.", VEC_LEN);
-        return -1;
+        return false;
     }
 
     self->length = VEC_LEN;
 
-    return 0;
+    return true;
+}
+
+static int vec_init(_SELF, PyObject *args, PyObject *_kwargs)
+{
+    return vec_set_values(self, &PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args)) ? 0 : -1;
+}
+
+static PyObject *vec_vectorcall(PyTypeObject *Py_UNUSED(type), PyObject *const *args, size_t nargsf, PyObject *kwnames)
+{
+    THROW_IF(
+        kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0,
+        PyExc_TypeError,
+        "pygl.math." STRINGIFY(_TYPE) " does not take keyword arguments.",
+        NULL);
+
+    _NEW(result);
+    if (!vec_set_values(result, args, PyVectorcall_NARGS(nargsf)))
+    {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
 }
 
 static PyObject *vec_normalize(_SELF, PyObject *_args)
@@ -88,48 +147,119 @@ static PyObject *vec_normalize(_SELF, PyObject *_args)
     Py_RETURN_NONE;
 }
 
-static PyObject *vec_normalized(_SELF, PyObject *_args)
+// Resolves object that receives result of an operation. If `out` is not provided new vector is created,
+// otherwise new reference to `out` is returned, so results can be written without allocating.
+static _TYPE *vec_get_out(PyObject *out)
 {
-    _NEW(result);
+    if (out == NULL || out == Py_None)
+        return _NEW_FUNC();
+
+    if (!utils_check_arg_type(out, &_PY_TYPE, "out"))
+        return NULL;
+
+    return (_TYPE *)Py_NewRef(out);
+}
+
+static PyObject *vec_normalized_impl(_SELF, PyObject *out)
+{
+    _TYPE *result = vec_get_out(out);
+    if (!result)
+        return NULL;
+
     _GLM_INVOKE(normalize_to, self->data, result->data);
 
     return (PyObject *)result;
 }
 
+static PyObject *vec_normalized(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"out", NULL};
+
+    PyObject *values[1];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 0, values))
+        return NULL;
+
+    return vec_normalized_impl(self, values[0]);
+}
+
+static PyObject *vec_normalized_into(_SELF, PyObject *out)
+{
+    if (!utils_check_arg_type(out, &_PY_TYPE, "out"))
+        return NULL;
+
+    return vec_normalized_impl(self, out);
+}
+
 static PyObject *vec_dot(_SELF, _TYPE *other)
 {
     _VEC_CHECK(other);
-    float result = _GLM_INVOKE(dot, self->data, other->data);
+    _SCALAR result = _GLM_INVOKE(dot, self->data, other->data);
     return PyFloat_FromDouble((double)result);
 }
 
+#if VEC_LEN == 2
 static PyObject *vec_cross(_SELF, _TYPE *other)
 {
     _VEC_CHECK(other);
 
-#if VEC_LEN == 2
-    float result = _GLM_INVOKE(cross, self->data, other->data);
+    _SCALAR result = _GLM_INVOKE(cross, self->data, other->data);
     return PyFloat_FromDouble((double)result);
-#else
-    _NEW(result);
-    _GLM_INVOKE(cross, self->data, other->data, result->data);
+}
+#elif VEC_LEN == 3
+static PyObject *vec_cross_impl(_SELF, PyObject *other, PyObject *out)
+{
+    if (!utils_check_arg_type(other, &_PY_TYPE, "other"))
+        return NULL;
+
+    _TYPE *result = vec_get_out(out);
+    if (!result)
+        return NULL;
+
+    // cglm computes cross product into a temporary, so `out` may alias any of the operands
+    _GLM_INVOKE(cross, self->data, ((_TYPE *)other)->data, result->data);
 
     return (PyObject *)result;
-#endif
 }
 
+static PyObject *vec_cross(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "out", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 1, values))
+        return NULL;
+
+    return vec_cross_impl(self, values[0], values[1]);
+}
+
+static PyObject *vec_cross_into(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "out", NULL};
+
+    PyObject *values[2];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values) ||
+        !utils_check_arg_type(values[1], &_PY_TYPE, "out"))
+        return NULL;
+
+    return vec_cross_impl(self, values[0], values[1]);
+}
+#endif
+
 static PyObject *vec_distance(_SELF, _TYPE *other)
 {
     _VEC_CHECK(other);
-    float result = _GLM_INVOKE(distance, self->data, other->data);
+    _SCALAR result = _GLM_INVOKE(distance, self->data, other->data);
     return PyFloat_FromDouble((double)result);
 }
 
-static PyObject *vec_interpolate(_SELF, PyObject *args)
+static PyObject *vec_interpolate_impl(_SELF, PyObject *const *values)
 {
-    _TYPE *other = NULL;
-    float factor = 0.0f;
-    if (!PyArg_ParseTuple(args, "O!f", &_PY_TYPE, &other, &factor))
+    if (!utils_check_arg_type(values[0], &_PY_TYPE, "other"))
+        return NULL;
+
+    _TYPE *other = (_TYPE *)values[0];
+    double factor = PyFloat_AsDouble(values[1]);
+    if (factor == -1.0 && PyErr_Occurred())
         return NULL;
 
     if (factor < 0.0 || factor > 1.0)
@@ -138,30 +268,52 @@ static PyObject *vec_interpolate(_SELF, PyObject *args)
         return NULL;
     }
 
-    _NEW(result);
+    _TYPE *result = vec_get_out(values[2]);
+    if (!result)
+        return NULL;
+
     _GLM_INVOKE(lerp, self->data, other->data, factor, result->data);
 
     return (PyObject *)result;
 }
 
+static PyObject *vec_interpolate(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "factor", "out", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 2, values))
+        return NULL;
+
+    return vec_interpolate_impl(self, values);
+}
+
+static PyObject *vec_interpolate_into(_SELF, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    static const char *const kwNames[] = {"other", "factor", "out", NULL};
+
+    PyObject *values[3];
+    if (!utils_parse_fastcall_args(args, nargs, kwnames, kwNames, 3, values) ||
+        !utils_check_arg_type(values[2], &_PY_TYPE, "out"))
+        return NULL;
+
+    return vec_interpolate_impl(self, values);
+}
+
 static PyObject *vec_one(PyTypeObject *cls, PyObject *_args)
 {
-    _TYPE *result = PyObject_New(_TYPE, cls);
+    _NEW(result);
     for (size_t i = 0; i < VEC_LEN; i++)
         result->data[i] = 1.0f;
 
-    result->length = VEC_LEN;
-
     return (PyObject *)result;
 }
 
 static PyObject *vec_zero(PyTypeObject *cls, PyObject *_args)
 {
-    _TYPE *result = PyObject_New(_TYPE, cls);
+    _NEW(result);
     memset(result->data, 0, sizeof(_GLM_TYPE));
 
-    result->length = VEC_LEN;
-
     return (PyObject *)result;
 }
 
@@ -185,7 +337,7 @@ static int vec_assign_item(_SELF, Py_ssize_t index, PyObject *value)
         return -1;
     }
 
-    self->data[index] = (float)PyFloat_AS_DOUBLE(value);
+    self->data[index] = (_SCALAR)PyFloat_AS_DOUBLE(value);
     return 0;
 }
 
@@ -229,11 +381,11 @@ static _TYPE *vec_mult(_SELF, PyObject *other)
     if (PyFloat_Check(other))
     {
         _NEW(res);
-        _GLM_INVOKE(scale, self->data, (float)PyFloat_AS_DOUBLE(other), res->data);
+        _GLM_INVOKE(scale, self->data, (_SCALAR)PyFloat_AS_DOUBLE(other), res->data);
 
         return res;
     }
-    else if (PyObject_IsInstance(other, (PyObject *)&_PY_TYPE))
+    else if (Py_IS_TYPE(other, &_PY_TYPE))
     {
         _NEW(res);
         _GLM_INVOKE(mul, self->data, ((_TYPE *)other)->data, res->data);
@@ -241,23 +393,23 @@ static _TYPE *vec_mult(_SELF, PyObject *other)
         return res;
     }
 
-    return (_TYPE *)Py_NotImplemented;
+    return (_TYPE *)Py_NewRef(Py_NotImplemented);
 }
 
 static _TYPE *vec_imult(_SELF, PyObject *other)
 {
     if (PyFloat_Check(other))
     {
-        _GLM_INVOKE(scale, self->data, (float)PyFloat_AS_DOUBLE(other), self->data);
+        _GLM_INVOKE(scale, self->data, (_SCALAR)PyFloat_AS_DOUBLE(other), self->data);
         return (_TYPE *)Py_NewRef(self);
     }
-    else if (PyObject_IsInstance(other, (PyObject *)&_PY_TYPE))
+    else if (Py_IS_TYPE(other, &_PY_TYPE))
     {
         _GLM_INVOKE(mul, self->data, ((_TYPE *)other)->data, self->data);
         return (_TYPE *)Py_NewRef(self);
     }
 
-    return (_TYPE *)Py_NotImplemented;
+    return (_TYPE *)Py_NewRef(Py_NotImplemented);
 }
 
 static _TYPE *vec_negative(_SELF, _TYPE *other)
@@ -273,20 +425,20 @@ static _TYPE *vec_remainder(_SELF, _TYPE *other)
 
     if (PyLong_Check(other))
     {
-        float divisor = (float)PyLong_AsDouble((PyObject *)other);
+        _SCALAR divisor = (_SCALAR)PyLong_AsDouble((PyObject *)other);
         for (size_t i = 0; i < VEC_LEN; i++)
-            res->data[i] = fmodf(self->data[i], divisor);
+            res->data[i] = _FMOD(self->data[i], divisor);
     }
     else if (PyFloat_Check(other))
     {
-        float divisor = (float)PyFloat_AS_DOUBLE((PyObject *)other);
+        _SCALAR divisor = (_SCALAR)PyFloat_AS_DOUBLE((PyObject *)other);
         for (size_t i = 0; i < VEC_LEN; i++)
-            res->data[i] = fmodf(self->data[i], divisor);
+            res->data[i] = _FMOD(self->data[i], divisor);
     }
-    else if (PyObject_IsInstance((PyObject *)other, (PyObject *)&_PY_TYPE))
+    else if (Py_IS_TYPE((PyObject *)other, &_PY_TYPE))
     {
         for (size_t i = 0; i < VEC_LEN; i++)
-            res->data[i] = fmodf(self->data[i], other->data[i]);
+            res->data[i] = _FMOD(self->data[i], other->data[i]);
     }
     else
     {
@@ -327,7 +479,7 @@ static bool set_data_at(_SELF, size_t index, PyObject *value)
         return false;
     }
 
-    self->data[index] = (float)PyFloat_AS_DOUBLE(value);
+    self->data[index] = (_SCALAR)PyFloat_AS_DOUBLE(value);
 
     return true;
 }
@@ -374,17 +526,17 @@ static int a_set(_SELF, PyObject *value, void *Py_UNUSED(closure))
 
 static PyObject *vec_richcompare(_SELF, PyObject *other, int op)
 {
-    if (!PyObject_IsInstance(other, (PyObject *)&_PY_TYPE))
+    if (!Py_IS_TYPE(other, &_PY_TYPE))
         Py_RETURN_FALSE;
 
     bool result = false;
     switch (op)
     {
     case Py_EQ:
-        result = _GLM_INVOKE(eqv, self->data, ((Vector2 *)other)->data);
+        result = _GLM_INVOKE(eqv, self->data, ((_TYPE *)other)->data);
         break;
     case Py_NE:
-        result = !_GLM_INVOKE(eqv, self->data, ((Vector2 *)other)->data);
+        result = !_GLM_INVOKE(eqv, self->data, ((_TYPE *)other)->data);
         break;
     default:
         Py_RETURN_NOTIMPLEMENTED;
@@ -393,18 +545,22 @@ static PyObject *vec_richcompare(_SELF, PyObject *other, int op)
     return result ? Py_NewRef(Py_True) : Py_NewRef(Py_False);
 }
 
+// shape and strides have to outlive the exported buffer, so they can't be stored on the stack
+static Py_ssize_t bufferShape[] = {VEC_LEN};
+static Py_ssize_t bufferStrides[] = {sizeof(_SCALAR)};
+
 static int vec_get_buffer(_SELF, Py_buffer *buffer, int flags)
 {
     *buffer = (Py_buffer){
         .obj = Py_NewRef(self),
         .buf = self->data,
-        .len = VEC_LEN * sizeof(float),
-        .itemsize = sizeof(float),
+        .len = VEC_LEN * sizeof(_SCALAR),
+        .itemsize = sizeof(_SCALAR),
         .ndim = 1,
-        .readonly = !(flags & PyBUF_WRITABLE == PyBUF_WRITABLE),
-        .format = (flags & PyBUF_FORMAT == PyBUF_FORMAT) ? "f" : NULL,
-        .shape = (Py_ssize_t[]){VEC_LEN},
-        .strides = (Py_ssize_t[]){sizeof(float)},
+        .readonly = !FLAG_IS_SET(flags, PyBUF_WRITABLE),
+        .format = FLAG_IS_SET(flags, PyBUF_FORMAT) ? _SCALAR_FORMAT : NULL,
+        .shape = bufferShape,
+        .strides = bufferStrides,
     };
 
     return 0;
@@ -448,10 +604,13 @@ static _TYPE *vec_right(PyTypeObject *cls, PyObject *Py_UNUSED(args))
 PyTypeObject _PY_TYPE = {
     PyVarObject_HEAD_INIT(NULL, 0)
         .tp_new = PyType_GenericNew,
+    .tp_alloc = free_list_tp_alloc,
+    .tp_dealloc = (destructor)vec_dealloc,
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_name = "pygl.math." STRINGIFY(_TYPE),
     .tp_basicsize = sizeof(_TYPE),
     .tp_init = (initproc)vec_init,
+    .tp_vectorcall = (vectorcallfunc)vec_vectorcall,
     .tp_repr = (reprfunc)vec_repr,
     .tp_richcompare = (richcmpfunc)vec_richcompare,
     .tp_getset = (PyGetSetDef[]){
@@ -466,25 +625,30 @@ PyTypeObject _PY_TYPE = {
         {0},
     },
     .tp_members = (PyMemberDef[]){
-        {"x", T_FLOAT, _VEC_DATA_OFFSET(_TYPE, 0), 0, NULL},
-        {"y", T_FLOAT, _VEC_DATA_OFFSET(_TYPE, 1), 0, NULL},
+        {"x", _SCALAR_MEMBER, _VEC_DATA_OFFSET(_TYPE, 0), 0, NULL},
+        {"y", _SCALAR_MEMBER, _VEC_DATA_OFFSET(_TYPE, 1), 0, NULL},
 #if VEC_LEN > 2
-        {"z", T_FLOAT, _VEC_DATA_OFFSET(_TYPE, 2), 0, NULL},
+        {"z", _SCALAR_MEMBER, _VEC_DATA_OFFSET(_TYPE, 2), 0, NULL},
 #endif
 #if VEC_LEN > 3
-        {"w", T_FLOAT, _VEC_DATA_OFFSET(_TYPE, 3), 0, NULL},
+        {"w", _SCALAR_MEMBER, _VEC_DATA_OFFSET(_TYPE, 3), 0, NULL},
 #endif
         {0},
     },
     .tp_methods = (PyMethodDef[]){
         {"normalize", (PyCFunction)vec_normalize, METH_NOARGS, NULL},
-        {"normalized", (PyCFunction)vec_normalized, METH_NOARGS, NULL},
+        {"normalized", (PyCFunction)vec_normalized, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"normalized_into", (PyCFunction)vec_normalized_into, METH_O, NULL},
         {"dot", (PyCFunction)vec_dot, METH_O, NULL},
-#if VEC_LEN != 4
+#if VEC_LEN == 2
         {"cross", (PyCFunction)vec_cross, METH_O, NULL},
+#elif VEC_LEN == 3
+        {"cross", (PyCFunction)vec_cross, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"cross_into", (PyCFunction)vec_cross_into, METH_FASTCALL | METH_KEYWORDS, NULL},
 #endif
         {"distance", (PyCFunction)vec_distance, METH_O, NULL},
-        {"interpolate", (PyCFunction)vec_interpolate, METH_VARARGS, NULL},
+        {"interpolate", (PyCFunction)vec_interpolate, METH_FASTCALL | METH_KEYWORDS, NULL},
+        {"interpolate_into", (PyCFunction)vec_interpolate_into, METH_FASTCALL | METH_KEYWORDS, NULL},
         {"zero", (PyCFunction)vec_zero, METH_CLASS | METH_NOARGS, NULL},
         {"one", (PyCFunction)vec_one, METH_CLASS | METH_NOARGS, NULL},
         {"length", (PyCFunction)class_length, METH_CLASS | METH_NOARGS, NULL},
@@ -6,7 +6,6 @@
 #include "sync.h"
 
 #define AUTO_SYNC_TIMEOUT_NS 100
-#define SYNC_SIGNALED(state) (state == GL_ALREADY_SIGNALED || state == GL_CONDITION_SATISFIED)
 
 static PyObject *PySync_set(PySync *self, PyObject *args)
 {
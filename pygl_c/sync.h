@@ -1,6 +1,9 @@
 #pragma once
 #include <Python.h>
 
+// Checks whether result of glClientWaitSync means that the sync object has been signaled.
+#define SYNC_SIGNALED(state) ((state) == GL_ALREADY_SIGNALED || (state) == GL_CONDITION_SATISFIED)
+
 typedef struct
 {
     PyObject_HEAD
@@ -1,6 +1,7 @@
 #include <stdbool.h>
 #include "../buffers/buffer.h"
 #include "texture.h"
+#include "../utility.h"
 
 static bool Create1DTextureStorage(const PyTexture *texture, const PyTextureSpec *spec)
 {
@@ -83,7 +84,7 @@ static bool CheckTextureImmutableFormat(GLuint textureID)
     return true;
 }
 
-static bool UploadTexture1D(PyTexture *texture, const PyTextureUploadInfo *info, const void *dataPtr)
+static bool UploadTexture1D(PyTexture *texture, const PyTextureUploadInfo *info, const void *dataPtr, bool allowThreads)
 {
     if (info->width <= 0 || info->xOffset < 0)
     {
@@ -91,6 +92,8 @@ static bool UploadTexture1D(PyTexture *texture, const PyTextureUploadInfo *info,
         return false;
     }
 
+    PyThreadState *threadState = utils_begin_allow_threads(allowThreads);
+
     if (info->imageSize != 0)
         glCompressedTextureSubImage1D(
             texture->id,
@@ -110,10 +113,12 @@ static bool UploadTexture1D(PyTexture *texture, const PyTextureUploadInfo *info,
             info->pixelType,
             dataPtr);
 
+    utils_end_allow_threads(threadState);
+
     return true;
 }
 
-static bool UploadTexture2D(PyTexture *texture, const PyTextureUploadInfo *info, const void *dataPtr)
+static bool UploadTexture2D(PyTexture *texture, const PyTextureUploadInfo *info, const void *dataPtr, bool allowThreads)
 {
     if (info->width <= 0 ||
         info->height <= 0 ||
@@ -124,6 +129,8 @@ static bool UploadTexture2D(PyTexture *texture, const PyTextureUploadInfo *info,
         return false;
     }
 
+    PyThreadState *threadState = utils_begin_allow_threads(allowThreads);
+
     if (info->imageSize != 0)
         glCompressedTextureSubImage2D(
             texture->id,
@@ -147,10 +154,12 @@ static bool UploadTexture2D(PyTexture *texture, const PyTextureUploadInfo *info,
             info->pixelType,
             dataPtr);
 
+    utils_end_allow_threads(threadState);
+
     return true;
 }
 
-static bool UploadTexture3D(PyTexture *texture, const PyTextureUploadInfo *info, const void *dataPtr)
+static bool UploadTexture3D(PyTexture *texture, const PyTextureUploadInfo *info, const void *dataPtr, bool allowThreads)
 {
     if (info->width <= 0 ||
         info->height <= 0 ||
@@ -163,6 +172,8 @@ static bool UploadTexture3D(PyTexture *texture, const PyTextureUploadInfo *info,
         return false;
     }
 
+    PyThreadState *threadState = utils_begin_allow_threads(allowThreads);
+
     if (info->imageSize != 0)
         glCompressedTextureSubImage3D(
             texture->id,
@@ -190,6 +201,8 @@ static bool UploadTexture3D(PyTexture *texture, const PyTextureUploadInfo *info,
             info->pixelType,
             dataPtr);
 
+    utils_end_allow_threads(threadState);
+
     return true;
 }
 
@@ -478,6 +491,7 @@ static PyObject *PyTexture_upload(PyTexture *self, PyObject *args)
 
     Py_buffer buffer = {0};
     void *dataPtr = NULL;
+    bool allowThreads = false;
 
     if (!Py_IsNone(bufferObject))
     {
@@ -491,17 +505,20 @@ static PyObject *PyTexture_upload(PyTexture *self, PyObject *args)
             goto end;
 
         dataPtr = (char *)buffer.buf + info->dataOffset;
+
+        // data buffer stays exported until the upload is finished
+        allowThreads = buffer.len - info->dataOffset >= UTILS_ALLOW_THREADS_THRESHOLD;
     }
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, info->alignment);
 
     bool uploadSuccess = false;
     if (self->target == GL_TEXTURE_1D)
-        uploadSuccess = UploadTexture1D(self, info, dataPtr);
+        uploadSuccess = UploadTexture1D(self, info, dataPtr, allowThreads);
     else if (Requires2DUpload(self->target))
-        uploadSuccess = UploadTexture2D(self, info, dataPtr);
+        uploadSuccess = UploadTexture2D(self, info, dataPtr, allowThreads);
     else if (Requires3DUpload(self->target))
-        uploadSuccess = UploadTexture3D(self, info, dataPtr);
+        uploadSuccess = UploadTexture3D(self, info, dataPtr, allowThreads);
     else
     {
         // TODO Implement support for array cubemap textures
@@ -0,0 +1,218 @@
+#include "threadPool.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Condition;
+
+#define MUTEX_INIT(mutex) InitializeCriticalSection(mutex)
+#define MUTEX_LOCK(mutex) EnterCriticalSection(mutex)
+#define MUTEX_UNLOCK(mutex) LeaveCriticalSection(mutex)
+#define CONDITION_INIT(cond) InitializeConditionVariable(cond)
+#define CONDITION_WAIT(cond, mutex) SleepConditionVariableCS(cond, mutex, INFINITE)
+#define CONDITION_BROADCAST(cond) WakeAllConditionVariable(cond)
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+
+#define MUTEX_INIT(mutex) pthread_mutex_init(mutex, NULL)
+#define MUTEX_LOCK(mutex) pthread_mutex_lock(mutex)
+#define MUTEX_UNLOCK(mutex) pthread_mutex_unlock(mutex)
+#define CONDITION_INIT(cond) pthread_cond_init(cond, NULL)
+#define CONDITION_WAIT(cond, mutex) pthread_cond_wait(cond, mutex)
+#define CONDITION_BROADCAST(cond) pthread_cond_broadcast(cond)
+#endif
+
+#define THREAD_POOL_MAX_WORKERS 63
+
+typedef struct
+{
+    // serializes concurrent submissions
+    Mutex submitMutex;
+    // guards all fields below
+    Mutex mutex;
+    Condition workReady;
+    Condition workDone;
+    ThreadPoolJob job;
+    void *userData;
+    size_t count;
+    size_t next;
+    size_t finished;
+    uint64_t generation;
+    size_t workerCount;
+} ThreadPool;
+
+static ThreadPool pool;
+
+// Executes indices of current job until none are left. Has to be called with `pool.mutex` locked.
+static void run_pending(void)
+{
+    while (pool.next < pool.count)
+    {
+        const size_t index = pool.next++;
+        ThreadPoolJob job = pool.job;
+        void *userData = pool.userData;
+
+        MUTEX_UNLOCK(&pool.mutex);
+        job(userData, index);
+        MUTEX_LOCK(&pool.mutex);
+
+        if (++pool.finished == pool.count)
+            CONDITION_BROADCAST(&pool.workDone);
+    }
+}
+
+static void worker_main(void)
+{
+    uint64_t seenGeneration = 0;
+
+    MUTEX_LOCK(&pool.mutex);
+    while (true)
+    {
+        while (pool.generation == seenGeneration)
+            CONDITION_WAIT(&pool.workReady, &pool.mutex);
+
+        seenGeneration = pool.generation;
+        run_pending();
+    }
+}
+
+static size_t get_processor_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#endif
+}
+
+#ifdef _WIN32
+static unsigned __stdcall worker_entry(void *arg)
+{
+    worker_main();
+    return 0;
+}
+
+static bool start_worker(void)
+{
+    uintptr_t handle = _beginthreadex(NULL, 0, worker_entry, NULL, 0, NULL);
+    if (handle == 0)
+        return false;
+
+    CloseHandle((HANDLE)handle);
+    return true;
+}
+
+static INIT_ONCE initOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK init_pool(PINIT_ONCE once, PVOID param, PVOID *context)
+#else
+static void *worker_entry(void *arg)
+{
+    worker_main();
+    return NULL;
+}
+
+static bool start_worker(void)
+{
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, worker_entry, NULL) != 0)
+        return false;
+
+    pthread_detach(thread);
+    return true;
+}
+
+static pthread_once_t initOnce = PTHREAD_ONCE_INIT;
+
+static void init_pool(void)
+#endif
+{
+    MUTEX_INIT(&pool.submitMutex);
+    MUTEX_INIT(&pool.mutex);
+    CONDITION_INIT(&pool.workReady);
+    CONDITION_INIT(&pool.workDone);
+
+    size_t workerCount = get_processor_count() - 1;
+    if (workerCount > THREAD_POOL_MAX_WORKERS)
+        workerCount = THREAD_POOL_MAX_WORKERS;
+
+    // pool still works if some workers failed to start, the calling thread always participates in jobs
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        if (!start_worker())
+            break;
+
+        pool.workerCount++;
+    }
+
+#ifdef _WIN32
+    return TRUE;
+#endif
+}
+
+static void ensure_initialized(void)
+{
+#ifdef _WIN32
+    InitOnceExecuteOnce(&initOnce, init_pool, NULL, NULL);
+#else
+    pthread_once(&initOnce, init_pool);
+#endif
+}
+
+size_t thread_pool_get_thread_count(void)
+{
+    ensure_initialized();
+    return pool.workerCount + 1;
+}
+
+void thread_pool_run(ThreadPoolJob job, void *userData, size_t count)
+{
+    if (count == 0)
+        return;
+
+    ensure_initialized();
+
+    if (pool.workerCount == 0 || count == 1)
+    {
+        for (size_t i = 0; i < count; i++)
+            job(userData, i);
+
+        return;
+    }
+
+    MUTEX_LOCK(&pool.submitMutex);
+    MUTEX_LOCK(&pool.mutex);
+
+    pool.job = job;
+    pool.userData = userData;
+    pool.count = count;
+    pool.next = 0;
+    pool.finished = 0;
+    pool.generation++;
+    CONDITION_BROADCAST(&pool.workReady);
+
+    run_pending();
+
+    while (pool.finished != pool.count)
+        CONDITION_WAIT(&pool.workDone, &pool.mutex);
+
+    pool.job = NULL;
+    pool.userData = NULL;
+    pool.count = 0;
+    pool.next = 0;
+
+    MUTEX_UNLOCK(&pool.mutex);
+    MUTEX_UNLOCK(&pool.submitMutex);
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <stddef.h>
+
+// Function executed by the thread pool for every index in range [0, count). Jobs run without the GIL held,
+// so they must not touch any Python objects and must not submit work to the pool themselves.
+typedef void (*ThreadPoolJob)(void *userData, size_t index);
+
+// Returns number of threads participating in `thread_pool_run`, including the calling thread.
+size_t thread_pool_get_thread_count(void);
+
+// Executes `job` for each index in range [0, count) using worker threads and the calling thread, then waits
+// until all of them are finished. Indices are handed out one at a time, so callers should split work into chunks
+// that are large enough to hide synchronization overhead. Worker threads are started on first use.
+// Can be called without the GIL, concurrent calls are executed one after another.
+void thread_pool_run(ThreadPoolJob job, void *userData, size_t count);
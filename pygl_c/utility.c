@@ -1,4 +1,5 @@
 #include "utility.h"
+#include <string.h>
 
 void raise_buffer_not_contiguous(void)
 {
@@ -15,3 +16,132 @@ bool utils_check_buffer_contiguous(const Py_buffer* buf)
 
     return true;
 }
+
+void *utils_aligned_malloc(size_t size, size_t alignment)
+{
+    // over-allocate to make room for alignment padding and the original pointer, which is stored
+    // right before the aligned block
+    void *original = PyMem_Malloc(size + alignment + sizeof(void *));
+    if (!original)
+        return NULL;
+
+    uintptr_t aligned = ((uintptr_t)original + sizeof(void *) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    ((void **)aligned)[-1] = original;
+
+    return (void *)aligned;
+}
+
+void utils_aligned_free(void *ptr)
+{
+    if (ptr != NULL)
+        PyMem_Free(((void **)ptr)[-1]);
+}
+
+PyObject *utils_new_typed_view(Py_ssize_t count, const char *format, Py_ssize_t itemSize, void **data)
+{
+    PyObject *storage = PyByteArray_FromStringAndSize(NULL, count * itemSize);
+    if (!storage)
+        return NULL;
+
+    *data = PyByteArray_AS_STRING(storage);
+
+    PyObject *byteView = PyMemoryView_FromObject(storage);
+    Py_DECREF(storage);
+    if (!byteView)
+        return NULL;
+
+    PyObject *result = PyObject_CallMethod(byteView, "cast", "s", format);
+    Py_DECREF(byteView);
+
+    return result;
+}
+
+bool utils_get_float_buffer(PyObject *obj, Py_ssize_t components, Py_buffer *view, Py_ssize_t *count)
+{
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1)
+    {
+        raise_buffer_not_contiguous();
+        return false;
+    }
+
+    if (view->format != NULL && strcmp(view->format, "f") != 0 && strcmp(view->format, "B") != 0)
+    {
+        PyErr_Format(PyExc_TypeError, "Expected buffer of floats, got buffer with format: %s.", view->format);
+        PyBuffer_Release(view);
+        return false;
+    }
+
+    const Py_ssize_t elementSize = components * sizeof(float);
+    if (view->len % elementSize != 0)
+    {
+        PyErr_Format(PyExc_ValueError, "Buffer size has to be a multiple of %zd bytes.", elementSize);
+        PyBuffer_Release(view);
+        return false;
+    }
+
+    *count = view->len / elementSize;
+
+    return true;
+}
+
+bool utils_parse_fastcall_args(PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames, const char *const *names, Py_ssize_t required, PyObject **out)
+{
+    Py_ssize_t namesCount = 0;
+    while (names[namesCount] != NULL)
+        out[namesCount++] = NULL;
+
+    if (nargs > namesCount)
+    {
+        PyErr_Format(PyExc_TypeError, "Function takes at most %zd arguments (%zd given).", namesCount, nargs);
+        return false;
+    }
+
+    for (Py_ssize_t i = 0; i < nargs; i++)
+        out[i] = args[i];
+
+    Py_ssize_t kwargsCount = kwnames != NULL ? PyTuple_GET_SIZE(kwnames) : 0;
+    for (Py_ssize_t i = 0; i < kwargsCount; i++)
+    {
+        PyObject *kwname = PyTuple_GET_ITEM(kwnames, i);
+
+        Py_ssize_t idx = 0;
+        while (idx < namesCount && PyUnicode_CompareWithASCIIString(kwname, names[idx]) != 0)
+            idx++;
+
+        if (idx == namesCount)
+        {
+            PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'.", kwname);
+            return false;
+        }
+
+        if (out[idx] != NULL)
+        {
+            PyErr_Format(PyExc_TypeError, "Got multiple values for argument '%s'.", names[idx]);
+            return false;
+        }
+
+        out[idx] = args[nargs + i];
+    }
+
+    for (Py_ssize_t i = 0; i < required; i++)
+    {
+        if (out[i] == NULL)
+        {
+            PyErr_Format(PyExc_TypeError, "Missing required argument '%s' (pos %zd).", names[i], i + 1);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool utils_check_arg_type(PyObject *obj, PyTypeObject *type, const char *name)
+{
+    if (!Py_IS_TYPE(obj, type))
+    {
+        PyErr_Format(PyExc_TypeError, "Expected argument '%s' to be of type %s, got: %s.", name, type->tp_name, Py_TYPE(obj)->tp_name);
+        return false;
+    }
+
+    return true;
+}
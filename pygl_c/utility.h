@@ -43,9 +43,57 @@
 #define LOG_PY_INFO(logger, msg, ...) LOG_PY(logger, "info", msg, ##__VA_ARGS__)
 #define LOG_PY_WARNING(logger, msg, ...) LOG_PY(logger, "warning", msg, ##__VA_ARGS__)
 
+// Copies and uploads of at least this many bytes are done with the GIL released, so other threads can run meanwhile.
+#define UTILS_ALLOW_THREADS_THRESHOLD (256 * 1024)
+
 #define FLAG_IS_SET(flags, x) (((flags) & (x)) == (x))
 #define FLAG_SET(flags, x) flags |= (x)
 #define FLAG_CLEAR(flags, x) flags &= ~(x)
 
 bool utils_check_buffer_contiguous(const Py_buffer *buf);
 void raise_buffer_not_contiguous(void);
+
+// Allocates memory block which start is aligned to `alignment` bytes (which has to be a power of 2).
+// Memory returned by this function has to be freed using `utils_aligned_free`.
+void *utils_aligned_malloc(size_t size, size_t alignment);
+void utils_aligned_free(void *ptr);
+
+// Creates new memoryview of `count` items described by struct `format` character, backed by a bytearray.
+// Pointer to the underlying storage is written to `data`.
+PyObject *utils_new_typed_view(Py_ssize_t count, const char *format, Py_ssize_t itemSize, void **data);
+
+// Acquires C-contiguous buffer of floats from `obj`, which size has to be a multiple of `components` floats.
+// Number of elements is written to `count`. On success `view` has to be released by the caller.
+bool utils_get_float_buffer(PyObject *obj, Py_ssize_t components, Py_buffer *view, Py_ssize_t *count);
+
+// Matches positional and keyword arguments of METH_FASTCALL | METH_KEYWORDS functions (and vectorcall constructors)
+// against NULL-terminated list of `names` and stores them in `out` in the same order. Arguments that were not
+// provided are set to NULL. First `required` arguments have to be always provided.
+bool utils_parse_fastcall_args(PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames, const char *const *names, Py_ssize_t required, PyObject **out);
+
+// Checks if `obj` is exactly of type `type`, raising TypeError mentioning argument `name` otherwise.
+bool utils_check_arg_type(PyObject *obj, PyTypeObject *type, const char *name);
+
+// Releases the GIL if `cond` is true. Returned state has to be passed to `utils_end_allow_threads`.
+// Memory used meanwhile has to stay valid when other threads run, e.g. by holding exports of the objects that own it.
+static inline PyThreadState *utils_begin_allow_threads(bool cond)
+{
+    return cond ? PyEval_SaveThread() : NULL;
+}
+
+static inline void utils_end_allow_threads(PyThreadState *state)
+{
+    if (state != NULL)
+        PyEval_RestoreThread(state);
+}
+
+// Converts `obj` to float the same way as "f" format unit of PyArg_Parse* functions.
+static inline bool utils_as_float(PyObject *obj, float *out)
+{
+    double value = PyFloat_AsDouble(obj);
+    if (value == -1.0 && PyErr_Occurred())
+        return false;
+
+    *out = (float)value;
+    return true;
+}
@@ -1,6 +1,7 @@
 #include "vertexArray.h"
 #include "vertexInput.h"
 #include "vertexDescriptor.h"
+#include "../buffers/streamBuffer.h"
 #include "../utility.h"
 #include <stdbool.h>
 #include <assert.h>
@@ -27,6 +28,9 @@ static GLuint get_gl_type_size(GLenum type)
         return sizeof(GLbyte);
     case GL_UNSIGNED_BYTE:
         return sizeof(GLubyte);
+    case GL_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+        return sizeof(GLuint);
     }
 
     assert(0 && "Unreachable at vertexArray::get_gl_type_size");
@@ -47,6 +51,8 @@ static bool set_attrib_format(GLuint array, PyVertexDescriptor *desc, GLuint *of
         break;
     case GL_FLOAT:
     case GL_HALF_FLOAT:
+    case GL_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
         glVertexArrayAttribFormat(
             array,
             desc->attribIndex + rowOffset,
@@ -83,7 +89,11 @@ static bool set_attrib_format(GLuint array, PyVertexDescriptor *desc, GLuint *of
         return false;
     }
 
-    *offset += get_gl_type_size(desc->type) * desc->count;
+    // all components of packed formats share a single 32-bit word
+    if (desc->type == GL_INT_2_10_10_10_REV || desc->type == GL_UNSIGNED_INT_2_10_10_10_REV)
+        *offset += get_gl_type_size(desc->type);
+    else
+        *offset += get_gl_type_size(desc->type) * desc->count;
     return true;
 }
 
@@ -106,6 +116,9 @@ static bool add_vertex_input(GLuint array, GLuint index, PyVertexInput *input)
             "All vertex descriptors objects has to be of type pygl.vertex_array.VertexDescriptor",
             false);
 
+        if (descriptor->offset >= 0)
+            attribOffset = (GLuint)descriptor->offset;
+
         for (int row = 0; row < descriptor->rows; row++)
         {
             glEnableVertexArrayAttrib(array, descriptor->attribIndex + row);
@@ -176,14 +189,20 @@ static PyObject *bind_vertex_buffer(PyVertexArray *self, PyObject *args, PyObjec
 {
     static char *kwNames[] = {"buffer", "index", "stride", "offset", "divisor", NULL};
 
-    PyBuffer *buffer;
+    GLObject *buffer;
     GLuint index;
     GLsizei stride;
     GLintptr offset = 0;
     GLuint divisor = 0;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!Ii|nI", kwNames, &pyBufferType, &buffer, &index, &stride, &offset, &divisor))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OIi|nI", kwNames, &buffer, &index, &stride, &offset, &divisor))
+        return NULL;
+
+    if (!PyObject_TypeCheck(buffer, &pyBufferType) && !PyObject_TypeCheck(buffer, &pyStreamBufferType))
+    {
+        PyErr_Format(PyExc_TypeError, "Expected buffer to be of type pygl.buffers.Buffer or pygl.buffers.StreamBuffer, got: %s.", Py_TYPE(buffer)->tp_name);
         return NULL;
+    }
 
     glVertexArrayVertexBuffer(self->id, index, buffer->id, offset, stride);
     glVertexArrayBindingDivisor(self->id, index, divisor);
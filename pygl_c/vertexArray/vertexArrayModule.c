@@ -21,6 +21,8 @@ static EnumDef attribTypeEnum = {
         {"UNSIGNED_SHORT", GL_UNSIGNED_SHORT},
         {"INT", GL_INT},
         {"UNSIGNED_INT", GL_UNSIGNED_INT},
+        {"INT_2_10_10_10_REV", GL_INT_2_10_10_10_REV},
+        {"UNSIGNED_INT_2_10_10_10_REV", GL_UNSIGNED_INT_2_10_10_10_REV},
         {0}},
 };
 
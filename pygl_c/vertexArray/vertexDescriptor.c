@@ -3,15 +3,16 @@
 
 static int py_vaolayout_init(PyVertexDescriptor* self, PyObject* args, PyObject* kwargs)
 {
-    static char* kwNames[] = { "attrib_index", "type", "count", "rows", "is_normalized", NULL };
+    static char* kwNames[] = { "attrib_index", "type", "count", "rows", "is_normalized", "offset", NULL };
 
     self->rows = 1;
+    self->offset = -1;
     if (!PyArg_ParseTupleAndKeywords(
             args,
             kwargs,
-            "IIi|Ip",
+            "IIi|Ipi",
             kwNames,
-            &self->attribIndex, &self->type, &self->count, &self->rows, &self->isNormalized))
+            &self->attribIndex, &self->type, &self->count, &self->rows, &self->isNormalized, &self->offset))
         return -1;
 
     return 0;
@@ -30,6 +31,7 @@ PyTypeObject pyVertexDescriptorType = {
         {"count", T_INT, offsetof(PyVertexDescriptor, count), 0, NULL},
         {"rows", T_INT, offsetof(PyVertexDescriptor, rows), 0, NULL},
         {"is_normalized", T_BOOL, offsetof(PyVertexDescriptor, isNormalized), 0, NULL},
+        {"offset", T_INT, offsetof(PyVertexDescriptor, offset), 0, NULL},
         {0},
     },
 };
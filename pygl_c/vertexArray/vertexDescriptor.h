@@ -11,6 +11,8 @@ typedef struct
     GLint count;
     GLuint rows;
     bool isNormalized;
+    // relative offset of the attribute, -1 places it right after the previous one
+    GLint offset;
 } PyVertexDescriptor;
 
 extern PyTypeObject pyVertexDescriptorType;
@@ -8,12 +8,14 @@ IS_DEBUG = False
 CMAKE_BUILD_TYPE = 'RelWithDebInfo' if IS_DEBUG else 'Release'
 CMAKE_DIR = './build/cmake'
 CMAKE_BUILD_DIR = f'{CMAKE_DIR}/{CMAKE_BUILD_TYPE}'
+# set PYGL_ENABLE_AVX=1 to build with cglm AVX code paths (requires CPU with AVX support)
+ENABLE_AVX = os.getenv('PYGL_ENABLE_AVX', '0') == '1'
 
 class PyglDist(setuptools.Distribution):
     def has_ext_modules(self):
         return True
 
-subprocess.call(f'cmake -S . -B {CMAKE_DIR} -DCMAKE_BUILD_TYPE={CMAKE_BUILD_TYPE} -DCMAKE_VERBOSE_MAKEFILE=ON')
+subprocess.call(f'cmake -S . -B {CMAKE_DIR} -DCMAKE_BUILD_TYPE={CMAKE_BUILD_TYPE} -DCMAKE_VERBOSE_MAKEFILE=ON -DPYGL_ENABLE_AVX={"ON" if ENABLE_AVX else "OFF"}')
 subprocess.call(f'cmake --build {CMAKE_DIR} --config {CMAKE_BUILD_TYPE}')
 
 # temporarily copy resulting dll into package directory bcs setuptools suck
@@ -0,0 +1,124 @@
+import array
+import math
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import AnimationClip, Matrix4, Matrix4Array, Skeleton, Vector3
+
+def _translation(matrices: Matrix4Array, i: int) -> tuple[float, float, float]:
+    m = matrices[i]
+    return (m[3, 0], m[3, 1], m[3, 2])
+
+def _two_joint_clip() -> AnimationClip:
+    # joint 0 moves from x=0 to x=2 over 1 second, joint 1 rotates 90 degrees around z and is offset by 1 in x
+    s = math.sqrt(0.5)
+    return AnimationClip(
+        [0, 2, 4],
+        array.array('f', [0.0, 1.0, 0.0, 1.0]),
+        array.array('f', [0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0]),
+        array.array('f', [0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, s, s]))
+
+def test_animation_clip_init_success() -> None:
+    clip = _two_joint_clip()
+
+    assert clip.joint_count == 2
+    assert clip.key_count == 4
+    assert clip.duration == 1.0
+
+def test_animation_clip_sample_success() -> None:
+    local = _two_joint_clip().sample(0.25)
+
+    assert _translation(local, 0) == pytest.approx((0.5, 0.0, 0.0))
+    assert _translation(local, 1) == pytest.approx((1.0, 0.0, 0.0))
+
+def test_animation_clip_sample_clamp_success() -> None:
+    local = _two_joint_clip().sample(5.0, loop=False)
+
+    assert _translation(local, 0) == pytest.approx((2.0, 0.0, 0.0))
+
+def test_skeleton_compute_palettes_success() -> None:
+    skeleton = Skeleton([-1, 0])
+
+    palettes = skeleton.compute_palettes(_two_joint_clip(), array.array('f', [0.5, 1.0]))
+
+    assert len(palettes) == 4
+    # instance 0: root at x=1, child offset by 1 in root space
+    assert _translation(palettes, 0) == pytest.approx((1.0, 0.0, 0.0))
+    assert _translation(palettes, 1) == pytest.approx((2.0, 0.0, 0.0))
+    # instance 1 wraps to time 0
+    assert _translation(palettes, 2) == pytest.approx((0.0, 0.0, 0.0))
+
+def test_skeleton_compute_palettes_rotation_success() -> None:
+    palettes = Skeleton([-1, 0]).compute_palettes(_two_joint_clip(), 0.999999, nlerp=True)
+
+    # child rotated 90 degrees around z maps its local x axis onto y
+    child = palettes[1]
+    assert (child[0, 0], child[0, 1]) == pytest.approx((0.0, 1.0), abs=1e-4)
+
+def test_skeleton_compute_palettes_inverse_bind_success() -> None:
+    inverse_bind = Matrix4Array(2)
+    inverse_bind[0] = Matrix4.identity()
+    inverse_bind[1] = Matrix4.transform(Vector3(-1.0, 0.0, 0.0))
+
+    palettes = Skeleton([-1, 0], inverse_bind).compute_palettes([_two_joint_clip()], array.array('f', [0.0]))
+
+    # bind pose produces identity skinning matrices
+    assert _translation(palettes, 1) == pytest.approx((0.0, 0.0, 0.0))
+
+def test_skeleton_compute_palettes_out_success() -> None:
+    out = Matrix4Array(4)
+
+    assert Skeleton([-1, 0]).compute_palettes(_two_joint_clip(), array.array('f', [0.5, 0.5]), out=out) is None
+    assert _translation(out, 3) == pytest.approx((2.0, 0.0, 0.0))
+
+def test_skeleton_compute_palettes_into_buffer_success(gl_context) -> None:
+    buf = Buffer(4 * 64, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+    skeleton = Skeleton([-1, 0])
+    times = array.array('f', [0.25, 0.75])
+
+    assert skeleton.compute_palettes(_two_joint_clip(), times, out=buf) is None
+    assert buf.current_offset == 4 * 64
+
+    data = bytearray(4 * 64)
+    buf.read(data, 4 * 64)
+
+    assert bytes(data) == bytes(skeleton.compute_palettes(_two_joint_clip(), times))
+
+    buf.delete()
+
+def test_skeleton_compute_palettes_many_success() -> None:
+    count = 1000
+    parents = [-1] + list(range(15))
+    clip = AnimationClip(
+        list(range(17)),
+        array.array('f', [0.0] * 16),
+        array.array('f', [1.0, 0.0, 0.0] * 16),
+        array.array('f', [0.0, 0.0, 0.0, 1.0] * 16))
+
+    palettes = Skeleton(parents).compute_palettes(clip, array.array('f', [0.0] * count))
+
+    assert len(palettes) == count * 16
+    assert _translation(palettes, count * 16 - 1) == pytest.approx((16.0, 0.0, 0.0))
+
+def test_skeleton_compute_palettes_no_joints_success() -> None:
+    skeleton = Skeleton([])
+
+    assert skeleton.joint_count == 0
+    assert len(skeleton.compute_palettes([], array.array('f'))) == 0
+
+def test_skeleton_init_failure_invalid_parent() -> None:
+    with pytest.raises(ValueError):
+        Skeleton([-1, 2, 0])
+
+def test_skeleton_compute_palettes_failure_joint_count() -> None:
+    with pytest.raises(ValueError):
+        Skeleton([-1]).compute_palettes(_two_joint_clip(), 0.0)
+
+def test_animation_clip_init_failure_unsorted_times() -> None:
+    with pytest.raises(ValueError):
+        AnimationClip(
+            [0, 2],
+            array.array('f', [1.0, 0.0]),
+            array.array('f', [0.0] * 6),
+            array.array('f', [0.0, 0.0, 0.0, 1.0] * 2))
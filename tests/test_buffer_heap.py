@@ -0,0 +1,154 @@
+import struct
+
+import pytest
+
+from pygl.buffers import BufferFlags, BufferHeap, HeapAllocation
+
+def _read(heap: BufferHeap, allocation: HeapAllocation, size: int) -> bytes:
+    data = bytearray(size)
+    heap.buffer.read(data, size, allocation.offset)
+
+    return bytes(data)
+
+def test_buffer_heap_allocate_success(gl_context) -> None:
+    heap = BufferHeap(4096)
+    a = heap.allocate(10)
+    b = heap.allocate(100)
+
+    assert isinstance(a, HeapAllocation)
+    assert a.offset == 0 and a.size == 16
+    assert b.offset == 16 and b.size == 112
+
+    stats = heap.get_stats()
+
+    assert stats['size'] == 4096
+    assert stats['used'] == 128
+    assert stats['allocations'] == 2
+    assert stats['fragmentation'] == 0.0
+
+def test_buffer_heap_alignment_success(gl_context) -> None:
+    heap = BufferHeap(1 << 16, alignment=4)
+    heap.allocate(4)
+
+    # stride which is not a power of two, offset has to be divisible by it to be used as base vertex
+    vertices = heap.allocate(12 * 10, alignment=12)
+
+    assert vertices.offset % 12 == 0
+    assert vertices.index(12) == vertices.offset // 12
+    assert heap.allocate(64, alignment=256).offset % 256 == 0
+
+def test_buffer_heap_free_merge_success(gl_context) -> None:
+    heap = BufferHeap(1024, alignment=64)
+    blocks = [heap.allocate(64) for _ in range(16)]
+
+    with pytest.raises(RuntimeError):
+        heap.allocate(64)
+
+    for block in blocks[1::2]:
+        heap.free(block)
+
+    stats = heap.get_stats()
+    assert stats['free_blocks'] == 8
+    assert stats['largest_free_block'] == 64
+    assert stats['fragmentation'] == pytest.approx(7 / 8)
+
+    blocks[2].free()
+    del blocks[4]
+
+    assert heap.get_stats()['free_blocks'] == 6
+    assert heap.allocate(192).offset == 64
+
+def test_buffer_heap_store_success(gl_context) -> None:
+    heap = BufferHeap(1024)
+    heap.allocate(32)
+    allocation = heap.allocate(32)
+
+    assert heap.store(allocation, struct.pack('<4f', 1.0, 2.0, 3.0, 4.0)) == 16
+    assert heap.store(allocation, 7, offset=16) == 4
+    assert _read(heap, allocation, 20) == struct.pack('<4fi', 1.0, 2.0, 3.0, 4.0, 7)
+
+def test_buffer_heap_persistent_success(gl_context) -> None:
+    heap = BufferHeap(1024, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT | BufferFlags.MAP_COHERENT_BIT)
+    allocation = heap.allocate(16)
+    heap.store(allocation, b'persistent')
+
+    assert _read(heap, allocation, 10) == b'persistent'
+
+def test_buffer_heap_defragment_success(gl_context) -> None:
+    heap = BufferHeap(4096, alignment=16)
+    blocks = [heap.allocate(48) for _ in range(32)]
+    for i, block in enumerate(blocks):
+        heap.store(block, bytes([i]) * 48)
+
+    for block in blocks[::2]:
+        block.free()
+
+    kept = blocks[1::2]
+    assert heap.get_stats()['fragmentation'] > 0.0
+    assert heap.defragment() > 0
+
+    stats = heap.get_stats()
+    assert stats['free_blocks'] == 1
+    assert stats['fragmentation'] == 0.0
+
+    for i, block in enumerate(kept):
+        assert block.offset == i * 48
+        assert _read(heap, block, 48) == bytes([i * 2 + 1]) * 48
+
+    assert heap.defragment() == 0
+
+def test_buffer_heap_defragment_flush_explicit_success(gl_context) -> None:
+    heap = BufferHeap(1024, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT | BufferFlags.MAP_FLUSH_EXPLICIT_BIT)
+    first = heap.allocate(64)
+    second = heap.allocate(64)
+    heap.store(second, b'moved')
+    first.free()
+
+    assert heap.defragment() == 64
+    assert second.offset == 0
+    assert heap.buffer.dirty_ranges == []
+    assert bytes(heap.buffer.read_async(5, second.offset).result()) == b'moved'
+
+def test_buffer_heap_defragment_fail_mapped(gl_context) -> None:
+    heap = BufferHeap(1024, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT)
+    heap.buffer.map()
+    first = heap.allocate(64)
+    second = heap.allocate(64)
+    heap.store(second, b'kept')
+    first.free()
+
+    with pytest.raises(BufferError):
+        heap.defragment()
+
+    assert second.offset == 64
+
+    heap.buffer.transfer()
+
+    assert heap.defragment() == 64
+    assert bytes(heap.buffer.read_async(4, second.offset).result()) == b'kept'
+
+def test_buffer_heap_failure_freed_allocation(gl_context) -> None:
+    heap = BufferHeap(1024)
+    other = BufferHeap(1024)
+    allocation = heap.allocate(16)
+
+    with pytest.raises(ValueError):
+        other.free(allocation)
+
+    allocation.free()
+
+    assert allocation.is_freed
+    with pytest.raises(RuntimeError):
+        allocation.offset
+
+    with pytest.raises(RuntimeError):
+        heap.free(allocation)
+
+def test_buffer_heap_failure_too_big(gl_context) -> None:
+    heap = BufferHeap(1024)
+
+    with pytest.raises(ValueError):
+        heap.allocate(2048)
+
+    with pytest.raises(ValueError):
+        heap.allocate(0)
@@ -1,6 +1,13 @@
+import random
+import struct
+import threading
+
 import pytest
 
+from pygl import buffers
 from pygl.buffers import Buffer, BufferFlags
+from pygl.math import (DVector3, Matrix2, Matrix3, Matrix4, Quaternion,
+                       Vector2, Vector3, Vector4, transform_points)
 
 
 def test_buffer_init_fail_invalid_persistent_flags(gl_context):
@@ -235,3 +242,417 @@ def test_buffer_read_fail_not_mapped(gl_context):
         buf.read(out_data, 4)
 
     buf.delete()
+
+def test_buffer_store_math_types_success(gl_context):
+    objects = [
+        Matrix4.identity(),
+        Vector4(1.0, 2.0, 3.0, 4.0),
+        Vector3(5.0, 6.0, 7.0),
+        Vector2(8.0, 9.0),
+        Quaternion(0.0, 0.0, 0.0, 1.0),
+        Matrix3.identity(),
+        Matrix2.identity(),
+        DVector3(1.0, 2.0, 3.0)]
+    expected = b''.join(struct.pack('<4f', 0.0, 0.0, 0.0, 1.0) if isinstance(obj, Quaternion) else bytes(obj) for obj in objects)
+    buf = Buffer(len(expected), BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    for obj in objects:
+        buf.store(obj)
+
+    out_data = bytearray(len(expected))
+    buf.read(out_data, len(expected))
+
+    assert buf.current_offset == len(expected)
+    assert bytes(out_data) == expected
+
+    buf.delete()
+
+def test_buffer_store_offset_success(gl_context):
+    buf = Buffer(32, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    buf.store(Vector2(1.0, 2.0), offset=16)
+    buf.store(3, offset=None)
+
+    out_data = bytearray(32)
+    buf.read(out_data, 32)
+
+    assert buf.current_offset == 4
+    assert struct.unpack_from('<i', out_data, 0) == (3,)
+    assert struct.unpack_from('<2f', out_data, 16) == (1.0, 2.0)
+
+    buf.delete()
+
+def test_buffer_store_many_success(gl_context):
+    data = [Matrix4.identity(), Vector3(1.0, 2.0, 3.0), 4.0, 5, bytearray([6, 7, 8, 9])]
+    buf = Buffer(64 + 12 + 4 + 4 + 4, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    buf.store_many(data)
+    buf.store_many(())
+
+    out_data = bytearray(buf.size)
+    buf.read(out_data, buf.size)
+
+    assert buf.current_offset == buf.size
+    assert bytes(out_data) == bytes(data[0]) + bytes(data[1]) + struct.pack('<fi', 4.0, 5) + bytes(data[4])
+
+    buf.delete()
+
+def test_buffer_store_many_fail_overflow(gl_context):
+    buf = Buffer(32, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with pytest.raises(RuntimeError):
+        buf.store_many([Vector4(0.0)] * 3)
+
+    assert buf.current_offset == 0
+
+    buf.delete()
+
+def test_buffer_store_many_fail_invalid_type(gl_context):
+    buf = Buffer(32, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with pytest.raises(TypeError):
+        buf.store_many([Vector4(0.0), 'text'])
+
+    with pytest.raises(TypeError):
+        buf.store_many(5)
+
+    buf.delete()
+
+def test_buffer_dirty_ranges_client_success(gl_context):
+    buf = Buffer(8192, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    buf.store(Vector4(1.0))
+    buf.store(Vector4(2.0))
+    buf.store(7, offset=4096)
+
+    # explicit offset beyond current offset has to be uploaded too
+    assert buf.dirty_ranges == [(0, 32), (4096, 4)]
+
+    # ranges separated by a small gap are merged
+    buf.store(8, offset=4200)
+
+    assert buf.dirty_ranges == [(0, 32), (4096, 108)]
+    assert buf.transfer() == 32 + 108
+    assert buf.dirty_ranges == []
+
+    data = bytearray(4)
+    buf.read(data, 4, 4096)
+
+    assert struct.unpack('<i', data) == (7,)
+
+    buf.delete()
+
+def test_buffer_dirty_ranges_limit_success(gl_context):
+    buf = Buffer(1 << 20, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    for i in range(64):
+        buf.store(i, offset=i * 1024)
+
+    ranges = buf.dirty_ranges
+
+    assert 1 < len(ranges) <= 16
+    assert ranges[0][0] == 0
+    assert sum(ranges[-1]) == 63 * 1024 + 4
+
+    buf.transfer()
+    data = bytearray(4)
+    buf.read(data, 4, 40 * 1024)
+
+    assert struct.unpack('<i', data) == (40,)
+
+    buf.delete()
+
+def test_buffer_flush_explicit_success(gl_context):
+    buf = Buffer(4096, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT | BufferFlags.MAP_FLUSH_EXPLICIT_BIT)
+
+    buf.store(Vector2(1.0, 2.0), offset=1024)
+
+    assert buf.dirty_ranges == [(1024, 8)]
+    assert buf.transfer() == 8
+    assert buf.dirty_ranges == []
+
+    buf.delete()
+
+    mapped = Buffer(64, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_FLUSH_EXPLICIT_BIT)
+    mapped.map()
+    mapped.store(5)
+
+    assert mapped.transfer() == 4
+
+    mapped.delete()
+
+def test_buffer_init_fail_flush_explicit_flags(gl_context):
+    with pytest.raises(ValueError):
+        Buffer(64, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_FLUSH_EXPLICIT_BIT)
+
+def test_buffer_view_client_success(gl_context):
+    buf = Buffer(64, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with buf.view('f', offset=16, size=16) as floats:
+        assert floats.shape == (4,)
+        assert buf.export_count == 1
+
+        floats[:] = memoryview(struct.pack('<4f', 1.0, 2.0, 3.0, 4.0)).cast('f')
+
+    assert buf.export_count == 0
+    assert buf.dirty_ranges == [(16, 16)]
+    assert buf.transfer() == 16
+
+    data = bytearray(16)
+    buf.read(data, 16, 16)
+
+    assert struct.unpack('<4f', data) == (1.0, 2.0, 3.0, 4.0)
+
+    with buf.view('i', (4, 4)) as ints:
+        assert ints.shape == (4, 4)
+        assert ints[1, 0] == struct.unpack('<i', struct.pack('<f', 1.0))[0]
+
+    buf.delete()
+
+def test_buffer_view_client_initial_data_success(gl_context):
+    buf = Buffer(16, BufferFlags.DYNAMIC_STORAGE_BIT, b'abcd')
+
+    with buf.view() as mem:
+        assert bytes(mem) == b'abcd' + bytes(12)
+
+    buf.delete()
+
+    buf = Buffer(16, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with buf.view() as mem:
+        assert bytes(mem) == bytes(16)
+
+    buf.delete()
+
+def test_buffer_protocol_mapped_success(gl_context):
+    buf = Buffer(32, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    with memoryview(buf) as mem:
+        assert len(mem) == 32
+        assert not mem.readonly
+
+        struct.pack_into('<2i', mem, 8, 21, 37)
+
+        with pytest.raises(BufferError):
+            buf.delete()
+
+    data = bytearray(8)
+    buf.read(data, 8, 8)
+
+    assert struct.unpack('<2i', data) == (21, 37)
+
+    buf.delete()
+
+def test_buffer_view_fail_not_mapped(gl_context):
+    buf = Buffer(32, BufferFlags.MAP_WRITE_BIT)
+
+    with pytest.raises(BufferError):
+        memoryview(buf)
+
+    buf.map()
+    mem = buf.view()
+
+    with pytest.raises(BufferError):
+        buf.transfer()
+
+    mem.release()
+    buf.transfer()
+    buf.delete()
+
+def test_buffer_view_fail_invalid_range(gl_context):
+    buf = Buffer(32, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with pytest.raises(ValueError):
+        buf.view(offset=64)
+
+    with pytest.raises(ValueError):
+        buf.view(offset=16, size=32)
+
+    with pytest.raises(ValueError):
+        buf.view('?x')
+
+    assert buf.export_count == 0
+
+    buf.delete()
+
+def test_buffer_view_fail_deleted(gl_context):
+    for flags in (BufferFlags.DYNAMIC_STORAGE_BIT, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT):
+        buf = Buffer(32, flags)
+        buf.delete()
+
+        with pytest.raises(BufferError):
+            buf.view()
+
+        with pytest.raises(BufferError):
+            memoryview(buf)
+
+        with pytest.raises(RuntimeError):
+            buf.store(bytes(4))
+
+def test_buffer_read_async_success(gl_context):
+    buf = Buffer(256, BufferFlags.DYNAMIC_STORAGE_BIT)
+    buf.store(struct.pack('<4i', 1, 2, 3, 4), offset=128)
+    buf.transfer()
+
+    future = buf.read_async(16, 128)
+
+    assert future.size == 16
+    assert future.offset == 128
+
+    with future.result() as data:
+        assert future.ready()
+        assert data.readonly
+        assert struct.unpack('<4i', data) == (1, 2, 3, 4)
+
+    # staging buffer of the released future can be reused
+    del future
+
+    buf.store(struct.pack('<i', 5), offset=128)
+    buf.transfer()
+
+    assert struct.unpack('<i', buf.read_async(4, 128).result()) == (5,)
+
+    buf.delete()
+
+def test_buffer_read_async_fail_invalid_range(gl_context):
+    buf = Buffer(64, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with pytest.raises(ValueError):
+        buf.read_async(64, 16)
+
+    with pytest.raises(ValueError):
+        buf.read_async(0)
+
+    buf.delete()
+
+def test_buffer_read_async_fail_mapped(gl_context):
+    buf = Buffer(64, BufferFlags.MAP_WRITE_BIT)
+    buf.map()
+
+    with pytest.raises(RuntimeError):
+        buf.read_async(16)
+
+    buf.transfer()
+    buf.read_async(16).result()
+    buf.delete()
+
+def test_buffer_parallel_copy_success(gl_context):
+    assert buffers.get_parallel_copy_threshold() == 0
+
+    data = random.Random(0).randbytes(3 << 20)
+    buffers.set_parallel_copy_threshold(1 << 20)
+    try:
+        mapped = Buffer(len(data) + 64, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+        client = Buffer(len(data) + 64, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+        # unaligned offset checks splitting into chunks aligned to the destination
+        for buf in (mapped, client):
+            buf.store(data, offset=3)
+            buf.transfer()
+
+            out = bytearray(len(data))
+            buf.read(out, len(data), 3)
+
+            assert out == data
+
+            buf.delete()
+    finally:
+        buffers.set_parallel_copy_threshold(0)
+
+def test_buffer_parallel_copy_fail_negative_threshold():
+    with pytest.raises(ValueError):
+        buffers.set_parallel_copy_threshold(-1)
+
+def _run_while_writing(write, attempt) -> int:
+    '''
+    Runs `write` in a background thread and calls `attempt` until it finishes. Returns number of `BufferError`s
+    raised by `attempt`.
+    '''
+
+    started = threading.Event()
+    done = threading.Event()
+
+    def worker() -> None:
+        started.set()
+        write()
+        done.set()
+
+    thread = threading.Thread(target=worker)
+    thread.start()
+    started.wait()
+
+    errors = 0
+    while not done.is_set():
+        try:
+            attempt()
+        except BufferError:
+            errors += 1
+
+    thread.join()
+
+    return errors
+
+def test_buffer_pinned_during_store(gl_context):
+    data = random.Random(0).randbytes(64 << 20)
+    buf = Buffer(len(data), BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT)
+    buf.map()
+
+    assert _run_while_writing(lambda: buf.store(data), buf.transfer) > 0
+
+    buf.map()
+    out = bytearray(1024)
+    buf.read(out, 1024, len(data) - 1024)
+
+    assert out == data[-1024:]
+
+    buf.transfer()
+    buf.delete()
+
+def test_buffer_pinned_during_kernel_write(gl_context):
+    count = 4 << 20
+    src = bytes(count * 12)
+    buf = Buffer(count * 12, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    assert _run_while_writing(lambda: transform_points(Matrix4.identity(), src, buf), buf.delete) > 0
+    assert buf.export_count == 0
+    assert buf.current_offset == count * 12
+
+    buf.delete()
+
+def test_buffer_store_concurrent_offsets(gl_context):
+    chunk = 4 << 20
+    buf = Buffer(chunk * 8, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    def store(value: int) -> None:
+        for _ in range(4):
+            buf.store(bytes([value]) * chunk)
+
+    threads = [threading.Thread(target=store, args=(value,)) for value in (1, 2)]
+    for thread in threads:
+        thread.start()
+
+    for thread in threads:
+        thread.join()
+
+    assert buf.current_offset == chunk * 8
+
+    buf.transfer()
+
+    # every chunk has to be written by exactly one store
+    out = bytearray(chunk * 8)
+    buf.read(out, len(out))
+
+    assert sorted(out[i * chunk] for i in range(8)) == [1, 1, 1, 1, 2, 2, 2, 2]
+    assert all(out[i * chunk:(i + 1) * chunk].count(out[i * chunk]) == chunk for i in range(8))
+
+    buf.delete()
+
+def test_buffer_store_many_sequence_cleared(gl_context):
+    items = [bytearray([i]) * (4 << 20) for i in range(16)]
+    buf = Buffer(16 * (4 << 20), BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    _run_while_writing(lambda: buf.store_many(items), items.clear)
+
+    assert buf.current_offset == 16 * (4 << 20)
+
+    buf.delete()
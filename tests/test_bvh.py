@@ -0,0 +1,103 @@
+import array
+import math
+
+import pytest
+
+from pygl.math import BVH, Frustum, Matrix4
+
+# unit boxes placed along x axis at 0, 3, 6, ...
+def _row_of_boxes(count: int, shift: float = 0.0) -> array.array:
+    data = array.array('f')
+    for i in range(count):
+        x = i * 3.0 + shift
+        data.extend((x, 0.0, 0.0, x + 1.0, 1.0, 1.0))
+
+    return data
+
+def test_bvh_init_success() -> None:
+    bvh = BVH(_row_of_boxes(100), max_leaf_size=2)
+
+    assert bvh.count == 100
+    assert bvh.node_count > 1
+    assert bvh.bounds.tolist() == [0.0, 0.0, 0.0, 298.0, 1.0, 1.0]
+
+def test_bvh_init_empty_success() -> None:
+    bvh = BVH(array.array('f'))
+
+    assert bvh.count == 0
+    assert bvh.query_frustum(Frustum(Matrix4.identity())).tolist() == []
+
+def test_bvh_query_frustum_success() -> None:
+    bvh = BVH(_row_of_boxes(1000))
+    frustum = Frustum(Matrix4.ortho(10.0, 20.0, -1.0, 1.0, -1.0, 1.0))
+
+    # boxes spanning [9, 10], [12, 13], [15, 16], [18, 19]
+    assert sorted(bvh.query_frustum(frustum).tolist()) == [3, 4, 5, 6]
+
+def test_bvh_query_aabbs_success() -> None:
+    bvh = BVH(_row_of_boxes(100))
+    queries = array.array('f', [2.5, 0.0, 0.0, 6.5, 1.0, 1.0, -5.0, 5.0, 5.0, -4.0, 6.0, 6.0])
+
+    offsets, indices = bvh.query_aabbs(queries)
+
+    assert offsets.tolist() == [0, 2, 2]
+    assert sorted(indices.tolist()) == [1, 2]
+
+def test_bvh_query_rays_success() -> None:
+    bvh = BVH(_row_of_boxes(100))
+    origins = array.array('f', [-10.0, 0.5, 0.5, 7.5, 0.5, 0.5, 0.0, 5.0, 0.0])
+    directions = array.array('f', [1.0, 0.0, 0.0, -1.0, 0.0, 0.0, 1.0, 0.0, 0.0])
+
+    hits, distances = bvh.query_rays(origins, directions)
+
+    assert hits.tolist() == [0, 2, 0xFFFFFFFF]
+    assert distances.tolist()[:2] == [10.0, 0.5]
+    assert math.isinf(distances[2])
+
+def test_bvh_query_rays_max_distance_success() -> None:
+    bvh = BVH(_row_of_boxes(10))
+
+    hits, _ = bvh.query_rays(array.array('f', [-10.0, 0.5, 0.5]), array.array('f', [1.0, 0.0, 0.0]), max_distance=5.0)
+
+    assert hits.tolist() == [0xFFFFFFFF]
+
+def test_bvh_query_rays_miss_inside_leaf_success() -> None:
+    # L-shaped pair of boxes isn't worth splitting, ray passes through the empty corner of the leaf bounds
+    bvh = BVH(array.array('f', [0.0, 0.0, 0.0, 2.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 2.0, 1.0]))
+
+    assert bvh.node_count == 1
+
+    hits, distances = bvh.query_rays(array.array('f', [1.5, 1.5, -5.0]), array.array('f', [0.0, 0.0, 1.0]))
+
+    assert hits.tolist() == [0xFFFFFFFF]
+    assert math.isinf(distances[0])
+
+def test_bvh_refit_success() -> None:
+    bvh = BVH(_row_of_boxes(1000))
+    frustum = Frustum(Matrix4.ortho(10.0, 20.0, -1.0, 1.0, -1.0, 1.0))
+
+    bvh.refit(_row_of_boxes(1000, shift=-9.0))
+
+    # boxes now span [-9, -8], [-6, -5], ..., so [9, 10], [12, 13], [15, 16] and [18, 19] overlap the frustum
+    assert sorted(bvh.query_frustum(frustum).tolist()) == [6, 7, 8, 9]
+
+def test_bvh_large_matches_linear_culling_success() -> None:
+    aabbs = array.array('f')
+    for i in range(20000):
+        x, y, z = (i * 7919) % 200 - 100.0, (i * 104729) % 200 - 100.0, (i * 1299709) % 200 - 100.0
+        aabbs.extend((x, y, z, x + 1.0, y + 1.0, z + 1.0))
+
+    bvh = BVH(aabbs)
+    frustum = Frustum(Matrix4.perspective(1.0, 1.5, 0.1, 80.0))
+
+    assert sorted(bvh.query_frustum(frustum).tolist()) == frustum.cull_aabbs(aabbs, indices=True).tolist()
+
+def test_bvh_refit_failure_invalid_count() -> None:
+    bvh = BVH(_row_of_boxes(10))
+
+    with pytest.raises(ValueError):
+        bvh.refit(_row_of_boxes(11))
+
+def test_bvh_init_failure_invalid_leaf_size() -> None:
+    with pytest.raises(ValueError):
+        BVH(_row_of_boxes(10), max_leaf_size=0)
@@ -0,0 +1,96 @@
+import array
+import math
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import (BezierCurve, CatmullRomCurve, Curve, HermiteCurve,
+                       Vector3)
+
+def _points(*values: float) -> array.array:
+    return array.array('f', values)
+
+def _xyz(v: Vector3) -> tuple[float, float, float]:
+    return (v.x, v.y, v.z)
+
+def test_bezier_curve_evaluate_success() -> None:
+    curve = BezierCurve(_points(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 2.0, 0.0, 0.0, 3.0, 0.0, 0.0))
+    result = array.array('f', [0.0] * 15)
+
+    curve.evaluate(5, result)
+
+    assert isinstance(curve, Curve)
+    assert curve.segment_count == 1
+    assert curve.length == pytest.approx(3.0)
+    assert list(result[::3]) == pytest.approx([0.0, 0.75, 1.5, 2.25, 3.0])
+    assert _xyz(curve.tangent_at(0.5)) == pytest.approx((3.0, 0.0, 0.0))
+
+def test_bezier_curve_arc_length_success() -> None:
+    # control points clustered at the start make the curve speed up along its parameter
+    curve = BezierCurve(_points(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 3.0, 0.0, 0.0))
+    result = array.array('f', [0.0] * 15)
+
+    curve.evaluate(array.array('f', [0.0, 0.25, 0.5, 0.75, 1.0]), result, arc_length=True)
+
+    assert list(result[::3]) == pytest.approx([0.0, 0.75, 1.5, 2.25, 3.0], abs=1e-2)
+
+def test_catmull_rom_curve_interpolates_points_success() -> None:
+    curve = CatmullRomCurve(_points(0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 2.0, 0.0, 0.0, 3.0, 1.0, 0.0))
+
+    assert curve.segment_count == 3
+    assert _xyz(curve.point_at(1.0 / 3.0)) == pytest.approx((1.0, 1.0, 0.0))
+    assert _xyz(curve.point_at(2.0 / 3.0)) == pytest.approx((2.0, 0.0, 0.0))
+    assert _xyz(curve.point_at(1.0)) == pytest.approx((3.0, 1.0, 0.0))
+
+def test_catmull_rom_curve_closed_success() -> None:
+    curve = CatmullRomCurve(_points(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, -1.0, 0.0, 0.0, 0.0, -1.0, 0.0), closed=True)
+
+    assert curve.segment_count == 4
+    assert curve.length == pytest.approx(2.0 * math.pi, rel=0.1)
+    assert _xyz(curve.point_at(1.0)) == pytest.approx((1.0, 0.0, 0.0))
+
+def test_hermite_curve_success() -> None:
+    curve = HermiteCurve(_points(0.0, 0.0, 0.0, 1.0, 0.0, 0.0), _points(0.0, 1.0, 0.0, 0.0, -1.0, 0.0))
+
+    assert _xyz(curve.point_at(0.0)) == pytest.approx((0.0, 0.0, 0.0))
+    assert _xyz(curve.tangent_at(0.0)) == pytest.approx((0.0, 1.0, 0.0))
+    assert _xyz(curve.point_at(1.0)) == pytest.approx((1.0, 0.0, 0.0))
+
+def test_curve_evaluate_tangents_normalized_success() -> None:
+    curve = CatmullRomCurve(_points(0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 2.0, 0.0, 0.0))
+    result = array.array('f', [0.0] * 300)
+
+    curve.evaluate_tangents(100, result, normalize=True)
+
+    for i in range(100):
+        assert math.hypot(*result[i * 3:i * 3 + 3]) == pytest.approx(1.0)
+
+def test_curve_evaluate_interleaved_success(gl_context) -> None:
+    curve = BezierCurve(_points(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 2.0, 0.0, 0.0, 3.0, 0.0, 0.0))
+    buf = Buffer(3 * 24, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    curve.evaluate(3, buf, stride=24)
+    buf.reset_offset()
+    curve.evaluate_tangents(3, buf, stride=24, offset=12)
+
+    data = bytearray(3 * 24)
+    buf.read(data, 3 * 24)
+    result = memoryview(data).cast('f')
+
+    assert list(result[6:12]) == pytest.approx([1.5, 0.0, 0.0, 3.0, 0.0, 0.0])
+
+    buf.delete()
+
+def test_bezier_curve_init_failure_point_count() -> None:
+    with pytest.raises(ValueError):
+        BezierCurve(_points(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 2.0, 0.0, 0.0))
+
+def test_hermite_curve_init_failure_tangent_count() -> None:
+    with pytest.raises(ValueError):
+        HermiteCurve(_points(0.0, 0.0, 0.0, 1.0, 0.0, 0.0), _points(0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0))
+
+def test_curve_evaluate_failure_too_small() -> None:
+    curve = BezierCurve(_points(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 2.0, 0.0, 0.0, 3.0, 0.0, 0.0))
+
+    with pytest.raises(Exception):
+        curve.evaluate(10, array.array('f', [0.0] * 3))
@@ -0,0 +1,74 @@
+import array
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import (DMatrix4, DVector2, DVector3, DVector4, Matrix4,
+                       Quaternion, Vector3, get_free_list_stats,
+                       to_camera_relative)
+
+def test_dvector_precision_success() -> None:
+    v = DVector3(1e9, 0.0, 0.0) + DVector3(0.25)
+
+    assert v.x == 1e9 + 0.25
+    assert (v - DVector3(1e9, 0.0, 0.0)).x == 0.25
+
+def test_dvector_operations_success() -> None:
+    assert DVector2(1.0, 2.0).cross(DVector2(3.0, 4.0)) == -2.0
+    assert DVector3(1.0, 0.0, 0.0).cross(DVector3(0.0, 1.0, 0.0)).z == 1.0
+    assert DVector4(2.0).normalized().x == 0.5
+    assert DVector3(1.0, 2.0, 3.0).dot(DVector3(1.0)) == 6.0
+
+def test_dmatrix4_inverse_success() -> None:
+    m = DMatrix4.transform(
+        DVector3(1e9, 2.0, 3.0),
+        DVector3(2.0),
+        Quaternion.from_axis(0.3, Vector3(0.0, 0.0, 1.0)))
+    result = m @ m.inversed()
+
+    for i in range(4):
+        for j in range(4):
+            assert result[i, j] == pytest.approx(1.0 if i == j else 0.0, abs=1e-6)
+
+def test_dmatrix4_matches_matrix4_success() -> None:
+    d = DMatrix4.look_at(DVector3(1.0, 2.0, 5.0), DVector3(0.0))
+    f = Matrix4.look_at(Vector3(1.0, 2.0, 5.0), Vector3(0.0))
+
+    for i in range(4):
+        for j in range(4):
+            assert d[i, j] == pytest.approx(f[i, j], abs=1e-6)
+
+    assert DMatrix4.perspective(1.0, 1.5)[1, 1] == pytest.approx(Matrix4.perspective(1.0, 1.5)[1, 1])
+
+def test_to_camera_relative_success() -> None:
+    positions = array.array('d', [1e9 + 0.5, 2.0, 3.0, 1e9, 0.0, -1.0])
+    result = array.array('f', [0.0] * 6)
+
+    to_camera_relative(positions, DVector3(1e9, 0.0, 0.0), result)
+
+    assert list(result) == [0.5, 2.0, 3.0, 0.0, 0.0, -1.0]
+
+def test_to_camera_relative_interleaved_success(gl_context) -> None:
+    positions = array.array('d', [1e12 + 1.0, 1.0, 1.0, 1e12 - 1.0, -1.0, -1.0])
+    buf = Buffer(2 * 16, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    to_camera_relative(positions, DVector3(1e12, 0.0, 0.0), buf, stride=16, offset=4)
+
+    data = bytearray(2 * 16)
+    buf.read(data, 2 * 16)
+    result = memoryview(data).cast('f')
+
+    assert list(result[1:4]) == [1.0, 1.0, 1.0]
+    assert list(result[5:8]) == [-1.0, -1.0, -1.0]
+
+    buf.delete()
+
+def test_double_free_lists_success() -> None:
+    stats = get_free_list_stats()
+
+    assert 'pygl.math.DVector3' in stats
+    assert 'pygl.math.DMatrix4' in stats
+
+def test_to_camera_relative_failure_format() -> None:
+    with pytest.raises(TypeError):
+        to_camera_relative(array.array('f', [0.0] * 3), DVector3(0.0), array.array('f', [0.0] * 3))
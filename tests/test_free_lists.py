@@ -0,0 +1,34 @@
+import pytest
+
+from pygl.math import (Matrix4, Quaternion, Vector3, get_free_list_stats,
+                       set_free_list_capacity)
+
+
+def test_free_list_reuse_success() -> None:
+    a = Vector3(1.0)
+    del a
+
+    hits = get_free_list_stats()['pygl.math.Vector3']['hits']
+    b = Vector3(2.0) + Vector3(1.0)
+
+    assert get_free_list_stats()['pygl.math.Vector3']['hits'] > hits
+    assert b == Vector3(3.0)
+
+def test_free_list_set_capacity_success() -> None:
+    set_free_list_capacity(0, Matrix4)
+    Matrix4.identity() @ Matrix4.identity()
+
+    stats = get_free_list_stats()['pygl.math.Matrix4']
+    assert stats['capacity'] == 0
+    assert stats['size'] == 0
+
+    set_free_list_capacity(128)
+    assert get_free_list_stats()['pygl.math.Quaternion']['capacity'] == 128
+
+def test_free_list_set_capacity_failure_invalid_type() -> None:
+    with pytest.raises(TypeError):
+        set_free_list_capacity(16, int)
+
+def test_free_list_set_capacity_failure_negative() -> None:
+    with pytest.raises(ValueError):
+        set_free_list_capacity(-1, Quaternion)
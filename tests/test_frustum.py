@@ -0,0 +1,87 @@
+import array
+
+import pytest
+
+from pygl.math import Frustum, Matrix4, Plane, Vector3, Vector4Array
+
+# orthographic projection of the [-1, 1] cube is identity, so the frustum is the cube itself
+def _unit_frustum() -> Frustum:
+    return Frustum(Matrix4.ortho(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0))
+
+def test_plane_init_success() -> None:
+    plane = Plane(Vector3(0.0, 1.0, 0.0), 2.0)
+
+    assert plane.normal_y == 1.0
+    assert plane.distance == 2.0
+    assert plane.distance_to(Vector3(0.0, 1.0, 0.0)) == 3.0
+
+def test_frustum_planes_success() -> None:
+    planes = _unit_frustum().planes
+
+    assert len(planes) == 6
+    # left plane points inside, towards +x
+    assert (planes[0].normal_x, planes[0].normal_y, planes[0].normal_z) == pytest.approx((1.0, 0.0, 0.0))
+    assert planes[0].distance == pytest.approx(1.0)
+
+def test_frustum_contains_point_success() -> None:
+    frustum = _unit_frustum()
+
+    assert frustum.contains_point(Vector3(0.5, -0.5, 0.0))
+    assert not frustum.contains_point(Vector3(1.5, 0.0, 0.0))
+
+def test_frustum_intersects_success() -> None:
+    frustum = _unit_frustum()
+
+    assert frustum.intersects_sphere(Vector3(1.5, 0.0, 0.0), 0.6)
+    assert not frustum.intersects_sphere(Vector3(1.5, 0.0, 0.0), 0.4)
+    assert frustum.intersects_aabb(Vector3(0.9, 0.9, 0.9), Vector3(2.0, 2.0, 2.0))
+    assert not frustum.intersects_aabb(Vector3(1.1, 0.0, 0.0), Vector3(2.0, 1.0, 1.0))
+
+def test_frustum_cull_spheres_mask_success() -> None:
+    spheres = Vector4Array(array.array('f', [
+        0.0, 0.0, 0.0, 0.1,
+        5.0, 0.0, 0.0, 1.0,
+        0.0, -1.5, 0.0, 0.6,
+        0.0, 0.0, 3.0, 0.5,
+        0.0, 0.0, 0.0, 0.0,
+        9.0, 9.0, 9.0, 1.0,
+        1.0, 1.0, 1.0, 0.0,
+        -1.2, 0.0, 0.0, 0.1,
+        0.2, 0.2, 0.2, 0.2]))
+
+    mask = _unit_frustum().cull_spheres(spheres)
+
+    assert mask.format == 'B'
+    assert mask.tolist() == [0b01010101, 0b1]
+
+def test_frustum_cull_aabbs_indices_success() -> None:
+    aabbs = array.array('f', [
+        -0.5, -0.5, -0.5, 0.5, 0.5, 0.5,
+        2.0, 2.0, 2.0, 3.0, 3.0, 3.0,
+        -3.0, -3.0, -3.0, 3.0, 3.0, 3.0,
+        0.5, -4.0, 0.0, 0.6, -2.0, 0.1])
+
+    indices = _unit_frustum().cull_aabbs(aabbs, indices=True)
+
+    assert indices.format == 'I'
+    assert indices.tolist() == [0, 2]
+
+def test_frustum_cull_large_success() -> None:
+    count = 10000
+    data = array.array('f', [0.0, 0.0, 0.0, 0.5, 10.0, 0.0, 0.0, 0.5] * (count // 2))
+
+    frustum = _unit_frustum()
+
+    assert frustum.cull_spheres(data, indices=True).tolist() == list(range(0, count, 2))
+    assert frustum.cull_spheres(data).tolist() == [0b01010101] * (count // 8)
+
+def test_frustum_update_success() -> None:
+    frustum = _unit_frustum()
+    frustum.update(Matrix4.ortho(9.0, 11.0, -1.0, 1.0, -1.0, 1.0))
+
+    assert frustum.contains_point(Vector3(10.0, 0.0, 0.0))
+    assert not frustum.contains_point(Vector3(0.0, 0.0, 0.0))
+
+def test_frustum_cull_failure_invalid_size() -> None:
+    with pytest.raises(ValueError):
+        _unit_frustum().cull_aabbs(array.array('f', [0.0] * 4))
@@ -1,7 +1,9 @@
+import sys
+
 import numpy as np
 import pytest
 
-from pygl.math import Matrix4, Vector4
+from pygl.math import Matrix4, MatrixKind, Quaternion, Vector3, Vector4
 
 
 def test_matrix_init_no_args_success() -> None:
@@ -45,3 +47,134 @@ def test_matrix_init_buffer_success() -> None:
 def test_matrix_init_one_arg_failure_invalid_type() -> None:
     with pytest.raises(TypeError):
         Matrix4('str')
+
+def _values(m: Matrix4) -> list[float]:
+    return [m[i, j] for i in range(4) for j in range(4)]
+
+def test_matrix_matmul_into_success() -> None:
+    a = Matrix4.transform(Vector3(1.0, 2.0, 3.0))
+    b = Matrix4.transform(Vector3(0.0), Vector3(2.0))
+    out = Matrix4()
+
+    assert a.matmul_into(b, out) is out
+    assert _values(out) == _values(a @ b)
+
+def test_matrix_matmul_into_self_success() -> None:
+    a = Matrix4.transform(Vector3(1.0, 0.0, 0.0))
+    expected = _values(a @ a)
+
+    a.matmul_into(a, a)
+
+    assert _values(a) == expected
+
+def test_matrix_matmul_vector_out_success() -> None:
+    out = Vector4(0.0)
+
+    assert Matrix4.transform(Vector3(1.0)).matmul(Vector4(0.0, 0.0, 0.0, 1.0), out=out) is out
+    assert out == Vector4(1.0)
+
+def test_matrix_transposed_inversed_out_success() -> None:
+    m = Matrix4.transform(Vector3(1.0, 2.0, 3.0), Vector3(2.0))
+    out = Matrix4()
+
+    assert m.inversed(out=out) is out
+    assert _values(out @ m) == pytest.approx(_values(Matrix4.identity()))
+
+    m.transposed_into(m)
+
+    assert m[0, 3] == 1.0
+
+def test_matrix_inplace_ops_keep_reference_success() -> None:
+    m = Matrix4.identity()
+    other = Matrix4.identity()
+    refcount = sys.getrefcount(m)
+
+    for _ in range(10):
+        m @= other
+        m += other
+        m -= other
+
+    assert sys.getrefcount(m) == refcount
+
+def test_matrix_matmul_into_failure_invalid_out() -> None:
+    with pytest.raises(TypeError):
+        Matrix4.identity().matmul_into(Matrix4.identity(), Vector4(0.0))
+
+def test_matrix_buffer_success() -> None:
+    m = Matrix4.transform(Vector3(1.0, 2.0, 3.0))
+
+    assert memoryview(m).format == 'f'
+    assert memoryview(m).shape == (4, 4)
+    assert len(bytes(m)) == 64
+    assert np.asarray(memoryview(m))[0:3, 3].tolist() == [1.0, 2.0, 3.0]
+
+def test_matrix_data_aligned_success() -> None:
+    matrices = [Matrix4.identity() for _ in range(64)]
+
+    for m in matrices:
+        assert np.asarray(memoryview(m)).ctypes.data % 16 == 0
+
+def _as_general(m: Matrix4) -> Matrix4:
+    result = Matrix4([m[i, j] for i in range(4) for j in range(4)])
+    result.kind = MatrixKind.GENERAL
+
+    return result
+
+def _assert_close(a: Matrix4, b: Matrix4) -> None:
+    for i in range(4):
+        for j in range(4):
+            assert a[i, j] == pytest.approx(b[i, j], abs=1e-5)
+
+def _kind_cases() -> list[Matrix4]:
+    rotation = Quaternion.from_axis(0.7, Vector3(0.0, 1.0, 0.0))
+    return [
+        Matrix4.identity(),
+        Matrix4.transform(Vector3(1.0, 2.0, 3.0)),
+        Matrix4.transform(Vector3(1.0, 2.0, 3.0), rotation=rotation),
+        Matrix4.transform(Vector3(1.0, 2.0, 3.0), Vector3(2.0, 3.0, 0.5), rotation),
+        Matrix4.look_at(Vector3(3.0, 4.0, 5.0), Vector3(0.0)),
+        Matrix4.ortho(0.0, 10.0, 0.0, 5.0, 0.1, 100.0),
+        Matrix4.perspective(1.0, 1.5, 0.1, 100.0)]
+
+def test_matrix_kind_constructors_success() -> None:
+    assert [m.kind for m in _kind_cases()] == [
+        MatrixKind.IDENTITY,
+        MatrixKind.TRANSLATION,
+        MatrixKind.RIGID,
+        MatrixKind.AFFINE,
+        MatrixKind.RIGID,
+        MatrixKind.AFFINE,
+        MatrixKind.GENERAL]
+
+def test_matrix_kind_classify_success() -> None:
+    m = Matrix4(1.0)
+    assert m.kind == MatrixKind.IDENTITY
+
+    m[3, 0] = 2.0
+    assert m.kind == MatrixKind.TRANSLATION
+
+    m[0, 0] = 2.0
+    assert m.kind == MatrixKind.AFFINE
+
+    m[0, 3] = 1.0
+    assert m.kind == MatrixKind.GENERAL
+
+def test_matrix_kind_inverse_success() -> None:
+    for m in _kind_cases():
+        result = m.inversed()
+
+        assert result.kind == m.kind
+        _assert_close(result, _as_general(m).inversed())
+
+def test_matrix_kind_matmul_success() -> None:
+    cases = _kind_cases()
+    for a in cases:
+        for b in cases:
+            result = a @ b
+
+            assert result.kind == min(a.kind, b.kind)
+            _assert_close(result, _as_general(a) @ _as_general(b))
+
+def test_matrix_kind_set_failure() -> None:
+    with pytest.raises(ValueError):
+        Matrix4().kind = 10
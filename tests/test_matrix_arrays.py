@@ -0,0 +1,119 @@
+import array
+import ctypes
+import math
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import Matrix4, Matrix4Array, Quaternion, Vector3, Vector3Array
+
+
+class _PyBuffer(ctypes.Structure):
+    _fields_ = [
+        ('buf', ctypes.c_void_p),
+        ('obj', ctypes.c_void_p),
+        ('len', ctypes.c_ssize_t),
+        ('itemsize', ctypes.c_ssize_t),
+        ('readonly', ctypes.c_int),
+        ('ndim', ctypes.c_int),
+        ('format', ctypes.c_char_p),
+        ('shape', ctypes.POINTER(ctypes.c_ssize_t)),
+        ('strides', ctypes.POINTER(ctypes.c_ssize_t)),
+        ('suboffsets', ctypes.POINTER(ctypes.c_ssize_t)),
+        ('internal', ctypes.c_void_p)]
+
+_PyBUF_ND = 0x8
+
+def _export_info(obj, flags: int) -> tuple[int, bytes | None, tuple[int, ...], int]:
+    # exports `obj` with raw flags, which memoryview doesn't allow to choose
+    view = _PyBuffer()
+    ctypes.pythonapi.PyObject_GetBuffer.argtypes = [ctypes.py_object, ctypes.POINTER(_PyBuffer), ctypes.c_int]
+    ctypes.pythonapi.PyBuffer_Release.argtypes = [ctypes.POINTER(_PyBuffer)]
+    assert ctypes.pythonapi.PyObject_GetBuffer(obj, ctypes.byref(view), flags) == 0
+    try:
+        return view.itemsize, view.format, tuple(view.shape[i] for i in range(view.ndim)), view.len
+    finally:
+        ctypes.pythonapi.PyBuffer_Release(ctypes.byref(view))
+
+
+def _matrix_values(matrix: Matrix4) -> list[float]:
+    return [matrix[i, j] for i in range(4) for j in range(4)]
+
+def _assert_matrices_close(a: Matrix4, b: Matrix4) -> None:
+    assert _matrix_values(a) == pytest.approx(_matrix_values(b), abs=1e-5)
+
+def test_matrix_array_init_count_success() -> None:
+    a = Matrix4Array(3)
+
+    assert len(a) == 3
+    assert a.count == 3
+    assert memoryview(a).shape == (3, 4, 4)
+
+def test_matrix_array_buffer_protocol_no_format_success() -> None:
+    itemsize, fmt, shape, size = _export_info(Matrix4Array(3), _PyBUF_ND)
+
+    assert itemsize == 1
+    assert fmt is None
+    assert math.prod(shape) * itemsize == size == 3 * 16 * 4
+
+def test_matrix_array_identity_success() -> None:
+    a = Matrix4Array.identity(2)
+
+    _assert_matrices_close(a[1], Matrix4.identity())
+
+def test_matrix_array_compose_success() -> None:
+    translations = Vector3Array([Vector3(1.0, 2.0, 3.0), Vector3(-4.0, 0.0, 2.0)])
+    scales = Vector3Array([Vector3(2.0), Vector3(1.0, 3.0, 0.5)])
+    rotations = array.array('f', [0.0, 0.0, math.sin(0.5), math.cos(0.5)] * 2)
+
+    result = Matrix4Array.compose(translations, scales, rotations)
+
+    rotation = Quaternion(*rotations[:4])
+    for i in range(2):
+        _assert_matrices_close(result[i], Matrix4.transform(translations[i], scales[i], rotation))
+
+def test_matrix_array_compose_failure_count_mismatch() -> None:
+    with pytest.raises(ValueError):
+        Matrix4Array.compose(Vector3Array(2), Vector3Array(3))
+
+def test_matrix_array_compose_into_buffer_success(gl_context) -> None:
+    buf = Buffer(2 * 64, BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_READ_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+    translations = Vector3Array([Vector3(1.0, 2.0, 3.0), Vector3(4.0, 5.0, 6.0)])
+
+    assert Matrix4Array.compose(translations, out=buf) is None
+    assert buf.current_offset == 2 * 64
+
+    data = bytearray(2 * 64)
+    buf.read(data, 2 * 64)
+
+    assert bytes(data) == bytes(Matrix4Array.compose(translations))
+
+    buf.delete()
+
+def test_matrix_array_matmul_success() -> None:
+    a = Matrix4Array.compose(Vector3Array([Vector3(1.0), Vector3(2.0)]))
+    b = a.inversed()
+
+    result = a @ b
+
+    _assert_matrices_close(result[0], Matrix4.identity())
+    _assert_matrices_close(result[1], Matrix4.identity())
+
+def test_matrix_array_matmul_broadcast_success() -> None:
+    a = Matrix4Array.compose(Vector3Array([Vector3(1.0), Vector3(2.0)]))
+    m = Matrix4.transform(Vector3(-1.0))
+
+    _assert_matrices_close((m @ a)[0], Matrix4.identity())
+    _assert_matrices_close((a @ m)[1], Matrix4.transform(Vector3(1.0)))
+
+def test_matrix_array_matmul_failure_count_mismatch() -> None:
+    with pytest.raises(ValueError):
+        Matrix4Array(2) @ Matrix4Array(3)
+
+def test_matrix_array_transposed_out_success() -> None:
+    a = Matrix4Array.compose(Vector3Array([Vector3(1.0, 2.0, 3.0)]))
+    out = bytearray(64)
+
+    a.transposed(out=out)
+
+    assert Matrix4Array(out)[0][0, 3] == 1.0
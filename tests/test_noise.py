@@ -0,0 +1,113 @@
+import array
+import sys
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import Vector2, Vector3, Vector4, noise
+from pygl.textures import PixelType
+
+def test_noise_module_import_success() -> None:
+    import pygl.math.noise
+
+    assert sys.modules['pygl.math.noise'] is noise
+    assert pygl.math.noise.fill is noise.fill
+
+def test_noise_sample_success() -> None:
+    for func in (noise.perlin, noise.simplex, noise.worley):
+        for point in (Vector2(0.3, 1.7), Vector3(0.3, 1.7, -2.1), Vector4(0.3, 1.7, -2.1, 5.5)):
+            value = func(point, seed=3)
+
+            assert -1.0 <= value <= 1.0
+            assert func(point, seed=3) == value
+
+    # gradient noise vanishes at lattice points
+    assert noise.perlin(Vector3(1.0, 2.0, 3.0)) == pytest.approx(0.0, abs=1e-6)
+    assert noise.perlin(Vector2(0.5, 0.5), seed=1) != noise.perlin(Vector2(0.5, 0.5), seed=2)
+
+def test_noise_fractal_success() -> None:
+    point = Vector2(0.37, 0.81)
+
+    assert noise.fractal(point, fractal=noise.FractalType.NONE) == noise.perlin(point)
+    assert noise.fractal(point, octaves=1) == noise.perlin(point)
+
+    for fractal in (noise.FractalType.FBM, noise.FractalType.RIDGED):
+        assert -1.0 <= noise.fractal(point, noise.NoiseType.SIMPLEX, fractal=fractal, octaves=6) <= 1.0
+
+def test_noise_fill_success() -> None:
+    width, height = 37, 5
+    scale = 0.1
+    data = array.array('f', [0.0] * width * height)
+
+    noise.fill(data, width, height, noise_type=noise.NoiseType.SIMPLEX, scale=scale, seed=7)
+
+    for y in (0, height - 1):
+        for x in (0, width - 1):
+            expected = noise.simplex(Vector2(x * scale, y * scale), seed=7)
+            assert data[y * width + x] == pytest.approx(expected, abs=1e-5)
+
+def test_noise_fill_3d_origin_success() -> None:
+    data = array.array('f', [0.0] * 4 * 4 * 3)
+    origin = Vector4(1.0, 2.0, 3.0, 0.25)
+
+    noise.fill(data, 4, 4, 3, origin=origin, scale=0.5)
+
+    assert data[2 * 16 + 1 * 4 + 3] == pytest.approx(noise.perlin(Vector4(2.5, 2.5, 4.0, 0.25)))
+
+def test_noise_fill_parallel_success() -> None:
+    size = 256
+    data = array.array('f', [0.0] * size * size)
+
+    noise.fill(data, size, size, fractal=noise.FractalType.FBM, octaves=3, scale=0.05)
+
+    assert data[size * size - 1] == pytest.approx(
+        noise.fractal(Vector2((size - 1) * 0.05, (size - 1) * 0.05), octaves=3))
+    assert all(-1.0 <= value <= 1.0 for value in data)
+
+def test_noise_fill_region_success() -> None:
+    # fill 3x2 region of 5x4 bytes image, starting at texel (1, 1)
+    data = bytearray(5 * 4)
+
+    noise.fill(data, 3, 2, noise_type=noise.NoiseType.WORLEY, pixel_type=PixelType.UNSIGNED_BYTE, alignment=1, row_length=5, offset=6, scale=0.4)
+
+    assert data[:6] == bytes(6)
+    assert data[9:11] == bytes(2)
+    assert data[14:] == bytes(6)
+    assert data[6] == round((noise.worley(Vector2(0.0, 0.0)) * 0.5 + 0.5) * 255.0)
+    assert data[12] == round((noise.worley(Vector2(0.4, 0.4)) * 0.5 + 0.5) * 255.0)
+
+def test_noise_fill_alignment_success() -> None:
+    data = bytearray(8 * 2)
+
+    noise.fill(data, 5, 2, pixel_type=PixelType.UNSIGNED_BYTE, scale=0.3)
+
+    # rows are padded to 4 bytes by default, the same as GL_UNPACK_ALIGNMENT
+    assert data[5:8] == bytes(3)
+    assert data[13:] == bytes(3)
+    assert data[8] != 0
+
+def test_noise_fill_buffer_success(gl_context) -> None:
+    buf = Buffer(16 * 16 * 4, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+    expected = array.array('f', [0.0] * 16 * 16)
+
+    noise.fill(buf, 16, 16, seed=5)
+    noise.fill(expected, 16, 16, seed=5)
+
+    data = bytearray(16 * 16 * 4)
+    buf.read(data, len(data))
+
+    assert bytes(data) == bytes(expected)
+
+    buf.delete()
+
+def test_noise_fill_failure_buffer_too_small() -> None:
+    with pytest.raises(ValueError):
+        noise.fill(array.array('f', [0.0] * 15), 4, 4)
+
+def test_noise_fill_failure_pixel_type() -> None:
+    with pytest.raises(ValueError):
+        noise.fill(bytearray(64), 4, 4, pixel_type=PixelType.SHORT)
+
+def test_noise_fractal_failure_octaves() -> None:
+    with pytest.raises(ValueError):
+        noise.fractal(Vector2(0.0, 0.0), octaves=0)
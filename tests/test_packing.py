@@ -0,0 +1,134 @@
+import array
+import math
+import struct
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import PackFormat, get_packed_size, pack_vertices, unpack_vertices
+
+def _pack(values: list[float], format: PackFormat, components: int, **kwargs) -> bytes:
+    src = array.array('f', values)
+    dst = bytearray(kwargs.get('stride', get_packed_size(format, components)) * (len(values) // components))
+    pack_vertices(src, dst, format, components, **kwargs)
+
+    return bytes(dst)
+
+def _unpack(data: bytes, format: PackFormat, components: int, count: int, **kwargs) -> list[float]:
+    dst = array.array('f', [0.0] * components * count)
+    unpack_vertices(data, dst, format, components, **kwargs)
+
+    return dst.tolist()
+
+def test_get_packed_size_success() -> None:
+    assert get_packed_size(PackFormat.HALF_FLOAT, 2) == 4
+    assert get_packed_size(PackFormat.SNORM8, 4) == 4
+    assert get_packed_size(PackFormat.UNORM16, 3) == 6
+    assert get_packed_size(PackFormat.INT_2_10_10_10_REV, 4) == 4
+    assert get_packed_size(PackFormat.OCTAHEDRAL8) == 2
+    assert get_packed_size(PackFormat.OCTAHEDRAL16) == 4
+
+def test_pack_half_float_success() -> None:
+    values = [0.0, -0.0, 1.0, -2.5, 65504.0, 1e6, 1e-7, 0.1, math.inf, 3.0]
+    data = _pack(values, PackFormat.HALF_FLOAT, 2)
+
+    # values out of half range become infinity, the rest is rounded the same way as by struct
+    expected = [struct.unpack('<e', struct.pack('<e', v))[0] if abs(v) <= 65504.0 else math.inf for v in values]
+
+    assert list(struct.unpack(f'<{len(values)}e', data)) == expected
+    assert _unpack(data, PackFormat.HALF_FLOAT, 2, 5)[:8] == pytest.approx([0.0, 0.0, 1.0, -2.5, 65504.0, math.inf, 1.1920929e-07, 0.0999755859375])
+
+def test_pack_half_float_nan_success() -> None:
+    data = _pack([math.nan], PackFormat.HALF_FLOAT, 1)
+
+    assert math.isnan(struct.unpack('<e', data)[0])
+    assert math.isnan(_unpack(data, PackFormat.HALF_FLOAT, 1, 1)[0])
+
+def test_pack_snorm_unorm_success() -> None:
+    assert struct.unpack('<4b', _pack([1.0, -1.0, 0.5, -3.0], PackFormat.SNORM8, 4)) == (127, -127, 64, -127)
+    assert struct.unpack('<2h', _pack([1.0, -0.25], PackFormat.SNORM16, 2)) == (32767, -8192)
+    assert struct.unpack('<4B', _pack([1.0, 0.0, 0.5, 2.0], PackFormat.UNORM8, 4)) == (255, 0, 128, 255)
+    assert struct.unpack('<2H', _pack([0.25, -1.0], PackFormat.UNORM16, 2)) == (16384, 0)
+
+    assert _unpack(struct.pack('<4b', 127, -127, -128, 0), PackFormat.SNORM8, 4, 1) == pytest.approx([1.0, -1.0, -1.0, 0.0])
+    assert _unpack(struct.pack('<2H', 65535, 0), PackFormat.UNORM16, 2, 1) == pytest.approx([1.0, 0.0])
+
+def test_pack_int_2_10_10_10_rev_success() -> None:
+    tangent = [1.0, -1.0, 0.5, -1.0]
+    value, = struct.unpack('<I', _pack(tangent, PackFormat.INT_2_10_10_10_REV, 4))
+
+    assert value & 0x3ff == 511
+    assert (value >> 10) & 0x3ff == (-511) & 0x3ff
+    assert (value >> 20) & 0x3ff == 256
+    assert value >> 30 == 3
+    assert _unpack(struct.pack('<I', value), PackFormat.INT_2_10_10_10_REV, 4, 1) == pytest.approx([1.0, -1.0, 256 / 511, -1.0])
+
+def test_pack_unsigned_int_2_10_10_10_rev_success() -> None:
+    color = [1.0, 0.0, 0.5]
+    data = _pack(color, PackFormat.UNSIGNED_INT_2_10_10_10_REV, 3)
+    value, = struct.unpack('<I', data)
+
+    assert value == 1023 | 512 << 20 | 3 << 30
+    assert _unpack(data, PackFormat.UNSIGNED_INT_2_10_10_10_REV, 3, 1) == pytest.approx(color, abs=1e-3)
+
+def test_pack_octahedral_success() -> None:
+    normals = []
+    for i in range(64):
+        theta = math.acos(1.0 - 2.0 * (i + 0.5) / 64)
+        phi = i * 2.399963
+        normals.extend((math.sin(theta) * math.cos(phi), math.sin(theta) * math.sin(phi), math.cos(theta)))
+
+    for format, tolerance in ((PackFormat.OCTAHEDRAL8, 2e-2), (PackFormat.OCTAHEDRAL16, 1e-4)):
+        decoded = _unpack(_pack(normals, format, 3), format, 3, 64)
+
+        assert decoded == pytest.approx(normals, abs=tolerance)
+
+def test_pack_interleaved_success() -> None:
+    # 2 vertices with 12 byte stride, packed half UVs placed after 8 bytes of other attributes
+    data = bytearray(b'\xaa' * 24)
+    pack_vertices(array.array('f', [0.5, 1.0, 0.25, 2.0]), data, PackFormat.HALF_FLOAT, 2, stride=12, offset=8)
+
+    assert data[:8] == b'\xaa' * 8
+    assert struct.unpack_from('<2e', data, 8) == (0.5, 1.0)
+    assert struct.unpack_from('<2e', data, 20) == (0.25, 2.0)
+    assert _unpack(data, PackFormat.HALF_FLOAT, 2, 2, stride=12, offset=8) == [0.5, 1.0, 0.25, 2.0]
+
+def test_unpack_unaligned_destination_success() -> None:
+    dst = bytearray(1 + 4 * 4)
+    unpack_vertices(struct.pack('<4b', 127, -127, 0, 64), memoryview(dst)[1:], PackFormat.SNORM8, 4)
+
+    assert struct.unpack_from('<4f', dst, 1) == pytest.approx((1.0, -1.0, 0.0, 64 / 127))
+
+def test_pack_large_success() -> None:
+    values = [(i % 200) / 100.0 - 1.0 for i in range(3 * 10_000)]
+    data = _pack(values, PackFormat.SNORM16, 3)
+
+    assert _unpack(data, PackFormat.SNORM16, 3, 10_000) == pytest.approx(values, abs=1 / 32767)
+
+def test_pack_buffer_success(gl_context) -> None:
+    buf = Buffer(8 * 4, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+    values = [0.0, 0.0, 1.0] * 8
+
+    pack_vertices(array.array('f', values), buf, PackFormat.OCTAHEDRAL16)
+
+    data = bytearray(8 * 4)
+    buf.read(data, len(data))
+
+    assert bytes(data) == _pack(values, PackFormat.OCTAHEDRAL16, 3)
+
+    buf.delete()
+
+def test_pack_failure_components() -> None:
+    with pytest.raises(ValueError):
+        pack_vertices(array.array('f', [0.0] * 4), bytearray(4), PackFormat.OCTAHEDRAL8, 2)
+
+    with pytest.raises(ValueError):
+        pack_vertices(array.array('f', [0.0] * 5), bytearray(20), PackFormat.HALF_FLOAT, 5)
+
+def test_pack_failure_stride() -> None:
+    with pytest.raises(ValueError):
+        pack_vertices(array.array('f', [0.0] * 6), bytearray(12), PackFormat.SNORM16, 3, stride=4)
+
+def test_pack_failure_buffer_too_small() -> None:
+    with pytest.raises(ValueError):
+        pack_vertices(array.array('f', [0.0] * 6), bytearray(11), PackFormat.SNORM16, 3)
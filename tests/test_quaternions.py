@@ -0,0 +1,52 @@
+import math
+import sys
+
+import pytest
+
+from pygl.math import Quaternion, Vector3
+
+
+def test_quaternion_rotate_vector_success() -> None:
+    q = Quaternion.from_axis(math.pi / 2, Vector3(0.0, 0.0, 1.0))
+    v = Vector3(1.0, 0.0, 0.0)
+
+    assert q.rotate_vector(v) is v
+    assert (v.x, v.y, v.z) == pytest.approx((0.0, 1.0, 0.0), abs=1e-6)
+
+def test_quaternion_rotate_vector_into_success() -> None:
+    q = Quaternion.from_axis(math.pi / 2, Vector3(0.0, 0.0, 1.0))
+    v = Vector3(1.0, 0.0, 0.0)
+    out = Vector3(0.0)
+
+    assert q.rotate_vector_into(v, out) is out
+    assert (out.x, out.y, out.z) == pytest.approx((0.0, 1.0, 0.0), abs=1e-6)
+    assert v == Vector3(1.0, 0.0, 0.0)
+
+def test_quaternion_out_params_success() -> None:
+    q = Quaternion(0.0, 0.0, 2.0, 0.0)
+    out = Quaternion.identity()
+
+    assert q.normalized(out=out) is out
+    assert (out.x, out.y, out.z, out.w) == (0.0, 0.0, 1.0, 0.0)
+
+    assert out.inversed_into(out) is out
+    assert (out.x, out.y, out.z, out.w) == pytest.approx((0.0, 0.0, -1.0, 0.0))
+
+    assert Quaternion.identity().interpolate_into(Quaternion(0.0, 0.0, 0.0, 0.0), 0.5, out) is out
+    assert out.w == 0.5
+
+def test_quaternion_inplace_ops_keep_reference_success() -> None:
+    q = Quaternion.identity()
+    other = Quaternion.identity()
+    refcount = sys.getrefcount(q)
+
+    for _ in range(10):
+        q *= other
+        q += other
+        q -= other
+
+    assert sys.getrefcount(q) == refcount
+
+def test_quaternion_rotate_vector_into_failure_invalid_out() -> None:
+    with pytest.raises(TypeError):
+        Quaternion.identity().rotate_vector_into(Vector3(0.0), Quaternion.identity())
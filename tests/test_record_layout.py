@@ -0,0 +1,167 @@
+import struct
+
+import pytest
+
+from pygl.buffers import (Buffer, BufferFlags, FieldType, LayoutRule,
+                          RecordLayout)
+from pygl.math import Matrix4, Vector2, Vector3, Vector4
+from pygl.vertex_array import AttribType, VertexArray
+
+def test_record_layout_packed_success() -> None:
+    layout = RecordLayout([
+        ('position', FieldType.FLOAT3),
+        ('color', FieldType.UBYTE4N),
+        ('uv', FieldType.HALF2),
+        ('id', FieldType.UINT)])
+
+    assert layout.stride == 12 + 4 + 4 + 4
+    assert layout.offsets == {'position': 0, 'color': 12, 'uv': 16, 'id': 20}
+    assert layout.names == ('position', 'color', 'uv', 'id')
+
+    data = layout.pack([
+        (Vector3(1.0, 2.0, 3.0), (1.0, 0.0, 0.5, 2.0), Vector2(0.5, 0.25), 7),
+        ((4.0, 5.0, 6.0), Vector4(0.0), (1.0, -2.0), 2 ** 32 - 1)])
+
+    assert data == (
+        struct.pack('<3f4B2eI', 1.0, 2.0, 3.0, 255, 0, 128, 255, 0.5, 0.25, 7) +
+        struct.pack('<3f4B2eI', 4.0, 5.0, 6.0, 0, 0, 0, 0, 1.0, -2.0, 2 ** 32 - 1))
+
+def test_record_layout_normalized_success() -> None:
+    layout = RecordLayout([
+        ('a', FieldType.BYTE4N),
+        ('b', FieldType.SHORT2N),
+        ('c', FieldType.USHORT2N),
+        ('d', FieldType.INT_2_10_10_10_REV),
+        ('e', FieldType.UBYTE4)])
+    data = layout.pack([((1.0, -1.0, 0.5, 0.0), (1.0, -0.25), (0.25, 1.0), (1.0, -1.0, 0.0, 1.0), (1, 2, 3, 255))])
+
+    assert struct.unpack('<4b2h2HI4B', data) == (
+        127, -127, 64, 0, 32767, -8192, 16384, 65535,
+        511 | ((-511) & 0x3ff) << 10 | 1 << 30, 1, 2, 3, 255)
+
+def test_record_layout_std140_success() -> None:
+    layout = RecordLayout([
+        ('scale', FieldType.FLOAT),
+        ('direction', FieldType.FLOAT3),
+        ('offset', FieldType.FLOAT2),
+        ('normal_matrix', FieldType.MAT3),
+        ('model', FieldType.MAT4)], LayoutRule.STD140)
+
+    assert layout.offsets == {'scale': 0, 'direction': 16, 'offset': 32, 'normal_matrix': 48, 'model': 96}
+    assert layout.stride == 160
+    assert layout.alignment == 16
+
+    model = Matrix4([float(i) for i in range(16)])
+    data = layout.pack([(2.0, (0.0, 1.0, 0.0), (3.0, 4.0), [float(i) for i in range(9)], model)])
+
+    assert struct.unpack_from('<f', data, 0) == (2.0,)
+    assert data[4:16] == bytes(12)
+    assert struct.unpack_from('<3f', data, 64) == (3.0, 4.0, 5.0)
+    assert data[60:64] == bytes(4)
+    # matrices are stored column by column, the same as by Buffer.store
+    assert struct.unpack_from('<16f', data, 96) == tuple(float(i) for i in range(16))
+
+def test_record_layout_std430_success() -> None:
+    layout = RecordLayout([('a', FieldType.FLOAT), ('b', FieldType.FLOAT2), ('c', FieldType.FLOAT)], LayoutRule.STD430)
+
+    assert layout.offsets == {'a': 0, 'b': 8, 'c': 16}
+    assert layout.stride == 24
+
+    std140 = RecordLayout([('a', FieldType.FLOAT), ('b', FieldType.FLOAT2), ('c', FieldType.FLOAT)], LayoutRule.STD140)
+
+    assert std140.stride == 32
+
+def test_record_layout_pack_into_buffer_success(gl_context) -> None:
+    layout = RecordLayout([('position', FieldType.FLOAT2)])
+    buf = Buffer(64, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+
+    # rows of single field layouts don't have to be wrapped in tuples
+    assert layout.pack_into(buf, None, [Vector2(1.0, 2.0), (3.0, 4.0)]) == 2
+    assert buf.current_offset == 16
+    assert layout.pack_into(buf, None, (Vector2(float(i)) for i in range(2))) == 2
+
+    data = bytearray(32)
+    buf.read(data, 32)
+
+    assert struct.unpack('<8f', data) == (1.0, 2.0, 3.0, 4.0, 0.0, 0.0, 1.0, 1.0)
+
+    out = bytearray(12)
+    layout.pack_into(out, 4, [(5.0, 6.0)])
+
+    assert out == bytes(4) + struct.pack('<2f', 5.0, 6.0)
+
+    buf.delete()
+
+def test_record_layout_vertex_descriptors_success(gl_context) -> None:
+    layout = RecordLayout([('position', FieldType.FLOAT3), ('color', FieldType.UBYTE4N), ('model', FieldType.MAT4)])
+    descriptors = layout.get_vertex_descriptors(1)
+
+    assert [(d.attrib_index, d.type, d.count, d.rows, d.is_normalized, d.offset) for d in descriptors] == [
+        (1, AttribType.FLOAT, 3, 1, False, 0),
+        (2, AttribType.UNSIGNED_BYTE, 4, 1, True, 12),
+        (3, AttribType.FLOAT, 4, 4, False, 16)]
+
+    std140 = RecordLayout([('normal_matrix', FieldType.MAT3)], LayoutRule.STD140)
+
+    assert [d.offset for d in std140.get_vertex_descriptors()] == [0, 16, 32]
+
+    buf = Buffer(layout.stride * 4, BufferFlags.DYNAMIC_STORAGE_BIT)
+    vertex_input = layout.create_vertex_input(buf, divisor=1)
+
+    assert vertex_input.stride == layout.stride
+    assert vertex_input.divisor == 1
+
+    vao = VertexArray([vertex_input])
+    vao.delete()
+    buf.delete()
+
+def test_record_layout_failure_std_types() -> None:
+    with pytest.raises(ValueError):
+        RecordLayout([('color', FieldType.UBYTE4N)], LayoutRule.STD140)
+
+def test_record_layout_failure_fields() -> None:
+    with pytest.raises(ValueError):
+        RecordLayout([])
+
+    with pytest.raises(ValueError):
+        RecordLayout([('a', FieldType.FLOAT), ('a', FieldType.INT)])
+
+    with pytest.raises(TypeError):
+        RecordLayout([FieldType.FLOAT])
+
+def test_record_layout_init_after_failure_success() -> None:
+    layout = RecordLayout.__new__(RecordLayout)
+
+    with pytest.raises(ValueError):
+        layout.__init__([('a', FieldType.FLOAT), ('a', FieldType.INT)])
+
+    layout.__init__([('a', FieldType.FLOAT), ('b', FieldType.INT)])
+
+    assert layout.names == ('a', 'b')
+    assert layout.stride == 8
+
+def test_record_layout_failure_values() -> None:
+    layout = RecordLayout([('position', FieldType.FLOAT3), ('id', FieldType.UBYTE4)])
+
+    with pytest.raises(ValueError):
+        layout.pack([((1.0, 2.0), (0, 0, 0, 0))])
+
+    with pytest.raises(ValueError):
+        layout.pack([(Vector2(1.0, 2.0), (0, 0, 0, 0))])
+
+    with pytest.raises(OverflowError):
+        layout.pack([((1.0, 2.0, 3.0), (0, 0, 0, 256))])
+
+    with pytest.raises(ValueError):
+        layout.pack([((1.0, 2.0, 3.0),)])
+
+def test_record_layout_failure_buffer_overflow(gl_context) -> None:
+    layout = RecordLayout([('value', FieldType.FLOAT4)])
+    buf = Buffer(16, BufferFlags.DYNAMIC_STORAGE_BIT)
+
+    with pytest.raises(RuntimeError):
+        layout.pack_into(buf, None, [(0.0, 0.0, 0.0, 0.0)] * 2)
+
+    assert buf.current_offset == 0
+
+    buf.delete()
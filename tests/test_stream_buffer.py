@@ -0,0 +1,104 @@
+import struct
+
+import pytest
+
+from pygl.buffers import BindTarget, BufferBaseTarget, StreamBuffer
+from pygl.math import Matrix4, Vector4
+
+def test_stream_buffer_create_success(gl_context) -> None:
+    buf = StreamBuffer(1000, 3, alignment=256)
+
+    assert buf.region_size == 1024
+    assert buf.region_count == 3
+    assert buf.size == 3 * 1024
+    assert buf.alignment == 256
+    assert buf.current_region == 0
+    assert buf.available == 1024
+
+    default = StreamBuffer(100)
+
+    assert default.alignment >= 1
+    assert default.alignment & (default.alignment - 1) == 0
+    assert default.region_count == 3
+
+    buf.delete()
+    default.delete()
+
+def test_stream_buffer_allocate_success(gl_context) -> None:
+    buf = StreamBuffer(256, 2, alignment=16)
+
+    assert buf.allocate(4) == 0
+    assert buf.allocate(20) == 16
+    assert buf.region_offset == 36
+    assert buf.allocate(0) == 48
+    assert buf.available == 256 - 48
+
+    buf.end_frame()
+
+    assert buf.current_region == 1
+    assert buf.allocate(8) == 256
+
+    buf.delete()
+
+def test_stream_buffer_store_success(gl_context) -> None:
+    buf = StreamBuffer(256, 2, alignment=64)
+    matrix = Matrix4.identity()
+
+    assert buf.store(matrix) == 0
+    assert buf.store(Vector4(1.0, 2.0, 3.0, 4.0)) == 64
+    assert buf.store(b'\x01\x02\x03') == 128
+    assert buf.store(7) == 192
+
+    data = bytearray(buf.size)
+    buf.read(data, len(data))
+
+    assert bytes(data[:64]) == bytes(matrix)
+    assert struct.unpack_from('<4f', data, 64) == (1.0, 2.0, 3.0, 4.0)
+    assert data[128:131] == b'\x01\x02\x03'
+    assert struct.unpack_from('<i', data, 192) == (7,)
+
+    buf.delete()
+
+def test_stream_buffer_end_frame_wrap_success(gl_context) -> None:
+    buf = StreamBuffer(64, 3, alignment=4)
+
+    for frame in range(7):
+        offset = buf.store(struct.pack('<I', frame))
+        buf.bind_range(BufferBaseTarget.UNIFORM_BUFFER, 0, offset, 64)
+
+        assert offset == (frame % 3) * 64
+
+        buf.end_frame()
+
+    data = bytearray(4)
+    buf.read(data, 4, 64)
+
+    # region 1 was last written in frame 4, after waiting for frame 1 to finish
+    assert struct.unpack('<I', data) == (4,)
+    assert buf.current_region == 1
+    assert buf.stall_count >= 0
+
+    buf.bind(BindTarget.UNIFORM_BUFFER)
+    buf.delete()
+
+def test_stream_buffer_failure_region_full(gl_context) -> None:
+    buf = StreamBuffer(64, 2, alignment=4)
+    buf.allocate(60)
+
+    with pytest.raises(RuntimeError):
+        buf.allocate(8)
+
+    with pytest.raises(RuntimeError):
+        buf.store(Vector4(0.0, 0.0, 0.0, 0.0))
+
+    # failed allocations don't consume space
+    assert buf.allocate(4) == 60
+
+    buf.delete()
+
+def test_stream_buffer_failure_alignment(gl_context) -> None:
+    with pytest.raises(ValueError):
+        StreamBuffer(64, alignment=24)
+
+    with pytest.raises(ValueError):
+        StreamBuffer(0)
@@ -0,0 +1,54 @@
+import array
+
+import pytest
+
+from pygl.math import (Matrix4, Vector3, transform_directions, transform_normals,
+                       transform_points)
+
+
+def test_transform_points_success() -> None:
+    src = array.array('f', [1.0, 2.0, 3.0, 0.0, 0.0, 0.0])
+    dst = array.array('f', [0.0] * 6)
+
+    transform_points(Matrix4.transform(Vector3(1.0, 0.0, -1.0)), src, dst)
+
+    assert dst.tolist() == [2.0, 2.0, 2.0, 1.0, 0.0, -1.0]
+
+def test_transform_points_interleaved_success() -> None:
+    # position (3 floats) followed by uv (2 floats)
+    data = array.array('f', [1.0, 1.0, 1.0, 0.5, 0.5, 2.0, 2.0, 2.0, 0.25, 0.25])
+
+    transform_points(Matrix4.transform(Vector3(0.0), Vector3(2.0)), data, data, stride=20)
+
+    assert data.tolist() == [2.0, 2.0, 2.0, 0.5, 0.5, 4.0, 4.0, 4.0, 0.25, 0.25]
+
+def test_transform_points_offset_success() -> None:
+    # uv (2 floats) followed by position (3 floats)
+    data = array.array('f', [0.5, 0.5, 1.0, 2.0, 3.0])
+
+    transform_points(Matrix4.transform(Vector3(1.0)), data, data, stride=20, offset=8)
+
+    assert data.tolist() == [0.5, 0.5, 2.0, 3.0, 4.0]
+
+def test_transform_directions_success() -> None:
+    data = array.array('f', [1.0, 2.0, 3.0])
+
+    transform_directions(Matrix4.transform(Vector3(5.0)), data, data)
+
+    assert data.tolist() == [1.0, 2.0, 3.0]
+
+def test_transform_normals_success() -> None:
+    data = array.array('f', [1.0, 1.0, 0.0])
+
+    transform_normals(Matrix4.transform(Vector3(0.0), Vector3(1.0, 2.0, 1.0)), data, data)
+
+    # normals have to be transformed by inverse-transpose and normalized
+    assert data.tolist() == pytest.approx([0.894427, 0.447213, 0.0], abs=1e-5)
+
+def test_transform_points_failure_invalid_stride() -> None:
+    with pytest.raises(ValueError):
+        transform_points(Matrix4.identity(), bytes(24), bytearray(24), stride=8)
+
+def test_transform_points_failure_dst_too_small() -> None:
+    with pytest.raises(ValueError):
+        transform_points(Matrix4.identity(), bytes(24), bytearray(12))
@@ -0,0 +1,108 @@
+import array
+import math
+
+import pytest
+
+from pygl.buffers import Buffer, BufferFlags
+from pygl.math import Matrix4, Quaternion, TransformTree, Vector3
+
+def _translation(matrix: Matrix4) -> tuple[float, float, float]:
+    return (matrix[3, 0], matrix[3, 1], matrix[3, 2])
+
+def test_transform_tree_init_success() -> None:
+    tree = TransformTree([-1, 0, 1, -1])
+
+    assert tree.count == 4
+    assert len(tree) == 4
+    assert tree.parents == (-1, 0, 1, -1)
+    assert not tree.is_dirty
+    assert memoryview(tree).shape == (4, 4, 4)
+
+def test_transform_tree_update_success() -> None:
+    tree = TransformTree([-1, 0, 1])
+
+    tree.set_translation(0, Vector3(1.0, 0.0, 0.0))
+    tree.set_translation(1, Vector3(0.0, 2.0, 0.0))
+    tree.set_scale(1, Vector3(2.0))
+    tree.set_translation(2, Vector3(0.0, 0.0, 1.0))
+
+    assert tree.is_dirty
+    assert tree.update() == (0, 3)
+    assert not tree.is_dirty
+    assert _translation(tree.get_world(2)) == pytest.approx((1.0, 2.0, 2.0))
+
+def test_transform_tree_update_rotation_success() -> None:
+    tree = TransformTree([-1, 0])
+
+    tree.set_rotation(0, Quaternion.from_axis(math.pi / 2, Vector3(0.0, 0.0, 1.0)))
+    tree.set_translation(1, Vector3(1.0, 0.0, 0.0))
+    tree.update()
+
+    assert _translation(tree.get_world(1)) == pytest.approx((0.0, 1.0, 0.0), abs=1e-6)
+
+def test_transform_tree_update_subtree_success() -> None:
+    # two independent chains: 0 -> 1 -> 2 and 3 -> 4
+    tree = TransformTree([-1, 0, 1, -1, 3])
+    tree.set_translation(0, Vector3(1.0, 0.0, 0.0))
+    tree.update()
+
+    tree.set_translation(3, Vector3(0.0, 5.0, 0.0))
+
+    # only the second chain is visited
+    assert tree.update() == (3, 5)
+    assert tree.update() == (0, 0)
+    assert _translation(tree.get_world(2)) == pytest.approx((1.0, 0.0, 0.0))
+    assert _translation(tree.get_world(4)) == pytest.approx((0.0, 5.0, 0.0))
+
+def test_transform_tree_set_transforms_success() -> None:
+    tree = TransformTree([-1, 0, 0])
+
+    tree.set_transforms(array.array('I', [0, 2]), translations=array.array('f', [1.0, 0.0, 0.0, 0.0, 3.0, 0.0]))
+    tree.update()
+
+    assert _translation(tree.get_world(1)) == pytest.approx((1.0, 0.0, 0.0))
+    assert _translation(tree.get_world(2)) == pytest.approx((1.0, 3.0, 0.0))
+
+def test_transform_tree_set_transforms_all_success() -> None:
+    tree = TransformTree([-1, -1])
+
+    tree.set_transforms(None, translations=array.array('f', [1.0, 2.0, 3.0, 4.0, 5.0, 6.0]), scales=array.array('f', [2.0] * 6))
+    tree.update()
+
+    expected = Matrix4.transform(Vector3(4.0, 5.0, 6.0), Vector3(2.0))
+    local = tree.get_local(1)
+    world = memoryview(tree).tolist()[1]
+
+    for i in range(4):
+        for j in range(4):
+            assert local[i, j] == expected[i, j]
+            assert world[i][j] == expected[i, j]
+
+def test_transform_tree_store_success(gl_context) -> None:
+    tree = TransformTree([-1, 0])
+    tree.set_translation(0, Vector3(1.0, 2.0, 3.0))
+    tree.update()
+
+    buf = Buffer(2 * 64, BufferFlags.MAP_READ_BIT | BufferFlags.MAP_WRITE_BIT | BufferFlags.MAP_PERSISTENT_BIT)
+    buf.store(tree)
+
+    data = bytearray(2 * 64)
+    buf.read(data, 2 * 64)
+
+    assert bytes(data) == bytes(tree)
+
+    buf.delete()
+
+def test_transform_tree_init_failure_invalid_parent() -> None:
+    with pytest.raises(ValueError):
+        TransformTree([-1, 1])
+
+def test_transform_tree_set_translation_failure_index() -> None:
+    with pytest.raises(IndexError):
+        TransformTree([-1]).set_translation(1, Vector3(0.0))
+
+def test_transform_tree_set_transforms_failure_count() -> None:
+    with pytest.raises(ValueError):
+        TransformTree([-1, -1]).set_transforms(
+            array.array('I', [0, 1]),
+            translations=array.array('f', [0.0] * 3))
@@ -0,0 +1,118 @@
+import array
+import ctypes
+import math
+
+import pytest
+
+from pygl.math import Vector2, Vector2Array, Vector3, Vector3Array, Vector4Array
+
+
+class _PyBuffer(ctypes.Structure):
+    _fields_ = [
+        ('buf', ctypes.c_void_p),
+        ('obj', ctypes.c_void_p),
+        ('len', ctypes.c_ssize_t),
+        ('itemsize', ctypes.c_ssize_t),
+        ('readonly', ctypes.c_int),
+        ('ndim', ctypes.c_int),
+        ('format', ctypes.c_char_p),
+        ('shape', ctypes.POINTER(ctypes.c_ssize_t)),
+        ('strides', ctypes.POINTER(ctypes.c_ssize_t)),
+        ('suboffsets', ctypes.POINTER(ctypes.c_ssize_t)),
+        ('internal', ctypes.c_void_p)]
+
+_PyBUF_ND = 0x8
+
+def _export_info(obj, flags: int) -> tuple[int, bytes | None, tuple[int, ...], int]:
+    # exports `obj` with raw flags, which memoryview doesn't allow to choose
+    view = _PyBuffer()
+    ctypes.pythonapi.PyObject_GetBuffer.argtypes = [ctypes.py_object, ctypes.POINTER(_PyBuffer), ctypes.c_int]
+    ctypes.pythonapi.PyBuffer_Release.argtypes = [ctypes.POINTER(_PyBuffer)]
+    assert ctypes.pythonapi.PyObject_GetBuffer(obj, ctypes.byref(view), flags) == 0
+    try:
+        return view.itemsize, view.format, tuple(view.shape[i] for i in range(view.ndim)), view.len
+    finally:
+        ctypes.pythonapi.PyBuffer_Release(ctypes.byref(view))
+
+
+def test_vector_array_init_count_success() -> None:
+    a = Vector3Array(4)
+
+    assert len(a) == 4
+    assert a.count == 4
+    assert a[3] == Vector3(0.0)
+
+def test_vector_array_init_sequence_success() -> None:
+    a = Vector3Array([Vector3(1.0, 2.0, 3.0), Vector3(4.0, 5.0, 6.0)])
+
+    assert a[0] == Vector3(1.0, 2.0, 3.0)
+    assert a[1] == Vector3(4.0, 5.0, 6.0)
+
+def test_vector_array_init_buffer_success() -> None:
+    a = Vector2Array(array.array('f', [1.0, 2.0, 3.0, 4.0]))
+
+    assert len(a) == 2
+    assert a[1] == Vector2(3.0, 4.0)
+
+def test_vector_array_init_buffer_failure_invalid_size() -> None:
+    with pytest.raises(ValueError):
+        Vector4Array(bytes(12))
+
+def test_vector_array_init_sequence_failure_invalid_type() -> None:
+    with pytest.raises(TypeError):
+        Vector3Array([Vector3(1.0), Vector2(1.0)])
+
+def test_vector_array_buffer_protocol_success() -> None:
+    a = Vector3Array(5)
+    view = memoryview(a)
+
+    assert view.format == 'f'
+    assert view.shape == (5, 3)
+    assert view.nbytes == 5 * 3 * 4
+
+def test_vector_array_buffer_protocol_no_format_success() -> None:
+    itemsize, fmt, shape, size = _export_info(Vector3Array(5), _PyBUF_ND)
+
+    assert itemsize == 1
+    assert fmt is None
+    assert math.prod(shape) * itemsize == size == 5 * 3 * 4
+
+def test_vector_array_add_success() -> None:
+    a = Vector3Array([Vector3(1.0), Vector3(2.0)])
+    b = a + a
+
+    assert b[0] == Vector3(2.0)
+    assert b[1] == Vector3(4.0)
+
+def test_vector_array_add_broadcast_success() -> None:
+    a = Vector3Array([Vector3(1.0), Vector3(2.0)])
+    a += Vector3(1.0, 0.0, 0.0)
+
+    assert a[0] == Vector3(2.0, 1.0, 1.0)
+    assert a[1] == Vector3(3.0, 2.0, 2.0)
+
+def test_vector_array_add_failure_length_mismatch() -> None:
+    with pytest.raises(ValueError):
+        Vector3Array(2) + Vector3Array(3)
+
+def test_vector_array_scale_success() -> None:
+    a = Vector2Array([Vector2(1.0, 2.0)]) * 2.0
+
+    assert a[0] == Vector2(2.0, 4.0)
+
+def test_vector_array_normalize_success() -> None:
+    a = Vector3Array([Vector3(3.0, 0.0, 0.0), Vector3(0.0, 0.0, 5.0)])
+    a.normalize()
+
+    assert a[0] == Vector3(1.0, 0.0, 0.0)
+    assert a[1] == Vector3(0.0, 0.0, 1.0)
+
+def test_vector_array_dot_success() -> None:
+    a = Vector3Array([Vector3(1.0, 2.0, 3.0), Vector3(1.0)])
+
+    assert a.dot(Vector3(1.0)).tolist() == [6.0, 3.0]
+
+def test_vector_array_cross_success() -> None:
+    a = Vector3Array([Vector3(1.0, 0.0, 0.0)])
+
+    assert a.cross(Vector3(0.0, 1.0, 0.0))[0] == Vector3(0.0, 0.0, 1.0)
@@ -245,3 +245,34 @@ def test_vector_mul_failure_invalid_operand() -> None:
 
     with pytest.raises(TypeError):
         a * b
+
+def test_vector_normalized_out_success() -> None:
+    v = Vector3(3.0, 0.0, 4.0)
+    out = Vector3(0.0)
+
+    assert v.normalized(out=out) is out
+    assert out == Vector3(0.6, 0.0, 0.8)
+    assert v == Vector3(3.0, 0.0, 4.0)
+
+def test_vector_cross_into_self_success() -> None:
+    v = Vector3(1.0, 0.0, 0.0)
+
+    assert v.cross_into(Vector3(0.0, 1.0, 0.0), v) is v
+    assert v == Vector3(0.0, 0.0, 1.0)
+
+def test_vector_interpolate_into_success() -> None:
+    out = Vector2(0.0)
+
+    assert Vector2(0.0).interpolate_into(Vector2(2.0), 0.5, out) is out
+    assert out == Vector2(1.0)
+
+def test_vector_normalized_into_failure_invalid_type() -> None:
+    with pytest.raises(TypeError):
+        Vector3(1.0).normalized_into(Vector4(1.0))
+
+def test_vector_buffer_success() -> None:
+    view = memoryview(Vector4(1.0, 2.0, 3.0, 4.0))
+
+    assert view.format == 'f'
+    assert view.readonly
+    assert view.tolist() == [1.0, 2.0, 3.0, 4.0]